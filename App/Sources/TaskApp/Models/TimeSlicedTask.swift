@@ -79,12 +79,17 @@ final class TimeSlicedTask : TSKTask {
     override func main() {
         let timeSliceInterval: TimeInterval = 1 / 16;
 
+        // Checking the token is a single load, which is much cheaper than checking isExecuting
+        guard let cancellationToken = cancellationToken else {
+            return
+        }
+
         let shouldFail = Double.random(in: 0 ..< 1) < probabilityOfFailure
         let failureTime: TimeInterval = Double.random(in: 0 ..< 1) * timeRequired
 
         timeTaken = 0
         while timeTaken < timeRequired {
-            guard isExecuting else {
+            guard !cancellationToken.isCancelled else {
                 return
             }
 
@@ -81,6 +81,9 @@ extension TaskState {
         case .failed:
             Image(systemName: "xmark.circle")
                 .symbolRenderingMode(.multicolor)
+        case .skipped:
+            Image(systemName: "forward.circle")
+                .foregroundColor(.gray)
         }
     }
 
@@ -103,6 +106,9 @@ extension TaskState {
         case .failed:
             Image(systemName: "xmark.circle.fill")
                 .symbolRenderingMode(.multicolor)
+        case .skipped:
+            Image(systemName: "forward.circle.fill")
+                .foregroundColor(.gray)
         }
     }
 }
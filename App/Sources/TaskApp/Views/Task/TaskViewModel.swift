@@ -18,16 +18,18 @@ final class TaskViewModel : TaskViewModeling {
     init(task: TSKTask) {
         self.task = task
 
-        for task in task.prerequisiteTasks + [task] {
-            task.publisher(for: \.state)
-                .map { _ in return () }
-                .merge(with: task.publisher(for: \.progress).map { _ in return () })
-                .receive(on: RunLoop.main)
-                .sink { [weak self] (_) in
-                    self?.objectWillChange.send()
-                }
-                .store(in: &taskChangeSubscribers)
-        }
+        // State changes are delivered by the workflow view model’s state observer. Progress changes
+        // aren’t state changes, so they are observed here, but throttled to the same rate.
+        task.publisher(for: \.progress)
+            .throttle(
+                for: .seconds(1 / WorkflowViewModel.maximumRefreshRate),
+                scheduler: RunLoop.main,
+                latest: true
+            )
+            .sink { [weak self] (_) in
+                self?.objectWillChange.send()
+            }
+            .store(in: &taskChangeSubscribers)
     }
 
 
@@ -68,7 +70,7 @@ final class TaskViewModel : TaskViewModeling {
             return "Cancel"
         case .cancelled, .failed:
             return "Retry"
-        case .finished:
+        case .finished, .skipped:
             return "Reset"
         default:
             return "N/A"
@@ -93,7 +95,7 @@ final class TaskViewModel : TaskViewModeling {
             task.cancel()
         case .cancelled, .failed:
             task.retry()
-        case .finished:
+        case .finished, .skipped:
             task.reset()
         default:
             return
@@ -115,6 +117,8 @@ extension TaskState {
             self = .failed
         case .finished:
             self = .finished
+        case .skipped:
+            self = .skipped
         default:
             self = .waiting
         }
@@ -41,4 +41,5 @@ enum TaskState {
     case canceled
     case finished
     case failed
+    case skipped
 }
@@ -11,9 +11,13 @@ import Task
 
 
 final class WorkflowViewModel : WorkflowViewModeling {
+    /// The maximum number of times per second that task view models are refreshed.
+    static let maximumRefreshRate: Double = 10
+
     let workflow: TSKWorkflow
     let taskViewModels: [TaskViewModel]
     var subscribers: Set<AnyCancellable> = []
+    private var stateObserver: TSKWorkflowStateObserver?
 
 
     @Published
@@ -24,6 +28,31 @@ final class WorkflowViewModel : WorkflowViewModeling {
         self.workflow = workflow
         self.taskViewModels = tasks.map(TaskViewModel.init(task:))
 
+        // Each task view model shows its task and the task’s prerequisites, so it needs to refresh when
+        // any of them changes state
+        var taskViewModelsByTask: [ObjectIdentifier : [TaskViewModel]] = [:]
+        for taskViewModel in taskViewModels {
+            for task in taskViewModel.task.prerequisiteTasks + [taskViewModel.task] {
+                taskViewModelsByTask[ObjectIdentifier(task), default: []].append(taskViewModel)
+            }
+        }
+
+        // State changes are coalesced so that busy workflows don’t flood the main thread with updates
+        stateObserver = TSKWorkflowStateObserver(
+            workflow: workflow,
+            maximumDeliveryRate: Self.maximumRefreshRate,
+            queue: .main
+        ) { (delta) in
+            var changedViewModelIDs: Set<ObjectIdentifier> = []
+            for task in delta.changedTasks {
+                for taskViewModel in taskViewModelsByTask[ObjectIdentifier(task)] ?? [] {
+                    if changedViewModelIDs.insert(ObjectIdentifier(taskViewModel)).inserted {
+                        taskViewModel.objectWillChange.send()
+                    }
+                }
+            }
+        }
+
         workflow.notificationCenter.publisher(for: .TSKWorkflowDidFinish, object: workflow)
             .receive(on: RunLoop.main)
             .sink { [weak self] _ in
@@ -43,6 +72,11 @@ final class WorkflowViewModel : WorkflowViewModeling {
     }
 
 
+    deinit {
+        stateObserver?.invalidate()
+    }
+
+
     var name: String {
         return workflow.name
     }
@@ -10,6 +10,10 @@ let package = Package(
             name: "Task",
             targets: ["Task"]
         ),
+        .library(
+            name: "TaskAsync",
+            targets: ["TaskAsync"]
+        ),
     ],
     dependencies: [
         .package(url: "https://github.com/prachigauriar/URLMock.git", from: "1.3.6"),
@@ -18,6 +22,15 @@ let package = Package(
         .target(
             name: "Task"
         ),
+        .target(
+            name: "TaskAsync",
+            dependencies: ["Task"]
+        ),
+        .executableTarget(
+            name: "TaskWorkerFixture",
+            dependencies: ["Task"],
+            path: "Tests/TaskWorkerFixture"
+        ),
         .testTarget(
             name: "TaskTests",
             dependencies: [
@@ -25,5 +38,12 @@ let package = Package(
                 "URLMock"
             ]
         ),
+        .testTarget(
+            name: "TaskAsyncTests",
+            dependencies: [
+                "Task",
+                "TaskAsync"
+            ]
+        ),
     ]
 )
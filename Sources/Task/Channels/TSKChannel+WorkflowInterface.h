@@ -0,0 +1,60 @@
+//
+//  TSKChannel+WorkflowInterface.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Task/TSKChannel.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ The WorkflowInterface category of TSKChannel declares messages that must be exposed so that
+ TSKWorkflows and TSKTasks can connect channels to the state of their producers and consumers.
+ */
+@interface TSKChannel (WorkflowInterface)
+
+/*! Whether an item has been sent since the channel was created or last reopened. */
+@property (nonatomic, assign, readonly) BOOL hasSentItem;
+
+/*!
+ @abstract A block that is executed when the first item is sent after the channel is created or
+     reopened.
+ @discussion The block is executed on the sending thread after the item has been added and the
+     channel’s lock has been released. The block is set and read while holding the channel’s lock,
+     so it can be set while the producer is already sending items.
+ */
+@property (nonatomic, copy, nullable) void (^firstItemHandler)(void);
+
+/*!
+ @abstract Removes all items from the channel and reopens it.
+ @discussion Senders and receivers that were blocked before the channel was reopened return as if
+     the channel had been closed. This is used when a producer is reset or retried so that its next
+     execution starts with an empty channel.
+ */
+- (void)reopen;
+
+@end
+
+NS_ASSUME_NONNULL_END
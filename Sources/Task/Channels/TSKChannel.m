@@ -0,0 +1,253 @@
+//
+//  TSKChannel.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Task/TSKChannel.h>
+
+#import "TSKChannel+WorkflowInterface.h"
+
+
+@interface TSKChannel () {
+    /*!
+     The number of times the channel has been reopened. Blocked senders and receivers compare this
+     to the value they started with so that they return when the channel is reopened.
+     */
+    NSUInteger _generation;
+
+    BOOL _closed;
+    NSError *_error;
+    BOOL _hasSentItem;
+    void (^_firstItemHandler)(void);
+}
+
+/*! The condition that guards the channel’s state and on which senders and receivers wait. */
+@property (nonatomic, strong, readonly) NSCondition *condition;
+
+/*! The items in the channel, oldest first. */
+@property (nonatomic, strong, readonly) NSMutableArray *items;
+
+/*!
+ @abstract Adds the specified item to the channel and wakes waiting receivers.
+ @discussion The channel’s condition must be locked when this is invoked.
+ @param item The item to add.
+ @result The block that should be executed after the condition is unlocked, or nil if there is none.
+ */
+- (nullable void (^)(void))enqueueItem:(id)item;
+
+@end
+
+
+@implementation TSKChannel
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity
+{
+    NSParameterAssert(capacity > 0);
+
+    self = [super init];
+    if (self) {
+        _capacity = capacity;
+        _condition = [[NSCondition alloc] init];
+        _items = [[NSMutableArray alloc] initWithCapacity:capacity];
+    }
+
+    return self;
+}
+
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p count = %lu; capacity = %lu; closed = %@>", self.class, self,
+            (unsigned long)self.count, (unsigned long)self.capacity, self.isClosed ? @"YES" : @"NO"];
+}
+
+
+- (NSUInteger)count
+{
+    [self.condition lock];
+    NSUInteger count = self.items.count;
+    [self.condition unlock];
+    return count;
+}
+
+
+- (BOOL)isClosed
+{
+    [self.condition lock];
+    BOOL closed = _closed;
+    [self.condition unlock];
+    return closed;
+}
+
+
+- (NSError *)error
+{
+    [self.condition lock];
+    NSError *error = _error;
+    [self.condition unlock];
+    return error;
+}
+
+
+- (BOOL)hasSentItem
+{
+    [self.condition lock];
+    BOOL hasSentItem = _hasSentItem;
+    [self.condition unlock];
+    return hasSentItem;
+}
+
+
+- (void (^)(void))firstItemHandler
+{
+    [self.condition lock];
+    void (^handler)(void) = _firstItemHandler;
+    [self.condition unlock];
+    return handler;
+}
+
+
+- (void)setFirstItemHandler:(void (^)(void))firstItemHandler
+{
+    firstItemHandler = [firstItemHandler copy];
+
+    [self.condition lock];
+    _firstItemHandler = firstItemHandler;
+    [self.condition unlock];
+}
+
+
+#pragma mark - Sending and Receiving
+
+- (void (^)(void))enqueueItem:(id)item
+{
+    [self.items addObject:item];
+    [self.condition broadcast];
+
+    if (_hasSentItem) {
+        return nil;
+    }
+
+    _hasSentItem = YES;
+    return _firstItemHandler;
+}
+
+
+- (BOOL)sendItem:(id)item
+{
+    NSParameterAssert(item);
+
+    [self.condition lock];
+
+    NSUInteger generation = _generation;
+    while (!_closed && _generation == generation && self.items.count >= self.capacity) {
+        [self.condition wait];
+    }
+
+    BOOL didSend = !_closed && _generation == generation;
+    void (^handler)(void) = didSend ? [self enqueueItem:item] : nil;
+
+    [self.condition unlock];
+
+    if (handler) {
+        handler();
+    }
+
+    return didSend;
+}
+
+
+- (BOOL)trySendItem:(id)item
+{
+    NSParameterAssert(item);
+
+    [self.condition lock];
+
+    BOOL didSend = !_closed && self.items.count < self.capacity;
+    void (^handler)(void) = didSend ? [self enqueueItem:item] : nil;
+
+    [self.condition unlock];
+
+    if (handler) {
+        handler();
+    }
+
+    return didSend;
+}
+
+
+- (id)receiveItem
+{
+    [self.condition lock];
+
+    NSUInteger generation = _generation;
+    while (!_closed && _generation == generation && self.items.count == 0) {
+        [self.condition wait];
+    }
+
+    id item = nil;
+    if (_generation == generation && self.items.count != 0) {
+        item = self.items.firstObject;
+        [self.items removeObjectAtIndex:0];
+        [self.condition broadcast];
+    }
+
+    [self.condition unlock];
+    return item;
+}
+
+
+#pragma mark - Closing
+
+- (void)close
+{
+    [self closeWithError:nil];
+}
+
+
+- (void)closeWithError:(NSError *)error
+{
+    [self.condition lock];
+    if (!_closed) {
+        _closed = YES;
+        _error = error;
+        [self.condition broadcast];
+    }
+    [self.condition unlock];
+}
+
+
+- (void)reopen
+{
+    [self.condition lock];
+    ++_generation;
+    [self.items removeAllObjects];
+    _closed = NO;
+    _error = nil;
+    _hasSentItem = NO;
+    [self.condition broadcast];
+    [self.condition unlock];
+}
+
+@end
@@ -0,0 +1,148 @@
+//
+//  TSKCancellationToken.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Task/TSKCancellationToken.h>
+
+#import <os/lock.h>
+#import <stdatomic.h>
+
+
+@interface TSKCancellationToken () {
+    /*! Whether the token is cancelled. This is only set while holding the handler lock. */
+    atomic_bool _cancelled;
+
+    /*! A lock that guards handlers and the transition into the cancelled state. */
+    os_unfair_lock _handlerLock;
+}
+
+/*! The token’s handlers that have not yet run, in the order they were added. */
+@property (nonatomic, strong, readonly) NSMutableArray<void (^)(void)> *handlers;
+
+/*! The object returned when the token registered its handler with its parent. */
+@property (nonatomic, strong, readonly, nullable) id parentHandler;
+
+@end
+
+
+@implementation TSKCancellationToken
+
+- (instancetype)init
+{
+    return [self initWithParentToken:nil];
+}
+
+
+- (instancetype)initWithParentToken:(TSKCancellationToken *)parentToken
+{
+    self = [super init];
+    if (self) {
+        atomic_init(&_cancelled, false);
+        _handlerLock = OS_UNFAIR_LOCK_INIT;
+        _handlers = [[NSMutableArray alloc] init];
+        _parentToken = parentToken;
+
+        // The parent must not keep its children alive, as tokens are created for every execution
+        __weak TSKCancellationToken *weakSelf = self;
+        _parentHandler = [parentToken addCancellationHandler:^{
+            [weakSelf cancel];
+        }];
+    }
+
+    return self;
+}
+
+
+- (void)dealloc
+{
+    if (_parentHandler) {
+        [_parentToken removeCancellationHandler:_parentHandler];
+    }
+}
+
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p cancelled = %@>", self.class, self, self.isCancelled ? @"YES" : @"NO"];
+}
+
+
+- (BOOL)isCancelled
+{
+    return atomic_load_explicit(&_cancelled, memory_order_acquire);
+}
+
+
+- (void)cancel
+{
+    os_unfair_lock_lock(&_handlerLock);
+    if (atomic_load_explicit(&_cancelled, memory_order_relaxed)) {
+        os_unfair_lock_unlock(&_handlerLock);
+        return;
+    }
+
+    atomic_store_explicit(&_cancelled, true, memory_order_release);
+    NSArray<void (^)(void)> *handlers = [self.handlers copy];
+    [self.handlers removeAllObjects];
+    os_unfair_lock_unlock(&_handlerLock);
+
+    // Handlers run without the lock held so that they can use the token
+    for (void (^handler)(void) in handlers) {
+        handler();
+    }
+}
+
+
+- (id)addCancellationHandler:(void (^)(void))handler
+{
+    NSParameterAssert(handler);
+
+    void (^copiedHandler)(void) = [handler copy];
+
+    os_unfair_lock_lock(&_handlerLock);
+    BOOL cancelled = atomic_load_explicit(&_cancelled, memory_order_relaxed);
+    if (!cancelled) {
+        [self.handlers addObject:copiedHandler];
+    }
+    os_unfair_lock_unlock(&_handlerLock);
+
+    if (cancelled) {
+        copiedHandler();
+    }
+
+    return copiedHandler;
+}
+
+
+- (void)removeCancellationHandler:(id)handler
+{
+    NSParameterAssert(handler);
+
+    os_unfair_lock_lock(&_handlerLock);
+    [self.handlers removeObjectIdenticalTo:handler];
+    os_unfair_lock_unlock(&_handlerLock);
+}
+
+@end
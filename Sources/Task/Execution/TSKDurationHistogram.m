@@ -0,0 +1,277 @@
+//
+//  TSKDurationHistogram.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Task/TSKDurationHistogram.h>
+
+#import <sched.h>
+#import <stdatomic.h>
+#import <time.h>
+
+
+/*! The window of histograms created with ‑init. */
+static const NSTimeInterval kTSKDurationHistogramDefaultWindowDuration = 5 * 60;
+
+/*! The number of epochs into which a histogram’s window is divided. */
+#define TSK_HISTOGRAM_EPOCH_COUNT 4
+
+/*! The number of buckets per power of two, expressed as a power of two. */
+#define TSK_HISTOGRAM_SUB_BUCKET_BITS 2
+
+/*! The number of buckets in each epoch. This covers every 64-bit nanosecond duration. */
+#define TSK_HISTOGRAM_BUCKET_COUNT (64 << TSK_HISTOGRAM_SUB_BUCKET_BITS)
+
+
+/*! The bit of an epoch’s stamp that is set while its counts are being cleared. */
+#define TSK_HISTOGRAM_STAMP_RESETTING ((uint64_t)1)
+
+
+/*! The counts for one epoch of a histogram’s window. */
+typedef struct {
+    /*!
+     One more than the number of the epoch whose counts are stored, shifted left by one, or 0 if the
+     slot is unused. The low bit is TSK_HISTOGRAM_STAMP_RESETTING while the counts are being cleared.
+     */
+    _Atomic(uint64_t) stamp;
+    _Atomic(uint64_t) count;
+    _Atomic(uint64_t) totalNanoseconds;
+    _Atomic(uint64_t) buckets[TSK_HISTOGRAM_BUCKET_COUNT];
+} TSKHistogramEpoch;
+
+
+static NSUInteger TSKHistogramBucketIndex(uint64_t nanoseconds)
+{
+    static const uint64_t kSubBucketCount = 1 << TSK_HISTOGRAM_SUB_BUCKET_BITS;
+    if (nanoseconds < kSubBucketCount) {
+        return (NSUInteger)nanoseconds;
+    }
+
+    // Durations from 2^k up to 2^(k + 1) are split into kSubBucketCount equally sized buckets
+    unsigned int highBit = 63 - __builtin_clzll(nanoseconds);
+    unsigned int shift = highBit - TSK_HISTOGRAM_SUB_BUCKET_BITS;
+    uint64_t subBucket = (nanoseconds >> shift) - kSubBucketCount;
+    return (NSUInteger)(((highBit - TSK_HISTOGRAM_SUB_BUCKET_BITS + 1) << TSK_HISTOGRAM_SUB_BUCKET_BITS) + subBucket);
+}
+
+
+static double TSKHistogramBucketMidpoint(NSUInteger index)
+{
+    static const NSUInteger kSubBucketCount = 1 << TSK_HISTOGRAM_SUB_BUCKET_BITS;
+    if (index < kSubBucketCount) {
+        return index;
+    }
+
+    NSUInteger shift = (index >> TSK_HISTOGRAM_SUB_BUCKET_BITS) - 1;
+    double lowerBound = (double)((kSubBucketCount + (index & (kSubBucketCount - 1))) << shift);
+    return lowerBound + (double)((uint64_t)1 << shift) / 2;
+}
+
+
+#pragma mark -
+
+@interface TSKDurationHistogram () {
+    TSKHistogramEpoch *_epochs;
+    uint64_t _epochNanoseconds;
+}
+
+/*!
+ @abstract Merges the counts of the epochs in the current window.
+ @param buckets A buffer with room for TSK_HISTOGRAM_BUCKET_COUNT counts that receives the merged
+     bucket counts. May be NULL.
+ @param totalNanoseconds Receives the sum of the durations in the window. May be NULL.
+ @result The number of durations in the window.
+ */
+- (uint64_t)mergeCountsIntoBuckets:(nullable uint64_t *)buckets totalNanoseconds:(nullable uint64_t *)totalNanoseconds;
+
+@end
+
+
+@implementation TSKDurationHistogram
+
+- (instancetype)init
+{
+    return [self initWithWindowDuration:kTSKDurationHistogramDefaultWindowDuration];
+}
+
+
+- (instancetype)initWithWindowDuration:(NSTimeInterval)windowDuration
+{
+    NSParameterAssert(windowDuration > 0);
+
+    self = [super init];
+    if (self) {
+        _windowDuration = windowDuration;
+        _epochNanoseconds = MAX((uint64_t)(windowDuration * NSEC_PER_SEC / TSK_HISTOGRAM_EPOCH_COUNT), 1);
+
+        // Zeroed memory is a valid initial state for the epochs’ atomic counters
+        _epochs = calloc(TSK_HISTOGRAM_EPOCH_COUNT, sizeof(TSKHistogramEpoch));
+        if (!_epochs) {
+            [NSException raise:NSMallocException format:@"Could not allocate duration histogram"];
+        }
+    }
+
+    return self;
+}
+
+
+- (void)dealloc
+{
+    free(_epochs);
+}
+
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p count = %lu; mean = %g; p50 = %g; p99 = %g>", self.class, self,
+            (unsigned long)self.count, self.meanDuration, [self durationAtPercentile:0.5], [self durationAtPercentile:0.99]];
+}
+
+
+- (uint64_t)currentEpoch
+{
+    return clock_gettime_nsec_np(CLOCK_MONOTONIC_RAW) / _epochNanoseconds;
+}
+
+
+- (void)recordDuration:(NSTimeInterval)duration
+{
+    if (!(duration >= 0)) {
+        return;
+    }
+
+    uint64_t nanoseconds = duration < (double)UINT64_MAX / NSEC_PER_SEC ? (uint64_t)(duration * NSEC_PER_SEC) : UINT64_MAX;
+    uint64_t epoch = [self currentEpoch];
+    TSKHistogramEpoch *slot = &_epochs[epoch % TSK_HISTOGRAM_EPOCH_COUNT];
+    uint64_t epochStamp = (epoch + 1) << 1;
+
+    // The first thread to record in a new epoch claims the slot by marking it as resetting, clears its
+    // old counts, and only then publishes the new stamp. Other threads wait for the stamp to be
+    // published before recording, so that the clearing can’t wipe out their counts. Threads that
+    // computed an older epoch just record into the newer one rather than moving it backwards.
+    uint64_t stamp = atomic_load_explicit(&slot->stamp, memory_order_acquire);
+    while (YES) {
+        if (stamp & TSK_HISTOGRAM_STAMP_RESETTING) {
+            sched_yield();
+            stamp = atomic_load_explicit(&slot->stamp, memory_order_acquire);
+        } else if (stamp >= epochStamp) {
+            break;
+        } else if (atomic_compare_exchange_weak_explicit(&slot->stamp, &stamp, epochStamp | TSK_HISTOGRAM_STAMP_RESETTING,
+                                                         memory_order_acquire, memory_order_acquire)) {
+            atomic_store_explicit(&slot->count, 0, memory_order_relaxed);
+            atomic_store_explicit(&slot->totalNanoseconds, 0, memory_order_relaxed);
+            for (NSUInteger i = 0; i < TSK_HISTOGRAM_BUCKET_COUNT; ++i) {
+                atomic_store_explicit(&slot->buckets[i], 0, memory_order_relaxed);
+            }
+
+            atomic_store_explicit(&slot->stamp, epochStamp, memory_order_release);
+            break;
+        }
+    }
+
+    atomic_fetch_add_explicit(&slot->buckets[TSKHistogramBucketIndex(nanoseconds)], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&slot->totalNanoseconds, nanoseconds, memory_order_relaxed);
+    atomic_fetch_add_explicit(&slot->count, 1, memory_order_relaxed);
+}
+
+
+- (uint64_t)mergeCountsIntoBuckets:(uint64_t *)buckets totalNanoseconds:(uint64_t *)totalNanoseconds
+{
+    uint64_t currentEpoch = [self currentEpoch];
+    uint64_t count = 0;
+    uint64_t total = 0;
+
+    if (buckets) {
+        memset(buckets, 0, TSK_HISTOGRAM_BUCKET_COUNT * sizeof(uint64_t));
+    }
+
+    for (NSUInteger i = 0; i < TSK_HISTOGRAM_EPOCH_COUNT; ++i) {
+        TSKHistogramEpoch *slot = &_epochs[i];
+        // Slots that are unused, expired, or being cleared don’t contribute
+        uint64_t stamp = atomic_load_explicit(&slot->stamp, memory_order_acquire);
+        if (stamp == 0 || (stamp & TSK_HISTOGRAM_STAMP_RESETTING) || (stamp >> 1) - 1 + TSK_HISTOGRAM_EPOCH_COUNT <= currentEpoch) {
+            continue;
+        }
+
+        count += atomic_load_explicit(&slot->count, memory_order_relaxed);
+        total += atomic_load_explicit(&slot->totalNanoseconds, memory_order_relaxed);
+        if (buckets) {
+            for (NSUInteger j = 0; j < TSK_HISTOGRAM_BUCKET_COUNT; ++j) {
+                buckets[j] += atomic_load_explicit(&slot->buckets[j], memory_order_relaxed);
+            }
+        }
+    }
+
+    if (totalNanoseconds) {
+        *totalNanoseconds = total;
+    }
+
+    return count;
+}
+
+
+- (NSUInteger)count
+{
+    return (NSUInteger)[self mergeCountsIntoBuckets:NULL totalNanoseconds:NULL];
+}
+
+
+- (NSTimeInterval)meanDuration
+{
+    uint64_t totalNanoseconds = 0;
+    uint64_t count = [self mergeCountsIntoBuckets:NULL totalNanoseconds:&totalNanoseconds];
+    return count != 0 ? (double)totalNanoseconds / count / NSEC_PER_SEC : 0;
+}
+
+
+- (NSTimeInterval)durationAtPercentile:(double)percentile
+{
+    NSParameterAssert(percentile >= 0 && percentile <= 1);
+
+    uint64_t buckets[TSK_HISTOGRAM_BUCKET_COUNT];
+    [self mergeCountsIntoBuckets:buckets totalNanoseconds:NULL];
+
+    // Counts are read bucket by bucket, so use their sum rather than the separately maintained count
+    uint64_t count = 0;
+    for (NSUInteger i = 0; i < TSK_HISTOGRAM_BUCKET_COUNT; ++i) {
+        count += buckets[i];
+    }
+
+    if (count == 0) {
+        return -1;
+    }
+
+    uint64_t rank = MAX((uint64_t)ceil(percentile * count), 1);
+    uint64_t cumulativeCount = 0;
+    for (NSUInteger i = 0; i < TSK_HISTOGRAM_BUCKET_COUNT; ++i) {
+        cumulativeCount += buckets[i];
+        if (cumulativeCount >= rank) {
+            return TSKHistogramBucketMidpoint(i) / NSEC_PER_SEC;
+        }
+    }
+
+    return TSKHistogramBucketMidpoint(TSK_HISTOGRAM_BUCKET_COUNT - 1) / NSEC_PER_SEC;
+}
+
+@end
@@ -0,0 +1,125 @@
+//
+//  TSKDurationStatistics.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Task/TSKDurationStatistics.h>
+
+#import <Task/TSKDurationHistogram.h>
+#import <os/lock.h>
+
+
+/*! The window of the shared instance and of instances created with ‑init. */
+static const NSTimeInterval kTSKDurationStatisticsDefaultWindowDuration = 5 * 60;
+
+
+@interface TSKDurationStatistics () {
+    /*! A lock that synchronizes access to histogramsByTaskName. */
+    os_unfair_lock _lock;
+}
+
+@property (nonatomic, strong, readonly) NSMutableDictionary<NSString *, TSKDurationHistogram *> *histogramsByTaskName;
+
+@end
+
+
+@implementation TSKDurationStatistics
+
++ (TSKDurationStatistics *)sharedStatistics
+{
+    static TSKDurationStatistics *sharedStatistics = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedStatistics = [[self alloc] init];
+    });
+
+    return sharedStatistics;
+}
+
+
+- (instancetype)init
+{
+    return [self initWithWindowDuration:kTSKDurationStatisticsDefaultWindowDuration];
+}
+
+
+- (instancetype)initWithWindowDuration:(NSTimeInterval)windowDuration
+{
+    NSParameterAssert(windowDuration > 0);
+
+    self = [super init];
+    if (self) {
+        _windowDuration = windowDuration;
+        _lock = OS_UNFAIR_LOCK_INIT;
+        _histogramsByTaskName = [[NSMutableDictionary alloc] init];
+    }
+
+    return self;
+}
+
+
+- (NSSet<NSString *> *)taskNames
+{
+    os_unfair_lock_lock(&_lock);
+    NSSet *taskNames = [[NSSet alloc] initWithArray:self.histogramsByTaskName.allKeys];
+    os_unfair_lock_unlock(&_lock);
+
+    return taskNames;
+}
+
+
+- (TSKDurationHistogram *)histogramForTaskName:(NSString *)taskName
+{
+    NSParameterAssert(taskName);
+
+    os_unfair_lock_lock(&_lock);
+    TSKDurationHistogram *histogram = self.histogramsByTaskName[taskName];
+    if (!histogram) {
+        histogram = [[TSKDurationHistogram alloc] initWithWindowDuration:self.windowDuration];
+        self.histogramsByTaskName[taskName] = histogram;
+    }
+    os_unfair_lock_unlock(&_lock);
+
+    return histogram;
+}
+
+
+- (TSKDurationHistogram *)existingHistogramForTaskName:(NSString *)taskName
+{
+    NSParameterAssert(taskName);
+
+    os_unfair_lock_lock(&_lock);
+    TSKDurationHistogram *histogram = self.histogramsByTaskName[taskName];
+    os_unfair_lock_unlock(&_lock);
+
+    return histogram;
+}
+
+
+- (void)recordDuration:(NSTimeInterval)duration forTaskName:(NSString *)taskName
+{
+    [[self histogramForTaskName:taskName] recordDuration:duration];
+}
+
+@end
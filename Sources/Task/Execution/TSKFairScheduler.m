@@ -0,0 +1,410 @@
+//
+//  TSKFairScheduler.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Task/TSKFairScheduler.h>
+
+#import <os/lock.h>
+
+
+/*! A block that has been scheduled but not yet added to the operation queue. */
+@interface TSKScheduledBlock : NSObject
+
+@property (nonatomic, copy, readonly) void (^block)(void);
+
+/*! The system uptime at which the block was scheduled. */
+@property (nonatomic, assign, readonly) NSTimeInterval scheduleTime;
+
+/*!
+ The block’s deadline as a time interval since the reference date. Blocks without a deadline have a
+ deadline of infinity so that they sort after all blocks with one.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval deadline;
+
+- (instancetype)initWithBlock:(void (^)(void))block scheduleTime:(NSTimeInterval)scheduleTime deadline:(NSTimeInterval)deadline;
+
+@end
+
+
+/*! A workflow’s scheduling state and statistics. */
+@interface TSKSchedulerFlow : NSObject
+
+@property (nonatomic, assign) NSUInteger weight;
+
+/*! The number of blocks the flow may still run during its current turn. */
+@property (nonatomic, assign) NSUInteger deficit;
+
+/*! Whether the flow is in the scheduler’s list of flows with scheduled blocks. */
+@property (nonatomic, assign, getter=isActive) BOOL active;
+
+/*! The flow’s scheduled blocks, ordered by deadline and then by the order they were scheduled. */
+@property (nonatomic, strong, readonly) NSMutableArray<TSKScheduledBlock *> *scheduledBlocks;
+
+@property (nonatomic, assign) NSUInteger dispatchedCount;
+@property (nonatomic, assign) NSTimeInterval totalWaitTime;
+@property (nonatomic, assign) NSTimeInterval maximumWaitTime;
+
+@end
+
+
+#pragma mark -
+
+@interface TSKFairScheduler () {
+    /*! A lock that synchronizes access to all of the scheduler’s mutable state. */
+    os_unfair_lock _lock;
+
+    /*! The number of blocks the scheduler has on its operation queue. */
+    NSUInteger _runningCount;
+
+    /*! The index in activeFlows of the flow whose turn it is. */
+    NSUInteger _activeFlowIndex;
+}
+
+/*! A map table from workflows to their flows. Workflows are weakly referenced. */
+@property (nonatomic, strong, readonly) NSMapTable<TSKWorkflow *, TSKSchedulerFlow *> *flows;
+
+/*! The flows that have scheduled blocks, in the order in which they take turns. */
+@property (nonatomic, strong, readonly) NSMutableArray<TSKSchedulerFlow *> *activeFlows;
+
+/*!
+ @abstract Returns the flow for the specified workflow, creating it if necessary.
+ @discussion The scheduler’s lock must be held when this is invoked.
+ */
+- (TSKSchedulerFlow *)flowForWorkflow:(TSKWorkflow *)workflow;
+
+/*!
+ @abstract Returns the index in activeFlows of the flow that should run the next block.
+ @discussion The scheduler’s lock must be held when this is invoked, and there must be at least one
+     active flow.
+ */
+- (NSUInteger)nextActiveFlowIndex;
+
+/*!
+ @abstract Removes blocks from the active flows until the scheduler’s operation queue is full or
+     there are no more scheduled blocks.
+ @discussion The scheduler’s lock must be held when this is invoked.
+ @result The blocks to add to the operation queue, or nil if there are none.
+ */
+- (nullable NSArray<void (^)(void)> *)dequeueBlocks;
+
+/*!
+ @abstract Adds the specified blocks to the operation queue.
+ @discussion The scheduler’s lock must not be held when this is invoked.
+ */
+- (void)runBlocks:(nullable NSArray<void (^)(void)> *)blocks;
+
+@end
+
+
+@implementation TSKFairScheduler
+
+- (instancetype)init
+{
+    return [self initWithOperationQueue:[[NSOperationQueue alloc] init]];
+}
+
+
+- (instancetype)initWithOperationQueue:(NSOperationQueue *)operationQueue
+{
+    NSInteger maxConcurrentOperationCount = operationQueue.maxConcurrentOperationCount;
+    NSUInteger maximumConcurrentTaskCount = maxConcurrentOperationCount > 0 ? maxConcurrentOperationCount
+                                                                            : [NSProcessInfo processInfo].activeProcessorCount;
+    return [self initWithOperationQueue:operationQueue maximumConcurrentTaskCount:maximumConcurrentTaskCount];
+}
+
+
+- (instancetype)initWithOperationQueue:(NSOperationQueue *)operationQueue maximumConcurrentTaskCount:(NSUInteger)maximumConcurrentTaskCount
+{
+    NSParameterAssert(operationQueue);
+    NSParameterAssert(maximumConcurrentTaskCount > 0);
+
+    self = [super init];
+    if (self) {
+        _operationQueue = operationQueue;
+        _maximumConcurrentTaskCount = maximumConcurrentTaskCount;
+        _lock = OS_UNFAIR_LOCK_INIT;
+        _flows = [NSMapTable weakToStrongObjectsMapTable];
+        _activeFlows = [[NSMutableArray alloc] init];
+    }
+
+    return self;
+}
+
+
+- (TSKSchedulerFlow *)flowForWorkflow:(TSKWorkflow *)workflow
+{
+    TSKSchedulerFlow *flow = [self.flows objectForKey:workflow];
+    if (!flow) {
+        flow = [[TSKSchedulerFlow alloc] init];
+        [self.flows setObject:flow forKey:workflow];
+    }
+
+    return flow;
+}
+
+
+#pragma mark - Weights
+
+- (void)setWeight:(NSUInteger)weight forWorkflow:(TSKWorkflow *)workflow
+{
+    NSParameterAssert(weight > 0);
+    NSParameterAssert(workflow);
+
+    os_unfair_lock_lock(&_lock);
+    [self flowForWorkflow:workflow].weight = weight;
+    os_unfair_lock_unlock(&_lock);
+}
+
+
+- (NSUInteger)weightForWorkflow:(TSKWorkflow *)workflow
+{
+    NSParameterAssert(workflow);
+
+    os_unfair_lock_lock(&_lock);
+    TSKSchedulerFlow *flow = [self.flows objectForKey:workflow];
+    NSUInteger weight = flow ? flow.weight : 1;
+    os_unfair_lock_unlock(&_lock);
+
+    return weight;
+}
+
+
+#pragma mark - Scheduling
+
+- (void)scheduleBlock:(void (^)(void))block forWorkflow:(TSKWorkflow *)workflow
+{
+    [self scheduleBlock:block forWorkflow:workflow deadline:nil];
+}
+
+
+- (void)scheduleBlock:(void (^)(void))block forWorkflow:(TSKWorkflow *)workflow deadline:(NSDate *)deadline
+{
+    NSParameterAssert(block);
+    NSParameterAssert(workflow);
+
+    TSKScheduledBlock *scheduledBlock = [[TSKScheduledBlock alloc] initWithBlock:block
+                                                                    scheduleTime:[NSProcessInfo processInfo].systemUptime
+                                                                        deadline:deadline ? deadline.timeIntervalSinceReferenceDate : INFINITY];
+
+    os_unfair_lock_lock(&_lock);
+
+    // Keep the flow’s blocks sorted by deadline. Most blocks have no deadline or a later deadline
+    // than those already scheduled, so we search from the end.
+    TSKSchedulerFlow *flow = [self flowForWorkflow:workflow];
+    NSMutableArray<TSKScheduledBlock *> *scheduledBlocks = flow.scheduledBlocks;
+    NSUInteger index = scheduledBlocks.count;
+    while (index > 0 && scheduledBlocks[index - 1].deadline > scheduledBlock.deadline) {
+        --index;
+    }
+
+    [scheduledBlocks insertObject:scheduledBlock atIndex:index];
+    if (!flow.isActive) {
+        flow.active = YES;
+        [self.activeFlows addObject:flow];
+    }
+
+    NSArray *blocks = [self dequeueBlocks];
+
+    os_unfair_lock_unlock(&_lock);
+
+    [self runBlocks:blocks];
+}
+
+
+- (NSUInteger)nextActiveFlowIndex
+{
+    NSArray<TSKSchedulerFlow *> *activeFlows = self.activeFlows;
+    if (self.policy != TSKSchedulingPolicyEarliestDeadlineFirst) {
+        return _activeFlowIndex < activeFlows.count ? _activeFlowIndex : 0;
+    }
+
+    // Each flow’s blocks are sorted by deadline, so the earliest deadline is at the head of one of
+    // the flows. Ties go to the flow that comes first, which keeps blocks without deadlines roughly
+    // in the order they were scheduled.
+    NSUInteger nextIndex = 0;
+    NSTimeInterval earliestDeadline = INFINITY;
+    for (NSUInteger i = 0; i < activeFlows.count; ++i) {
+        NSTimeInterval deadline = activeFlows[i].scheduledBlocks.firstObject.deadline;
+        if (deadline < earliestDeadline) {
+            earliestDeadline = deadline;
+            nextIndex = i;
+        }
+    }
+
+    return nextIndex;
+}
+
+
+- (NSArray<void (^)(void)> *)dequeueBlocks
+{
+    NSMutableArray *blocks = nil;
+    NSTimeInterval now = [NSProcessInfo processInfo].systemUptime;
+    NSMutableArray<TSKSchedulerFlow *> *activeFlows = self.activeFlows;
+
+    while (_runningCount < self.maximumConcurrentTaskCount && activeFlows.count != 0) {
+        _activeFlowIndex = [self nextActiveFlowIndex];
+
+        // A flow’s deficit is replenished at the beginning of each of its turns. Since every block
+        // costs the same, there’s no need to carry unused deficit over to the next turn.
+        TSKSchedulerFlow *flow = activeFlows[_activeFlowIndex];
+        if (flow.deficit == 0) {
+            flow.deficit = flow.weight;
+        }
+
+        TSKScheduledBlock *scheduledBlock = flow.scheduledBlocks.firstObject;
+        [flow.scheduledBlocks removeObjectAtIndex:0];
+        flow.deficit -= 1;
+
+        NSTimeInterval waitTime = now - scheduledBlock.scheduleTime;
+        flow.dispatchedCount += 1;
+        flow.totalWaitTime += waitTime;
+        flow.maximumWaitTime = MAX(flow.maximumWaitTime, waitTime);
+
+        if (!blocks) {
+            blocks = [[NSMutableArray alloc] init];
+        }
+
+        [blocks addObject:scheduledBlock.block];
+        ++_runningCount;
+
+        if (flow.scheduledBlocks.count == 0) {
+            // Removing the flow moves the next flow into the current index, so its turn is next
+            flow.active = NO;
+            flow.deficit = 0;
+            [activeFlows removeObjectAtIndex:_activeFlowIndex];
+        } else if (flow.deficit == 0) {
+            ++_activeFlowIndex;
+        }
+    }
+
+    return blocks;
+}
+
+
+- (void)runBlocks:(NSArray<void (^)(void)> *)blocks
+{
+    for (void (^block)(void) in blocks) {
+        [self.operationQueue addOperationWithBlock:^{
+            block();
+
+            os_unfair_lock_lock(&self->_lock);
+            --self->_runningCount;
+            NSArray *nextBlocks = [self dequeueBlocks];
+            os_unfair_lock_unlock(&self->_lock);
+
+            [self runBlocks:nextBlocks];
+        }];
+    }
+}
+
+
+#pragma mark - Statistics
+
+- (NSUInteger)queueDepthForWorkflow:(TSKWorkflow *)workflow
+{
+    NSParameterAssert(workflow);
+
+    os_unfair_lock_lock(&_lock);
+    NSUInteger queueDepth = [self.flows objectForKey:workflow].scheduledBlocks.count;
+    os_unfair_lock_unlock(&_lock);
+
+    return queueDepth;
+}
+
+
+- (NSUInteger)dispatchedTaskCountForWorkflow:(TSKWorkflow *)workflow
+{
+    NSParameterAssert(workflow);
+
+    os_unfair_lock_lock(&_lock);
+    NSUInteger dispatchedCount = [self.flows objectForKey:workflow].dispatchedCount;
+    os_unfair_lock_unlock(&_lock);
+
+    return dispatchedCount;
+}
+
+
+- (NSTimeInterval)averageWaitTimeForWorkflow:(TSKWorkflow *)workflow
+{
+    NSParameterAssert(workflow);
+
+    os_unfair_lock_lock(&_lock);
+    TSKSchedulerFlow *flow = [self.flows objectForKey:workflow];
+    NSTimeInterval averageWaitTime = flow.dispatchedCount != 0 ? flow.totalWaitTime / flow.dispatchedCount : 0;
+    os_unfair_lock_unlock(&_lock);
+
+    return averageWaitTime;
+}
+
+
+- (NSTimeInterval)maximumWaitTimeForWorkflow:(TSKWorkflow *)workflow
+{
+    NSParameterAssert(workflow);
+
+    os_unfair_lock_lock(&_lock);
+    NSTimeInterval maximumWaitTime = [self.flows objectForKey:workflow].maximumWaitTime;
+    os_unfair_lock_unlock(&_lock);
+
+    return maximumWaitTime;
+}
+
+@end
+
+
+#pragma mark -
+
+@implementation TSKScheduledBlock
+
+- (instancetype)initWithBlock:(void (^)(void))block scheduleTime:(NSTimeInterval)scheduleTime deadline:(NSTimeInterval)deadline
+{
+    self = [super init];
+    if (self) {
+        _block = [block copy];
+        _scheduleTime = scheduleTime;
+        _deadline = deadline;
+    }
+
+    return self;
+}
+
+@end
+
+
+#pragma mark -
+
+@implementation TSKSchedulerFlow
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _weight = 1;
+        _scheduledBlocks = [[NSMutableArray alloc] init];
+    }
+
+    return self;
+}
+
+@end
@@ -0,0 +1,55 @@
+//
+//  TSKFlightRecorder+TaskInterface.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Task/TSKFlightRecorder.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! TSKFlightRecorderEventType enumerates the kinds of events the flight recorder records. */
+typedef NS_ENUM(uint8_t, TSKFlightRecorderEventType) {
+    /*! The task transitioned from one state to another. */
+    TSKFlightRecorderEventTypeStateTransition = 1,
+
+    /*! A block of the task’s work was enqueued. */
+    TSKFlightRecorderEventTypeEnqueue,
+
+    /*! A block of the task’s work was dequeued and started running. */
+    TSKFlightRecorderEventTypeDequeue,
+};
+
+
+/*!
+ @abstract Records an event for the specified task in the current thread’s ring.
+ @discussion This function does nothing if the flight recorder is disabled.
+ @param type The type of the event.
+ @param task The task the event pertains to. The task is not retained.
+ @param fromState For state transitions, the state the task transitioned from. Otherwise 0.
+ @param toState For state transitions, the state the task transitioned to. Otherwise 0.
+ */
+extern void TSKFlightRecorderRecordEvent(TSKFlightRecorderEventType type, const void *task, uint8_t fromState, uint8_t toState);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,425 @@
+//
+//  TSKFlightRecorder.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TSKFlightRecorder+TaskInterface.h"
+
+#import <Task/TSKTask.h>
+#import <errno.h>
+#import <fcntl.h>
+#import <mach/mach_time.h>
+#import <pthread.h>
+#import <signal.h>
+#import <stdatomic.h>
+#import <unistd.h>
+
+
+#pragma mark Constants and Types
+
+/*! The number of events in each thread’s ring. Must be a power of two. */
+#define TSK_FLIGHT_RECORDER_RING_CAPACITY 2048
+
+/*! The number of events copied out of a ring at a time while writing a dump. */
+#define TSK_FLIGHT_RECORDER_DUMP_CHUNK_SIZE 64
+
+/*! The first four bytes of every dump, “TSKF” in little-endian order. */
+static const uint32_t kTSKFlightRecorderDumpMagic = 0x464B5354;
+
+/*! The version of the dump format. */
+static const uint32_t kTSKFlightRecorderDumpVersion = 1;
+
+
+/*! A recorded event. Events are written to dumps as is. */
+typedef struct {
+    /*! The time at which the event was recorded in mach absolute time units. */
+    uint64_t timestamp;
+    uint64_t threadID;
+    uint64_t taskAddress;
+    uint8_t type;
+    uint8_t fromState;
+    uint8_t toState;
+    uint8_t reserved[5];
+} TSKFlightRecorderEvent;
+
+_Static_assert(sizeof(TSKFlightRecorderEvent) == 32, "Flight recorder events must be 32 bytes");
+
+
+/*! The header at the start of every dump. It is followed by zero or more events. */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t timebaseNumerator;
+    uint32_t timebaseDenominator;
+} TSKFlightRecorderDumpHeader;
+
+
+/*!
+ A ring of events. Each ring is written by a single thread at a time, but may be read by any thread.
+ Rings are never freed; when their thread exits, they are marked unused so that a new thread can
+ take them over, which keeps the number of rings bounded by the peak number of threads.
+ */
+typedef struct TSKFlightRecorderRing {
+    /*! The next ring in the list of all rings. This is immutable once the ring is published. */
+    struct TSKFlightRecorderRing *next;
+
+    atomic_bool inUse;
+
+    /*! The total number of events written to the ring. The next event is written at this index modulo the capacity. */
+    _Atomic(uint64_t) writeCount;
+
+    TSKFlightRecorderEvent events[TSK_FLIGHT_RECORDER_RING_CAPACITY];
+} TSKFlightRecorderRing;
+
+
+/*! A function that writes bytes to a dump’s destination, returning whether it succeeded. */
+typedef bool (*TSKFlightRecorderDumpWriter)(void *context, const void *bytes, size_t length);
+
+
+#pragma mark - Global State
+
+static atomic_bool TSKFlightRecorderEnabled = true;
+
+/*! The head of the list of all rings. Rings are only ever pushed onto the list. */
+static _Atomic(TSKFlightRecorderRing *) TSKFlightRecorderRings = NULL;
+
+/*! Events with timestamps earlier than this are omitted from dumps. */
+static _Atomic(uint64_t) TSKFlightRecorderMinimumTimestamp = 0;
+
+/*! The path to which the signal handler writes dumps. */
+static _Atomic(char *) TSKFlightRecorderSignalDumpPath = NULL;
+
+static pthread_once_t TSKFlightRecorderOnceToken = PTHREAD_ONCE_INIT;
+static pthread_key_t TSKFlightRecorderRingKey;
+static mach_timebase_info_data_t TSKFlightRecorderTimebase;
+
+static _Thread_local TSKFlightRecorderRing *TSKFlightRecorderCurrentRing = NULL;
+static _Thread_local uint64_t TSKFlightRecorderCurrentThreadID = 0;
+
+
+static void TSKFlightRecorderReleaseRing(void *ring)
+{
+    atomic_store_explicit(&((TSKFlightRecorderRing *)ring)->inUse, false, memory_order_release);
+}
+
+
+static void TSKFlightRecorderInitialize(void)
+{
+    pthread_key_create(&TSKFlightRecorderRingKey, TSKFlightRecorderReleaseRing);
+    mach_timebase_info(&TSKFlightRecorderTimebase);
+}
+
+
+#pragma mark - Recording
+
+/*! Assigns a ring to the current thread, reusing one from an exited thread if possible. */
+static TSKFlightRecorderRing *TSKFlightRecorderAcquireRing(void)
+{
+    pthread_once(&TSKFlightRecorderOnceToken, TSKFlightRecorderInitialize);
+
+    TSKFlightRecorderRing *ring = atomic_load_explicit(&TSKFlightRecorderRings, memory_order_acquire);
+    for (; ring; ring = ring->next) {
+        bool inUse = false;
+        if (atomic_compare_exchange_strong(&ring->inUse, &inUse, true)) {
+            break;
+        }
+    }
+
+    if (!ring) {
+        ring = calloc(1, sizeof(TSKFlightRecorderRing));
+        if (!ring) {
+            return NULL;
+        }
+
+        atomic_init(&ring->inUse, true);
+        TSKFlightRecorderRing *head = atomic_load_explicit(&TSKFlightRecorderRings, memory_order_relaxed);
+        do {
+            ring->next = head;
+        } while (!atomic_compare_exchange_weak_explicit(&TSKFlightRecorderRings, &head, ring,
+                                                        memory_order_release, memory_order_relaxed));
+    }
+
+    // The key’s destructor releases the ring when the thread exits
+    pthread_setspecific(TSKFlightRecorderRingKey, ring);
+    pthread_threadid_np(NULL, &TSKFlightRecorderCurrentThreadID);
+    TSKFlightRecorderCurrentRing = ring;
+    return ring;
+}
+
+
+void TSKFlightRecorderRecordEvent(TSKFlightRecorderEventType type, const void *task, uint8_t fromState, uint8_t toState)
+{
+    if (!atomic_load_explicit(&TSKFlightRecorderEnabled, memory_order_relaxed)) {
+        return;
+    }
+
+    TSKFlightRecorderRing *ring = TSKFlightRecorderCurrentRing;
+    if (!ring && !(ring = TSKFlightRecorderAcquireRing())) {
+        return;
+    }
+
+    // Only this thread writes to the ring, so the write count can be loaded without synchronization.
+    // Publishing the new count with release semantics lets readers know the event is complete.
+    uint64_t index = atomic_load_explicit(&ring->writeCount, memory_order_relaxed);
+    TSKFlightRecorderEvent *event = &ring->events[index & (TSK_FLIGHT_RECORDER_RING_CAPACITY - 1)];
+    event->timestamp = mach_absolute_time();
+    event->threadID = TSKFlightRecorderCurrentThreadID;
+    event->taskAddress = (uintptr_t)task;
+    event->type = type;
+    event->fromState = fromState;
+    event->toState = toState;
+    atomic_store_explicit(&ring->writeCount, index + 1, memory_order_release);
+}
+
+
+#pragma mark - Dumping
+
+/*!
+ Writes a dump of all rings using the specified writer. This function is async-signal-safe as long
+ as the writer is.
+ */
+static bool TSKFlightRecorderWriteDump(TSKFlightRecorderDumpWriter writer, void *context)
+{
+    TSKFlightRecorderDumpHeader header = {
+        kTSKFlightRecorderDumpMagic,
+        kTSKFlightRecorderDumpVersion,
+        TSKFlightRecorderTimebase.numer,
+        TSKFlightRecorderTimebase.denom
+    };
+
+    if (!writer(context, &header, sizeof(header))) {
+        return false;
+    }
+
+    uint64_t minimumTimestamp = atomic_load(&TSKFlightRecorderMinimumTimestamp);
+    TSKFlightRecorderEvent chunk[TSK_FLIGHT_RECORDER_DUMP_CHUNK_SIZE];
+
+    TSKFlightRecorderRing *ring = atomic_load_explicit(&TSKFlightRecorderRings, memory_order_acquire);
+    for (; ring; ring = ring->next) {
+        uint64_t endIndex = atomic_load_explicit(&ring->writeCount, memory_order_acquire);
+        uint64_t startIndex = endIndex > TSK_FLIGHT_RECORDER_RING_CAPACITY ? endIndex - TSK_FLIGHT_RECORDER_RING_CAPACITY : 0;
+
+        for (uint64_t chunkStart = startIndex; chunkStart < endIndex; chunkStart += TSK_FLIGHT_RECORDER_DUMP_CHUNK_SIZE) {
+            uint64_t chunkEnd = MIN(chunkStart + TSK_FLIGHT_RECORDER_DUMP_CHUNK_SIZE, endIndex);
+            for (uint64_t i = chunkStart; i < chunkEnd; ++i) {
+                chunk[i - chunkStart] = ring->events[i & (TSK_FLIGHT_RECORDER_RING_CAPACITY - 1)];
+            }
+
+            // The ring’s thread may have kept writing while we copied. Any slot it could have started
+            // overwriting in the meantime holds a torn event, so we drop it.
+            atomic_thread_fence(memory_order_acquire);
+            uint64_t writeCount = atomic_load_explicit(&ring->writeCount, memory_order_relaxed);
+            uint64_t firstIntactIndex = writeCount >= TSK_FLIGHT_RECORDER_RING_CAPACITY ? writeCount - TSK_FLIGHT_RECORDER_RING_CAPACITY + 1 : 0;
+
+            size_t count = 0;
+            for (uint64_t i = MAX(chunkStart, firstIntactIndex); i < chunkEnd; ++i) {
+                if (chunk[i - chunkStart].timestamp >= minimumTimestamp) {
+                    chunk[count++] = chunk[i - chunkStart];
+                }
+            }
+
+            if (count > 0 && !writer(context, chunk, count * sizeof(TSKFlightRecorderEvent))) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+static bool TSKFlightRecorderWriteToData(void *context, const void *bytes, size_t length)
+{
+    [(__bridge NSMutableData *)context appendBytes:bytes length:length];
+    return true;
+}
+
+
+static bool TSKFlightRecorderWriteToFileDescriptor(void *context, const void *bytes, size_t length)
+{
+    int fileDescriptor = *(int *)context;
+    while (length > 0) {
+        ssize_t written = write(fileDescriptor, bytes, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return false;
+        }
+
+        bytes = (const uint8_t *)bytes + written;
+        length -= written;
+    }
+
+    return true;
+}
+
+
+static void TSKFlightRecorderHandleSignal(int signal)
+{
+    int savedErrno = errno;
+
+    const char *path = atomic_load(&TSKFlightRecorderSignalDumpPath);
+    if (path) {
+        int fileDescriptor = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fileDescriptor >= 0) {
+            TSKFlightRecorderWriteDump(TSKFlightRecorderWriteToFileDescriptor, &fileDescriptor);
+            close(fileDescriptor);
+        }
+    }
+
+    errno = savedErrno;
+}
+
+
+#pragma mark - Decoding
+
+static int TSKFlightRecorderCompareEvents(const void *lhs, const void *rhs)
+{
+    const TSKFlightRecorderEvent *event1 = lhs;
+    const TSKFlightRecorderEvent *event2 = rhs;
+    if (event1->timestamp != event2->timestamp) {
+        return event1->timestamp < event2->timestamp ? -1 : 1;
+    }
+
+    return event1->threadID < event2->threadID ? -1 : event1->threadID > event2->threadID;
+}
+
+
+static NSString *TSKFlightRecorderEventDescription(const TSKFlightRecorderEvent *event)
+{
+    switch (event->type) {
+        case TSKFlightRecorderEventTypeStateTransition:
+            return [NSString stringWithFormat:@"%@ → %@",
+                    TSKTaskStateDescription(event->fromState) ?: @(event->fromState).stringValue,
+                    TSKTaskStateDescription(event->toState) ?: @(event->toState).stringValue];
+        case TSKFlightRecorderEventTypeEnqueue:
+            return @"Enqueued";
+        case TSKFlightRecorderEventTypeDequeue:
+            return @"Dequeued";
+        default:
+            return [NSString stringWithFormat:@"Unknown event %u", event->type];
+    }
+}
+
+
+#pragma mark -
+
+@implementation TSKFlightRecorder
+
++ (BOOL)isEnabled
+{
+    return atomic_load(&TSKFlightRecorderEnabled);
+}
+
+
++ (void)setEnabled:(BOOL)enabled
+{
+    atomic_store(&TSKFlightRecorderEnabled, enabled);
+}
+
+
++ (NSUInteger)eventCapacityPerThread
+{
+    return TSK_FLIGHT_RECORDER_RING_CAPACITY;
+}
+
+
++ (NSData *)dump
+{
+    pthread_once(&TSKFlightRecorderOnceToken, TSKFlightRecorderInitialize);
+
+    NSMutableData *dump = [[NSMutableData alloc] init];
+    TSKFlightRecorderWriteDump(TSKFlightRecorderWriteToData, (__bridge void *)dump);
+    return dump;
+}
+
+
++ (NSString *)descriptionOfDump:(NSData *)dump
+{
+    NSParameterAssert(dump);
+
+    TSKFlightRecorderDumpHeader header;
+    if (dump.length < sizeof(header) || (dump.length - sizeof(header)) % sizeof(TSKFlightRecorderEvent) != 0) {
+        return nil;
+    }
+
+    [dump getBytes:&header length:sizeof(header)];
+    if (header.magic != kTSKFlightRecorderDumpMagic || header.version != kTSKFlightRecorderDumpVersion ||
+        header.timebaseNumerator == 0 || header.timebaseDenominator == 0) {
+        return nil;
+    }
+
+    NSUInteger eventCount = (dump.length - sizeof(header)) / sizeof(TSKFlightRecorderEvent);
+    NSMutableString *description = [[NSMutableString alloc] init];
+    if (eventCount == 0) {
+        return description;
+    }
+
+    TSKFlightRecorderEvent *events = malloc(eventCount * sizeof(TSKFlightRecorderEvent));
+    if (!events) {
+        return nil;
+    }
+
+    [dump getBytes:events range:NSMakeRange(sizeof(header), eventCount * sizeof(TSKFlightRecorderEvent))];
+    qsort(events, eventCount, sizeof(TSKFlightRecorderEvent), TSKFlightRecorderCompareEvents);
+
+    double secondsPerTick = (double)header.timebaseNumerator / header.timebaseDenominator / NSEC_PER_SEC;
+    for (NSUInteger i = 0; i < eventCount; ++i) {
+        const TSKFlightRecorderEvent *event = &events[i];
+        [description appendFormat:@"%12.6f  thread %-8llu  task 0x%llx  %@\n",
+         (event->timestamp - events[0].timestamp) * secondsPerTick, event->threadID, event->taskAddress,
+         TSKFlightRecorderEventDescription(event)];
+    }
+
+    free(events);
+    return description;
+}
+
+
++ (void)removeAllEvents
+{
+    atomic_store(&TSKFlightRecorderMinimumTimestamp, mach_absolute_time());
+}
+
+
++ (BOOL)installSignalHandlerForSignal:(int)signal dumpPath:(NSString *)path
+{
+    NSParameterAssert(path);
+
+    // The handler needs the timebase, which is set up on first use
+    pthread_once(&TSKFlightRecorderOnceToken, TSKFlightRecorderInitialize);
+
+    // The previous path is intentionally leaked, since a handler may be running with it right now
+    atomic_store(&TSKFlightRecorderSignalDumpPath, strdup(path.fileSystemRepresentation));
+
+    struct sigaction action = { 0 };
+    action.sa_handler = TSKFlightRecorderHandleSignal;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    return sigaction(signal, &action, NULL) == 0;
+}
+
+@end
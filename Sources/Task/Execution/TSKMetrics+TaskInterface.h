@@ -0,0 +1,66 @@
+//
+//  TSKMetrics+TaskInterface.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Task/TSKMetrics.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! TSKMetricsLatency enumerates the latency histograms that metrics keep. */
+typedef NS_ENUM(NSInteger, TSKMetricsLatency) {
+    TSKMetricsLatencyQueueWait,
+    TSKMetricsLatencyExecution,
+};
+
+
+/*!
+ The TaskInterface category of TSKMetrics declares the methods tasks and workflows use to record
+ metrics. Each method also records in the metrics’ parent, if it has one.
+ */
+@interface TSKMetrics (TaskInterface)
+
+/*! The metrics in which everything recorded in the receiver is also recorded. */
+@property (nonatomic, strong, nullable) TSKMetrics *parent;
+
+/*! Increments the specified counter. */
+- (void)incrementCounter:(TSKMetricsCounter)counter;
+
+/*! Adds the specified delta to the ready queue depth gauge. */
+- (void)addToReadyQueueDepth:(int64_t)delta;
+
+/*! Adds the specified delta to the active workflow count gauge. */
+- (void)addToActiveWorkflowCount:(int64_t)delta;
+
+/*!
+ @abstract Records a latency in the specified histogram.
+ @param nanoseconds The latency in nanoseconds.
+ @param latency The histogram in which to record the latency.
+ */
+- (void)recordNanoseconds:(uint64_t)nanoseconds forLatency:(TSKMetricsLatency)latency;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,538 @@
+//
+//  TSKMetrics.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TSKMetrics+TaskInterface.h"
+
+#import <os/lock.h>
+#import <stdatomic.h>
+#import <time.h>
+
+
+#pragma mark Constants and Types
+
+/*! The number of shards per metrics instance. Must be a power of two. */
+#define TSK_METRICS_SHARD_COUNT 16
+
+/*! The base-2 logarithm of the upper bound of the first latency bucket in nanoseconds. */
+#define TSK_METRICS_MINIMUM_EXPONENT 10
+
+/*! The number of powers of two covered by latency buckets after the first. */
+#define TSK_METRICS_EXPONENT_COUNT 30
+
+/*! The number of latency buckets per power of two. */
+#define TSK_METRICS_SUBBUCKET_COUNT 4
+
+/*! The total number of latency buckets: one for small latencies, the logarithmic buckets, and one for overflow. */
+#define TSK_METRICS_BUCKET_COUNT (1 + TSK_METRICS_EXPONENT_COUNT * TSK_METRICS_SUBBUCKET_COUNT + 1)
+
+/*! The number of counters in TSKMetricsCounter. */
+#define TSK_METRICS_COUNTER_COUNT (TSKMetricsCounterBatchesDispatched + 1)
+
+/*! The number of latencies in TSKMetricsLatency. */
+#define TSK_METRICS_LATENCY_COUNT (TSKMetricsLatencyExecution + 1)
+
+
+typedef struct {
+    _Atomic(uint64_t) totalNanoseconds;
+    _Atomic(uint64_t) buckets[TSK_METRICS_BUCKET_COUNT];
+} TSKMetricsShardHistogram;
+
+
+/*!
+ A shard of a metrics instance’s values. Gauges are stored as deltas, so the value of a gauge is
+ the sum of its deltas across shards.
+ */
+typedef struct {
+    _Atomic(uint64_t) counters[TSK_METRICS_COUNTER_COUNT];
+    _Atomic(int64_t) readyQueueDepth;
+    _Atomic(int64_t) activeWorkflowCount;
+    TSKMetricsShardHistogram histograms[TSK_METRICS_LATENCY_COUNT];
+} TSKMetricsShard;
+
+
+/*! The source of the shard indexes assigned to threads. */
+static atomic_uint TSKMetricsNextThreadShardIndex = 0;
+
+/*! The current thread’s shard index plus one, or 0 if the thread has not been assigned one yet. */
+static _Thread_local unsigned TSKMetricsThreadShardIndex = 0;
+
+
+static inline unsigned TSKMetricsCurrentShardIndex(void)
+{
+    unsigned index = TSKMetricsThreadShardIndex;
+    if (index == 0) {
+        // Threads are assigned shards round-robin, so up to TSK_METRICS_SHARD_COUNT threads can
+        // record without ever sharing a shard
+        index = atomic_fetch_add_explicit(&TSKMetricsNextThreadShardIndex, 1, memory_order_relaxed) + 1;
+        TSKMetricsThreadShardIndex = index;
+    }
+
+    return (index - 1) & (TSK_METRICS_SHARD_COUNT - 1);
+}
+
+
+/*!
+ Returns the index of the bucket for the specified latency. Each bucket includes its upper bound,
+ which matches the semantics of Prometheus’s le label.
+ */
+static inline NSUInteger TSKMetricsBucketIndex(uint64_t nanoseconds)
+{
+    if (nanoseconds <= (1ull << TSK_METRICS_MINIMUM_EXPONENT)) {
+        return 0;
+    }
+
+    uint64_t value = nanoseconds - 1;
+    unsigned exponent = 63 - __builtin_clzll(value);
+    if (exponent >= TSK_METRICS_MINIMUM_EXPONENT + TSK_METRICS_EXPONENT_COUNT) {
+        return TSK_METRICS_BUCKET_COUNT - 1;
+    }
+
+    unsigned subbucket = (value >> (exponent - 2)) & (TSK_METRICS_SUBBUCKET_COUNT - 1);
+    return 1 + (exponent - TSK_METRICS_MINIMUM_EXPONENT) * TSK_METRICS_SUBBUCKET_COUNT + subbucket;
+}
+
+
+/*! Returns the inclusive upper bound in seconds of the bucket with the specified index. */
+static NSTimeInterval TSKMetricsBucketUpperBound(NSUInteger index)
+{
+    if (index == 0) {
+        return ldexp(1, TSK_METRICS_MINIMUM_EXPONENT) / NSEC_PER_SEC;
+    } else if (index == TSK_METRICS_BUCKET_COUNT - 1) {
+        return INFINITY;
+    }
+
+    int exponent = TSK_METRICS_MINIMUM_EXPONENT + (int)(index - 1) / TSK_METRICS_SUBBUCKET_COUNT;
+    NSUInteger subbucket = (index - 1) % TSK_METRICS_SUBBUCKET_COUNT;
+    return (ldexp(1, exponent) + (subbucket + 1) * ldexp(1, exponent - 2)) / NSEC_PER_SEC;
+}
+
+
+/*! Returns the label set for a Prometheus sample, e.g., {workflow="name",le="0.5"}. */
+static NSString *TSKMetricsPrometheusLabels(NSString *name, NSString *additionalLabel)
+{
+    NSMutableArray<NSString *> *labels = [[NSMutableArray alloc] init];
+    if (name) {
+        NSString *escapedName = [[[name stringByReplacingOccurrencesOfString:@"\\" withString:@"\\\\"]
+                                  stringByReplacingOccurrencesOfString:@"\"" withString:@"\\\""]
+                                 stringByReplacingOccurrencesOfString:@"\n" withString:@"\\n"];
+        [labels addObject:[NSString stringWithFormat:@"workflow=\"%@\"", escapedName]];
+    }
+
+    if (additionalLabel) {
+        [labels addObject:additionalLabel];
+    }
+
+    return labels.count > 0 ? [NSString stringWithFormat:@"{%@}", [labels componentsJoinedByString:@","]] : @"";
+}
+
+
+#pragma mark - TSKLatencyHistogram
+
+@interface TSKLatencyHistogram () {
+    uint64_t _buckets[TSK_METRICS_BUCKET_COUNT];
+}
+
+/*! Initializes a histogram by merging the specified histogram from all the specified shards. */
+- (instancetype)initWithShards:(TSKMetricsShard *const *)shards latency:(TSKMetricsLatency)latency NS_DESIGNATED_INITIALIZER;
+
+/*! Appends the histogram to the specified string in the Prometheus text exposition format. */
+- (void)appendPrometheusTextToString:(NSMutableString *)text metricName:(NSString *)metricName help:(NSString *)help name:(nullable NSString *)name;
+
+@end
+
+
+@implementation TSKLatencyHistogram
+
+- (instancetype)initWithShards:(TSKMetricsShard *const *)shards latency:(TSKMetricsLatency)latency
+{
+    self = [super init];
+    if (self) {
+        uint64_t totalNanoseconds = 0;
+        for (NSUInteger i = 0; i < TSK_METRICS_SHARD_COUNT; ++i) {
+            if (!shards[i]) {
+                continue;
+            }
+
+            TSKMetricsShardHistogram *histogram = &shards[i]->histograms[latency];
+            totalNanoseconds += atomic_load_explicit(&histogram->totalNanoseconds, memory_order_relaxed);
+            for (NSUInteger j = 0; j < TSK_METRICS_BUCKET_COUNT; ++j) {
+                _buckets[j] += atomic_load_explicit(&histogram->buckets[j], memory_order_relaxed);
+            }
+        }
+
+        // The count is derived from the buckets so that it is consistent with them even if latencies
+        // were recorded while the histogram was being merged
+        for (NSUInteger j = 0; j < TSK_METRICS_BUCKET_COUNT; ++j) {
+            _count += _buckets[j];
+        }
+
+        _totalDuration = (NSTimeInterval)totalNanoseconds / NSEC_PER_SEC;
+    }
+
+    return self;
+}
+
+
+- (NSTimeInterval)meanDuration
+{
+    return self.count > 0 ? self.totalDuration / self.count : 0;
+}
+
+
+- (NSTimeInterval)durationAtPercentile:(double)percentile
+{
+    NSParameterAssert(percentile >= 0 && percentile <= 1);
+
+    uint64_t count = self.count;
+    if (count == 0) {
+        return -1;
+    }
+
+    uint64_t rank = MAX((uint64_t)ceil(percentile * count), 1);
+    uint64_t cumulativeCount = 0;
+    for (NSUInteger i = 0; i < TSK_METRICS_BUCKET_COUNT; ++i) {
+        cumulativeCount += _buckets[i];
+        if (cumulativeCount >= rank) {
+            return TSKMetricsBucketUpperBound(i);
+        }
+    }
+
+    return INFINITY;
+}
+
+
+- (void)enumerateBucketsUsingBlock:(void (NS_NOESCAPE ^)(NSTimeInterval, uint64_t))block
+{
+    NSParameterAssert(block);
+
+    uint64_t cumulativeCount = 0;
+    for (NSUInteger i = 0; i < TSK_METRICS_BUCKET_COUNT; ++i) {
+        cumulativeCount += _buckets[i];
+        block(TSKMetricsBucketUpperBound(i), cumulativeCount);
+    }
+}
+
+
+- (void)appendPrometheusTextToString:(NSMutableString *)text metricName:(NSString *)metricName help:(NSString *)help name:(NSString *)name
+{
+    [text appendFormat:@"# HELP %@ %@\n# TYPE %@ histogram\n", metricName, help, metricName];
+    [self enumerateBucketsUsingBlock:^(NSTimeInterval upperBound, uint64_t cumulativeCount) {
+        NSString *bound = isinf(upperBound) ? @"le=\"+Inf\"" : [NSString stringWithFormat:@"le=\"%.9g\"", upperBound];
+        [text appendFormat:@"%@_bucket%@ %llu\n", metricName, TSKMetricsPrometheusLabels(name, bound), cumulativeCount];
+    }];
+
+    NSString *labels = TSKMetricsPrometheusLabels(name, nil);
+    [text appendFormat:@"%@_sum%@ %.9g\n", metricName, labels, self.totalDuration];
+    [text appendFormat:@"%@_count%@ %llu\n", metricName, labels, self.count];
+}
+
+@end
+
+
+#pragma mark - TSKMetricsSnapshot
+
+@interface TSKMetricsSnapshot () {
+    uint64_t _counters[TSK_METRICS_COUNTER_COUNT];
+}
+
+- (instancetype)initWithName:(NSString *)name shards:(TSKMetricsShard *const *)shards NS_DESIGNATED_INITIALIZER;
+
+@end
+
+
+@implementation TSKMetricsSnapshot
+
+- (instancetype)initWithName:(NSString *)name shards:(TSKMetricsShard *const *)shards
+{
+    self = [super init];
+    if (self) {
+        _name = [name copy];
+        _timestamp = [NSProcessInfo processInfo].systemUptime;
+
+        for (NSUInteger i = 0; i < TSK_METRICS_SHARD_COUNT; ++i) {
+            TSKMetricsShard *shard = shards[i];
+            if (!shard) {
+                continue;
+            }
+
+            for (NSUInteger j = 0; j < TSK_METRICS_COUNTER_COUNT; ++j) {
+                _counters[j] += atomic_load_explicit(&shard->counters[j], memory_order_relaxed);
+            }
+
+            _readyQueueDepth += atomic_load_explicit(&shard->readyQueueDepth, memory_order_relaxed);
+            _activeWorkflowCount += atomic_load_explicit(&shard->activeWorkflowCount, memory_order_relaxed);
+        }
+
+        _queueWaitLatency = [[TSKLatencyHistogram alloc] initWithShards:shards latency:TSKMetricsLatencyQueueWait];
+        _executionLatency = [[TSKLatencyHistogram alloc] initWithShards:shards latency:TSKMetricsLatencyExecution];
+    }
+
+    return self;
+}
+
+
+- (uint64_t)valueForCounter:(TSKMetricsCounter)counter
+{
+    NSParameterAssert(counter >= 0 && counter < TSK_METRICS_COUNTER_COUNT);
+    return _counters[counter];
+}
+
+
+- (double)ratePerSecondForCounter:(TSKMetricsCounter)counter sinceSnapshot:(TSKMetricsSnapshot *)snapshot
+{
+    NSParameterAssert(snapshot);
+
+    NSTimeInterval elapsed = self.timestamp - snapshot.timestamp;
+    if (elapsed <= 0) {
+        return 0;
+    }
+
+    return ((double)[self valueForCounter:counter] - [snapshot valueForCounter:counter]) / elapsed;
+}
+
+
+- (NSString *)prometheusText
+{
+    static NSArray<NSArray<NSString *> *> *counterNamesAndHelp = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        counterNamesAndHelp = @[ @[ @"tsk_tasks_started_total", @"Tasks that started executing." ],
+                                 @[ @"tsk_tasks_finished_total", @"Tasks that finished successfully." ],
+                                 @[ @"tsk_tasks_failed_total", @"Tasks that failed." ],
+                                 @[ @"tsk_tasks_cancelled_total", @"Tasks that were cancelled." ],
+                                 @[ @"tsk_tasks_retried_total", @"Tasks that were retried." ],
+                                 @[ @"tsk_batches_dispatched_total", @"Batches of batchable tasks’ work that were dispatched." ] ];
+    });
+
+    NSString *name = self.name;
+    NSString *labels = TSKMetricsPrometheusLabels(name, nil);
+    NSMutableString *text = [[NSMutableString alloc] init];
+
+    for (NSUInteger i = 0; i < TSK_METRICS_COUNTER_COUNT; ++i) {
+        NSString *metricName = counterNamesAndHelp[i][0];
+        [text appendFormat:@"# HELP %@ %@\n# TYPE %@ counter\n%@%@ %llu\n", metricName, counterNamesAndHelp[i][1],
+         metricName, metricName, labels, _counters[i]];
+    }
+
+    [text appendFormat:@"# HELP tsk_ready_queue_depth Task work blocks waiting to run.\n# TYPE tsk_ready_queue_depth gauge\n"
+                        "tsk_ready_queue_depth%@ %lld\n", labels, self.readyQueueDepth];
+    [text appendFormat:@"# HELP tsk_active_workflows Workflows that are running.\n# TYPE tsk_active_workflows gauge\n"
+                        "tsk_active_workflows%@ %lld\n", labels, self.activeWorkflowCount];
+
+    [self.queueWaitLatency appendPrometheusTextToString:text
+                                             metricName:@"tsk_task_queue_wait_seconds"
+                                                   help:@"Time task work blocks waited before running."
+                                                   name:name];
+    [self.executionLatency appendPrometheusTextToString:text
+                                             metricName:@"tsk_task_execution_seconds"
+                                                   help:@"Time tasks spent executing before finishing successfully."
+                                                   name:name];
+    return text;
+}
+
+
+- (BOOL)writePrometheusTextToURL:(NSURL *)fileURL error:(NSError **)error
+{
+    NSParameterAssert(fileURL);
+    return [self.prometheusText writeToURL:fileURL atomically:YES encoding:NSUTF8StringEncoding error:error];
+}
+
+@end
+
+
+#pragma mark - TSKMetrics
+
+@interface TSKMetrics () {
+    /*! The instance’s shards, which are allocated the first time a thread records in them. */
+    _Atomic(TSKMetricsShard *) _shards[TSK_METRICS_SHARD_COUNT];
+
+    /*! A lock that synchronizes access to exportTimer. */
+    os_unfair_lock _exportLock;
+}
+
+@property (nonatomic, strong, nullable) TSKMetrics *parent;
+
+/*! The timer that drives periodic exports. Access to this object must be synchronized using the export lock. */
+@property (nonatomic, strong, nullable) dispatch_source_t exportTimer;
+
+@end
+
+
+@implementation TSKMetrics
+
++ (TSKMetrics *)sharedMetrics
+{
+    static TSKMetrics *sharedMetrics = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedMetrics = [[self alloc] init];
+    });
+
+    return sharedMetrics;
+}
+
+
+- (instancetype)init
+{
+    return [self initWithName:nil];
+}
+
+
+- (instancetype)initWithName:(NSString *)name
+{
+    self = [super init];
+    if (self) {
+        _name = [name copy];
+        _exportLock = OS_UNFAIR_LOCK_INIT;
+    }
+
+    return self;
+}
+
+
+- (void)dealloc
+{
+    [self stopExporting];
+
+    for (NSUInteger i = 0; i < TSK_METRICS_SHARD_COUNT; ++i) {
+        free(atomic_load(&_shards[i]));
+    }
+}
+
+
+- (TSKMetricsShard *)currentShard
+{
+    _Atomic(TSKMetricsShard *) *slot = &_shards[TSKMetricsCurrentShardIndex()];
+    TSKMetricsShard *shard = atomic_load_explicit(slot, memory_order_acquire);
+    if (shard) {
+        return shard;
+    }
+
+    TSKMetricsShard *newShard = calloc(1, sizeof(TSKMetricsShard));
+    if (!newShard) {
+        [NSException raise:NSMallocException format:@"Could not allocate metrics shard"];
+    }
+
+    // Another thread that shares the slot may have allocated a shard first, in which case we use that one
+    if (!atomic_compare_exchange_strong_explicit(slot, &shard, newShard, memory_order_acq_rel, memory_order_acquire)) {
+        free(newShard);
+        return shard;
+    }
+
+    return newShard;
+}
+
+
+- (TSKMetricsSnapshot *)snapshot
+{
+    TSKMetricsShard *shards[TSK_METRICS_SHARD_COUNT];
+    for (NSUInteger i = 0; i < TSK_METRICS_SHARD_COUNT; ++i) {
+        shards[i] = atomic_load_explicit(&_shards[i], memory_order_acquire);
+    }
+
+    return [[TSKMetricsSnapshot alloc] initWithName:self.name shards:shards];
+}
+
+
+#pragma mark - Recording
+
+- (void)incrementCounter:(TSKMetricsCounter)counter
+{
+    atomic_fetch_add_explicit(&[self currentShard]->counters[counter], 1, memory_order_relaxed);
+    [self.parent incrementCounter:counter];
+}
+
+
+- (void)addToReadyQueueDepth:(int64_t)delta
+{
+    atomic_fetch_add_explicit(&[self currentShard]->readyQueueDepth, delta, memory_order_relaxed);
+    [self.parent addToReadyQueueDepth:delta];
+}
+
+
+- (void)addToActiveWorkflowCount:(int64_t)delta
+{
+    atomic_fetch_add_explicit(&[self currentShard]->activeWorkflowCount, delta, memory_order_relaxed);
+    [self.parent addToActiveWorkflowCount:delta];
+}
+
+
+- (void)recordNanoseconds:(uint64_t)nanoseconds forLatency:(TSKMetricsLatency)latency
+{
+    TSKMetricsShardHistogram *histogram = &[self currentShard]->histograms[latency];
+    atomic_fetch_add_explicit(&histogram->buckets[TSKMetricsBucketIndex(nanoseconds)], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&histogram->totalNanoseconds, nanoseconds, memory_order_relaxed);
+    [self.parent recordNanoseconds:nanoseconds forLatency:latency];
+}
+
+
+#pragma mark - Exporting
+
+- (void)startExportingWithInterval:(NSTimeInterval)interval handler:(void (^)(TSKMetricsSnapshot *))handler
+{
+    NSParameterAssert(interval > 0);
+    NSParameterAssert(handler);
+
+    dispatch_queue_t queue = dispatch_queue_create("com.ticketmaster.TSKMetrics.export", DISPATCH_QUEUE_SERIAL);
+    dispatch_source_t timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, queue);
+    uint64_t intervalNanoseconds = (uint64_t)(interval * NSEC_PER_SEC);
+    dispatch_source_set_timer(timer, dispatch_time(DISPATCH_TIME_NOW, intervalNanoseconds), intervalNanoseconds, intervalNanoseconds / 10);
+
+    // The timer only holds a weak reference so that exporting does not keep the metrics alive
+    __weak typeof(self) weakSelf = self;
+    dispatch_source_set_event_handler(timer, ^{
+        TSKMetricsSnapshot *snapshot = [weakSelf snapshot];
+        if (snapshot) {
+            handler(snapshot);
+        }
+    });
+
+    os_unfair_lock_lock(&_exportLock);
+    dispatch_source_t previousTimer = self.exportTimer;
+    self.exportTimer = timer;
+    os_unfair_lock_unlock(&_exportLock);
+
+    if (previousTimer) {
+        dispatch_source_cancel(previousTimer);
+    }
+
+    dispatch_resume(timer);
+}
+
+
+- (void)stopExporting
+{
+    os_unfair_lock_lock(&_exportLock);
+    dispatch_source_t timer = self.exportTimer;
+    self.exportTimer = nil;
+    os_unfair_lock_unlock(&_exportLock);
+
+    if (timer) {
+        dispatch_source_cancel(timer);
+    }
+}
+
+@end
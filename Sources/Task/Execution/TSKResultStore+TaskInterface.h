@@ -0,0 +1,52 @@
+//
+//  TSKResultStore+TaskInterface.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <Task/TSKResultStore.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class TSKTask;
+
+/*!
+ The TaskInterface category of TSKResultStore declares the method tasks use to register their
+ results.
+ */
+@interface TSKResultStore (TaskInterface)
+
+/*!
+ @abstract Registers the specified task’s current result as a candidate for spilling.
+ @discussion Does nothing if the result is not an NSData at least as long as the spill threshold or
+     was already spilled. Otherwise, the store checks whether it needs to spill results on a
+     background queue. The store only references the task weakly.
+ @param task The task that just finished. May not be nil.
+ */
+- (void)registerResultOfTask:(TSKTask *)task;
+
+@end
+
+NS_ASSUME_NONNULL_END
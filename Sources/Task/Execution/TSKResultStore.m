@@ -0,0 +1,422 @@
+//
+//  TSKResultStore.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import "TSKResultStore+TaskInterface.h"
+
+#import <Task/TSKTask.h>
+#import <fcntl.h>
+#import <mach/mach.h>
+#import <os/lock.h>
+#import <sys/mman.h>
+#import <unistd.h>
+
+#import "../Tasks/TSKTask+WorkflowInterface.h"
+
+
+/*! The spill threshold of instances whose threshold hasn’t been changed. */
+static const NSUInteger kTSKResultStoreDefaultSpillThreshold = 1024 * 1024;
+
+
+#pragma mark - TSKMappedData
+
+/*!
+ TSKMappedData objects are the spilled results of a result store. Their bytes are a read-only,
+ shared mapping of a file, which is unmapped when the object is deallocated.
+ */
+@interface TSKMappedData : NSData {
+    const void *_mappedBytes;
+    NSUInteger _mappedLength;
+}
+
+/*!
+ @abstract Initializes a newly created mapped data object that takes ownership of the specified
+     mapping.
+ @param bytes The start of the mapping. Must have been returned by mmap.
+ @param length The length of the mapping.
+ @result A newly initialized mapped data object.
+ */
+- (instancetype)initWithMappedBytes:(const void *)bytes length:(NSUInteger)length;
+
+@end
+
+
+@implementation TSKMappedData
+
+- (instancetype)initWithMappedBytes:(const void *)bytes length:(NSUInteger)length
+{
+    self = [super init];
+    if (self) {
+        _mappedBytes = bytes;
+        _mappedLength = length;
+    }
+
+    return self;
+}
+
+
+- (void)dealloc
+{
+    munmap((void *)_mappedBytes, _mappedLength);
+}
+
+
+- (const void *)bytes
+{
+    return _mappedBytes;
+}
+
+
+- (NSUInteger)length
+{
+    return _mappedLength;
+}
+
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    // The mapping is immutable, so copies can share it instead of reading it all back in
+    return self;
+}
+
+@end
+
+
+#pragma mark - TSKResultStore
+
+@interface TSKResultStore () {
+    /*! A lock that synchronizes access to the store’s candidates and counts. */
+    os_unfair_lock _lock;
+
+    /*! Whether a check of the memory footprint is scheduled on the store’s queue. */
+    BOOL _checkScheduled;
+}
+
+/*!
+ @abstract The tasks whose results are candidates for spilling, oldest first.
+ @discussion Each task appears at most once, in the position of its first registration since it was
+     last removed. Entries for tasks that were deallocated are pruned whenever the memory footprint
+     is checked. Tasks whose results changed are skipped when they are reached.
+ */
+@property (nonatomic, strong, readonly) NSPointerArray *candidateTasks;
+
+/*! The tasks in candidateTasks, which lets the store avoid adding a task more than once. */
+@property (nonatomic, strong, readonly) NSHashTable<TSKTask *> *candidateTaskSet;
+
+/*! Removes the entries for deallocated tasks from candidateTasks. */
+- (void)pruneCandidateTasks;
+
+/*! The queue on which the store checks the memory footprint and responds to memory pressure. */
+@property (nonatomic, strong, readonly) dispatch_queue_t queue;
+
+/*! The source that reports memory pressure to the store. */
+@property (nonatomic, strong, readonly) dispatch_source_t memoryPressureSource;
+
+/*!
+ @abstract Spills candidate results, oldest first, until the specified number of bytes have been
+     spilled or no candidates remain.
+ @param byteCount The number of bytes to spill.
+ */
+- (void)spillResultsWithByteCount:(uint64_t)byteCount;
+
+/*!
+ @abstract Writes the specified data to a new temporary file and maps it.
+ @param data The data to spill.
+ @result Mapped data equal to data, or nil if it could not be written or mapped.
+ */
+- (nullable NSData *)mappedDataBySpillingData:(NSData *)data;
+
+@end
+
+
+@implementation TSKResultStore
+
+@synthesize spilledResultCount = _spilledResultCount;
+@synthesize spilledByteCount = _spilledByteCount;
+
++ (uint64_t)currentMemoryFootprint
+{
+    task_vm_info_data_t info;
+    mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+    if (task_info(mach_task_self(), TASK_VM_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+        return 0;
+    }
+
+    return info.phys_footprint;
+}
+
+
+- (instancetype)init
+{
+    return [self initWithDirectoryURL:[NSURL fileURLWithPath:NSTemporaryDirectory() isDirectory:YES]];
+}
+
+
+- (instancetype)initWithDirectoryURL:(NSURL *)directoryURL
+{
+    NSParameterAssert(directoryURL.isFileURL);
+
+    self = [super init];
+    if (self) {
+        _directoryURL = [directoryURL copy];
+        _spillThreshold = kTSKResultStoreDefaultSpillThreshold;
+        _memoryBudget = [NSProcessInfo processInfo].physicalMemory / 2;
+        _lock = OS_UNFAIR_LOCK_INIT;
+        _candidateTasks = [NSPointerArray weakObjectsPointerArray];
+        _candidateTaskSet = [NSHashTable weakObjectsHashTable];
+
+        NSString *queueName = [NSString stringWithFormat:@"com.ticketmaster.TSKResultStore.%p", self];
+        dispatch_queue_attr_t attributes = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0);
+        _queue = dispatch_queue_create(queueName.UTF8String, attributes);
+
+        __weak typeof(self) weakSelf = self;
+        _memoryPressureSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_MEMORYPRESSURE, 0,
+                                                       DISPATCH_MEMORYPRESSURE_WARN | DISPATCH_MEMORYPRESSURE_CRITICAL, _queue);
+        dispatch_source_set_event_handler(_memoryPressureSource, ^{
+            [weakSelf spillAllResults];
+        });
+
+        dispatch_resume(_memoryPressureSource);
+    }
+
+    return self;
+}
+
+
+- (void)dealloc
+{
+    dispatch_source_cancel(_memoryPressureSource);
+}
+
+
+- (void)setSpillThreshold:(NSUInteger)spillThreshold
+{
+    NSParameterAssert(spillThreshold > 0);
+    os_unfair_lock_lock(&_lock);
+    _spillThreshold = spillThreshold;
+    os_unfair_lock_unlock(&_lock);
+}
+
+
+- (NSUInteger)spillThreshold
+{
+    os_unfair_lock_lock(&_lock);
+    NSUInteger spillThreshold = _spillThreshold;
+    os_unfair_lock_unlock(&_lock);
+    return spillThreshold;
+}
+
+
+- (NSUInteger)spilledResultCount
+{
+    os_unfair_lock_lock(&_lock);
+    NSUInteger spilledResultCount = _spilledResultCount;
+    os_unfair_lock_unlock(&_lock);
+    return spilledResultCount;
+}
+
+
+- (uint64_t)spilledByteCount
+{
+    os_unfair_lock_lock(&_lock);
+    uint64_t spilledByteCount = _spilledByteCount;
+    os_unfair_lock_unlock(&_lock);
+    return spilledByteCount;
+}
+
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p directoryURL = %@; spilledResultCount = %lu; spilledByteCount = %llu>",
+            self.class, self, self.directoryURL.path, (unsigned long)self.spilledResultCount, self.spilledByteCount];
+}
+
+
+#pragma mark - Registering Results
+
+- (void)registerResultOfTask:(TSKTask *)task
+{
+    NSParameterAssert(task);
+
+    NSData *result = task.result;
+    if (![result isKindOfClass:[NSData class]] || [result isKindOfClass:[TSKMappedData class]]) {
+        return;
+    }
+
+    os_unfair_lock_lock(&_lock);
+    if (result.length < _spillThreshold) {
+        os_unfair_lock_unlock(&_lock);
+        return;
+    }
+
+    // A task that finishes again before it is spilled keeps its place in line
+    if (![self.candidateTaskSet containsObject:task]) {
+        [self.candidateTasks addPointer:(__bridge void *)task];
+        [self.candidateTaskSet addObject:task];
+    }
+
+    // Checking the footprint is cheap, but spilling is not, so neither happens on the finishing thread
+    BOOL shouldScheduleCheck = !_checkScheduled;
+    _checkScheduled = YES;
+    os_unfair_lock_unlock(&_lock);
+
+    if (shouldScheduleCheck) {
+        __weak typeof(self) weakSelf = self;
+        dispatch_async(self.queue, ^{
+            TSKResultStore *strongSelf = weakSelf;
+            if (!strongSelf) {
+                return;
+            }
+
+            os_unfair_lock_lock(&strongSelf->_lock);
+            strongSelf->_checkScheduled = NO;
+            os_unfair_lock_unlock(&strongSelf->_lock);
+
+            [strongSelf spillResultsIfNeeded];
+        });
+    }
+}
+
+
+#pragma mark - Spilling Results
+
+- (void)spillResultsIfNeeded
+{
+    [self pruneCandidateTasks];
+
+    uint64_t footprint = [[self class] currentMemoryFootprint];
+    uint64_t memoryBudget = self.memoryBudget;
+    if (footprint > memoryBudget) {
+        [self spillResultsWithByteCount:footprint - memoryBudget];
+    }
+}
+
+
+- (void)pruneCandidateTasks
+{
+    os_unfair_lock_lock(&_lock);
+    // NSPointerArray only notices that weak entries became NULL once a NULL has been added, so
+    // ‑compact does nothing without one
+    [self.candidateTasks addPointer:NULL];
+    [self.candidateTasks compact];
+    os_unfair_lock_unlock(&_lock);
+}
+
+
+- (void)spillAllResults
+{
+    [self spillResultsWithByteCount:UINT64_MAX];
+}
+
+
+- (void)spillResultsWithByteCount:(uint64_t)byteCount
+{
+    uint64_t spilledByteCount = 0;
+    while (spilledByteCount < byteCount) {
+        // Candidates are removed before they are spilled so that concurrent callers don’t spill the same one
+        os_unfair_lock_lock(&_lock);
+        NSPointerArray *candidateTasks = self.candidateTasks;
+        TSKTask *task = nil;
+        while (!task && candidateTasks.count > 0) {
+            task = (__bridge TSKTask *)[candidateTasks pointerAtIndex:0];
+            [candidateTasks removePointerAtIndex:0];
+        }
+
+        if (task) {
+            [self.candidateTaskSet removeObject:task];
+        }
+
+        NSUInteger spillThreshold = _spillThreshold;
+        os_unfair_lock_unlock(&_lock);
+
+        if (!task) {
+            return;
+        }
+
+        NSData *result = task.result;
+        if (![result isKindOfClass:[NSData class]] || [result isKindOfClass:[TSKMappedData class]] || result.length < spillThreshold) {
+            continue;
+        }
+
+        NSData *mappedResult = [self mappedDataBySpillingData:result];
+        if (!mappedResult || ![task replaceResult:result withResult:mappedResult]) {
+            continue;
+        }
+
+        spilledByteCount += result.length;
+
+        os_unfair_lock_lock(&_lock);
+        ++_spilledResultCount;
+        _spilledByteCount += result.length;
+        os_unfair_lock_unlock(&_lock);
+    }
+}
+
+
+- (NSData *)mappedDataBySpillingData:(NSData *)data
+{
+    NSString *template = [self.directoryURL.path stringByAppendingPathComponent:@"TSKResultStore.XXXXXX"];
+    char *path = strdup(template.fileSystemRepresentation);
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        free(path);
+        return nil;
+    }
+
+    // The mapping keeps the file’s contents alive, so its name is only needed until it is opened
+    unlink(path);
+    free(path);
+
+    __block BOOL didWrite = YES;
+    [data enumerateByteRangesUsingBlock:^(const void *bytes, NSRange byteRange, BOOL *stop) {
+        const char *cursor = bytes;
+        size_t remaining = byteRange.length;
+        while (remaining > 0) {
+            ssize_t written = write(fd, cursor, remaining);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            } else if (written <= 0) {
+                didWrite = NO;
+                *stop = YES;
+                return;
+            }
+
+            cursor += written;
+            remaining -= (size_t)written;
+        }
+    }];
+
+    void *bytes = didWrite ? mmap(NULL, data.length, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+
+    if (bytes == MAP_FAILED) {
+        return nil;
+    }
+
+    return [[TSKMappedData alloc] initWithMappedBytes:bytes length:data.length];
+}
+
+@end
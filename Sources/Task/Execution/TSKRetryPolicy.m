@@ -0,0 +1,85 @@
+//
+//  TSKRetryPolicy.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <Task/TSKRetryPolicy.h>
+
+#import <math.h>
+#import <stdlib.h>
+
+
+@implementation TSKRetryPolicy
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _maximumAttemptCount = 3;
+        _initialDelay = 1;
+        _backoffMultiplier = 2;
+        _maximumDelay = 60;
+        _jitter = 1;
+    }
+
+    return self;
+}
+
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p maximumAttemptCount = %lu; initialDelay = %g; backoffMultiplier = %g; maximumDelay = %g; jitter = %g>",
+            self.class, self, (unsigned long)self.maximumAttemptCount, self.initialDelay, self.backoffMultiplier, self.maximumDelay, self.jitter];
+}
+
+
+- (BOOL)shouldRetryAfterAttemptCount:(NSUInteger)attemptCount error:(NSError *)error
+{
+    if (attemptCount >= self.maximumAttemptCount) {
+        return NO;
+    }
+
+    BOOL (^retryableErrorPredicate)(NSError *) = self.retryableErrorPredicate;
+    return !retryableErrorPredicate || retryableErrorPredicate(error);
+}
+
+
+- (NSTimeInterval)delayAfterAttemptCount:(NSUInteger)attemptCount
+{
+    NSAssert(self.backoffMultiplier >= 1, @"backoffMultiplier must be at least 1");
+    NSAssert(self.jitter >= 0 && self.jitter <= 1, @"jitter must be between 0 and 1");
+
+    // The first retry waits the initial delay, and each one after that waits backoffMultiplier times longer
+    double exponent = attemptCount > 0 ? attemptCount - 1 : 0;
+    NSTimeInterval delay = MIN(self.initialDelay * pow(self.backoffMultiplier, exponent), self.maximumDelay);
+    if (delay <= 0) {
+        return 0;
+    }
+
+    double randomFraction = (double)arc4random() / ((double)UINT32_MAX + 1);
+    return delay * (1 - self.jitter * randomFraction);
+}
+
+@end
@@ -0,0 +1,74 @@
+//
+//  TSKSpeculationPolicy.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Task/TSKSpeculationPolicy.h>
+
+#import <Task/TSKDurationHistogram.h>
+
+
+@implementation TSKSpeculationPolicy
+
+- (instancetype)initWithPercentile:(double)percentile
+{
+    return [self initWithPercentile:percentile durationHistogram:[[TSKDurationHistogram alloc] init]];
+}
+
+
+- (instancetype)initWithPercentile:(double)percentile durationHistogram:(TSKDurationHistogram *)durationHistogram
+{
+    NSParameterAssert(percentile >= 0 && percentile <= 1);
+    NSParameterAssert(durationHistogram);
+
+    self = [super init];
+    if (self) {
+        _percentile = percentile;
+        _durationHistogram = durationHistogram;
+        _minimumSampleCount = 10;
+        _maximumSpeculativeAttemptCount = 1;
+    }
+
+    return self;
+}
+
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p percentile = %g; minimumSampleCount = %lu; maximumSpeculativeAttemptCount = %lu>",
+            self.class, self, self.percentile, (unsigned long)self.minimumSampleCount, (unsigned long)self.maximumSpeculativeAttemptCount];
+}
+
+
+- (NSTimeInterval)speculationDelay
+{
+    TSKDurationHistogram *durationHistogram = self.durationHistogram;
+    if (durationHistogram.count < MAX(self.minimumSampleCount, 1)) {
+        return -1;
+    }
+
+    return [durationHistogram durationAtPercentile:self.percentile];
+}
+
+@end
@@ -0,0 +1,394 @@
+//
+//  TSKTimerWheel.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Task/TSKTimerWheel.h>
+
+#import <os/lock.h>
+#import <stdatomic.h>
+#import <time.h>
+
+
+/*! The number of wheels in the hierarchy. */
+static const NSUInteger TSKTimerWheelLevelCount = 4;
+
+/*! The base-2 logarithm of the number of slots in each wheel. */
+static const NSUInteger TSKTimerWheelSlotBits = 6;
+
+/*! The number of slots in each wheel. */
+static const NSUInteger TSKTimerWheelSlotCount = 1 << TSKTimerWheelSlotBits;
+
+/*! A mask that extracts a slot index from a tick. */
+static const uint64_t TSKTimerWheelSlotMask = TSKTimerWheelSlotCount - 1;
+
+
+/*! Returns the number of ticks spanned by one slot in the wheel at the specified level. */
+static inline uint64_t TSKTimerWheelTicksPerSlot(NSUInteger level)
+{
+    return 1ull << (TSKTimerWheelSlotBits * level);
+}
+
+
+#pragma mark -
+
+@interface TSKTimerWheelTimer () {
+@public
+    /*! The tick at which the timer expires. */
+    uint64_t _expirationTick;
+
+    /*! The wheel level and slot whose list the timer is in. */
+    NSUInteger _level;
+    NSUInteger _slot;
+
+    /*!
+     @abstract The next and previous timers in the slot’s doubly-linked list.
+     @discussion Lists own their timers through the next pointers, so previous pointers are not
+         retained.
+     */
+    TSKTimerWheelTimer *_next;
+    __unsafe_unretained TSKTimerWheelTimer *_previous;
+
+    atomic_bool _armed;
+}
+
+/*! The timer’s handler. This is set to nil when the timer fires or is disarmed. */
+@property (nonatomic, copy, nullable) void (^handler)(void);
+
+/*!
+ @abstract Initializes a newly created timer with the specified handler.
+ @param handler The timer’s handler.
+ @result A newly initialized timer.
+ */
+- (instancetype)initWithHandler:(void (^)(void))handler NS_DESIGNATED_INITIALIZER;
+
+@end
+
+
+@implementation TSKTimerWheelTimer
+
+- (instancetype)initWithHandler:(void (^)(void))handler
+{
+    self = [super init];
+    if (self) {
+        _handler = [handler copy];
+        atomic_init(&_armed, false);
+    }
+
+    return self;
+}
+
+
+- (BOOL)isArmed
+{
+    return atomic_load(&_armed);
+}
+
+@end
+
+
+#pragma mark -
+
+@interface TSKTimerWheel () {
+    /*! A lock that guards the wheels and the tick source’s suspension state. */
+    os_unfair_lock _lock;
+
+    /*! The heads of each slot’s list of timers, indexed by level and then slot. */
+    TSKTimerWheelTimer *_slots[TSKTimerWheelLevelCount][TSKTimerWheelSlotCount];
+
+    /*! The last tick that the wheel has processed. */
+    uint64_t _currentTick;
+
+    /*! The number of nanoseconds in a tick. */
+    uint64_t _tickNanoseconds;
+
+    /*! The system uptime in nanoseconds at which tick 0 began. */
+    uint64_t _epochNanoseconds;
+
+    /*! Whether the tick source is resumed. */
+    BOOL _ticking;
+}
+
+@property (nonatomic, assign, readwrite) NSUInteger armedTimerCount;
+
+/*! The dispatch timer that advances the wheel. It is only resumed while timers are armed. */
+@property (nonatomic, strong, readonly) dispatch_source_t tickSource;
+
+/*! Returns the tick that corresponds to the current time. */
+- (uint64_t)tickForCurrentTime;
+
+/*!
+ @abstract Adds the specified timer to the appropriate slot for its expiration tick.
+ @discussion The lock must be held when this is invoked.
+ @param timer The timer.
+ */
+- (void)insertTimer:(TSKTimerWheelTimer *)timer;
+
+/*!
+ @abstract Removes the specified timer from its slot.
+ @discussion The lock must be held when this is invoked.
+ @param timer The timer.
+ */
+- (void)removeTimer:(TSKTimerWheelTimer *)timer;
+
+/*! Processes every tick up to the current time and runs the handlers of the timers that expired. */
+- (void)advance;
+
+@end
+
+
+@implementation TSKTimerWheel
+
++ (TSKTimerWheel *)sharedTimerWheel
+{
+    static TSKTimerWheel *sharedTimerWheel = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedTimerWheel = [[self alloc] init];
+    });
+
+    return sharedTimerWheel;
+}
+
+
+- (instancetype)init
+{
+    return [self initWithTickInterval:0.01];
+}
+
+
+- (instancetype)initWithTickInterval:(NSTimeInterval)tickInterval
+{
+    NSParameterAssert(tickInterval > 0);
+
+    self = [super init];
+    if (self) {
+        _tickInterval = tickInterval;
+        _lock = OS_UNFAIR_LOCK_INIT;
+        _tickNanoseconds = MAX((uint64_t)(tickInterval * NSEC_PER_SEC), 1);
+        _epochNanoseconds = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+
+        dispatch_queue_t queue = dispatch_queue_create("com.ticketmaster.TSKTimerWheel", DISPATCH_QUEUE_SERIAL);
+        _tickSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, queue);
+        dispatch_source_set_timer(_tickSource, dispatch_time(DISPATCH_TIME_NOW, _tickNanoseconds), _tickNanoseconds, _tickNanoseconds / 10);
+
+        // The tick source only holds a weak reference so that it does not keep the wheel alive
+        __weak typeof(self) weakSelf = self;
+        dispatch_source_set_event_handler(_tickSource, ^{
+            [weakSelf advance];
+        });
+    }
+
+    return self;
+}
+
+
+- (void)dealloc
+{
+    // Dispatch sources must not be released while suspended
+    if (!_ticking) {
+        dispatch_resume(_tickSource);
+    }
+
+    dispatch_source_cancel(_tickSource);
+}
+
+
+- (uint64_t)tickForCurrentTime
+{
+    return (clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - _epochNanoseconds) / _tickNanoseconds;
+}
+
+
+#pragma mark - Arming and Disarming
+
+- (TSKTimerWheelTimer *)armTimerWithInterval:(NSTimeInterval)interval handler:(void (^)(void))handler
+{
+    NSParameterAssert(handler);
+
+    TSKTimerWheelTimer *timer = [[TSKTimerWheelTimer alloc] initWithHandler:handler];
+    uint64_t intervalTicks = (uint64_t)ceil(MAX(interval, 0) * NSEC_PER_SEC / _tickNanoseconds);
+
+    os_unfair_lock_lock(&_lock);
+
+    // An idle wheel doesn’t advance, so it must catch up to the current time before it is used
+    uint64_t now = [self tickForCurrentTime];
+    if (self.armedTimerCount == 0) {
+        _currentTick = now;
+    }
+
+    timer->_expirationTick = now + MAX(intervalTicks, 1);
+    [self insertTimer:timer];
+    atomic_store(&timer->_armed, true);
+    self.armedTimerCount += 1;
+
+    if (!_ticking) {
+        _ticking = YES;
+        dispatch_resume(self.tickSource);
+    }
+
+    os_unfair_lock_unlock(&_lock);
+    return timer;
+}
+
+
+- (void)disarmTimer:(TSKTimerWheelTimer *)timer
+{
+    NSParameterAssert(timer);
+
+    // The handler is released after the lock is unlocked, as releasing it may release other objects
+    void (^handler)(void) = nil;
+
+    os_unfair_lock_lock(&_lock);
+    if (atomic_load(&timer->_armed)) {
+        [self removeTimer:timer];
+        atomic_store(&timer->_armed, false);
+        handler = timer.handler;
+        timer.handler = nil;
+        self.armedTimerCount -= 1;
+    }
+    os_unfair_lock_unlock(&_lock);
+}
+
+
+#pragma mark - Wheel Management
+
+- (void)insertTimer:(TSKTimerWheelTimer *)timer
+{
+    uint64_t expirationTick = timer->_expirationTick;
+    uint64_t delta = expirationTick > _currentTick ? expirationTick - _currentTick : 0;
+
+    // Timers go in the finest wheel whose slots span less than their remaining time. Timers that are
+    // due now go in the current slot of the finest wheel, which is processed after any cascading.
+    NSUInteger level = 0;
+    while (level < TSKTimerWheelLevelCount - 1 && delta >= TSKTimerWheelTicksPerSlot(level + 1)) {
+        ++level;
+    }
+
+    // Timers beyond the coarsest wheel’s range go in its furthest slot and are reinserted when it is
+    // processed
+    uint64_t placementTick = MAX(expirationTick, _currentTick);
+    uint64_t range = TSKTimerWheelTicksPerSlot(TSKTimerWheelLevelCount);
+    if (delta >= range) {
+        placementTick = _currentTick + range - 1;
+    }
+
+    NSUInteger slot = (placementTick >> (TSKTimerWheelSlotBits * level)) & TSKTimerWheelSlotMask;
+    timer->_level = level;
+    timer->_slot = slot;
+
+    TSKTimerWheelTimer *head = _slots[level][slot];
+    timer->_next = head;
+    timer->_previous = nil;
+    if (head) {
+        head->_previous = timer;
+    }
+
+    _slots[level][slot] = timer;
+}
+
+
+- (void)removeTimer:(TSKTimerWheelTimer *)timer
+{
+    // Keep the timer alive while unlinking it, as its list may hold the last reference to it
+    TSKTimerWheelTimer *strongTimer = timer;
+    TSKTimerWheelTimer *next = strongTimer->_next;
+    TSKTimerWheelTimer *previous = strongTimer->_previous;
+
+    if (next) {
+        next->_previous = previous;
+    }
+
+    if (previous) {
+        previous->_next = next;
+    } else {
+        _slots[strongTimer->_level][strongTimer->_slot] = next;
+    }
+
+    strongTimer->_next = nil;
+    strongTimer->_previous = nil;
+}
+
+
+- (void)advance
+{
+    NSMutableArray<void (^)(void)> *expiredHandlers = nil;
+
+    os_unfair_lock_lock(&_lock);
+
+    uint64_t now = [self tickForCurrentTime];
+    while (_currentTick < now && self.armedTimerCount > 0) {
+        ++_currentTick;
+
+        // When a wheel’s slot begins, its timers are moved to finer wheels. Coarser wheels go first
+        // so that their timers can be moved again in the same tick if need be.
+        for (NSUInteger level = TSKTimerWheelLevelCount - 1; level > 0; --level) {
+            if ((_currentTick & (TSKTimerWheelTicksPerSlot(level) - 1)) != 0) {
+                continue;
+            }
+
+            NSUInteger slot = (_currentTick >> (TSKTimerWheelSlotBits * level)) & TSKTimerWheelSlotMask;
+            TSKTimerWheelTimer *timer = _slots[level][slot];
+            _slots[level][slot] = nil;
+            while (timer) {
+                TSKTimerWheelTimer *next = timer->_next;
+                [self insertTimer:timer];
+                timer = next;
+            }
+        }
+
+        NSUInteger slot = _currentTick & TSKTimerWheelSlotMask;
+        TSKTimerWheelTimer *timer = _slots[0][slot];
+        _slots[0][slot] = nil;
+        while (timer) {
+            TSKTimerWheelTimer *next = timer->_next;
+            timer->_next = nil;
+            timer->_previous = nil;
+
+            if (!expiredHandlers) {
+                expiredHandlers = [[NSMutableArray alloc] init];
+            }
+
+            [expiredHandlers addObject:timer.handler];
+            timer.handler = nil;
+            atomic_store(&timer->_armed, false);
+            self.armedTimerCount -= 1;
+            timer = next;
+        }
+    }
+
+    // With no timers left, there’s nothing to advance until the next one is armed
+    if (self.armedTimerCount == 0 && _ticking) {
+        _ticking = NO;
+        dispatch_suspend(self.tickSource);
+    }
+
+    os_unfair_lock_unlock(&_lock);
+
+    for (void (^handler)(void) in expiredHandlers) {
+        handler();
+    }
+}
+
+@end
@@ -0,0 +1,144 @@
+//
+//  TSKWorker.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <Task/TSKWorker.h>
+
+#import "TSKWorkerConnection.h"
+
+#if TARGET_OS_OSX
+
+#pragma mark Constants
+
+NSString *const TSKWorkerSocketDescriptorEnvironmentKey = @"TSK_WORKER_SOCKET_DESCRIPTOR";
+
+
+#pragma mark -
+
+@interface TSKWorker ()
+
+/*! The connection to the worker’s pool, or nil if there is none. */
+@property (nonatomic, strong, readonly, nullable) TSKWorkerConnection *connection;
+
+/*!
+ @abstract Returns the response for the specified request message.
+ @param message The request message.
+ @result A dictionary containing either the request’s result or the error it failed with.
+ */
+- (NSDictionary<NSString *, id> *)responseForMessage:(NSData *)message;
+
+@end
+
+
+@implementation TSKWorker
+
+- (instancetype)initWithAllowedRequestClasses:(NSSet<Class> *)allowedRequestClasses handler:(TSKWorkerRequestHandler)handler
+{
+    NSString *socketDescriptorString = [NSProcessInfo processInfo].environment[TSKWorkerSocketDescriptorEnvironmentKey];
+    int socketDescriptor = socketDescriptorString ? socketDescriptorString.intValue : -1;
+    return [self initWithSocketDescriptor:socketDescriptor allowedRequestClasses:allowedRequestClasses handler:handler];
+}
+
+
+- (instancetype)initWithSocketDescriptor:(int)socketDescriptor
+                   allowedRequestClasses:(NSSet<Class> *)allowedRequestClasses
+                                 handler:(TSKWorkerRequestHandler)handler
+{
+    NSParameterAssert(allowedRequestClasses);
+    NSParameterAssert(handler);
+
+    self = [super init];
+    if (self) {
+        _allowedRequestClasses = [allowedRequestClasses copy];
+        _handler = [handler copy];
+        if (socketDescriptor >= 0) {
+            _connection = [[TSKWorkerConnection alloc] initWithSocketDescriptor:socketDescriptor];
+        }
+    }
+
+    return self;
+}
+
+
+- (void)run
+{
+    TSKWorkerConnection *connection = self.connection;
+    while (connection) {
+        @autoreleasepool {
+            NSData *message = [connection receiveMessageWithError:NULL];
+            if (!message) {
+                break;
+            }
+
+            NSDictionary *response = [self responseForMessage:message];
+            NSError *error = nil;
+            if (![connection sendObject:response error:&error]) {
+                // The result couldn’t be encoded, but the connection is fine, so report that instead
+                if (![error.domain isEqualToString:NSPOSIXErrorDomain]) {
+                    response = @{ TSKWorkerResponseErrorKey : [NSError errorWithDomain:error.domain
+                                                                                  code:error.code
+                                                                              userInfo:@{ NSLocalizedDescriptionKey : error.localizedDescription }] };
+                    if ([connection sendObject:response error:NULL]) {
+                        continue;
+                    }
+                }
+
+                break;
+            }
+        }
+    }
+
+    [connection close];
+}
+
+
+- (NSDictionary<NSString *, id> *)responseForMessage:(NSData *)message
+{
+    NSError *error = nil;
+    id request = [TSKWorkerConnection objectOfClasses:self.allowedRequestClasses fromMessage:message error:&error];
+
+    id result = nil;
+    if (request) {
+        error = nil;
+        result = self.handler(request, &error);
+    }
+
+    if (result) {
+        return @{ TSKWorkerResponseResultKey : result };
+    } else if (error) {
+        // Only the parts of the error that are guaranteed to be securely codable are sent back
+        NSError *sanitizedError = [NSError errorWithDomain:error.domain
+                                                      code:error.code
+                                                  userInfo:@{ NSLocalizedDescriptionKey : error.localizedDescription }];
+        return @{ TSKWorkerResponseErrorKey : sanitizedError };
+    }
+
+    return @{ };
+}
+
+@end
+
+#endif
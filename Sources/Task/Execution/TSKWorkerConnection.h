@@ -0,0 +1,99 @@
+//
+//  TSKWorkerConnection.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! The key in a worker’s response whose value is the request’s result. */
+extern NSString *const TSKWorkerResponseResultKey;
+
+/*! The key in a worker’s response whose value is the error the request failed with. */
+extern NSString *const TSKWorkerResponseErrorKey;
+
+/*!
+ TSKWorkerConnection objects exchange messages between a worker pool and a worker process over a
+ Unix-domain stream socket.
+
+ Each message is framed as a 4-byte big-endian length followed by that many bytes. Messages are
+ objects archived with NSKeyedArchiver using secure coding, so only objects of explicitly allowed
+ classes can be decoded.
+
+ A connection may be used by one sending thread and one receiving thread at a time.
+ */
+@interface TSKWorkerConnection : NSObject
+
+/*! The connection’s socket descriptor, or -1 if it has been closed. */
+@property (atomic, assign, readonly) int socketDescriptor;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/*!
+ @abstract Initializes a newly created connection with the specified socket descriptor.
+ @discussion The connection takes ownership of the socket and closes it when the connection is
+     closed or deallocated.
+ @param socketDescriptor A connected Unix-domain stream socket.
+ @result A newly initialized connection.
+ */
+- (instancetype)initWithSocketDescriptor:(int)socketDescriptor NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Archives the specified object and sends it as a message.
+ @param object The object to send. It and every object it encodes must support secure coding.
+ @param error On failure, an error describing why the object could not be archived or sent.
+ @result Whether the object was sent.
+ */
+- (BOOL)sendObject:(id<NSSecureCoding>)object error:(NSError **)error;
+
+/*!
+ @abstract Blocks until a message is received and returns its data.
+ @param error On failure, an error describing why no message could be received. If the peer closed
+     the connection, the error’s domain is NSPOSIXErrorDomain and its code is ECONNRESET.
+ @result The message’s data, or nil if the connection failed.
+ */
+- (nullable NSData *)receiveMessageWithError:(NSError **)error;
+
+/*!
+ @abstract Unarchives an object from a message’s data.
+ @param classes The classes of objects that may be decoded.
+ @param data The message’s data.
+ @param error On failure, an error describing why the object could not be decoded.
+ @result The decoded object, or nil if it could not be decoded.
+ */
++ (nullable id)objectOfClasses:(NSSet<Class> *)classes fromMessage:(NSData *)data error:(NSError **)error;
+
+/*!
+ @abstract Closes the connection.
+ @discussion Subsequent sends and receives fail. Closing a connection that is already closed has no
+     effect.
+ */
+- (void)close;
+
+@end
+
+NS_ASSUME_NONNULL_END
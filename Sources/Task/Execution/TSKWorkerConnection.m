@@ -0,0 +1,242 @@
+//
+//  TSKWorkerConnection.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import "TSKWorkerConnection.h"
+
+#import <errno.h>
+#import <stdatomic.h>
+#import <sys/socket.h>
+#import <unistd.h>
+
+
+#pragma mark Constants
+
+NSString *const TSKWorkerResponseResultKey = @"result";
+NSString *const TSKWorkerResponseErrorKey = @"error";
+
+/*! The largest message a connection will receive. Larger lengths indicate a corrupt stream. */
+static const uint32_t kTSKWorkerConnectionMaximumMessageLength = 256 * 1024 * 1024;
+
+
+#pragma mark - Functions
+
+/*! Returns an NSPOSIXErrorDomain error with the specified code. */
+static NSError *TSKWorkerConnectionPOSIXError(int code)
+{
+    return [NSError errorWithDomain:NSPOSIXErrorDomain code:code userInfo:nil];
+}
+
+
+/*!
+ @abstract Writes the specified bytes to the specified socket, retrying after partial writes.
+ @result 0 on success, or the errno value that caused the write to fail.
+ */
+static int TSKWorkerConnectionWriteAll(int socketDescriptor, const void *bytes, size_t length)
+{
+    while (length > 0) {
+        ssize_t written = write(socketDescriptor, bytes, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return errno;
+        }
+
+        bytes = (const uint8_t *)bytes + written;
+        length -= written;
+    }
+
+    return 0;
+}
+
+
+/*!
+ @abstract Reads exactly the specified number of bytes from the specified socket.
+ @result 0 on success, ECONNRESET if the peer closed the socket first, or the errno value that caused
+     the read to fail.
+ */
+static int TSKWorkerConnectionReadAll(int socketDescriptor, void *bytes, size_t length)
+{
+    while (length > 0) {
+        ssize_t bytesRead = read(socketDescriptor, bytes, length);
+        if (bytesRead < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return errno;
+        } else if (bytesRead == 0) {
+            return ECONNRESET;
+        }
+
+        bytes = (uint8_t *)bytes + bytesRead;
+        length -= bytesRead;
+    }
+
+    return 0;
+}
+
+
+#pragma mark -
+
+@interface TSKWorkerConnection () {
+    /*! The socket descriptor, or -1 once the connection is closed. */
+    atomic_int _socketDescriptor;
+}
+
+@end
+
+
+@implementation TSKWorkerConnection
+
+- (instancetype)initWithSocketDescriptor:(int)socketDescriptor
+{
+    NSParameterAssert(socketDescriptor >= 0);
+
+    self = [super init];
+    if (self) {
+        atomic_init(&_socketDescriptor, socketDescriptor);
+
+#ifdef SO_NOSIGPIPE
+        // Writing to a socket whose peer crashed should fail with EPIPE rather than kill the process
+        int noSIGPIPE = 1;
+        setsockopt(socketDescriptor, SOL_SOCKET, SO_NOSIGPIPE, &noSIGPIPE, sizeof(noSIGPIPE));
+#endif
+    }
+
+    return self;
+}
+
+
+- (void)dealloc
+{
+    [self close];
+}
+
+
+- (int)socketDescriptor
+{
+    return atomic_load(&_socketDescriptor);
+}
+
+
+- (BOOL)sendObject:(id<NSSecureCoding>)object error:(NSError **)error
+{
+    NSParameterAssert(object);
+
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:object requiringSecureCoding:YES error:error];
+    if (!data) {
+        return NO;
+    } else if (data.length > kTSKWorkerConnectionMaximumMessageLength) {
+        if (error) {
+            *error = TSKWorkerConnectionPOSIXError(EMSGSIZE);
+        }
+
+        return NO;
+    }
+
+    int socketDescriptor = self.socketDescriptor;
+    if (socketDescriptor < 0) {
+        if (error) {
+            *error = TSKWorkerConnectionPOSIXError(EBADF);
+        }
+
+        return NO;
+    }
+
+    uint32_t length = CFSwapInt32HostToBig((uint32_t)data.length);
+    int result = TSKWorkerConnectionWriteAll(socketDescriptor, &length, sizeof(length));
+    if (result == 0) {
+        result = TSKWorkerConnectionWriteAll(socketDescriptor, data.bytes, data.length);
+    }
+
+    if (result != 0) {
+        if (error) {
+            *error = TSKWorkerConnectionPOSIXError(result);
+        }
+
+        return NO;
+    }
+
+    return YES;
+}
+
+
+- (NSData *)receiveMessageWithError:(NSError **)error
+{
+    int socketDescriptor = self.socketDescriptor;
+    if (socketDescriptor < 0) {
+        if (error) {
+            *error = TSKWorkerConnectionPOSIXError(EBADF);
+        }
+
+        return nil;
+    }
+
+    uint32_t length = 0;
+    int result = TSKWorkerConnectionReadAll(socketDescriptor, &length, sizeof(length));
+    length = CFSwapInt32BigToHost(length);
+    if (result == 0 && length > kTSKWorkerConnectionMaximumMessageLength) {
+        result = EMSGSIZE;
+    }
+
+    NSMutableData *data = nil;
+    if (result == 0) {
+        data = [[NSMutableData alloc] initWithLength:length];
+        result = TSKWorkerConnectionReadAll(socketDescriptor, data.mutableBytes, length);
+    }
+
+    if (result != 0) {
+        if (error) {
+            *error = TSKWorkerConnectionPOSIXError(result);
+        }
+
+        return nil;
+    }
+
+    return data;
+}
+
+
++ (id)objectOfClasses:(NSSet<Class> *)classes fromMessage:(NSData *)data error:(NSError **)error
+{
+    NSParameterAssert(classes);
+    NSParameterAssert(data);
+    return [NSKeyedUnarchiver unarchivedObjectOfClasses:classes fromData:data error:error];
+}
+
+
+- (void)close
+{
+    int socketDescriptor = atomic_exchange(&_socketDescriptor, -1);
+    if (socketDescriptor >= 0) {
+        close(socketDescriptor);
+    }
+}
+
+@end
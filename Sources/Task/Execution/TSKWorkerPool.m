@@ -0,0 +1,677 @@
+//
+//  TSKWorkerPool.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <Task/TSKWorkerPool.h>
+
+#if TARGET_OS_OSX
+
+#import <Task/TSKCancellationToken.h>
+#import <Task/TSKWorker.h>
+#import <Task/TaskErrors.h>
+#import <errno.h>
+#import <fcntl.h>
+#import <os/lock.h>
+#import <signal.h>
+#import <spawn.h>
+#import <sys/socket.h>
+#import <sys/wait.h>
+#import <unistd.h>
+
+#import "TSKWorkerConnection.h"
+
+
+#pragma mark Constants
+
+/*! The file descriptor at which worker processes find their connection to the pool. */
+static const int kTSKWorkerPoolWorkerSocketDescriptor = 3;
+
+
+#pragma mark - Functions
+
+/*! Returns the error with which requests that were abandoned or never started are completed. */
+static NSError *TSKWorkerPoolCancelledError(void)
+{
+    return [NSError errorWithDomain:NSCocoaErrorDomain code:NSUserCancelledError userInfo:nil];
+}
+
+
+#pragma mark - TSKWorkerProcess
+
+/*! TSKWorkerProcess objects represent the worker processes that a pool launched. */
+@interface TSKWorkerProcess : NSObject
+
+/*! The worker’s process identifier. */
+@property (nonatomic, assign, readonly) pid_t processIdentifier;
+
+/*! The pool’s connection to the worker. */
+@property (nonatomic, strong, readonly) TSKWorkerConnection *connection;
+
+/*! The serial queue on which requests are sent to the worker and its responses are awaited. */
+@property (nonatomic, strong, readonly) dispatch_queue_t queue;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/*!
+ @abstract Initializes a newly created worker process object.
+ @param processIdentifier The worker’s process identifier.
+ @param connection The pool’s connection to the worker.
+ @result A newly initialized worker process object.
+ */
+- (instancetype)initWithProcessIdentifier:(pid_t)processIdentifier connection:(TSKWorkerConnection *)connection NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Closes the connection to the worker and waits for it to exit.
+ @discussion Workers exit when their connection is closed, so this only blocks for long if the
+     worker is performing a request.
+ @result The worker’s wait status, as returned by waitpid(2).
+ */
+- (int)terminate;
+
+@end
+
+
+@implementation TSKWorkerProcess
+
+- (instancetype)initWithProcessIdentifier:(pid_t)processIdentifier connection:(TSKWorkerConnection *)connection
+{
+    self = [super init];
+    if (self) {
+        _processIdentifier = processIdentifier;
+        _connection = connection;
+
+        NSString *queueName = [NSString stringWithFormat:@"com.ticketmaster.TSKWorkerPool.worker.%d", processIdentifier];
+        _queue = dispatch_queue_create(queueName.UTF8String, DISPATCH_QUEUE_SERIAL);
+    }
+
+    return self;
+}
+
+
+- (int)terminate
+{
+    [self.connection close];
+
+    int status = 0;
+    while (waitpid(self.processIdentifier, &status, 0) < 0 && errno == EINTR) {
+        continue;
+    }
+
+    return status;
+}
+
+@end
+
+
+#pragma mark - TSKWorkerRequest
+
+/*! TSKWorkerRequest objects track requests made to a pool until they finish. */
+@interface TSKWorkerRequest : NSObject
+
+@property (nonatomic, strong, readonly) id<NSSecureCoding> request;
+@property (nonatomic, strong, readonly, nullable) TSKCancellationToken *cancellationToken;
+@property (nonatomic, copy, readonly) void (^completionHandler)(id _Nullable, NSError *_Nullable);
+
+/*!
+ @abstract The object returned when the request’s cancellation handler was added to its token.
+ @discussion Access to this object must be synchronized using the pool’s lock.
+ */
+@property (nonatomic, strong, nullable) id cancellationHandler;
+
+/*!
+ @abstract The worker performing the request, or nil if it is not being performed.
+ @discussion Access to this object must be synchronized using the pool’s lock.
+ */
+@property (nonatomic, strong, nullable) TSKWorkerProcess *worker;
+
+/*!
+ @abstract Whether the request has finished, been abandoned, or failed to start.
+ @discussion Whoever sets this to YES is responsible for invoking the request’s completion handler.
+     Access to this must be synchronized using the pool’s lock.
+ */
+@property (nonatomic, assign, getter=isFinished) BOOL finished;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (instancetype)initWithRequest:(id<NSSecureCoding>)request
+              cancellationToken:(nullable TSKCancellationToken *)cancellationToken
+              completionHandler:(void (^)(id _Nullable, NSError *_Nullable))completionHandler NS_DESIGNATED_INITIALIZER;
+
+@end
+
+
+@implementation TSKWorkerRequest
+
+- (instancetype)initWithRequest:(id<NSSecureCoding>)request
+              cancellationToken:(TSKCancellationToken *)cancellationToken
+              completionHandler:(void (^)(id, NSError *))completionHandler
+{
+    self = [super init];
+    if (self) {
+        _request = request;
+        _cancellationToken = cancellationToken;
+        _completionHandler = [completionHandler copy];
+    }
+
+    return self;
+}
+
+@end
+
+
+#pragma mark - TSKWorkerPool
+
+@interface TSKWorkerPool () {
+    /*! A lock that synchronizes access to the pool’s workers and requests. */
+    os_unfair_lock _lock;
+
+    /*! The number of running workers, including those being launched. */
+    NSUInteger _workerCount;
+
+    /*! The number of workers that exited unexpectedly while performing a request. */
+    NSUInteger _crashedWorkerCount;
+
+    /*! Whether the pool has been invalidated. */
+    BOOL _invalidated;
+}
+
+/*! The classes of objects that the pool decodes from workers’ responses. */
+@property (nonatomic, copy, readonly) NSSet<Class> *responseClasses;
+
+/*!
+ @abstract The workers that are not performing a request.
+ @discussion Access to this object must be synchronized using the lock.
+ */
+@property (nonatomic, strong, readonly) NSMutableArray<TSKWorkerProcess *> *idleWorkers;
+
+/*!
+ @abstract The requests waiting for a worker, in the order they were made.
+ @discussion Access to this object must be synchronized using the lock.
+ */
+@property (nonatomic, strong, readonly) NSMutableArray<TSKWorkerRequest *> *pendingRequests;
+
+/*!
+ @abstract Launches a new worker process.
+ @param error On failure, an error describing why the worker could not be launched.
+ @result The new worker, or nil if it could not be launched.
+ */
+- (nullable TSKWorkerProcess *)launchWorkerWithError:(NSError **)error;
+
+/*! Starts pending requests for as long as there are workers available to perform them. */
+- (void)startPendingRequests;
+
+/*!
+ @abstract Sends the specified request to the specified worker and waits for its response.
+ @discussion This must be invoked on the worker’s queue.
+ */
+- (void)performRequest:(TSKWorkerRequest *)request onWorker:(TSKWorkerProcess *)worker;
+
+/*! Makes the specified worker available for other requests, or terminates it if the pool is invalidated. */
+- (void)returnWorker:(TSKWorkerProcess *)worker;
+
+/*!
+ @abstract Abandons the specified request because its cancellation token was cancelled.
+ @discussion If a worker is performing the request, the worker is killed.
+ */
+- (void)cancelRequest:(TSKWorkerRequest *)request;
+
+/*!
+ @abstract Invokes the specified request’s completion handler.
+ @discussion The request must have been marked finished by the caller.
+ */
+- (void)completeRequest:(TSKWorkerRequest *)request withResult:(nullable id)result error:(nullable NSError *)error;
+
+@end
+
+
+@implementation TSKWorkerPool
+
+- (instancetype)initWithExecutableURL:(NSURL *)executableURL allowedResultClasses:(NSSet<Class> *)allowedResultClasses
+{
+    return [self initWithExecutableURL:executableURL
+                             arguments:nil
+                    maximumWorkerCount:[NSProcessInfo processInfo].activeProcessorCount
+                  allowedResultClasses:allowedResultClasses];
+}
+
+
+- (instancetype)initWithExecutableURL:(NSURL *)executableURL
+                            arguments:(NSArray<NSString *> *)arguments
+                   maximumWorkerCount:(NSUInteger)maximumWorkerCount
+                 allowedResultClasses:(NSSet<Class> *)allowedResultClasses
+{
+    NSParameterAssert(executableURL.isFileURL);
+    NSParameterAssert(maximumWorkerCount > 0);
+    NSParameterAssert(allowedResultClasses);
+
+    self = [super init];
+    if (self) {
+        _executableURL = [executableURL copy];
+        _arguments = arguments ? [arguments copy] : @[];
+        _maximumWorkerCount = maximumWorkerCount;
+        _allowedResultClasses = [allowedResultClasses copy];
+
+        NSMutableSet<Class> *responseClasses = [allowedResultClasses mutableCopy];
+        [responseClasses addObjectsFromArray:@[ [NSDictionary class], [NSString class], [NSNumber class], [NSError class] ]];
+        _responseClasses = [responseClasses copy];
+
+        _lock = OS_UNFAIR_LOCK_INIT;
+        _idleWorkers = [[NSMutableArray alloc] init];
+        _pendingRequests = [[NSMutableArray alloc] init];
+    }
+
+    return self;
+}
+
+
+- (void)dealloc
+{
+    [self invalidate];
+}
+
+
+- (NSUInteger)workerCount
+{
+    os_unfair_lock_lock(&_lock);
+    NSUInteger workerCount = _workerCount;
+    os_unfair_lock_unlock(&_lock);
+    return workerCount;
+}
+
+
+- (NSUInteger)crashedWorkerCount
+{
+    os_unfair_lock_lock(&_lock);
+    NSUInteger crashedWorkerCount = _crashedWorkerCount;
+    os_unfair_lock_unlock(&_lock);
+    return crashedWorkerCount;
+}
+
+
+#pragma mark - Performing Requests
+
+- (void)performRequest:(id<NSSecureCoding>)request
+     cancellationToken:(TSKCancellationToken *)cancellationToken
+     completionHandler:(void (^)(id, NSError *))completionHandler
+{
+    NSParameterAssert(request);
+    NSParameterAssert(completionHandler);
+
+    TSKWorkerRequest *workerRequest = [[TSKWorkerRequest alloc] initWithRequest:request
+                                                              cancellationToken:cancellationToken
+                                                              completionHandler:completionHandler];
+
+    os_unfair_lock_lock(&_lock);
+    BOOL invalidated = _invalidated;
+    if (invalidated) {
+        workerRequest.finished = YES;
+    } else {
+        [self.pendingRequests addObject:workerRequest];
+    }
+    os_unfair_lock_unlock(&_lock);
+
+    if (invalidated) {
+        completionHandler(nil, TSKWorkerPoolCancelledError());
+        return;
+    }
+
+    if (cancellationToken) {
+        // The handler runs immediately if the token is already cancelled, which abandons the request
+        __weak typeof(self) weakSelf = self;
+        __weak TSKWorkerRequest *weakRequest = workerRequest;
+        id cancellationHandler = [cancellationToken addCancellationHandler:^{
+            TSKWorkerRequest *strongRequest = weakRequest;
+            if (strongRequest) {
+                [weakSelf cancelRequest:strongRequest];
+            }
+        }];
+
+        os_unfair_lock_lock(&_lock);
+        BOOL finished = workerRequest.isFinished;
+        if (!finished) {
+            workerRequest.cancellationHandler = cancellationHandler;
+        }
+        os_unfair_lock_unlock(&_lock);
+
+        if (finished) {
+            [cancellationToken removeCancellationHandler:cancellationHandler];
+        }
+    }
+
+    [self startPendingRequests];
+}
+
+
+- (void)startPendingRequests
+{
+    while (YES) {
+        TSKWorkerRequest *request = nil;
+        TSKWorkerProcess *worker = nil;
+        BOOL shouldLaunchWorker = NO;
+
+        os_unfair_lock_lock(&_lock);
+        if (!_invalidated && self.pendingRequests.count > 0) {
+            if (self.idleWorkers.count > 0) {
+                worker = self.idleWorkers.lastObject;
+                [self.idleWorkers removeLastObject];
+            } else if (_workerCount < self.maximumWorkerCount) {
+                // The worker is counted before it is launched so that concurrent callers don’t exceed the maximum
+                ++_workerCount;
+                shouldLaunchWorker = YES;
+            }
+
+            if (worker || shouldLaunchWorker) {
+                request = self.pendingRequests.firstObject;
+                [self.pendingRequests removeObjectAtIndex:0];
+            }
+        }
+        os_unfair_lock_unlock(&_lock);
+
+        if (!request) {
+            return;
+        }
+
+        if (shouldLaunchWorker) {
+            NSError *error = nil;
+            worker = [self launchWorkerWithError:&error];
+            if (!worker) {
+                os_unfair_lock_lock(&_lock);
+                --_workerCount;
+                BOOL wasFinished = request.isFinished;
+                request.finished = YES;
+                os_unfair_lock_unlock(&_lock);
+
+                if (!wasFinished) {
+                    [self completeRequest:request withResult:nil error:error];
+                }
+
+                continue;
+            }
+        }
+
+        // The request may have been abandoned while it was waiting for the worker
+        os_unfair_lock_lock(&_lock);
+        BOOL wasFinished = request.isFinished;
+        if (!wasFinished) {
+            request.worker = worker;
+        }
+        os_unfair_lock_unlock(&_lock);
+
+        if (wasFinished) {
+            [self returnWorker:worker];
+            continue;
+        }
+
+        dispatch_async(worker.queue, ^{
+            [self performRequest:request onWorker:worker];
+        });
+    }
+}
+
+
+- (void)performRequest:(TSKWorkerRequest *)request onWorker:(TSKWorkerProcess *)worker
+{
+    TSKWorkerConnection *connection = worker.connection;
+
+    id result = nil;
+    NSError *error = nil;
+    BOOL workerFailed = NO;
+    if (![connection sendObject:request.request error:&error]) {
+        // Requests that can’t be archived fail without affecting the worker
+        workerFailed = [error.domain isEqualToString:NSPOSIXErrorDomain];
+    } else {
+        NSData *message = [connection receiveMessageWithError:&error];
+        if (!message) {
+            workerFailed = YES;
+        } else {
+            NSDictionary *response = [TSKWorkerConnection objectOfClasses:self.responseClasses fromMessage:message error:&error];
+            if (response) {
+                result = response[TSKWorkerResponseResultKey];
+                error = response[TSKWorkerResponseErrorKey];
+            }
+        }
+    }
+
+    if (!workerFailed) {
+        os_unfair_lock_lock(&_lock);
+        BOOL wasFinished = request.isFinished;
+        request.finished = YES;
+        request.worker = nil;
+        os_unfair_lock_unlock(&_lock);
+
+        [self returnWorker:worker];
+        if (!wasFinished) {
+            [self completeRequest:request withResult:result error:error];
+        }
+
+        [self startPendingRequests];
+        return;
+    }
+
+    // Workers killed because their request was abandoned aren’t counted as crashes
+    os_unfair_lock_lock(&_lock);
+    BOOL wasFinished = request.isFinished;
+    request.finished = YES;
+    request.worker = nil;
+    --_workerCount;
+    if (!wasFinished) {
+        ++_crashedWorkerCount;
+    }
+    os_unfair_lock_unlock(&_lock);
+
+    int status = [worker terminate];
+    if (!wasFinished) {
+        NSString *description = nil;
+        if (WIFSIGNALED(status)) {
+            description = [NSString stringWithFormat:@"Worker process %d was terminated by signal %d before returning a result",
+                           worker.processIdentifier, WTERMSIG(status)];
+        } else {
+            description = [NSString stringWithFormat:@"Worker process %d exited with status %d before returning a result",
+                           worker.processIdentifier, WEXITSTATUS(status)];
+        }
+
+        NSMutableDictionary *userInfo = [[NSMutableDictionary alloc] initWithObjectsAndKeys:description, NSLocalizedDescriptionKey, nil];
+        if (error) {
+            userInfo[NSUnderlyingErrorKey] = error;
+        }
+
+        [self completeRequest:request withResult:nil error:[NSError errorWithDomain:TSKTaskErrorDomain
+                                                                               code:TSKErrorCodeWorkerCrashed
+                                                                           userInfo:userInfo]];
+    }
+
+    // A replacement worker is launched if there are requests waiting
+    [self startPendingRequests];
+}
+
+
+- (void)returnWorker:(TSKWorkerProcess *)worker
+{
+    os_unfair_lock_lock(&_lock);
+    BOOL invalidated = _invalidated;
+    if (invalidated) {
+        --_workerCount;
+    } else {
+        [self.idleWorkers addObject:worker];
+    }
+    os_unfair_lock_unlock(&_lock);
+
+    if (invalidated) {
+        dispatch_async(worker.queue, ^{
+            [worker terminate];
+        });
+    }
+}
+
+
+- (void)cancelRequest:(TSKWorkerRequest *)request
+{
+    os_unfair_lock_lock(&_lock);
+    BOOL wasFinished = request.isFinished;
+    if (!wasFinished) {
+        request.finished = YES;
+
+        // The worker is killed while holding the lock, since it can’t be reaped until the lock is
+        // released. This guarantees that its process identifier hasn’t been reused.
+        TSKWorkerProcess *worker = request.worker;
+        if (worker) {
+            kill(worker.processIdentifier, SIGKILL);
+        } else {
+            [self.pendingRequests removeObjectIdenticalTo:request];
+        }
+    }
+    os_unfair_lock_unlock(&_lock);
+
+    if (!wasFinished) {
+        [self completeRequest:request withResult:nil error:TSKWorkerPoolCancelledError()];
+    }
+}
+
+
+- (void)completeRequest:(TSKWorkerRequest *)request withResult:(id)result error:(NSError *)error
+{
+    os_unfair_lock_lock(&_lock);
+    id cancellationHandler = request.cancellationHandler;
+    request.cancellationHandler = nil;
+    os_unfair_lock_unlock(&_lock);
+
+    if (cancellationHandler) {
+        [request.cancellationToken removeCancellationHandler:cancellationHandler];
+    }
+
+    request.completionHandler(result, error);
+}
+
+
+- (void)invalidate
+{
+    os_unfair_lock_lock(&_lock);
+    if (_invalidated) {
+        os_unfair_lock_unlock(&_lock);
+        return;
+    }
+
+    _invalidated = YES;
+    NSArray<TSKWorkerProcess *> *idleWorkers = [self.idleWorkers copy];
+    [self.idleWorkers removeAllObjects];
+    _workerCount -= idleWorkers.count;
+
+    NSArray<TSKWorkerRequest *> *pendingRequests = [self.pendingRequests copy];
+    [self.pendingRequests removeAllObjects];
+    for (TSKWorkerRequest *request in pendingRequests) {
+        request.finished = YES;
+    }
+    os_unfair_lock_unlock(&_lock);
+
+    for (TSKWorkerProcess *worker in idleWorkers) {
+        dispatch_async(worker.queue, ^{
+            [worker terminate];
+        });
+    }
+
+    for (TSKWorkerRequest *request in pendingRequests) {
+        [self completeRequest:request withResult:nil error:TSKWorkerPoolCancelledError()];
+    }
+}
+
+
+#pragma mark - Launching Workers
+
+- (TSKWorkerProcess *)launchWorkerWithError:(NSError **)error
+{
+    int sockets[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0) {
+        if (error) {
+            *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+        }
+
+        return nil;
+    }
+
+    // Neither end should leak into processes launched by anything else
+    fcntl(sockets[0], F_SETFD, FD_CLOEXEC);
+    fcntl(sockets[1], F_SETFD, FD_CLOEXEC);
+
+    // The worker inherits only its standard streams and its end of the socket, which it finds at a
+    // well-known descriptor. Other descriptors are closed so that workers don’t hold each other’s
+    // sockets open, which would keep them from noticing when the pool closes their connection.
+    posix_spawn_file_actions_t fileActions;
+    posix_spawn_file_actions_init(&fileActions);
+    posix_spawn_file_actions_adddup2(&fileActions, STDIN_FILENO, STDIN_FILENO);
+    posix_spawn_file_actions_adddup2(&fileActions, STDOUT_FILENO, STDOUT_FILENO);
+    posix_spawn_file_actions_adddup2(&fileActions, STDERR_FILENO, STDERR_FILENO);
+    posix_spawn_file_actions_adddup2(&fileActions, sockets[1], kTSKWorkerPoolWorkerSocketDescriptor);
+
+    posix_spawnattr_t attributes;
+    posix_spawnattr_init(&attributes);
+    posix_spawnattr_setflags(&attributes, POSIX_SPAWN_CLOEXEC_DEFAULT);
+
+    NSString *path = self.executableURL.path;
+    NSMutableArray<NSString *> *argumentStrings = [[NSMutableArray alloc] initWithObjects:path, nil];
+    [argumentStrings addObjectsFromArray:self.arguments];
+
+    NSMutableDictionary<NSString *, NSString *> *environment = [[NSProcessInfo processInfo].environment mutableCopy];
+    environment[TSKWorkerSocketDescriptorEnvironmentKey] = [NSString stringWithFormat:@"%d", kTSKWorkerPoolWorkerSocketDescriptor];
+    NSMutableArray<NSString *> *environmentStrings = [[NSMutableArray alloc] initWithCapacity:environment.count];
+    [environment enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSString *value, BOOL *stop) {
+        [environmentStrings addObject:[NSString stringWithFormat:@"%@=%@", key, value]];
+    }];
+
+    char **argv = calloc(argumentStrings.count + 1, sizeof(char *));
+    [argumentStrings enumerateObjectsUsingBlock:^(NSString *argument, NSUInteger index, BOOL *stop) {
+        argv[index] = (char *)argument.fileSystemRepresentation;
+    }];
+
+    char **envp = calloc(environmentStrings.count + 1, sizeof(char *));
+    [environmentStrings enumerateObjectsUsingBlock:^(NSString *variable, NSUInteger index, BOOL *stop) {
+        envp[index] = (char *)variable.UTF8String;
+    }];
+
+    pid_t processIdentifier = 0;
+    int result = posix_spawn(&processIdentifier, path.fileSystemRepresentation, &fileActions, &attributes, argv, envp);
+
+    free(envp);
+    free(argv);
+    posix_spawnattr_destroy(&attributes);
+    posix_spawn_file_actions_destroy(&fileActions);
+    close(sockets[1]);
+
+    if (result != 0) {
+        close(sockets[0]);
+        if (error) {
+            *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:result userInfo:nil];
+        }
+
+        return nil;
+    }
+
+    TSKWorkerConnection *connection = [[TSKWorkerConnection alloc] initWithSocketDescriptor:sockets[0]];
+    return [[TSKWorkerProcess alloc] initWithProcessIdentifier:processIdentifier connection:connection];
+}
+
+@end
+
+#endif
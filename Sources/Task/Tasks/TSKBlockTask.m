@@ -66,6 +66,16 @@
 }
 
 
+- (id)copyWithZone:(NSZone *)zone
+{
+    TSKBlockTask *copy = [[[self class] allocWithZone:zone] initWithName:nil
+                                                 requiredPrerequisiteKeys:self.requiredPrerequisiteKeys
+                                                                    block:self.block];
+    [self copyConfigurationToTask:copy];
+    return copy;
+}
+
+
 - (void)main
 {
     self.block(self);
@@ -0,0 +1,66 @@
+//
+//  TSKFunctionTask.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <Task/TSKFunctionTask.h>
+
+
+@implementation TSKFunctionTask
+
+- (instancetype)initWithFunction:(TSKTaskFunction)function context:(void *)context
+{
+    return [self initWithName:nil function:function context:context];
+}
+
+
+- (instancetype)initWithName:(NSString *)name function:(TSKTaskFunction)function context:(void *)context
+{
+    NSParameterAssert(function);
+
+    self = [super initWithName:name];
+    if (self) {
+        _function = function;
+        _context = context;
+    }
+
+    return self;
+}
+
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    TSKFunctionTask *copy = [[[self class] allocWithZone:zone] initWithName:nil function:_function context:_context];
+    [self copyConfigurationToTask:copy];
+    return copy;
+}
+
+
+- (void)main
+{
+    _function(self, _context);
+}
+
+@end
@@ -0,0 +1,461 @@
+//
+//  TSKReduceTask.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <Task/TSKReduceTask.h>
+
+#import <Task/TSKWorkflow.h>
+
+#import "../Workflows/TSKWorkflow+TaskInterface.h"
+#import "TSKTask+WorkflowInterface.h"
+
+
+#pragma mark Functions
+
+/*! Returns the value that stands in for a nil result in the reduction tree. */
+static id TSKReduceTaskNilValue(void)
+{
+    static id nilValue = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        nilValue = [[NSObject alloc] init];
+    });
+
+    return nilValue;
+}
+
+
+/*! Returns the value of a node whose prerequisites contributed nothing, e.g., because they were skipped. */
+static id TSKReduceTaskAbsentValue(void)
+{
+    static id absentValue = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        absentValue = [[NSObject alloc] init];
+    });
+
+    return absentValue;
+}
+
+
+/*!
+ @abstract Returns the key for the specified node of the reduction tree.
+ @discussion Leaves are at level 0. The node at index j of level l covers the leaves in the range
+     [j × 2^l, (j + 1) × 2^l).
+ */
+static inline NSNumber *TSKReduceTaskNodeKey(NSUInteger level, NSUInteger index)
+{
+    return @((index << 6) | level);
+}
+
+
+#pragma mark -
+
+@interface TSKReduceTask () {
+    /*! The level of the reduction tree’s root node. */
+    NSUInteger _rootLevel;
+
+    /*!
+     @abstract The number of times the reduction has been discarded.
+     @discussion Combinations that were in progress when the reduction was discarded use this to
+         avoid storing their results in the new reduction. Access to this must be synchronized using
+         reductionCondition.
+     */
+    uint64_t _generation;
+
+    /*!
+     @abstract The index of the first leaf that might not have finished.
+     @discussion Every leaf before this one has finished at some point. Access to this must be
+         synchronized using reductionCondition.
+     */
+    NSUInteger _unfinishedLeafIndex;
+}
+
+/*!
+ @abstract A condition that synchronizes access to the reduction’s state.
+ @discussion The condition protects _generation, _unfinishedLeafIndex, deliveredLeafIndexes, and
+     nodeValues. It is broadcast whenever the root node’s value is stored.
+ */
+@property (nonatomic, strong, readonly) NSCondition *reductionCondition;
+
+/*!
+ @abstract The task’s prerequisites, in the order the workflow records them.
+ @discussion This is nil until the task first needs it. It is only set once, so it may be read
+     without synchronization after it is set.
+ */
+@property (atomic, copy, nullable) NSArray<TSKTask *> *leafTasks;
+
+/*!
+ @abstract The conditions on the task’s prerequisites, indexed like leafTasks.
+ @discussion Unconditional prerequisites have NSNull as their condition. This is set along with
+     leafTasks.
+ */
+@property (atomic, copy, nullable) NSArray *leafConditions;
+
+/*!
+ @abstract A map table from each prerequisite task to its index in leafTasks.
+ @discussion This is set along with leafTasks.
+ */
+@property (atomic, strong, nullable) NSMapTable<TSKTask *, NSNumber *> *leafIndexesByTask;
+
+/*!
+ @abstract The indexes of the leaves whose values have been added to the reduction.
+ @discussion Access to this object must be synchronized using reductionCondition.
+ */
+@property (nonatomic, strong, readonly) NSMutableIndexSet *deliveredLeafIndexes;
+
+/*!
+ @abstract The values of the nodes of the reduction tree that have not yet been combined with their
+     siblings, keyed by TSKReduceTaskNodeKey().
+ @discussion Access to this object must be synchronized using reductionCondition.
+ */
+@property (nonatomic, strong, readonly) NSMutableDictionary<NSNumber *, id> *nodeValues;
+
+/*!
+ @abstract Records the task’s prerequisites and their conditions if they have not been recorded yet.
+ @result Whether the task has any prerequisites.
+ */
+- (BOOL)loadLeafTasksIfNeeded;
+
+/*!
+ @abstract Returns the reduction tree value for the specified prerequisite result.
+ @param result The result.
+ @param leafIndex The index of the prerequisite that finished with the result.
+ @result The value, which is absent if the prerequisite’s condition is not met.
+ */
+- (id)leafValueForResult:(nullable id)result atLeafIndex:(NSUInteger)leafIndex;
+
+/*!
+ @abstract Adds the specified value to the reduction tree at the specified node, combining it with
+     its siblings’ values for as long as they are available.
+ @param value The value.
+ @param level The node’s level.
+ @param index The node’s index within its level.
+ @param generation The reduction generation to which the value belongs. If the reduction has since
+     been discarded, the value is dropped.
+ */
+- (void)addValue:(id)value toNodeAtLevel:(NSUInteger)level index:(NSUInteger)index generation:(uint64_t)generation;
+
+/*!
+ @abstract Returns the combination of the specified values using the task’s block.
+ @discussion Absent values are ignored rather than passed to the block.
+ */
+- (id)combineLeftValue:(id)leftValue rightValue:(id)rightValue;
+
+/*!
+ @abstract Returns whether all of the task’s prerequisites might have finished or been skipped.
+ @discussion This resumes scanning the prerequisites where the last invocation left off, so the total
+     cost of invoking it as each prerequisite finishes is proportional to the number of prerequisites.
+     It may return YES when some prerequisites are no longer finished or skipped, but never returns NO
+     when all of them are. Skipped prerequisites count, since a task that runs when its prerequisites
+     are skipped must be checked once the rest finish.
+ */
+- (BOOL)allLeafTasksMightBeFinished;
+
+/*!
+ @abstract Discards the reduction so that it is recomputed from the prerequisites’ results.
+ @discussion This must be invoked while holding reductionCondition’s lock.
+ */
+- (void)discardReductionWhileLocked;
+
+@end
+
+
+@implementation TSKReduceTask
+
+- (instancetype)initWithBlock:(id (^)(id, id))block
+{
+    return [self initWithName:nil block:block];
+}
+
+
+- (instancetype)initWithName:(NSString *)name block:(id (^)(id, id))block
+{
+    NSParameterAssert(block);
+
+    self = [super initWithName:name];
+    if (self) {
+        _block = [block copy];
+        _reductionCondition = [[NSCondition alloc] init];
+        _deliveredLeafIndexes = [[NSMutableIndexSet alloc] init];
+        _nodeValues = [[NSMutableDictionary alloc] init];
+    }
+
+    return self;
+}
+
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    TSKReduceTask *copy = [[[self class] allocWithZone:zone] initWithName:nil block:self.block];
+    [self copyConfigurationToTask:copy];
+    return copy;
+}
+
+
+#pragma mark - Reduction
+
+- (BOOL)loadLeafTasksIfNeeded
+{
+    NSArray<TSKTask *> *leafTasks = self.leafTasks;
+    if (leafTasks) {
+        return leafTasks.count > 0;
+    }
+
+    TSKWorkflow *workflow = self.workflow;
+    if (!workflow) {
+        return NO;
+    }
+
+    // The prerequisites are recorded outside the lock, since this reads the workflow’s graph
+    NSMutableArray<TSKTask *> *tasks = [[NSMutableArray alloc] init];
+    NSMutableArray *conditions = [[NSMutableArray alloc] init];
+    [workflow enumeratePrerequisiteTasksOfTask:self usingBlock:^(TSKTask *prerequisiteTask, BOOL (^condition)(id), BOOL *stop) {
+        [tasks addObject:prerequisiteTask];
+        [conditions addObject:condition ? (id)condition : [NSNull null]];
+    }];
+
+    NSMapTable<TSKTask *, NSNumber *> *leafIndexesByTask = [NSMapTable strongToStrongObjectsMapTable];
+    [tasks enumerateObjectsUsingBlock:^(TSKTask *task, NSUInteger index, BOOL *stop) {
+        [leafIndexesByTask setObject:@(index) forKey:task];
+    }];
+
+    NSUInteger rootLevel = 0;
+    while (((NSUInteger)1 << rootLevel) < tasks.count) {
+        ++rootLevel;
+    }
+
+    [self.reductionCondition lock];
+    if (!self.leafTasks) {
+        _rootLevel = rootLevel;
+        self.leafIndexesByTask = leafIndexesByTask;
+        self.leafConditions = conditions;
+        self.leafTasks = tasks;
+    }
+    [self.reductionCondition unlock];
+
+    return self.leafTasks.count > 0;
+}
+
+
+- (id)leafValueForResult:(id)result atLeafIndex:(NSUInteger)leafIndex
+{
+    id condition = self.leafConditions[leafIndex];
+    if (condition != [NSNull null] && !((BOOL (^)(id))condition)(result)) {
+        return TSKReduceTaskAbsentValue();
+    }
+
+    return result ? result : TSKReduceTaskNilValue();
+}
+
+
+- (void)addValue:(id)value toNodeAtLevel:(NSUInteger)level index:(NSUInteger)index generation:(uint64_t)generation
+{
+    NSCondition *reductionCondition = self.reductionCondition;
+    NSUInteger leafCount = self.leafTasks.count;
+    while (YES) {
+        [reductionCondition lock];
+        if (_generation != generation) {
+            [reductionCondition unlock];
+            return;
+        }
+
+        if (level == _rootLevel) {
+            self.nodeValues[TSKReduceTaskNodeKey(level, index)] = value;
+            [reductionCondition broadcast];
+            [reductionCondition unlock];
+            return;
+        }
+
+        // Nodes past the last leaf don’t exist, so a node without a sibling is promoted as is
+        NSUInteger siblingIndex = index ^ 1;
+        id siblingValue = nil;
+        if ((siblingIndex << level) < leafCount) {
+            NSNumber *siblingKey = TSKReduceTaskNodeKey(level, siblingIndex);
+            siblingValue = self.nodeValues[siblingKey];
+            if (!siblingValue) {
+                // The sibling isn’t ready yet, so whichever of the two finishes last combines them
+                self.nodeValues[TSKReduceTaskNodeKey(level, index)] = value;
+                [reductionCondition unlock];
+                return;
+            }
+
+            [self.nodeValues removeObjectForKey:siblingKey];
+        }
+        [reductionCondition unlock];
+
+        // Combining happens outside the lock so that disjoint parts of the tree combine in parallel
+        if (siblingValue) {
+            value = (index & 1) ? [self combineLeftValue:siblingValue rightValue:value]
+                                : [self combineLeftValue:value rightValue:siblingValue];
+        }
+
+        ++level;
+        index >>= 1;
+    }
+}
+
+
+- (id)combineLeftValue:(id)leftValue rightValue:(id)rightValue
+{
+    id absentValue = TSKReduceTaskAbsentValue();
+    if (leftValue == absentValue) {
+        return rightValue;
+    } else if (rightValue == absentValue) {
+        return leftValue;
+    }
+
+    id nilValue = TSKReduceTaskNilValue();
+    id result = self.block(leftValue == nilValue ? nil : leftValue, rightValue == nilValue ? nil : rightValue);
+    return result ? result : nilValue;
+}
+
+
+- (BOOL)allLeafTasksMightBeFinished
+{
+    NSArray<TSKTask *> *leafTasks = self.leafTasks;
+
+    [self.reductionCondition lock];
+    NSUInteger leafIndex = _unfinishedLeafIndex;
+    [self.reductionCondition unlock];
+
+    while (leafIndex < leafTasks.count && (leafTasks[leafIndex].isFinished || leafTasks[leafIndex].isSkipped)) {
+        ++leafIndex;
+    }
+
+    [self.reductionCondition lock];
+    _unfinishedLeafIndex = MAX(_unfinishedLeafIndex, leafIndex);
+    [self.reductionCondition unlock];
+
+    return leafIndex == leafTasks.count;
+}
+
+
+- (void)discardReductionWhileLocked
+{
+    ++_generation;
+    [self.deliveredLeafIndexes removeAllIndexes];
+    [self.nodeValues removeAllObjects];
+}
+
+
+#pragma mark - Task Lifecycle
+
+- (void)prerequisiteTask:(TSKTask *)task didFinishWithResult:(id)result
+{
+    NSNumber *leafIndexNumber = [self loadLeafTasksIfNeeded] ? [self.leafIndexesByTask objectForKey:task] : nil;
+    if (!leafIndexNumber) {
+        [super prerequisiteTask:task didFinishWithResult:result];
+        return;
+    }
+
+    NSUInteger leafIndex = leafIndexNumber.unsignedIntegerValue;
+
+    [self.reductionCondition lock];
+    // A prerequisite that finishes again, e.g., after being invalidated, makes every combination that
+    // included its old result stale. It’s simplest to start over, letting ‑main add the leaves of the
+    // prerequisites that don’t finish again.
+    if ([self.deliveredLeafIndexes containsIndex:leafIndex]) {
+        [self discardReductionWhileLocked];
+    }
+
+    [self.deliveredLeafIndexes addIndex:leafIndex];
+    uint64_t generation = _generation;
+    [self.reductionCondition unlock];
+
+    [self addValue:[self leafValueForResult:result atLeafIndex:leafIndex] toNodeAtLevel:0 index:leafIndex generation:generation];
+
+    // Checking whether the task is ready takes time proportional to its number of prerequisites, so
+    // it is skipped until they might all have finished. Conditional prerequisites are always checked,
+    // since they may cause the task to be skipped.
+    if (self.leafConditions[leafIndex] != [NSNull null] || [self allLeafTasksMightBeFinished]) {
+        [super prerequisiteTask:task didFinishWithResult:result];
+    }
+}
+
+
+- (void)main
+{
+    if (![self loadLeafTasksIfNeeded]) {
+        [self finishWithResult:nil];
+        return;
+    }
+
+    NSArray<TSKTask *> *leafTasks = self.leafTasks;
+    NSCondition *reductionCondition = self.reductionCondition;
+    NSNumber *rootKey = TSKReduceTaskNodeKey(_rootLevel, 0);
+
+    id rootValue = nil;
+    while (!rootValue) {
+        // Leaves that weren’t added as their prerequisites finished, e.g., because the reduction was
+        // discarded or the prerequisites were skipped, are added now
+        [reductionCondition lock];
+        uint64_t generation = _generation;
+        NSMutableIndexSet *undeliveredLeafIndexes = [[NSMutableIndexSet alloc] initWithIndexesInRange:NSMakeRange(0, leafTasks.count)];
+        [undeliveredLeafIndexes removeIndexes:self.deliveredLeafIndexes];
+        [self.deliveredLeafIndexes addIndexes:undeliveredLeafIndexes];
+        [reductionCondition unlock];
+
+        [undeliveredLeafIndexes enumerateIndexesUsingBlock:^(NSUInteger leafIndex, BOOL *stop) {
+            TSKTask *leafTask = leafTasks[leafIndex];
+            id value = leafTask.isFinished ? [self leafValueForResult:leafTask.result atLeafIndex:leafIndex] : TSKReduceTaskAbsentValue();
+            [self addValue:value toNodeAtLevel:0 index:leafIndex generation:generation];
+        }];
+
+        // Prerequisites’ threads may still be combining values, but only briefly, since every leaf
+        // has been added. If the reduction is discarded in the meantime, it is started over.
+        [reductionCondition lock];
+        while (!(rootValue = self.nodeValues[rootKey]) && _generation == generation) {
+            [reductionCondition wait];
+        }
+        [reductionCondition unlock];
+    }
+
+    [self finishWithResult:(rootValue == TSKReduceTaskNilValue() || rootValue == TSKReduceTaskAbsentValue()) ? nil : rootValue];
+}
+
+
+- (void)didReset
+{
+    [super didReset];
+
+    [self.reductionCondition lock];
+    [self discardReductionWhileLocked];
+    _unfinishedLeafIndex = 0;
+    [self.reductionCondition unlock];
+}
+
+
+- (void)didRetry
+{
+    [super didRetry];
+
+    [self.reductionCondition lock];
+    [self discardReductionWhileLocked];
+    [self.reductionCondition unlock];
+}
+
+@end
@@ -66,6 +66,17 @@
 }
 
 
+- (id)copyWithZone:(NSZone *)zone
+{
+    TSKSelectorTask *copy = [[[self class] allocWithZone:zone] initWithName:nil
+                                                                     target:self.target
+                                                                   selector:self.selector
+                                                   requiredPrerequisiteKeys:self.requiredPrerequisiteKeys];
+    [self copyConfigurationToTask:copy];
+    return copy;
+}
+
+
 - (void)main
 {
 #pragma clang diagnostic push
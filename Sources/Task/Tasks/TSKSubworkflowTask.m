@@ -27,6 +27,7 @@
 #import <Task/TSKSubworkflowTask.h>
 
 #import <Task/TSKWorkflow.h>
+#import <Task/TSKWorkflowTemplate.h>
 
 
 @implementation TSKSubworkflowTask
@@ -69,6 +70,16 @@
 }
 
 
+- (id)copyWithZone:(NSZone *)zone
+{
+    // Each copy gets its own instance of the subworkflow, as a workflow can only be run by one task
+    TSKWorkflow *subworkflow = [[[TSKWorkflowTemplate alloc] initWithWorkflow:self.subworkflow] instantiateWorkflow];
+    TSKSubworkflowTask *copy = [[[self class] allocWithZone:zone] initWithName:nil subworkflow:subworkflow];
+    [self copyConfigurationToTask:copy];
+    return copy;
+}
+
+
 #pragma mark -
 
 - (void)main
@@ -105,6 +116,8 @@
     } else if (foundCancelledTask) {
         [self cancelWithoutPropagationToSubworkflow];
     } else {
+        // Forwarding our token lets the subworkflow’s tasks stop as soon as we stop executing
+        self.subworkflow.cancellationToken = self.cancellationToken;
         [self.subworkflow start];
     }
 }
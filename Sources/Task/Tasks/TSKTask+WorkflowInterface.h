@@ -37,6 +37,21 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (nonatomic, weak, readwrite, nullable) TSKWorkflow *workflow;
 
+@property (atomic, strong, readwrite, nullable) TSKChannel *inputChannel;
+@property (atomic, strong, readwrite, nullable) TSKChannel *outputChannel;
+
+/*!
+ @abstract The index of the task’s node in its workflow’s task graph.
+ @discussion This is set when the task is added to a workflow and is meaningless before then.
+ */
+@property (nonatomic, assign) NSUInteger workflowNodeIndex;
+
+/*! Whether the task’s name is the default name, which is unique to the task. */
+@property (nonatomic, assign, readonly) BOOL hasDefaultName;
+
+/*! The task’s deadline if it has one, and its workflow’s deadline otherwise. */
+@property (nonatomic, strong, readonly, nullable) NSDate *effectiveDeadline;
+
 /*!
  @abstract Returns a recursive description of the task and its dependent tasks starting at the
      specified depth.
@@ -48,10 +63,48 @@ NS_ASSUME_NONNULL_BEGIN
 /*!
  @abstract Indicates to the task that it has a prerequisite.
  @discussion This has the effect of transitioning the task from the ready state to the pending
-     state.
+     state. The workflow is responsible for subsequently transitioning the task back to the ready
+     state if its prerequisites have already finished.
  */
 - (void)didAddPrerequisiteTask;
 
+/*!
+ @abstract If all the task’s prerequisite tasks have finished successfully, transitions from
+     pending to ready and executes the specified block.
+ @param block The block to execute after successfully transitioning to the ready state.
+ */
+- (void)transitionToReadyStateAndExecuteBlock:(nullable void (^)(void))block;
+
+/*!
+ @abstract If all the task’s prerequisite tasks have finished successfully, transitions from
+     pending to ready and starts the task.
+ @discussion If the task’s prerequisites call for it to be skipped instead, the pending task and its
+     pending dependents are skipped. See ‑[TSKTask runsWhenPrerequisitesSkipped].
+ */
+- (void)startIfReady;
+
+/*!
+ @abstract Indicates to the task that one of its prerequisite tasks finished with the specified
+     result.
+ @discussion TSKTask’s implementation invokes ‑startIfReady. Subclasses that consume their
+     prerequisites’ results as they arrive can override this to do so, and need only invoke super
+     once the task might be ready.
+ @param task The prerequisite task that finished. May not be nil.
+ @param result The result that the prerequisite task finished with.
+ */
+- (void)prerequisiteTask:(TSKTask *)task didFinishWithResult:(nullable id)result;
+
+/*!
+ @abstract Replaces the task’s result with the specified replacement if its result is still the
+     specified object.
+ @discussion TSKResultStore uses this to swap a result for an equal one it spilled to disk without
+     racing the task being reset or finishing again.
+ @param result The result that is expected to be the task’s current result.
+ @param replacement The result to replace it with.
+ @result Whether the result was replaced.
+ */
+- (BOOL)replaceResult:(nullable id)result withResult:(nullable id)replacement;
+
 @end
 
 NS_ASSUME_NONNULL_END
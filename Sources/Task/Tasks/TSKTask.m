@@ -26,9 +26,23 @@
 
 #import <Task/TSKTask.h>
 
+#import <Task/TSKCancellationToken.h>
+#import <Task/TSKDurationHistogram.h>
+#import <Task/TSKDurationStatistics.h>
+#import <Task/TSKRetryPolicy.h>
+#import <Task/TSKSpeculationPolicy.h>
+#import <Task/TSKTimerWheel.h>
 #import <Task/TSKWorkflow.h>
+#import <Task/TaskErrors.h>
+#import <os/lock.h>
+#import <stdatomic.h>
+#import <time.h>
 
 #import "TSKTask+WorkflowInterface.h"
+#import "../Channels/TSKChannel+WorkflowInterface.h"
+#import "../Execution/TSKFlightRecorder+TaskInterface.h"
+#import "../Execution/TSKMetrics+TaskInterface.h"
+#import "../Execution/TSKResultStore+TaskInterface.h"
 #import "../Workflows/TSKWorkflow+TaskInterface.h"
 
 
@@ -37,10 +51,16 @@
 NSString *const TSKTaskDidCancelNotification = @"TSKTaskDidCancelNotification";
 NSString *const TSKTaskDidFailNotification = @"TSKTaskDidFailNotification";
 NSString *const TSKTaskDidFinishNotification = @"TSKTaskDidFinishNotification";
+NSString *const TSKTaskDidInvalidateNotification = @"TSKTaskDidInvalidateNotification";
 NSString *const TSKTaskDidResetNotification = @"TSKTaskDidResetNotification";
 NSString *const TSKTaskDidRetryNotification = @"TSKTaskDidRetryNotification";
+NSString *const TSKTaskDidScheduleRetryNotification = @"TSKTaskDidScheduleRetryNotification";
+NSString *const TSKTaskDidSkipNotification = @"TSKTaskDidSkipNotification";
 NSString *const TSKTaskDidStartNotification = @"TSKTaskDidStartNotification";
 
+TSKExecutionClass const TSKExecutionClassLatencyCritical = @"TSKExecutionClassLatencyCritical";
+TSKExecutionClass const TSKExecutionClassBatch = @"TSKExecutionClassBatch";
+
 
 NSString *const TSKTaskStateDescription(TSKTaskState state)
 {
@@ -57,28 +77,141 @@ NSString *const TSKTaskStateDescription(TSKTaskState state)
             return @"Finished";
         case TSKTaskStateFailed:
             return @"Failed";
+        case TSKTaskStateSkipped:
+            return @"Skipped";
         default:
             return nil;
     }
 }
 
 
+/*! Returns whether a task in the specified state stays in it until it is reset, retried, or invalidated. */
+static inline BOOL TSKTaskStateIsTerminal(TSKTaskState state)
+{
+    return state == TSKTaskStateFinished || state == TSKTaskStateFailed || state == TSKTaskStateCancelled || state == TSKTaskStateSkipped;
+}
+
+
+/*! The combined status of a task’s prerequisites. See ‑[TSKTask prerequisiteStatus]. */
+typedef NS_ENUM(NSUInteger, TSKPrerequisiteStatus) {
+    /*! At least one prerequisite has not finished or been skipped. */
+    TSKPrerequisiteStatusUnfinished,
+
+    /*! All prerequisites have finished or been skipped in a way that lets the task run. */
+    TSKPrerequisiteStatusSatisfied,
+
+    /*! A prerequisite was skipped and the task does not run when its prerequisites are skipped. */
+    TSKPrerequisiteStatusSkipped
+};
+
+
 #pragma mark -
 
-@interface TSKTask ()
+@interface TSKTask () {
+    /*!
+     @abstract A lock to control changes to task state.
+     @discussion This lock is only used within ‑transitionFromStateInSet:toState:andExecuteBlock: to
+         perform data synchronization. We use an unfair lock instead of a serial dispatch queue because
+         it is stored inline in the task and thus requires no additional allocations.
+     */
+    os_unfair_lock _stateLock;
+
+    /*!
+     @abstract A lock that synchronizes access to the task’s result.
+     @discussion A workflow’s result store may replace the result from another thread while the task
+         is finished. See ‑replaceResult:withResult:.
+     */
+    os_unfair_lock _resultLock;
+
+    /*!
+     @abstract The number of times the task has started executing.
+     @discussion Speculative attempts are tied to the execution that scheduled them, and only run if
+         the task is still in that execution when they are due. This prevents an attempt scheduled
+         before a reset or retry from running during a later execution.
+     */
+    _Atomic(uint64_t) _executionCount;
+    atomic_ulong _speculativeAttemptCount;
+
+    /*! The number of times the task has started executing since it was last reset, retried, or invalidated. */
+    atomic_ulong _attemptCount;
+
+    /*! The system uptime at which the task last started executing. */
+    _Atomic(NSTimeInterval) _executionStartTime;
+
+    /*! Whether the task’s name is the default name, which is unique to the task. */
+    BOOL _hasDefaultName;
+
+    /*!
+     @abstract The cancellation token for the task’s current or most recent execution.
+     @discussion This is only accessed while holding the state lock, so that the token is replaced
+         and cancelled atomically with the transitions into and out of the executing state.
+     */
+    TSKCancellationToken *_cancellationToken;
+
+    /*!
+     @abstract The timer for the task’s current execution, if it has a timeout.
+     @discussion This is only accessed while holding the state lock, so that the timer is disarmed
+         atomically with the transition out of the executing state.
+     */
+    TSKTimerWheelTimer *_timeoutTimer;
+
+    /*!
+     @abstract The timer for the retry that the task’s retry policy scheduled, if the task is waiting
+         for one.
+     @discussion This is only accessed while holding the state lock, so that the timer is disarmed
+         atomically with the transition out of the pending state.
+     */
+    TSKTimerWheelTimer *_retryTimer;
+
+    /*!
+     @abstract Whether the task has reached a terminal state and finished reporting it.
+     @discussion A task is settled once the block of its transition into the finished, failed,
+         cancelled, or skipped state has run, so that waiters see its result or error. It is
+         unsettled by any other transition. This is only accessed while holding the state lock.
+     */
+    BOOL _settled;
+
+    /*!
+     @abstract The condition that threads waiting for the task to settle block on.
+     @discussion This is created the first time a thread waits, so that tasks nobody waits for don’t
+         pay for it. The pointer is only accessed while holding the state lock.
+     */
+    NSCondition *_settledCondition;
+
+    /*!
+     @abstract The number of times the task has finished with a result that differs from its previous one.
+     @discussion Versions only increase, so the sum of a task’s prerequisites’ versions changes if and
+         only if at least one of their results changed. This is how invalidated tasks decide whether
+         they need to execute again. See ‑invalidate.
+     */
+    _Atomic(uint64_t) _resultVersion;
+
+    /*!
+     The sum of the task’s prerequisites’ result versions when the task was invalidated. Like the
+     flags below, this is written when the task is invalidated or finishes and read on whichever
+     thread starts it next, so it is atomic.
+     */
+    _Atomic(uint64_t) _prerequisiteResultVersionSum;
+
+    /*! Whether the task has been invalidated and has not finished since. */
+    atomic_bool _hasPreviousResult;
+
+    /*!
+     Whether the task was invalidated because one of its prerequisites was and can finish with its
+     previous result if none of its prerequisites’ results change.
+     */
+    atomic_bool _canReusePreviousResult;
+}
 
 @property (nonatomic, weak, readwrite, nullable) TSKWorkflow *workflow;
+@property (nonatomic, assign) NSUInteger workflowNodeIndex;
 
 @property (nonatomic, strong, readwrite) NSDate *finishDate;
 @property (nonatomic, strong, readwrite) NSError *error;
 @property (nonatomic, strong, readwrite) id result;
 
-/*!
- @abstract A dispatch queue to control changes to task state.
- @discussion This queue is only used within ‑transitionFromStateInSet:toState:andExecuteBlock: to 
-     perform data synchronization.
- */
-@property (nonatomic, strong, readonly) dispatch_queue_t stateQueue;
+/*! The task’s result from before it was invalidated. This is only set while the task is invalidated. */
+@property (atomic, strong, nullable) id previousResult;
 
 /*!
  @abstract If the task’s state is in the specified set of from-states, transitions to the specified
@@ -99,23 +232,173 @@ NSString *const TSKTaskStateDescription(TSKTaskState state)
 - (void)transitionFromState:(TSKTaskState)fromState toState:(TSKTaskState)toState andExecuteBlock:(void (^)(void))block;
 
 /*!
- @abstract Returns whether all the task’s prerequisite tasks have finished successfully.
- @result Whether all the task’s prerequisite tasks have finished successfully.
+ @abstract Returns the combined status of the task’s prerequisite tasks.
+ @discussion A prerequisite counts as skipped if it is in the skipped state or if it is a
+     conditional prerequisite whose result does not satisfy its condition.
+ @result TSKPrerequisiteStatusSkipped if any prerequisite is skipped and the task does not run when
+     its prerequisites are skipped; otherwise, TSKPrerequisiteStatusSatisfied if all prerequisites
+     have finished or been skipped; otherwise, TSKPrerequisiteStatusUnfinished.
+ */
+- (TSKPrerequisiteStatus)prerequisiteStatus;
+
+/*!
+ @abstract If the task’s state is in the specified set of from-states, transitions to the skipped
+     state and informs observers and the workflow.
+ @discussion This does not skip the task’s dependents. See ‑skipDependentTasks.
+ @param validFromStates The set of states from which the task can be skipped.
+ @result Whether the task was skipped.
+ */
+- (BOOL)transitionToSkippedStateFromStateInSet:(NSSet *)validFromStates;
+
+/*!
+ @abstract Skips the pending tasks that depend on the task, directly or indirectly, and starts those
+     that run when their prerequisites are skipped.
+ @discussion This works through the affected tasks iteratively, so each task and prerequisite
+     relationship is visited at most once regardless of the workflow’s depth.
+ */
+- (void)skipDependentTasks;
+
+/*!
+ @abstract Returns the task’s dependent tasks in an array.
+ @discussion This is used when propagating state changes to the task’s dependents, as it is cheaper
+     than building the set returned by ‑dependentTasks.
+ @result An array containing the task’s dependent tasks.
+ */
+- (NSArray<TSKTask *> *)dependentTaskArray;
+
+/*!
+ @abstract Returns the error the task should fail with because it cannot meet its deadline.
+ @result An error whose code is TSKErrorCodeDeadlineCannotBeMet, or nil if the task has no deadline
+     or can still meet it.
+ */
+- (nullable NSError *)deadlineError;
+
+/*!
+ @abstract Returns the sum of the result versions of the task’s prerequisites.
+ @result The sum of the result versions of the task’s prerequisites.
  */
-- (BOOL)allPrerequisiteTasksFinished;
+- (uint64_t)prerequisiteResultVersionSum;
 
 /*!
- @abstract If all the task’s prerequisite tasks have finished successfully, transitions from
-     pending to ready and executes the specified block.
- @param block The block to execute after successfully transitioning to the ready state.
+ @abstract If the task is finished, puts it into the pending state, saves its result as its
+     previous result, and does the same to its finished dependents.
+ @param canReusePreviousResult Whether the task may finish with its previous result without
+     executing if its prerequisites’ results do not change.
+ @result Whether the task was invalidated.
  */
-- (void)transitionToReadyStateAndExecuteBlock:(void (^)(void))block;
+- (BOOL)invalidateAllowingReuseOfPreviousResult:(BOOL)canReusePreviousResult;
 
 /*!
- @abstract If all the task’s prerequisite tasks have finished successfully, transitions from 
-     pending to ready and starts the task.
+ @abstract Puts the task into the pending state if it is finished or skipped, or, if it is being
+     invalidated along with a prerequisite, if it is ready or executing.
+ @discussion Unlike ‑invalidateAllowingReuseOfPreviousResult:, this does not invalidate the task’s
+     dependents.
+ @param canReusePreviousResult Whether the task is being invalidated along with a prerequisite and may
+     finish with its previous result without executing if its prerequisites’ results do not change.
+ @result Whether the task was invalidated.
  */
-- (void)startIfReady;
+- (BOOL)invalidateTaskAllowingReuseOfPreviousResult:(BOOL)canReusePreviousResult;
+
+/*!
+ @abstract Finishes the task with its previous result if it is allowed to and none of its
+     prerequisites’ results have changed since it was invalidated.
+ @result Whether the task reused its previous result instead of executing.
+ */
+- (BOOL)finishWithPreviousResultIfPossible;
+
+/*!
+ @abstract Forgets the task’s previous result.
+ @discussion This should be invoked whenever an invalidated task finishes or is reset or retried.
+ */
+- (void)discardPreviousResult;
+
+/*!
+ @abstract Performs the work common to all of the ways the task can finish successfully.
+ @discussion This must only be invoked after the task has transitioned into the finished state.
+ @param result The task’s result.
+ @param resultChanged Whether the result differs from the task’s previous result. If YES, the
+     task’s result version is incremented.
+ */
+- (void)didTransitionToFinishedStateWithResult:(nullable id)result resultChanged:(BOOL)resultChanged;
+
+/*!
+ @abstract Enqueues the specified block to run on the task’s behalf.
+ @discussion The block runs on the task’s operation queue if it was explicitly set. Otherwise, the
+     task’s workflow decides where the block runs. See ‑[TSKWorkflow scheduleBlock:forTask:].
+ @param block The block to run.
+ */
+- (void)enqueueBlock:(void (^)(void))block;
+
+/*!
+ @abstract Schedules a speculative attempt of the task’s work, if its speculation policy calls for one.
+ @param execution The execution during which the attempt should run.
+ @param attempt The number of the attempt being scheduled, starting at 1.
+ */
+- (void)scheduleSpeculativeAttemptForExecution:(uint64_t)execution attempt:(NSUInteger)attempt;
+
+/*!
+ @abstract Returns whether the task is executing and has not started executing again since the
+     specified execution.
+ @param execution The execution.
+ @result Whether the task is still executing the specified execution.
+ */
+- (BOOL)isExecutingExecution:(uint64_t)execution;
+
+/*!
+ @abstract Arms a timer that fails the task if the specified execution outlasts the task’s timeout.
+ @discussion Does nothing if the task has no timeout.
+ @param execution The execution to time.
+ */
+- (void)armTimeoutTimerForExecution:(uint64_t)execution;
+
+/*!
+ @abstract Fails the task because its timeout elapsed during the specified execution.
+ @discussion Does nothing if the task is no longer executing that execution.
+ @param execution The execution that timed out.
+ */
+- (void)timeOutExecution:(uint64_t)execution;
+
+/*!
+ @abstract Puts the task back into the pending state to wait for a retry if its retry policy allows
+     another attempt after it failed with the specified error.
+ @param error The error the task failed with.
+ @result Whether the task scheduled a retry. If NO, the task should fail.
+ */
+- (BOOL)scheduleRetryAfterFailingWithError:(nullable NSError *)error;
+
+/*!
+ @abstract Arms a timer that restarts the task after the specified delay.
+ @discussion Does nothing if the task is no longer pending after the specified execution.
+ @param execution The execution that failed.
+ @param delay How long to wait before restarting the task.
+ */
+- (void)scheduleRetryForExecution:(uint64_t)execution afterDelay:(NSTimeInterval)delay;
+
+/*!
+ @abstract Restarts the task because the retry it scheduled after the specified execution is due.
+ @discussion Does nothing if the retry was cancelled.
+ @param execution The execution that failed.
+ */
+- (void)retryExecution:(uint64_t)execution;
+
+/*!
+ @abstract Cancels the retry the task is waiting for, if any.
+ @result Whether the task was waiting for a retry.
+ */
+- (BOOL)cancelScheduledRetry;
+
+/*! Returns whether the task is waiting for a retry scheduled by its retry policy. */
+- (BOOL)hasScheduledRetry;
+
+/*!
+ @abstract Marks the task as settled if it is still in the specified terminal state, and wakes
+     threads waiting for it.
+ @param state The terminal state the task transitioned into.
+ */
+- (void)settleInState:(TSKTaskState)state;
+
+/*! Returns whether the task has reached a terminal state and finished reporting it. */
+- (BOOL)isSettled;
 
 @end
 
@@ -124,6 +407,9 @@ NSString *const TSKTaskStateDescription(TSKTaskState state)
 
 @implementation TSKTask
 
+@synthesize name = _name;
+@synthesize result = _result;
+
 - (instancetype)init
 {
     return [self initWithName:nil];
@@ -136,8 +422,16 @@ NSString *const TSKTaskStateDescription(TSKTaskState state)
     if (self) {
         self.name = name;
         _state = TSKTaskStateReady;
-        NSString *stateQueueName = [NSString stringWithFormat:@"com.ticketmaster.TSKTask.%@.state", name];
-        _stateQueue = dispatch_queue_create([stateQueueName UTF8String], DISPATCH_QUEUE_SERIAL);
+        _stateLock = OS_UNFAIR_LOCK_INIT;
+        _resultLock = OS_UNFAIR_LOCK_INIT;
+        atomic_init(&_executionCount, 0);
+        atomic_init(&_speculativeAttemptCount, 0);
+        atomic_init(&_attemptCount, 0);
+        atomic_init(&_executionStartTime, 0);
+        atomic_init(&_resultVersion, 0);
+        atomic_init(&_prerequisiteResultVersionSum, 0);
+        atomic_init(&_hasPreviousResult, false);
+        atomic_init(&_canReusePreviousResult, false);
     }
 
     return self;
@@ -146,11 +440,56 @@ NSString *const TSKTaskStateDescription(TSKTaskState state)
 
 - (void)setName:(NSString *)name
 {
-    if (!name) {
-        name = [[NSString alloc] initWithFormat:@"TSKTask %p", self];
+    // Default names are generated when they’re read, as most tasks that have one never read it, and
+    // formatting it for each of a workflow’s tasks is a measurable part of creating them
+    _hasDefaultName = !name;
+    _name = [name copy];
+}
+
+
+- (NSString *)name
+{
+    return _hasDefaultName ? [[NSString alloc] initWithFormat:@"TSKTask %p", self] : _name;
+}
+
+
+- (BOOL)hasDefaultName
+{
+    return _hasDefaultName;
+}
+
+
+- (id)result
+{
+    os_unfair_lock_lock(&_resultLock);
+    id result = _result;
+    os_unfair_lock_unlock(&_resultLock);
+    return result;
+}
+
+
+- (void)setResult:(id)result
+{
+    // The old result is released when this returns, outside the lock, as releasing a large result can
+    // take a while
+    os_unfair_lock_lock(&_resultLock);
+    id oldResult = _result;
+    _result = result;
+    os_unfair_lock_unlock(&_resultLock);
+    (void)oldResult;
+}
+
+
+- (BOOL)replaceResult:(id)result withResult:(id)replacement
+{
+    os_unfair_lock_lock(&_resultLock);
+    BOOL shouldReplace = _result == result;
+    if (shouldReplace) {
+        _result = replacement;
     }
+    os_unfair_lock_unlock(&_resultLock);
 
-    _name = [name copy];
+    return shouldReplace;
 }
 
 
@@ -221,9 +560,22 @@ NSString *const TSKTaskStateDescription(TSKTaskState state)
 }
 
 
+- (NSArray<TSKTask *> *)dependentTaskArray
+{
+    TSKWorkflow *workflow = self.workflow;
+    return workflow ? [workflow dependentTaskArrayForTask:self] : @[];
+}
+
+
 - (NSOperationQueue *)operationQueue
 {
-    return _operationQueue ? _operationQueue : self.workflow.operationQueue;
+    if (_operationQueue) {
+        return _operationQueue;
+    }
+
+    TSKWorkflow *workflow = self.workflow;
+    TSKExecutionClass executionClass = self.executionClass;
+    return [workflow operationQueueForExecutionClass:executionClass ? executionClass : workflow.executionClass];
 }
 
 
@@ -232,12 +584,11 @@ NSString *const TSKTaskStateDescription(TSKTaskState state)
 + (BOOL)automaticallyNotifiesObserversOfState
 {
     // This avoids a deadlock condition in ‑transitionFromStateInSet:toState:andExecuteBlock: in which
-    // the stateQueue is in use, but KVO observers are notified of the change before the state transition
-    // block exits the queue. This is a problem when, e.g., upon task failure, a KVO observer is notified
+    // the stateLock is held, but KVO observers are notified of the change before the state transition
+    // releases the lock. This is a problem when, e.g., upon task failure, a KVO observer is notified
     // on the same thread as the aforementioned method. If the KVO observer immediately sends the task
     // ‑retry, that message will result in ‑transitionFromStateInSet:toState:andExecuteBlock: being
-    // invoked again before the block from the original invocation exits the stateQueue, thus resulting
-    // in deadlock.
+    // invoked again before the original invocation releases the stateLock, thus resulting in deadlock.
     return NO;
 }
 
@@ -247,7 +598,7 @@ NSString *const TSKTaskStateDescription(TSKTaskState state)
     static NSSet *stateKeys = nil;
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
-        stateKeys = [NSSet setWithObjects:@"ready", @"executing", @"cancelled", @"finished", @"failed", nil];
+        stateKeys = [NSSet setWithObjects:@"ready", @"executing", @"cancelled", @"finished", @"failed", @"skipped", nil];
     });
 
     return [stateKeys containsObject:key] ? [NSSet setWithObject:@"state"] : [super keyPathsForValuesAffectingValueForKey:key];
@@ -284,6 +635,21 @@ NSString *const TSKTaskStateDescription(TSKTaskState state)
 }
 
 
+- (BOOL)isSkipped
+{
+    return self.state == TSKTaskStateSkipped;
+}
+
+
+- (TSKCancellationToken *)cancellationToken
+{
+    os_unfair_lock_lock(&_stateLock);
+    TSKCancellationToken *cancellationToken = _cancellationToken;
+    os_unfair_lock_unlock(&_stateLock);
+    return cancellationToken;
+}
+
+
 - (void)transitionFromStateInSet:(NSSet *)validFromStates toState:(TSKTaskState)toState andExecuteBlock:(void (^)(void))block
 {
     NSParameterAssert(validFromStates);
@@ -291,52 +657,158 @@ NSString *const TSKTaskStateDescription(TSKTaskState state)
     // State transitions:
     //     Pending -> Ready: All of task’s prerequisite tasks are finished (-transitionToReadyStateAndExecuteBlock:)
     //     Pending -> Cancelled: Task is cancelled (-cancel)
+    //     Pending -> Skipped: Task is skipped (-skip) or one of its prerequisites is skipped (-startIfReady)
     //
     //     Ready -> Pending: Task is added to a workflow with at least one prerequisite task (-didAddPrerequisiteTask),
     //                       or Task is reset (-reset) and has an unfinished prerequisite (because the prerequisite
-    //                       also received -reset)
+    //                       also received -reset), or one of Task’s prerequisites is invalidated (-invalidate)
     //     Ready -> Executing: Task starts (-start)
     //     Ready -> Cancelled: Task is cancelled (-cancel)
+    //     Ready -> Finished: Task was invalidated along with a prerequisite (-invalidate) and none of its
+    //                        prerequisites’ results changed
+    //     Ready -> Skipped: Task is skipped (-skip)
     //
-    //     Executing -> Pending: Task is reset (-reset)
+    //     Executing -> Pending: Task is reset (-reset), fails and its retry policy schedules a retry
+    //                           (-failWithError:), or one of its prerequisites is invalidated (-invalidate)
     //     Executing -> Cancelled: Task is cancelled (-cancel)
     //     Executing -> Finished: Task finishes (-finishWithResult:)
     //     Executing -> Failed: Task fails (-failWithError:)
+    //     Executing -> Skipped: Task is skipped (-skip)
+    //
+    //     Every transition out of Executing except to Finished cancels the execution’s cancellation token.
+    //     Executing -> Finished also cancels it if a speculative attempt started, so that the attempts
+    //     that lost stop their work.
+    //     Every transition out of Executing disarms the execution’s timeout timer, and every transition
+    //     out of Pending disarms the timer for a scheduled retry.
     //
     //     Cancelled -> Pending: Task is retried (-retry) or reset (-reset)
     //
-    //     Finished -> Pending: Task is reset (-reset)
+    //     Finished -> Pending: Task is reset (-reset) or invalidated (-invalidate)
     //
     //     Failed -> Pending: Task is retried (-retry) or reset (-reset)
+    //
+    //     Skipped -> Pending: Task is reset (-reset) or invalidated (-invalidate)
 
-    __block BOOL didTransition = NO;
-    dispatch_sync(self.stateQueue, ^{
-        // If the current state is not in the set of valid from-states, we have nothing to do
-        if (![validFromStates containsObject:@(self.state)]) {
-            return;
+    // Each execution gets a new cancellation token. We create it before taking the lock to keep the
+    // critical section short.
+    TSKCancellationToken *executionToken = nil;
+    if (toState == TSKTaskStateExecuting) {
+        executionToken = [[TSKCancellationToken alloc] initWithParentToken:self.workflow.cancellationToken];
+    }
+
+    BOOL didTransition = NO;
+    TSKCancellationToken *replacedToken = nil;
+    TSKCancellationToken *cancelledToken = nil;
+    TSKTimerWheelTimer *disarmedTimer = nil;
+    os_unfair_lock_lock(&_stateLock);
+
+    // If the current state is in the set of valid from-states and differs from the to-state, change the
+    // state. We should avoid triggering KVO notifications. See the explanatory comments in
+    // +automaticallyNotifiesObserversOfState.
+    TSKTaskState fromState = _state;
+    if (fromState != toState && [validFromStates containsObject:@(fromState)]) {
+        [self willChangeValueForKey:@"state"];
+        _state = toState;
+        _settled = NO;
+        didTransition = YES;
+
+        // The replaced token is released after the lock is unlocked
+        if (executionToken) {
+            replacedToken = _cancellationToken;
+            _cancellationToken = executionToken;
+        } else if (fromState == TSKTaskStateExecuting &&
+                   (toState != TSKTaskStateFinished || atomic_load(&_speculativeAttemptCount) > 0)) {
+            cancelledToken = _cancellationToken;
         }
 
-        // Otherwise, if the from-state and the to-state differ, change the state. We should avoid triggering
-        // KVO notifications. See the explanatory comments in +automaticallyNotifiesObserversOfState.
-        TSKTaskState fromState = self.state;
-        if (fromState != toState) {
-            [self willChangeValueForKey:@"state"];
-            _state = toState;
-            didTransition = YES;
+        // Timers are disarmed after the lock is unlocked
+        if (fromState == TSKTaskStateExecuting) {
+            disarmedTimer = _timeoutTimer;
+            _timeoutTimer = nil;
+        } else if (fromState == TSKTaskStatePending) {
+            disarmedTimer = _retryTimer;
+            _retryTimer = nil;
         }
-    });
+
+        // Recording while holding the lock keeps the recorded transitions in the order they happened
+        TSKFlightRecorderRecordEvent(TSKFlightRecorderEventTypeStateTransition, (__bridge void *)self, fromState, toState);
+    }
+
+    os_unfair_lock_unlock(&_stateLock);
+
+    if (disarmedTimer) {
+        [[TSKTimerWheel sharedTimerWheel] disarmTimer:disarmedTimer];
+    }
 
     if (didTransition) {
+        // Cancellation handlers run first so that work is aborted as soon as possible
+        [cancelledToken cancel];
         [self didChangeValueForKey:@"state"];
+        [self.workflow subtaskDidChangeState:self];
 
         // Only once all KVO notifications have fired should we execute the block
         if (block) {
             block();
         }
+
+        if (TSKTaskStateIsTerminal(toState)) {
+            [self settleInState:toState];
+        }
     }
 }
 
 
+- (void)settleInState:(TSKTaskState)state
+{
+    os_unfair_lock_lock(&_stateLock);
+    NSCondition *settledCondition = nil;
+    if (_state == state) {
+        _settled = YES;
+        settledCondition = _settledCondition;
+    }
+    os_unfair_lock_unlock(&_stateLock);
+
+    // Taking the condition’s lock ensures that a waiter either saw that we were settled or is
+    // already waiting and will receive the broadcast
+    [settledCondition lock];
+    [settledCondition broadcast];
+    [settledCondition unlock];
+}
+
+
+- (BOOL)isSettled
+{
+    os_unfair_lock_lock(&_stateLock);
+    BOOL settled = _settled;
+    os_unfair_lock_unlock(&_stateLock);
+    return settled;
+}
+
+
+- (TSKTaskState)waitUntilFinishedWithTimeout:(NSTimeInterval)timeout
+{
+    NSDate *limitDate = [NSDate dateWithTimeIntervalSinceNow:MAX(timeout, 0)];
+
+    os_unfair_lock_lock(&_stateLock);
+    if (!_settledCondition) {
+        _settledCondition = [[NSCondition alloc] init];
+    }
+
+    NSCondition *settledCondition = _settledCondition;
+    os_unfair_lock_unlock(&_stateLock);
+
+    [settledCondition lock];
+    while (![self isSettled]) {
+        if (![settledCondition waitUntilDate:limitDate]) {
+            break;
+        }
+    }
+    [settledCondition unlock];
+
+    return self.state;
+}
+
+
 - (void)transitionFromState:(TSKTaskState)fromState toState:(TSKTaskState)toState andExecuteBlock:(void (^)(void))block
 {
     [self transitionFromStateInSet:[NSSet setWithObject:@(fromState)] toState:toState andExecuteBlock:block];
@@ -345,9 +817,7 @@ NSString *const TSKTaskStateDescription(TSKTaskState state)
 
 - (void)didAddPrerequisiteTask
 {
-    if (![self allPrerequisiteTasksFinished]) {
-        [self transitionFromState:TSKTaskStateReady toState:TSKTaskStatePending andExecuteBlock:nil];
-    }
+    [self transitionFromState:TSKTaskStateReady toState:TSKTaskStatePending andExecuteBlock:nil];
 }
 
 
@@ -373,30 +843,335 @@ NSString *const TSKTaskStateDescription(TSKTaskState state)
     // task has already been marked cancelled. This shouldn’t be an issue, since ‑main should be
     // checking if the task is cancelled and exiting as soon as possible, but that’s not always
     // possible. Doing the check inside the operation’s block before invoking ‑main avoids that.
-    [self.operationQueue addOperationWithBlock:^{
+    //
+    // Invalidated tasks that can reuse their previous results also finish from the operation’s block.
+    // Finishing starts the task’s dependents, so doing it synchronously would recurse once per task
+    // along a chain of unchanged results.
+    [self enqueueBlock:^{
+        if ([self finishWithPreviousResultIfPossible]) {
+            return;
+        }
+
         [self transitionFromState:TSKTaskStateReady toState:TSKTaskStateExecuting andExecuteBlock:^{
+            atomic_store(&self->_executionStartTime, [NSProcessInfo processInfo].systemUptime);
+            atomic_store(&self->_speculativeAttemptCount, 0);
+            atomic_fetch_add(&self->_attemptCount, 1);
+            uint64_t execution = atomic_fetch_add(&self->_executionCount, 1) + 1;
+            [self.workflow.metrics incrementCounter:TSKMetricsCounterTasksStarted];
+
             [self.workflow.notificationCenter postNotificationName:TSKTaskDidStartNotification object:self];
+
+            NSError *startError = [self.workflow timeoutError] ?: [self deadlineError];
+            if (startError) {
+                [self failWithError:startError];
+                return;
+            }
+
+            [self armTimeoutTimerForExecution:execution];
+            [self scheduleSpeculativeAttemptForExecution:execution attempt:1];
             [self main];
         }];
     }];
 }
 
 
-- (BOOL)allPrerequisiteTasksFinished
+- (void)enqueueBlock:(void (^)(void))block
 {
-    for (TSKTask *task in self.prerequisiteTasks) {
-        if (!task.isFinished) {
-            return NO;
+    NSOperationQueue *operationQueue = _operationQueue;
+    TSKWorkflow *workflow = self.workflow;
+
+    // Recording both when the block is enqueued and when it starts running lets the flight recorder
+    // and metrics show how long the task’s work waited
+    const void *taskAddress = (__bridge void *)self;
+    TSKMetrics *metrics = workflow ? workflow.metrics : [TSKMetrics sharedMetrics];
+    uint64_t enqueueTime = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+    void (^recordedBlock)(void) = ^{
+        TSKFlightRecorderRecordEvent(TSKFlightRecorderEventTypeDequeue, taskAddress, 0, 0);
+        [metrics addToReadyQueueDepth:-1];
+        [metrics recordNanoseconds:clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - enqueueTime forLatency:TSKMetricsLatencyQueueWait];
+        block();
+    };
+
+    TSKFlightRecorderRecordEvent(TSKFlightRecorderEventTypeEnqueue, taskAddress, 0, 0);
+    [metrics addToReadyQueueDepth:1];
+
+    // An explicitly set operation queue takes precedence over anything the workflow would choose
+    if (!operationQueue && workflow) {
+        [workflow scheduleBlock:recordedBlock forTask:self];
+    } else {
+        [operationQueue addOperationWithBlock:recordedBlock];
+    }
+}
+
+
+- (NSDate *)effectiveDeadline
+{
+    NSDate *deadline = self.deadline;
+    return deadline ? deadline : self.workflow.deadline;
+}
+
+
+- (NSError *)deadlineError
+{
+    NSDate *deadline = self.effectiveDeadline;
+    if (!deadline) {
+        return nil;
+    }
+
+    NSTimeInterval remainingTime = deadline.timeIntervalSinceNow;
+    if (remainingTime > 0) {
+        // Without a histogram of its own, the task uses the durations recorded for tasks with its name.
+        // Histograms return a negative duration when they’re empty.
+        TSKDurationHistogram *durationHistogram = self.durationHistogram;
+        if (!durationHistogram && !_hasDefaultName) {
+            durationHistogram = [self.workflow.durationStatistics existingHistogramForTaskName:self.name];
         }
+
+        NSTimeInterval expectedDuration = durationHistogram ? [durationHistogram durationAtPercentile:0.5] : -1;
+        if (expectedDuration <= remainingTime) {
+            return nil;
+        }
+    }
+
+    NSString *description = remainingTime > 0 ? @"Task’s expected duration exceeds the time remaining before its deadline"
+                                               : @"Task’s deadline passed before it could start";
+    return [NSError errorWithDomain:TSKTaskErrorDomain
+                               code:TSKErrorCodeDeadlineCannotBeMet
+                           userInfo:@{ NSLocalizedDescriptionKey : description }];
+}
+
+
+#pragma mark - Timeouts
+
+- (void)armTimeoutTimerForExecution:(uint64_t)execution
+{
+    NSTimeInterval timeout = self.timeout;
+    if (timeout <= 0) {
+        return;
+    }
+
+    __weak typeof(self) weakSelf = self;
+    TSKTimerWheelTimer *timer = [[TSKTimerWheel sharedTimerWheel] armTimerWithInterval:timeout handler:^{
+        [weakSelf timeOutExecution:execution];
+    }];
+
+    // If the task stopped executing while we were arming the timer, nothing will disarm it, so we
+    // have to do it ourselves
+    os_unfair_lock_lock(&_stateLock);
+    BOOL isStillExecuting = _state == TSKTaskStateExecuting && atomic_load(&_executionCount) == execution;
+    if (isStillExecuting) {
+        _timeoutTimer = timer;
+    }
+    os_unfair_lock_unlock(&_stateLock);
+
+    if (!isStillExecuting) {
+        [[TSKTimerWheel sharedTimerWheel] disarmTimer:timer];
+    }
+}
+
+
+- (void)timeOutExecution:(uint64_t)execution
+{
+    if (![self isExecutingExecution:execution]) {
+        return;
+    }
+
+    [self failWithError:[NSError errorWithDomain:TSKTaskErrorDomain
+                                            code:TSKErrorCodeTimedOut
+                                        userInfo:@{ NSLocalizedDescriptionKey : @"Task’s timeout elapsed before it finished" }]];
+}
+
+
+#pragma mark - Retry Policies
+
+- (NSUInteger)attemptCount
+{
+    return atomic_load(&_attemptCount);
+}
+
+
+- (BOOL)scheduleRetryAfterFailingWithError:(NSError *)error
+{
+    TSKRetryPolicy *retryPolicy = self.retryPolicy ?: self.workflow.retryPolicy;
+    if (!retryPolicy) {
+        return NO;
+    }
+
+    // Deadlines only get closer, and tasks can’t start once their workflow’s timeout elapses, so
+    // retrying after either would just fail again. Errors are matched by domain and code rather than
+    // by identity, since subclasses may fail with their own deadline errors.
+    BOOL isDeadlineError = [error.domain isEqualToString:TSKTaskErrorDomain] && error.code == TSKErrorCodeDeadlineCannotBeMet;
+    if (isDeadlineError || [self.workflow timeoutError]) {
+        return NO;
+    }
+
+    NSUInteger attemptCount = self.attemptCount;
+    if (![retryPolicy shouldRetryAfterAttemptCount:attemptCount error:error]) {
+        return NO;
     }
 
+    uint64_t execution = atomic_load(&_executionCount);
+    __block BOOL didScheduleRetry = NO;
+    [self transitionFromState:TSKTaskStateExecuting toState:TSKTaskStatePending andExecuteBlock:^{
+        didScheduleRetry = YES;
+        [self scheduleRetryForExecution:execution afterDelay:[retryPolicy delayAfterAttemptCount:attemptCount]];
+        [self.workflow.notificationCenter postNotificationName:TSKTaskDidScheduleRetryNotification object:self];
+    }];
+
+    return didScheduleRetry;
+}
+
+
+- (void)scheduleRetryForExecution:(uint64_t)execution afterDelay:(NSTimeInterval)delay
+{
+    // The timer is armed while holding the lock so that it is recorded before its handler can look
+    // for it, and so that it is never armed after the task has stopped waiting for it
+    __weak typeof(self) weakSelf = self;
+    os_unfair_lock_lock(&_stateLock);
+    if (_state == TSKTaskStatePending && atomic_load(&_executionCount) == execution) {
+        _retryTimer = [[TSKTimerWheel sharedTimerWheel] armTimerWithInterval:delay handler:^{
+            [weakSelf retryExecution:execution];
+        }];
+    }
+    os_unfair_lock_unlock(&_stateLock);
+}
+
+
+- (void)retryExecution:(uint64_t)execution
+{
+    os_unfair_lock_lock(&_stateLock);
+    BOOL isRetryDue = _retryTimer && _state == TSKTaskStatePending && atomic_load(&_executionCount) == execution;
+    if (isRetryDue) {
+        _retryTimer = nil;
+    }
+    os_unfair_lock_unlock(&_stateLock);
+
+    if (!isRetryDue) {
+        return;
+    }
+
+    [self.workflow.metrics incrementCounter:TSKMetricsCounterTasksRetried];
+    [self didRetry];
+    [self.workflow.notificationCenter postNotificationName:TSKTaskDidRetryNotification object:self];
+    [self startIfReady];
+}
+
+
+- (BOOL)cancelScheduledRetry
+{
+    os_unfair_lock_lock(&_stateLock);
+    TSKTimerWheelTimer *retryTimer = _retryTimer;
+    _retryTimer = nil;
+    os_unfair_lock_unlock(&_stateLock);
+
+    if (!retryTimer) {
+        return NO;
+    }
+
+    [[TSKTimerWheel sharedTimerWheel] disarmTimer:retryTimer];
     return YES;
 }
 
 
+- (BOOL)hasScheduledRetry
+{
+    os_unfair_lock_lock(&_stateLock);
+    BOOL hasScheduledRetry = _retryTimer != nil;
+    os_unfair_lock_unlock(&_stateLock);
+    return hasScheduledRetry;
+}
+
+
+#pragma mark - Speculation
+
+- (NSUInteger)speculativeAttemptCount
+{
+    return atomic_load(&_speculativeAttemptCount);
+}
+
+
+- (BOOL)isExecutingExecution:(uint64_t)execution
+{
+    return self.isExecuting && atomic_load(&_executionCount) == execution;
+}
+
+
+- (void)scheduleSpeculativeAttemptForExecution:(uint64_t)execution attempt:(NSUInteger)attempt
+{
+    TSKSpeculationPolicy *policy = self.speculationPolicy;
+    if (!policy || attempt > policy.maximumSpeculativeAttemptCount) {
+        return;
+    }
+
+    NSTimeInterval delay = policy.speculationDelay;
+    if (delay < 0) {
+        return;
+    }
+
+    // We only hold a weak reference until the attempt is due so that a pending attempt does not keep
+    // a task alive after its workflow is gone
+    __weak typeof(self) weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        TSKTask *task = weakSelf;
+        if (![task isExecutingExecution:execution]) {
+            return;
+        }
+
+        [task enqueueBlock:^{
+            // As in ‑start, check the task’s state when the operation begins executing, since the
+            // original attempt may have finished while the operation was enqueued
+            // We count the attempt before checking so that a winning attempt that finishes between the
+            // check and ‑main still cancels the token this attempt runs with. Counting an attempt that
+            // then does not run at worst cancels the token of an execution that already finished.
+            atomic_fetch_add(&task->_speculativeAttemptCount, 1);
+            if (![task isExecutingExecution:execution]) {
+                return;
+            }
+
+            [task scheduleSpeculativeAttemptForExecution:execution attempt:attempt + 1];
+            [task main];
+        }];
+    });
+}
+
+
+- (TSKPrerequisiteStatus)prerequisiteStatus
+{
+    TSKWorkflow *workflow = self.workflow;
+    if (!workflow) {
+        return TSKPrerequisiteStatusSatisfied;
+    }
+
+    TSKChannel *inputChannel = self.inputChannel;
+    BOOL runsWhenPrerequisitesSkipped = self.runsWhenPrerequisitesSkipped;
+    __block TSKPrerequisiteStatus status = TSKPrerequisiteStatusSatisfied;
+    [workflow enumeratePrerequisiteTasksOfTask:self usingBlock:^(TSKTask *prerequisiteTask, BOOL (^condition)(id), BOOL *stop) {
+        BOOL prerequisiteSkipped = NO;
+        if (prerequisiteTask.isFinished) {
+            prerequisiteSkipped = condition && !condition(prerequisiteTask.result);
+        } else if (prerequisiteTask.isSkipped) {
+            prerequisiteSkipped = YES;
+        } else if (!(inputChannel && prerequisiteTask.outputChannel == inputChannel &&
+                     prerequisiteTask.isExecuting && inputChannel.hasSentItem)) {
+            // A streaming prerequisite is satisfied as soon as it has sent an item while executing.
+            // Other unfinished prerequisites only matter if none of the rest cause the task to be skipped.
+            status = TSKPrerequisiteStatusUnfinished;
+            return;
+        }
+
+        if (prerequisiteSkipped && !runsWhenPrerequisitesSkipped) {
+            status = TSKPrerequisiteStatusSkipped;
+            *stop = YES;
+        }
+    }];
+
+    return status;
+}
+
+
 - (void)transitionToReadyStateAndExecuteBlock:(void (^)(void))block
 {
-    if ([self allPrerequisiteTasksFinished]) {
+    if ([self prerequisiteStatus] == TSKPrerequisiteStatusSatisfied) {
         [self transitionFromState:TSKTaskStatePending toState:TSKTaskStateReady andExecuteBlock:block];
     }
 }
@@ -404,9 +1179,34 @@ NSString *const TSKTaskStateDescription(TSKTaskState state)
 
 - (void)startIfReady
 {
-    [self transitionToReadyStateAndExecuteBlock:^{
-        [self start];
-    }];
+    static NSSet *skippableStates = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        skippableStates = [[NSSet alloc] initWithObjects:@(TSKTaskStatePending), nil];
+    });
+
+    // Tasks waiting for a scheduled retry are restarted when it is due
+    if ([self hasScheduledRetry]) {
+        return;
+    }
+
+    switch ([self prerequisiteStatus]) {
+        case TSKPrerequisiteStatusSatisfied:
+            [self transitionFromState:TSKTaskStatePending toState:TSKTaskStateReady andExecuteBlock:^{
+                // Tasks that the workflow’s targets don’t need stay ready until the whole workflow is started
+                if ([self.workflow needsTask:self]) {
+                    [self start];
+                }
+            }];
+            break;
+        case TSKPrerequisiteStatusSkipped:
+            if ([self transitionToSkippedStateFromStateInSet:skippableStates]) {
+                [self skipDependentTasks];
+            }
+            break;
+        case TSKPrerequisiteStatusUnfinished:
+            break;
+    }
 }
 
 
@@ -419,6 +1219,9 @@ NSString *const TSKTaskStateDescription(TSKTaskState state)
     });
 
     [self transitionFromStateInSet:fromStates toState:TSKTaskStateCancelled andExecuteBlock:^{
+        [self.workflow.metrics incrementCounter:TSKMetricsCounterTasksCancelled];
+        [self.inputChannel close];
+        [self.outputChannel close];
         [self didCancel];
 
         if ([self.delegate respondsToSelector:@selector(taskDidCancel:)]) {
@@ -429,7 +1232,7 @@ NSString *const TSKTaskStateDescription(TSKTaskState state)
         [self.workflow subtaskDidCancel:self];
     }];
     
-    [self.dependentTasks makeObjectsPerformSelector:@selector(cancel)];
+    [self.dependentTaskArray makeObjectsPerformSelector:@selector(cancel)];
 }
 
 
@@ -444,13 +1247,24 @@ NSString *const TSKTaskStateDescription(TSKTaskState state)
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
         fromStates = [[NSSet alloc] initWithArray:@[ @(TSKTaskStateReady), @(TSKTaskStateExecuting), @(TSKTaskStateFinished),
-                                                     @(TSKTaskStateFailed), @(TSKTaskStateCancelled) ]];
+                                                     @(TSKTaskStateFailed), @(TSKTaskStateCancelled), @(TSKTaskStateSkipped) ]];
     });
 
+    // A task waiting for a scheduled retry is already pending, so the transition below doesn’t apply
+    // to it. It just stops waiting.
+    if ([self cancelScheduledRetry]) {
+        atomic_store(&_attemptCount, 0);
+        [self transitionToReadyStateAndExecuteBlock:nil];
+    }
+
+    __block BOOL didReset = NO;
     [self transitionFromStateInSet:fromStates toState:TSKTaskStatePending andExecuteBlock:^{
+        didReset = YES;
         self.finishDate = nil;
         self.result = nil;
         self.error = nil;
+        atomic_store(&self->_attemptCount, 0);
+        [self discardPreviousResult];
 
         [self didReset];
 
@@ -459,7 +1273,14 @@ NSString *const TSKTaskStateDescription(TSKTaskState state)
         [self transitionToReadyStateAndExecuteBlock:nil];
     }];
 
-    [self.dependentTasks makeObjectsPerformSelector:@selector(reset)];
+    [self.dependentTaskArray makeObjectsPerformSelector:@selector(reset)];
+
+    // Reopening the output channel wakes a consumer that is blocked receiving from it. We wait until
+    // the consumer has been reset so that it sees it is no longer executing instead of mistaking the
+    // wake-up for the end of the stream.
+    if (didReset) {
+        [self.outputChannel reopen];
+    }
 }
 
 
@@ -480,6 +1301,14 @@ NSString *const TSKTaskStateDescription(TSKTaskState state)
         self.finishDate = nil;
         self.result = nil;
         self.error = nil;
+        atomic_store(&self->_attemptCount, 0);
+        [self discardPreviousResult];
+
+        [self.workflow.metrics incrementCounter:TSKMetricsCounterTasksRetried];
+
+        // The channel was closed when the task failed or was cancelled, so the consumer is no longer
+        // blocked on it. It must be reopened before the task starts sending again.
+        [self.outputChannel reopen];
 
         [self didRetry];
 
@@ -487,7 +1316,7 @@ NSString *const TSKTaskStateDescription(TSKTaskState state)
         [self startIfReady];
     }];
 
-    [self.dependentTasks makeObjectsPerformSelector:@selector(retry)];
+    [self.dependentTaskArray makeObjectsPerformSelector:@selector(retry)];
 }
 
 
@@ -496,25 +1325,124 @@ NSString *const TSKTaskStateDescription(TSKTaskState state)
 }
 
 
+#pragma mark - Skipping
+
+- (void)skip
+{
+    static NSSet *fromStates = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        fromStates = [[NSSet alloc] initWithObjects:@(TSKTaskStatePending), @(TSKTaskStateReady), @(TSKTaskStateExecuting), nil];
+    });
+
+    if ([self transitionToSkippedStateFromStateInSet:fromStates]) {
+        [self skipDependentTasks];
+    }
+}
+
+
+- (BOOL)transitionToSkippedStateFromStateInSet:(NSSet *)validFromStates
+{
+    __block BOOL didSkip = NO;
+    [self transitionFromStateInSet:validFromStates toState:TSKTaskStateSkipped andExecuteBlock:^{
+        didSkip = YES;
+        [self discardPreviousResult];
+
+        [self.inputChannel close];
+        [self.outputChannel close];
+
+        [self.workflow.notificationCenter postNotificationName:TSKTaskDidSkipNotification object:self];
+        [self.workflow subtaskDidSkip:self];
+    }];
+
+    return didSkip;
+}
+
+
+- (void)skipDependentTasks
+{
+    static NSSet *skippableStates = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        skippableStates = [[NSSet alloc] initWithObjects:@(TSKTaskStatePending), nil];
+    });
+
+    // Skipped tasks are appended as they are skipped. Because a task only transitions into the skipped
+    // state once, each task’s dependents are visited once, no matter how many paths lead to it.
+    NSMutableArray<TSKTask *> *skippedTasks = [[NSMutableArray alloc] initWithObjects:self, nil];
+    for (NSUInteger i = 0; i < skippedTasks.count; ++i) {
+        for (TSKTask *dependentTask in skippedTasks[i].dependentTaskArray) {
+            if (dependentTask.runsWhenPrerequisitesSkipped) {
+                [dependentTask startIfReady];
+            } else if ([dependentTask transitionToSkippedStateFromStateInSet:skippableStates]) {
+                [skippedTasks addObject:dependentTask];
+            }
+        }
+    }
+}
+
+
 - (void)finishWithResult:(id)result
 {
     [self transitionFromState:TSKTaskStateExecuting toState:TSKTaskStateFinished andExecuteBlock:^{
-        self.finishDate = [NSDate date];
-        self.result = result;
+        NSTimeInterval duration = [NSProcessInfo processInfo].systemUptime - atomic_load(&self->_executionStartTime);
+        [self.speculationPolicy.durationHistogram recordDuration:duration];
+        [self.durationHistogram recordDuration:duration];
+        if (!self->_hasDefaultName) {
+            [self.workflow.durationStatistics recordDuration:duration forTaskName:self.name];
+        }
 
-        [self didFinishWithResult:result];
+        TSKMetrics *metrics = self.workflow.metrics;
+        [metrics incrementCounter:TSKMetricsCounterTasksFinished];
+        [metrics recordNanoseconds:(uint64_t)(MAX(duration, 0) * NSEC_PER_SEC) forLatency:TSKMetricsLatencyExecution];
 
-        if ([self.delegate respondsToSelector:@selector(task:didFinishWithResult:)]) {
-            [self.delegate task:self didFinishWithResult:result];
+        // Results are assumed to change unless the task was invalidated and its test says otherwise
+        BOOL resultChanged = YES;
+        if (atomic_load(&self->_hasPreviousResult)) {
+            BOOL (^resultEqualityTest)(id, id) = self.resultEqualityTest;
+            resultChanged = !resultEqualityTest || !resultEqualityTest(self.previousResult, result);
         }
 
-        [self.workflow.notificationCenter postNotificationName:TSKTaskDidFinishNotification object:self];
-        [self.workflow subtask:self didFinishWithResult:result];
-        [self.dependentTasks makeObjectsPerformSelector:@selector(startIfReady)];
+        [self didTransitionToFinishedStateWithResult:result resultChanged:resultChanged];
     }];
 }
 
 
+- (void)didTransitionToFinishedStateWithResult:(id)result resultChanged:(BOOL)resultChanged
+{
+    self.finishDate = [NSDate date];
+    self.result = result;
+    [self discardPreviousResult];
+    [self.workflow.resultStore registerResultOfTask:self];
+
+    // This must happen before dependents are started so that they see the new version
+    if (resultChanged) {
+        atomic_fetch_add(&_resultVersion, 1);
+    }
+
+    [self.inputChannel close];
+    [self.outputChannel close];
+
+    [self didFinishWithResult:result];
+
+    if ([self.delegate respondsToSelector:@selector(task:didFinishWithResult:)]) {
+        [self.delegate task:self didFinishWithResult:result];
+    }
+
+    [self.workflow.notificationCenter postNotificationName:TSKTaskDidFinishNotification object:self];
+    [self.workflow subtask:self didFinishWithResult:result];
+    for (TSKTask *dependentTask in self.dependentTaskArray) {
+        [dependentTask prerequisiteTask:self didFinishWithResult:result];
+    }
+}
+
+
+- (void)prerequisiteTask:(TSKTask *)task didFinishWithResult:(id)result
+{
+    [self startIfReady];
+}
+
+
 - (void)didFinishWithResult:(id)result
 {
 }
@@ -522,9 +1450,17 @@ NSString *const TSKTaskStateDescription(TSKTaskState state)
 
 - (void)failWithError:(NSError *)error
 {
+    if ([self scheduleRetryAfterFailingWithError:error]) {
+        return;
+    }
+
     [self transitionFromState:TSKTaskStateExecuting toState:TSKTaskStateFailed andExecuteBlock:^{
         self.finishDate = [NSDate date];
         self.error = error;
+        [self.workflow.metrics incrementCounter:TSKMetricsCounterTasksFailed];
+
+        [self.inputChannel close];
+        [self.outputChannel closeWithError:error];
 
         [self didFailWithError:error];
 
@@ -543,6 +1479,162 @@ NSString *const TSKTaskStateDescription(TSKTaskState state)
 }
 
 
+#pragma mark - Invalidation
+
+- (void)invalidate
+{
+    if ([self invalidateAllowingReuseOfPreviousResult:NO]) {
+        [self startIfReady];
+    }
+}
+
+
+- (BOOL)invalidateAllowingReuseOfPreviousResult:(BOOL)canReusePreviousResult
+{
+    if (![self invalidateTaskAllowingReuseOfPreviousResult:canReusePreviousResult]) {
+        return NO;
+    }
+
+    // Every task downstream is invalidated before anything executes again. Otherwise, a dependent could
+    // be verified against a prerequisite that was about to be invalidated. Invalidated tasks are
+    // appended as they are invalidated. Because an invalidated task is pending and can’t be invalidated
+    // again, each task’s dependents are visited once, no matter how many paths lead to it, and the
+    // workflow’s depth doesn’t affect the stack depth.
+    NSMutableArray<TSKTask *> *invalidatedTasks = [[NSMutableArray alloc] initWithObjects:self, nil];
+    for (NSUInteger i = 0; i < invalidatedTasks.count; ++i) {
+        for (TSKTask *dependentTask in invalidatedTasks[i].dependentTaskArray) {
+            if ([dependentTask invalidateTaskAllowingReuseOfPreviousResult:YES]) {
+                [invalidatedTasks addObject:dependentTask];
+            }
+        }
+    }
+
+    return YES;
+}
+
+
+- (BOOL)invalidateTaskAllowingReuseOfPreviousResult:(BOOL)canReusePreviousResult
+{
+    __block BOOL didInvalidate = NO;
+    [self transitionFromState:TSKTaskStateFinished toState:TSKTaskStatePending andExecuteBlock:^{
+        didInvalidate = YES;
+        self.previousResult = self.result;
+        atomic_store(&self->_hasPreviousResult, true);
+        atomic_store(&self->_canReusePreviousResult, canReusePreviousResult);
+
+        // None of the prerequisites have executed again yet, so this is the sum the task last ran with
+        if (canReusePreviousResult) {
+            atomic_store(&self->_prerequisiteResultVersionSum, [self prerequisiteResultVersionSum]);
+        }
+
+        self.finishDate = nil;
+        self.result = nil;
+        atomic_store(&self->_attemptCount, 0);
+
+        [self.workflow.notificationCenter postNotificationName:TSKTaskDidInvalidateNotification object:self];
+        [self.workflow subtaskDidInvalidate:self];
+    }];
+
+    // Skipped tasks have no result to reuse, but whether they should be skipped must be decided again
+    if (!didInvalidate) {
+        [self transitionFromState:TSKTaskStateSkipped toState:TSKTaskStatePending andExecuteBlock:^{
+            didInvalidate = YES;
+            atomic_store(&self->_attemptCount, 0);
+            [self.workflow.notificationCenter postNotificationName:TSKTaskDidInvalidateNotification object:self];
+            [self.workflow subtaskDidInvalidate:self];
+        }];
+    }
+
+    // Dependents that are ready or executing are about to use, or are using, the result that was just
+    // invalidated. They go back to the pending state so that they run again once their prerequisites
+    // finish. An executing dependent’s cancellation token is cancelled, and since it is no longer
+    // executing, the result of its stale execution is ignored.
+    if (!didInvalidate && canReusePreviousResult) {
+        static NSSet *staleStates = nil;
+        static dispatch_once_t onceToken;
+        dispatch_once(&onceToken, ^{
+            staleStates = [[NSSet alloc] initWithObjects:@(TSKTaskStateReady), @(TSKTaskStateExecuting), nil];
+        });
+
+        [self transitionFromStateInSet:staleStates toState:TSKTaskStatePending andExecuteBlock:^{
+            didInvalidate = YES;
+            atomic_store(&self->_attemptCount, 0);
+            [self.workflow.notificationCenter postNotificationName:TSKTaskDidInvalidateNotification object:self];
+            [self.workflow subtaskDidInvalidate:self];
+        }];
+    }
+
+    return didInvalidate;
+}
+
+
+- (uint64_t)prerequisiteResultVersionSum
+{
+    __block uint64_t sum = 0;
+    [self.workflow allPrerequisiteTasksOfTask:self passTest:^BOOL(TSKTask *prerequisiteTask) {
+        sum += atomic_load(&prerequisiteTask->_resultVersion);
+        return YES;
+    }];
+
+    return sum;
+}
+
+
+- (BOOL)finishWithPreviousResultIfPossible
+{
+    if (!atomic_load(&_canReusePreviousResult) ||
+        [self prerequisiteResultVersionSum] != atomic_load(&_prerequisiteResultVersionSum)) {
+        return NO;
+    }
+
+    id previousResult = self.previousResult;
+    [self transitionFromState:TSKTaskStateReady toState:TSKTaskStateFinished andExecuteBlock:^{
+        [self didTransitionToFinishedStateWithResult:previousResult resultChanged:NO];
+    }];
+
+    return YES;
+}
+
+
+- (void)discardPreviousResult
+{
+    self.previousResult = nil;
+    atomic_store(&_hasPreviousResult, false);
+    atomic_store(&_canReusePreviousResult, false);
+}
+
+
+#pragma mark - Copying
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    TSKTask *copy = [[[self class] allocWithZone:zone] initWithName:nil];
+    [self copyConfigurationToTask:copy];
+    return copy;
+}
+
+
+- (void)copyConfigurationToTask:(TSKTask *)task
+{
+    NSParameterAssert(task);
+
+    if (!_hasDefaultName) {
+        task.name = self.name;
+    }
+
+    task.delegate = self.delegate;
+    task.operationQueue = _operationQueue;
+    task.executionClass = self.executionClass;
+    task.batchable = self.isBatchable;
+    task.durationHistogram = self.durationHistogram;
+    task.speculationPolicy = self.speculationPolicy;
+    task.retryPolicy = self.retryPolicy;
+    task.timeout = self.timeout;
+    task.resultEqualityTest = self.resultEqualityTest;
+    task.runsWhenPrerequisitesSkipped = self.runsWhenPrerequisitesSkipped;
+}
+
+
 #pragma mark - Prerequisite Results
 
 - (id)anyPrerequisiteResult
@@ -0,0 +1,81 @@
+//
+//  TSKWorkerTask.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <Task/TSKWorkerTask.h>
+
+#if TARGET_OS_OSX
+
+#import <Task/TSKWorkerPool.h>
+
+
+@implementation TSKWorkerTask
+
+- (instancetype)initWithWorkerPool:(TSKWorkerPool *)workerPool request:(id<NSSecureCoding>)request
+{
+    return [self initWithName:nil workerPool:workerPool request:request];
+}
+
+
+- (instancetype)initWithName:(NSString *)name workerPool:(TSKWorkerPool *)workerPool request:(id<NSSecureCoding>)request
+{
+    NSParameterAssert(workerPool);
+    NSParameterAssert(request);
+
+    self = [super initWithName:name];
+    if (self) {
+        _workerPool = workerPool;
+        _request = request;
+    }
+
+    return self;
+}
+
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    TSKWorkerTask *copy = [[[self class] allocWithZone:zone] initWithName:nil workerPool:self.workerPool request:self.request];
+    [self copyConfigurationToTask:copy];
+    return copy;
+}
+
+
+- (void)main
+{
+    // The token is cancelled when the task stops executing, which abandons the request and
+    // terminates its worker. Results that arrive after that are ignored by the state machine.
+    [self.workerPool performRequest:self.request cancellationToken:self.cancellationToken completionHandler:^(id result, NSError *error) {
+        if (error) {
+            [self failWithError:error];
+        } else {
+            [self finishWithResult:result];
+        }
+    }];
+}
+
+@end
+
+#endif
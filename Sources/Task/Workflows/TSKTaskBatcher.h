@@ -0,0 +1,80 @@
+//
+//  TSKTaskBatcher.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class TSKTask;
+@class TSKWorkflow;
+
+/*!
+ TSKTaskBatcher objects collect the work of a workflow’s batchable tasks and run it in batches.
+
+ Blocks are grouped by their tasks’ effective execution class, since that determines where they
+ run. A batch is dispatched as a single block, which runs its blocks one after another in the order
+ they were added, as soon as it holds the workflow’s batchSize blocks or its batchLingerInterval has
+ elapsed since its first block was added, whichever happens first. When the workflow has a
+ scheduler, a batch is ordered by the earliest effective deadline of its tasks.
+
+ Batching amortizes the cost of dispatching work, not the cost of state transitions. Each block
+ still transitions its own task, since a transition holds that task’s state lock and informs its
+ observers, delegate, and workflow in order before the next one starts. Committing a batch’s
+ transitions together would require holding every task’s lock at once and would reorder those
+ notifications, which dependents rely on.
+
+ TSKTaskBatcher is thread-safe.
+ */
+@interface TSKTaskBatcher : NSObject
+
+/*! The workflow whose tasks’ work the batcher collects. */
+@property (nonatomic, weak, readonly, nullable) TSKWorkflow *workflow;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/*!
+ @abstract Initializes a newly created batcher for the specified workflow.
+ @param workflow The workflow. The batcher does not retain it.
+ @result A newly initialized batcher.
+ */
+- (instancetype)initWithWorkflow:(TSKWorkflow *)workflow NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Adds the specified block to the pending batch for the specified task’s execution class.
+ @discussion If this fills the batch, it is dispatched before this method returns.
+ @param block The block to run. May not be nil.
+ @param task The task on whose behalf the block runs. May not be nil.
+ */
+- (void)addBlock:(void (^)(void))block forTask:(TSKTask *)task;
+
+/*! Dispatches every pending batch without waiting for it to fill or linger. */
+- (void)flush;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,229 @@
+//
+//  TSKTaskBatcher.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import "TSKTaskBatcher.h"
+
+#import <Task/TSKMetrics.h>
+#import <Task/TSKWorkflow.h>
+#import <os/lock.h>
+
+#import "../Execution/TSKMetrics+TaskInterface.h"
+#import "../Tasks/TSKTask+WorkflowInterface.h"
+#import "TSKWorkflow+TaskInterface.h"
+
+
+#pragma mark TSKPendingBatch
+
+/*! TSKPendingBatch objects hold the blocks of a batch that has not yet been dispatched. */
+@interface TSKPendingBatch : NSObject
+
+/*! The batch’s blocks, in the order they were added. */
+@property (nonatomic, strong, readonly) NSMutableArray<void (^)(void)> *blocks;
+
+/*! The task whose block was added first. The batch is dispatched on its behalf. */
+@property (nonatomic, strong, readonly) TSKTask *task;
+
+/*!
+ @abstract The earliest effective deadline of the tasks whose blocks were added.
+ @discussion The batch is scheduled with this deadline so that no task in it is ordered behind work
+     whose deadline is later than its own. This is nil if none of the tasks has a deadline.
+ */
+@property (nonatomic, strong, nullable) NSDate *deadline;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/*!
+ @abstract Initializes a newly created pending batch whose first block is for the specified task.
+ @param task The task whose block is added first.
+ @param capacity The number of blocks the batch is expected to hold.
+ @result A newly initialized pending batch.
+ */
+- (instancetype)initWithTask:(TSKTask *)task capacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
+
+@end
+
+
+@implementation TSKPendingBatch
+
+- (instancetype)initWithTask:(TSKTask *)task capacity:(NSUInteger)capacity
+{
+    self = [super init];
+    if (self) {
+        _task = task;
+        _blocks = [[NSMutableArray alloc] initWithCapacity:capacity];
+    }
+
+    return self;
+}
+
+@end
+
+
+#pragma mark - TSKTaskBatcher
+
+@interface TSKTaskBatcher () {
+    /*! A lock that synchronizes access to pendingBatches. */
+    os_unfair_lock _lock;
+}
+
+/*!
+ @abstract The batches that have not been dispatched, keyed by execution class.
+ @discussion Tasks without an effective execution class use NSNull as their key. Access to this
+     object must be synchronized using the lock.
+ */
+@property (nonatomic, strong, readonly) NSMutableDictionary<id, TSKPendingBatch *> *pendingBatches;
+
+/*!
+ @abstract Dispatches the pending batch for the specified key if it is still the specified batch.
+ @discussion This is invoked when a batch’s linger interval elapses. If the batch was already
+     dispatched because it filled up, this does nothing.
+ @param batch The batch.
+ @param key The batch’s key.
+ */
+- (void)dispatchBatch:(TSKPendingBatch *)batch ifPendingForKey:(id)key;
+
+/*!
+ @abstract Runs the specified batch’s blocks on behalf of its task.
+ @param batch The batch, which must no longer be pending.
+ */
+- (void)dispatchBatch:(TSKPendingBatch *)batch;
+
+@end
+
+
+@implementation TSKTaskBatcher
+
+- (instancetype)initWithWorkflow:(TSKWorkflow *)workflow
+{
+    NSParameterAssert(workflow);
+
+    self = [super init];
+    if (self) {
+        _workflow = workflow;
+        _lock = OS_UNFAIR_LOCK_INIT;
+        _pendingBatches = [[NSMutableDictionary alloc] init];
+    }
+
+    return self;
+}
+
+
+- (void)addBlock:(void (^)(void))block forTask:(TSKTask *)task
+{
+    NSParameterAssert(block);
+    NSParameterAssert(task);
+
+    TSKWorkflow *workflow = self.workflow;
+    if (!workflow) {
+        return;
+    }
+
+    NSUInteger batchSize = MAX(workflow.batchSize, 1);
+    TSKExecutionClass executionClass = task.executionClass ?: workflow.executionClass;
+    id key = executionClass ?: [NSNull null];
+    NSDate *deadline = task.effectiveDeadline;
+
+    TSKPendingBatch *fullBatch = nil;
+    TSKPendingBatch *newBatch = nil;
+    os_unfair_lock_lock(&_lock);
+    TSKPendingBatch *batch = self.pendingBatches[key];
+    if (!batch) {
+        batch = [[TSKPendingBatch alloc] initWithTask:task capacity:batchSize];
+        self.pendingBatches[key] = batch;
+        newBatch = batch;
+    }
+
+    [batch.blocks addObject:block];
+    if (deadline && (!batch.deadline || [deadline compare:batch.deadline] == NSOrderedAscending)) {
+        batch.deadline = deadline;
+    }
+
+    if (batch.blocks.count >= batchSize) {
+        [self.pendingBatches removeObjectForKey:key];
+        fullBatch = batch;
+    }
+    os_unfair_lock_unlock(&_lock);
+
+    if (fullBatch) {
+        [self dispatchBatch:fullBatch];
+    } else if (newBatch) {
+        // Only the first block of a batch starts its linger interval, so later blocks don’t extend it
+        __weak typeof(self) weakSelf = self;
+        NSTimeInterval lingerInterval = MAX(workflow.batchLingerInterval, 0);
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(lingerInterval * NSEC_PER_SEC)), dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            [weakSelf dispatchBatch:newBatch ifPendingForKey:key];
+        });
+    }
+}
+
+
+- (void)flush
+{
+    os_unfair_lock_lock(&_lock);
+    NSArray<TSKPendingBatch *> *batches = self.pendingBatches.allValues;
+    [self.pendingBatches removeAllObjects];
+    os_unfair_lock_unlock(&_lock);
+
+    for (TSKPendingBatch *batch in batches) {
+        [self dispatchBatch:batch];
+    }
+}
+
+
+- (void)dispatchBatch:(TSKPendingBatch *)batch ifPendingForKey:(id)key
+{
+    os_unfair_lock_lock(&_lock);
+    BOOL isPending = self.pendingBatches[key] == batch;
+    if (isPending) {
+        [self.pendingBatches removeObjectForKey:key];
+    }
+    os_unfair_lock_unlock(&_lock);
+
+    if (isPending) {
+        [self dispatchBatch:batch];
+    }
+}
+
+
+- (void)dispatchBatch:(TSKPendingBatch *)batch
+{
+    TSKWorkflow *workflow = self.workflow;
+    if (!workflow) {
+        return;
+    }
+
+    [workflow.metrics incrementCounter:TSKMetricsCounterBatchesDispatched];
+
+    NSArray<void (^)(void)> *blocks = batch.blocks;
+    [workflow dispatchBlock:^{
+        for (void (^block)(void) in blocks) {
+            block();
+        }
+    } forTask:batch.task deadline:batch.deadline];
+}
+
+@end
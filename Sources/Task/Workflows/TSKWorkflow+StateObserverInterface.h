@@ -0,0 +1,57 @@
+//
+//  TSKWorkflow+StateObserverInterface.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <Task/TSKWorkflow.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class TSKWorkflowStateObserver;
+
+/*!
+ The StateObserverInterface category of TSKWorkflow declares messages that TSKWorkflowStateObserver
+ uses to start and stop observing a workflow.
+ */
+@interface TSKWorkflow (StateObserverInterface)
+
+/*!
+ @abstract Adds the specified observer to the workflow’s state observers.
+ @discussion The workflow retains the observer and reports each of its tasks’ state changes to it.
+ @param observer The observer. May not be nil.
+ */
+- (void)addStateObserver:(TSKWorkflowStateObserver *)observer;
+
+/*!
+ @abstract Removes the specified observer from the workflow’s state observers.
+ @discussion Does nothing if the observer is not one of the workflow’s state observers.
+ @param observer The observer. May not be nil.
+ */
+- (void)removeStateObserver:(TSKWorkflowStateObserver *)observer;
+
+@end
+
+NS_ASSUME_NONNULL_END
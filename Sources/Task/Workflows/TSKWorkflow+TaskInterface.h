@@ -29,12 +29,115 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+@class TSKWorkflowGraph;
+
 /*!
  The TaskInterface category of TSKWorkflow declares messages that must be exposed so that TSKTasks
  can notify their workflows of state changes.
  */
 @interface TSKWorkflow (TaskInterface)
 
+/*!
+ @abstract Returns whether the specified predicate is true for all of the specified task’s
+     prerequisite tasks.
+ @discussion Unlike ‑prerequisiteTasksForTask:, this does not create a new collection of tasks.
+ @param task The task whose prerequisites are tested. May not be nil.
+ @param predicate The predicate to test each prerequisite task with. The predicate must not modify
+     the workflow.
+ @result Whether the predicate is true for all of the task’s prerequisites. Returns YES if the task
+     has no prerequisites or is not in the workflow.
+ */
+- (BOOL)allPrerequisiteTasksOfTask:(TSKTask *)task passTest:(BOOL (NS_NOESCAPE ^)(TSKTask *prerequisiteTask))predicate;
+
+/*!
+ @abstract Enumerates the specified task’s prerequisite tasks along with the conditions on them.
+ @discussion The prerequisites and their conditions are copied while the graph lock is held, and
+     the block is executed after it is unlocked. This allows the block to evaluate conditions, which
+     may re-enter the workflow. Does nothing if the task is not in the workflow.
+ @param task The task whose prerequisites are enumerated. May not be nil.
+ @param block The block to execute for each prerequisite task. Its condition parameter is the
+     condition the prerequisite’s result must satisfy for the task to run, or nil if the
+     prerequisite is unconditional. Setting *stop to YES ends the enumeration.
+ */
+- (void)enumeratePrerequisiteTasksOfTask:(TSKTask *)task
+                              usingBlock:(void (NS_NOESCAPE ^)(TSKTask *prerequisiteTask, BOOL (^ _Nullable condition)(id _Nullable result), BOOL *stop))block;
+
+/*!
+ @abstract Returns the specified task’s dependent tasks in an array.
+ @discussion This is cheaper than ‑dependentTasksForTask:, as it doesn’t need to build a set.
+ @param task The task. May not be nil.
+ @result The task’s dependent tasks. Returns an empty array if the task is not in the workflow.
+ */
+- (NSArray<TSKTask *> *)dependentTaskArrayForTask:(TSKTask *)task;
+
+/*!
+ @abstract Executes the specified block with the workflow’s task graph while holding the graph lock
+     for reading.
+ @discussion This allows internal clients to read the whole graph consistently and efficiently. The
+     block must not modify the graph or invoke methods that could re-enter the workflow.
+ @param block The block to execute. May not be nil.
+ */
+- (void)readGraphUsingBlock:(void (NS_NOESCAPE ^)(TSKWorkflowGraph *graph))block;
+
+/*!
+ @abstract Returns whether the workflow needs the specified task to run.
+ @discussion When the workflow was started with ‑startForTargetTasks:, only the targets and the
+     tasks they depend on are needed. Otherwise, every task is. Tasks use this to decide whether to
+     start automatically when their prerequisites finish.
+ @param task The task. May not be nil.
+ @result Whether the task is needed.
+ */
+- (BOOL)needsTask:(TSKTask *)task;
+
+/*!
+ @abstract Returns the error with which tasks should fail because the workflow’s current run timed
+     out.
+ @discussion Tasks check this before they start executing. It is nil if the workflow has no timeout
+     or its timeout has not elapsed since it was last started, retried, or reset.
+ */
+- (nullable NSError *)timeoutError;
+
+/*!
+ @abstract Schedules the specified block to run on behalf of the specified task.
+ @discussion If the task is batchable and the workflow’s batch size is greater than 1, the block is
+     added to a batch that is dispatched using ‑dispatchBlock:forTask: once it fills or lingers.
+     Otherwise, the block is dispatched immediately.
+ @param block The block to run. May not be nil.
+ @param task The task on whose behalf the block is run. May not be nil.
+ */
+- (void)scheduleBlock:(void (^)(void))block forTask:(TSKTask *)task;
+
+/*!
+ @abstract Runs the specified block on behalf of the specified task without batching it.
+ @discussion The block runs on the operation queue for the task’s effective execution class if it
+     has a dedicated one. Otherwise, it runs using the workflow’s scheduler if it has one, and on the
+     workflow’s operation queue if not.
+ @param block The block to run. May not be nil.
+ @param task The task on whose behalf the block is run. May not be nil.
+ */
+- (void)dispatchBlock:(void (^)(void))block forTask:(TSKTask *)task;
+
+/*!
+ @abstract Runs the specified block on behalf of the specified task with the specified deadline
+     without batching it.
+ @discussion This is like ‑dispatchBlock:forTask:, except that the block is ordered by the
+     specified deadline instead of the task’s effective deadline. Batches use this to run with the
+     earliest deadline of their tasks. If the block doesn’t go through a scheduler, the deadline
+     determines the queue priority of its operation, so blocks whose deadlines are imminent run first.
+ @param block The block to run. May not be nil.
+ @param task The task on whose behalf the block is run. May not be nil.
+ @param deadline The deadline the block is ordered by. If nil, the block has no deadline.
+ */
+- (void)dispatchBlock:(void (^)(void))block forTask:(TSKTask *)task deadline:(nullable NSDate *)deadline;
+
+/*!
+ @abstract Indicates to the workflow that the specified task’s state changed.
+ @discussion The workflow reports the change to its state observers. Tasks send this after every
+     state transition, so it must be cheap when the workflow has no observers.
+ @param task The task whose state changed. May not be nil.
+ */
+- (void)subtaskDidChangeState:(TSKTask *)task;
+
 /*!
  @abstract Indicates to the workflow that the specified task finished successfully.
  @param task The task that finished. May not be nil.
@@ -61,6 +164,20 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)subtaskDidReset:(TSKTask *)task;
 
+/*!
+ @abstract Indicates to the workflow that the specified task was invalidated.
+ @discussion The workflow becomes active again until the task and its dependents finish.
+ @param task The task that was invalidated. May not be nil.
+ */
+- (void)subtaskDidInvalidate:(TSKTask *)task;
+
+/*!
+ @abstract Indicates to the workflow that the specified task was skipped.
+ @discussion Skipped tasks count as done when the workflow determines whether it has finished.
+ @param task The task that was skipped. May not be nil.
+ */
+- (void)subtaskDidSkip:(TSKTask *)task;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -0,0 +1,68 @@
+//
+//  TSKWorkflow+TemplateInterface.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Task/TSKWorkflow.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class TSKWorkflowGraph;
+
+/*!
+ The TemplateInterface category of TSKWorkflow declares messages that TSKWorkflowTemplate uses to
+ populate the workflows it instantiates.
+ */
+@interface TSKWorkflow (TemplateInterface)
+
+/*!
+ @abstract Makes the tasks in the specified graph the workflow’s tasks, using the graph as the
+     workflow’s task graph.
+ @discussion This is equivalent to adding each of the graph’s tasks in node order, but it reuses the
+     graph’s nodes and edges instead of rebuilding them. The workflow must be empty and not running,
+     and none of the graph’s tasks may be in a workflow.
+ @param graph The graph. May not be nil.
+ @param keyedPrerequisiteTasks A map table that maps each of the graph’s tasks with keyed
+     prerequisites to its keyed prerequisite tasks. May be nil if none of the tasks have keyed
+     prerequisites.
+ @param prerequisiteConditions A map table that maps each of the graph’s tasks with conditional
+     prerequisites to a map table of its conditional prerequisite tasks and their conditions. May be
+     nil if none of the tasks have conditional prerequisites.
+ */
+- (void)adoptGraph:(TSKWorkflowGraph *)graph
+    keyedPrerequisiteTasks:(nullable NSMapTable<TSKTask *, NSDictionary<id<NSCopying>, TSKTask *> *> *)keyedPrerequisiteTasks
+    prerequisiteConditions:(nullable NSMapTable<TSKTask *, NSMapTable<TSKTask *, id> *> *)prerequisiteConditions;
+
+/*!
+ @abstract Returns the conditions on the specified task’s conditional prerequisites.
+ @param task The task. May not be nil.
+ @result A map table whose keys are the task’s conditional prerequisite tasks and whose values are
+     their conditions. Returns nil if the task has no conditional prerequisites.
+ */
+- (nullable NSMapTable<TSKTask *, id> *)prerequisiteConditionsForTask:(TSKTask *)task;
+
+@end
+
+NS_ASSUME_NONNULL_END
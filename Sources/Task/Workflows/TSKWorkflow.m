@@ -26,7 +26,22 @@
 
 #import <Task/TSKWorkflow.h>
 
+#import <Task/TSKFairScheduler.h>
+#import <Task/TSKTimerWheel.h>
+#import <Task/TaskErrors.h>
+
+#import "../Channels/TSKChannel+WorkflowInterface.h"
+#import "../Execution/TSKMetrics+TaskInterface.h"
 #import "../Tasks/TSKTask+WorkflowInterface.h"
+#import "TSKTaskBatcher.h"
+#import "TSKWorkflow+StateObserverInterface.h"
+#import "TSKWorkflow+TemplateInterface.h"
+#import "TSKWorkflowGraph.h"
+#import "TSKWorkflowStateObserver+WorkflowInterface.h"
+
+#import <os/lock.h>
+#import <pthread.h>
+#import <stdatomic.h>
 
 
 #pragma mark Constants
@@ -41,55 +56,247 @@ NSString *const TSKWorkflowWillStartNotification = @"TSKWorkflowWillStartNotific
 NSString *const TSKWorkflowTaskKey = @"TSKWorkflowTaskKey";
 
 
+/*!
+ @abstract Returns the operation queue priority for a block with the specified deadline.
+ @discussion Operation queues only order operations by a handful of priorities, so deadlines are
+     bucketed by how soon they arrive. This gives blocks with imminent deadlines approximately
+     earliest-deadline-first ordering when they don’t go through a scheduler.
+ @param deadline The block’s deadline. May be nil.
+ @result The priority for the block’s operation.
+ */
+static NSOperationQueuePriority TSKOperationQueuePriorityForDeadline(NSDate *deadline)
+{
+    if (!deadline) {
+        return NSOperationQueuePriorityNormal;
+    }
+
+    NSTimeInterval remainingTime = deadline.timeIntervalSinceNow;
+    if (remainingTime < 1) {
+        return NSOperationQueuePriorityVeryHigh;
+    } else if (remainingTime < 10) {
+        return NSOperationQueuePriorityHigh;
+    }
+
+    return NSOperationQueuePriorityNormal;
+}
+
+
 #pragma mark -
 
-@interface TSKWorkflow ()
+@interface TSKWorkflow () {
+    /*!
+     @abstract A readers-writer lock that synchronizes access to the workflow’s graph.
+     @discussion The lock protects graph, keyedPrerequisiteTasks, prerequisiteConditions,
+         mutableTasksWithNoPrerequisiteTasks, and mutableTasksWithNoDependentTasks. Adding a task takes
+         the lock for writing; everything else takes it for reading. Code that holds the lock must not
+         invoke methods that could re-enter the workflow, e.g., by changing a task’s state.
+
+         A single lock is enough because adding a task only appends a node and its edges to the graph, so
+         the write path is a short critical section. Concurrent adds contend for it, but throughput does
+         not collapse; see ‑[TSKWorkflowTestCase testAddTasksConcurrentlyScaling].
+     */
+    pthread_rwlock_t _graphLock;
+
+    /*! Whether the workflow has been started and not subsequently cancelled or reset. */
+    atomic_bool _running;
+
+    /*! A lock that synchronizes access to operationQueuesByExecutionClass. */
+    os_unfair_lock _executionClassLock;
+
+    /*! Whether the workflow is counted as active in its metrics. */
+    atomic_bool _active;
+
+    /*! A lock that synchronizes access to timeoutTimer and _timeoutGeneration. */
+    os_unfair_lock _timeoutLock;
+
+    /*! The number of timeout timers the workflow has armed, which identifies the current one. */
+    uint64_t _timeoutGeneration;
+
+    /*! Whether the workflow’s current run has ended. Access to this must be synchronized using outcomeCondition. */
+    BOOL _hasOutcome;
+
+    /*! How the workflow’s current run ended. Access to this must be synchronized using outcomeCondition. */
+    TSKWorkflowOutcome _outcome;
+
+    /*! A lock that synchronizes access to _stateObservers. */
+    os_unfair_lock _stateObserverLock;
+
+    /*!
+     @abstract The workflow’s state observers, or nil if it has none.
+     @discussion The array is replaced rather than mutated, so that tasks can report state changes to
+         it without holding the lock. Access to this must be synchronized using the state observer lock.
+     */
+    NSArray<TSKWorkflowStateObserver *> *_stateObservers;
+}
+
+/*!
+ @abstract A condition that synchronizes access to the outcome of the workflow’s current run.
+ @discussion The condition protects _hasOutcome, _outcome, outcomeError, and completionHandlers. It
+     is broadcast when the run ends, which wakes threads blocked in ‑waitUntilFinishedWithTimeout:error:.
+ */
+@property (nonatomic, strong, readonly) NSCondition *outcomeCondition;
+
+/*!
+ @abstract The error that the first task to fail during the workflow’s current run failed with.
+ @discussion Access to this object must be synchronized using outcomeCondition.
+ */
+@property (nonatomic, strong, nullable) NSError *outcomeError;
+
+/*!
+ @abstract The handlers passed to ‑startWithCompletionHandler: that have not yet been invoked.
+ @discussion This is nil until a handler is added. Access to this object must be synchronized using
+     outcomeCondition.
+ */
+@property (nonatomic, strong, nullable) NSMutableArray<TSKWorkflowCompletionHandler> *completionHandlers;
+
+/*!
+ @abstract The timer for the workflow’s current run, if it has a timeout.
+ @discussion Access to this object must be synchronized using the timeout lock.
+ */
+@property (nonatomic, strong, nullable) TSKTimerWheelTimer *timeoutTimer;
+
+/*! The error that tasks fail with because the workflow’s current run timed out, or nil if it hasn’t. */
+@property (atomic, strong, readwrite, nullable) NSError *timeoutError;
+
+/*!
+ @abstract A dictionary that maps execution classes to the operation queues for their tasks.
+ @discussion Access to this object must be synchronized using the execution class lock.
+ */
+@property (nonatomic, strong, readonly, nonnull) NSMutableDictionary<TSKExecutionClass, NSOperationQueue *> *operationQueuesByExecutionClass;
 
 /*!
- @abstract The set of tasks in the workflow.
- @discussion Access to this object is not thread-safe. This shouldn’t be a problem, as typically a
-     workflow’s tasks are created and added to the workflow and then the workflow is started.
+ @abstract The workflow’s task graph.
+ @discussion The graph stores every task in the workflow along with its prerequisite and dependent
+     relationships. Access to this object must be synchronized using the graph lock.
  */
-@property (nonatomic, strong, readonly, nonnull) NSMutableSet<TSKTask *> *tasks;
+@property (nonatomic, strong, readonly, nonnull) TSKWorkflowGraph *graph;
+
+/*! The batcher that collects the work of the workflow’s batchable tasks. */
+@property (nonatomic, strong, readonly, nonnull) TSKTaskBatcher *batcher;
 
 @property (nonatomic, strong, readonly, nonnull) dispatch_queue_t finishedTasksQueue;
 
 /*!
- @abstract The set of tasks in the workflow that have finished successfully.
+ @abstract The set of tasks in the workflow that have finished successfully or been skipped.
  @discussion Access to this object is not thread-safe. All accesses to the set should be
      synchronized on the set itself to maintain data integrity.
  */
 @property (nonatomic, strong, readonly, nonnull) NSMutableSet<TSKTask *> *finishedTasks;
 
-/*!
- @abstract A map table that maps a task to its prerequisite tasks.
- @discussion The keys for this map table are TSKTask instances and their values are NSSets of 
-     TSKTask instances.
- */
-@property (nonatomic, strong, readonly, nonnull) NSMapTable<TSKTask *, NSSet<TSKTask *> *> *prerequisiteTasks;
-
 /*!
  @abstract A map table that maps a task to its keyed prerequisite tasks.
  @discussion The keys for this map table are TSKTask instances and their values are NSDictionaries
-     whose keys are objects that conform to NSCopying and whose values are TSKTask instances.
+     whose keys are objects that conform to NSCopying and whose values are TSKTask instances. Tasks
+     without keyed prerequisites have no entry in the map table.
  */
 @property (nonatomic, strong, readonly, nonnull) NSMapTable<TSKTask *, NSDictionary<id<NSCopying>, TSKTask *> *> *keyedPrerequisiteTasks;
 
 /*!
- @abstract A map table that maps a task to its dependent tasks.
- @discussion The keys for this map table are TSKTask instances and their values are NSSets. We
-     use immutable sets instead of mutable ones because tasks are added to a workflow far less
-     frequently than a task gets its set of dependent tasks. Repeatedly copying a mutable set
-     is probably going to be more expensive than generating a new immutable set every time a
-     task gains a new dependent.
+ @abstract A map table that maps a task to the conditions on its conditional prerequisites.
+ @discussion The keys for this map table are TSKTask instances and their values are map tables whose
+     keys are the task’s conditional prerequisite tasks and whose values are the condition blocks.
+     Tasks without conditional prerequisites have no entry in the map table.
+ */
+@property (nonatomic, strong, readonly, nonnull) NSMapTable<TSKTask *, NSMapTable<TSKTask *, id> *> *prerequisiteConditions;
+
+/*!
+ @abstract The set of tasks currently in the workflow that have no prerequisite tasks.
+ @discussion This set is updated incrementally as tasks are added to the workflow.
+ */
+@property (nonatomic, strong, readonly, nonnull) NSMutableSet<TSKTask *> *mutableTasksWithNoPrerequisiteTasks;
+
+/*!
+ @abstract The set of tasks currently in the workflow that have no dependent tasks.
+ @discussion This set is updated incrementally as tasks are added to the workflow.
+ */
+@property (nonatomic, strong, readonly, nonnull) NSMutableSet<TSKTask *> *mutableTasksWithNoDependentTasks;
+
+@property (atomic, copy, readwrite, nullable) NSSet<TSKTask *> *targetTasks;
+
+/*!
+ @abstract The node indexes of the tasks that the workflow’s target tasks need.
+ @discussion This includes the target tasks themselves. It is nil if the workflow has no target
+     tasks, in which case every task is needed.
+ */
+@property (atomic, copy, nullable) NSIndexSet *neededNodeIndexes;
+
+/*!
+ @abstract Returns the operation queue that was set for the specified execution class.
+ @param executionClass The execution class. May be nil.
+ @result The operation queue set for the execution class, or nil if there is none or executionClass
+     is nil.
+ */
+- (nullable NSOperationQueue *)dedicatedOperationQueueForExecutionClass:(nullable TSKExecutionClass)executionClass;
+
+/*!
+ @abstract Sets whether the workflow is active, updating its metrics’ active workflow count if the
+     value changes.
+ @param active Whether the workflow is active.
+ */
+- (void)setActive:(BOOL)active;
+
+/*!
+ @abstract Starts each of the specified tasks if it is ready or can become ready.
+ @discussion This is used when tasks that were previously left unstarted may now be ready.
+ @param tasks The tasks to start.
+ */
+- (void)startTasksIfReady:(NSArray<TSKTask *> *)tasks;
+
+/*! Informs the delegate and observers that the workflow finished. */
+- (void)didFinish;
+
+/*!
+ @abstract Arms a timer for the workflow’s timeout, replacing any existing one.
+ @discussion This also clears the error from any previous timeout. Does nothing else if the
+     workflow has no timeout.
  */
-@property (nonatomic, strong, readonly, nonnull) NSMapTable<TSKTask *, NSSet<TSKTask *> *> *dependentTasks;
+- (void)armTimeoutTimer;
+
+/*! Disarms the workflow’s timeout timer, if it has one. */
+- (void)disarmTimeoutTimer;
 
-/*! The set of tasks currently in the workflow that have no prerequisite tasks. */
-@property (nonatomic, copy, readwrite) NSSet<TSKTask *> *tasksWithNoPrerequisiteTasks;
+/*!
+ @abstract Fails the workflow’s tasks because its timeout elapsed.
+ @param generation The generation of the timer that fired. If it is not the workflow’s current
+     timeout timer, this does nothing.
+ */
+- (void)timeOutWithGeneration:(uint64_t)generation;
 
-/*! The set of tasks currently in the workflow that have no dependent tasks. */
-@property (nonatomic, copy, readwrite) NSSet<TSKTask *> *tasksWithNoDependentTasks;
+/*! Forgets the outcome of the workflow’s previous run, as a new one is beginning. */
+- (void)beginRun;
+
+/*!
+ @abstract Records the outcome of the workflow’s current run, and invokes and removes its completion
+     handlers.
+ @discussion Only the first outcome of each run is recorded. Threads waiting for the run to end are
+     woken.
+ @param outcome The outcome of the workflow’s run.
+ @param error The error that the failed task failed with, if the outcome is
+     TSKWorkflowOutcomeFailed.
+ */
+- (void)completeWithOutcome:(TSKWorkflowOutcome)outcome error:(nullable NSError *)error;
+
+/*!
+ @abstract Adds the specified task to the workflow.
+ @discussion This is the primitive on which the public methods for adding tasks are built. See
+     ‑addTask:prerequisiteTasks:keyedPrerequisiteTasks:.
+ @param task The task to add.
+ @param prerequisiteTasks The task’s unkeyed prerequisite tasks.
+ @param keyedPrerequisiteTasks The task’s keyed prerequisite tasks.
+ @param prerequisiteConditions A map table that maps some of the task’s prerequisites to the
+     conditions their results must satisfy for the task to run. May be nil.
+ */
+-            (void)addTask:(TSKTask *)task
+         prerequisiteTasks:(nullable NSSet<TSKTask *> *)prerequisiteTasks
+    keyedPrerequisiteTasks:(nullable NSDictionary<id<NSCopying>, TSKTask *> *)keyedPrerequisiteTasks
+    prerequisiteConditions:(nullable NSMapTable<TSKTask *, id> *)prerequisiteConditions;
+
+/*!
+ @abstract Records that the specified task is done, either because it finished or was skipped, and
+     finishes the workflow if all the tasks it is waiting for are done.
+ @param task The task.
+ */
+- (void)subtaskIsDone:(TSKTask *)task;
 
 @end
 
@@ -142,21 +349,44 @@ NSString *const TSKWorkflowTaskKey = @"TSKWorkflowTaskKey";
         _operationQueue = operationQueue;
         _notificationCenter = notificationCenter ? notificationCenter : [NSNotificationCenter defaultCenter];
 
-        _tasks = [[NSMutableSet alloc] init];
+        _operationQueuesByExecutionClass = [[NSMutableDictionary alloc] init];
+        _executionClassLock = OS_UNFAIR_LOCK_INIT;
+        _timeoutLock = OS_UNFAIR_LOCK_INIT;
+        _stateObserverLock = OS_UNFAIR_LOCK_INIT;
+        _outcomeCondition = [[NSCondition alloc] init];
+        _batchSize = 64;
+        _batchLingerInterval = 0.001;
+        _batcher = [[TSKTaskBatcher alloc] initWithWorkflow:self];
+
+        _graph = [[TSKWorkflowGraph alloc] init];
+        pthread_rwlock_init(&_graphLock, NULL);
+        atomic_init(&_running, false);
+        atomic_init(&_active, false);
+        _metrics = [[TSKMetrics alloc] initWithName:_name];
+        _metrics.parent = [TSKMetrics sharedMetrics];
         _finishedTasks = [[NSMutableSet alloc] init];
 
         NSString *finishedTasksQueueName = [NSString stringWithFormat:@"com.ticketmaster.TSKWorkflow.%@.finishedTasks", _name];
         _finishedTasksQueue = dispatch_queue_create([finishedTasksQueueName UTF8String], DISPATCH_QUEUE_CONCURRENT);
 
-        _prerequisiteTasks = [NSMapTable strongToStrongObjectsMapTable];
         _keyedPrerequisiteTasks = [NSMapTable strongToStrongObjectsMapTable];
-        _dependentTasks = [NSMapTable strongToStrongObjectsMapTable];
+        _prerequisiteConditions = [NSMapTable strongToStrongObjectsMapTable];
+        _mutableTasksWithNoPrerequisiteTasks = [[NSMutableSet alloc] init];
+        _mutableTasksWithNoDependentTasks = [[NSMutableSet alloc] init];
     }
 
     return self;
 }
 
 
+- (void)dealloc
+{
+    [self setActive:NO];
+    [self disarmTimeoutTimer];
+    pthread_rwlock_destroy(&_graphLock);
+}
+
+
 - (void)setName:(NSString *)name
 {
     if (!name) {
@@ -192,11 +422,128 @@ NSString *const TSKWorkflowTaskKey = @"TSKWorkflowTaskKey";
 
 - (NSSet *)allTasks
 {
-    return [self.tasks copy];
+    return [[NSSet alloc] initWithArray:[self allTaskArray]];
 }
 
 
-#pragma mark -
+- (NSArray<TSKTask *> *)allTaskArray
+{
+    pthread_rwlock_rdlock(&_graphLock);
+    NSArray *tasks = self.graph.tasks;
+    pthread_rwlock_unlock(&_graphLock);
+    return tasks;
+}
+
+
+- (NSSet *)tasksWithNoPrerequisiteTasks
+{
+    pthread_rwlock_rdlock(&_graphLock);
+    NSSet *tasks = [self.mutableTasksWithNoPrerequisiteTasks copy];
+    pthread_rwlock_unlock(&_graphLock);
+    return tasks;
+}
+
+
+- (NSSet *)tasksWithNoDependentTasks
+{
+    pthread_rwlock_rdlock(&_graphLock);
+    NSSet *tasks = [self.mutableTasksWithNoDependentTasks copy];
+    pthread_rwlock_unlock(&_graphLock);
+    return tasks;
+}
+
+
+- (BOOL)tasksWithNoDependentTasksAreSubsetOfSet:(NSSet<TSKTask *> *)set
+{
+    pthread_rwlock_rdlock(&_graphLock);
+    BOOL isSubset = [self.mutableTasksWithNoDependentTasks isSubsetOfSet:set];
+    pthread_rwlock_unlock(&_graphLock);
+    return isSubset;
+}
+
+
+- (BOOL)isRunning
+{
+    return atomic_load(&_running);
+}
+
+
+- (void)setActive:(BOOL)active
+{
+    if (atomic_exchange(&_active, active) != active) {
+        [self.metrics addToActiveWorkflowCount:active ? 1 : -1];
+    }
+}
+
+
+#pragma mark - Execution Classes
+
+- (void)setOperationQueue:(NSOperationQueue *)operationQueue forExecutionClass:(TSKExecutionClass)executionClass
+{
+    NSParameterAssert(executionClass);
+
+    os_unfair_lock_lock(&_executionClassLock);
+    self.operationQueuesByExecutionClass[executionClass] = operationQueue;
+    os_unfair_lock_unlock(&_executionClassLock);
+}
+
+
+- (NSOperationQueue *)operationQueueForExecutionClass:(TSKExecutionClass)executionClass
+{
+    NSOperationQueue *operationQueue = [self dedicatedOperationQueueForExecutionClass:executionClass];
+    return operationQueue ? operationQueue : self.operationQueue;
+}
+
+
+- (NSOperationQueue *)dedicatedOperationQueueForExecutionClass:(TSKExecutionClass)executionClass
+{
+    if (!executionClass) {
+        return nil;
+    }
+
+    os_unfair_lock_lock(&_executionClassLock);
+    NSOperationQueue *operationQueue = self.operationQueuesByExecutionClass[executionClass];
+    os_unfair_lock_unlock(&_executionClassLock);
+
+    return operationQueue;
+}
+
+
+- (void)scheduleBlock:(void (^)(void))block forTask:(TSKTask *)task
+{
+    if (task.isBatchable && self.batchSize > 1) {
+        [self.batcher addBlock:block forTask:task];
+    } else {
+        [self dispatchBlock:block forTask:task];
+    }
+}
+
+
+- (void)dispatchBlock:(void (^)(void))block forTask:(TSKTask *)task
+{
+    [self dispatchBlock:block forTask:task deadline:task.effectiveDeadline];
+}
+
+
+- (void)dispatchBlock:(void (^)(void))block forTask:(TSKTask *)task deadline:(NSDate *)deadline
+{
+    TSKExecutionClass executionClass = task.executionClass;
+    NSOperationQueue *operationQueue = [self dedicatedOperationQueueForExecutionClass:executionClass ? executionClass : self.executionClass];
+
+    // Execution classes with dedicated queues bypass the scheduler, since they don’t share its queue
+    TSKFairScheduler *scheduler = self.scheduler;
+    if (!operationQueue && scheduler) {
+        [scheduler scheduleBlock:block forWorkflow:self deadline:deadline];
+    } else {
+        // Blocks that bypass the scheduler approximate deadline ordering using their operation’s priority
+        NSBlockOperation *operation = [NSBlockOperation blockOperationWithBlock:block];
+        operation.queuePriority = TSKOperationQueuePriorityForDeadline(deadline);
+        [operationQueue ? operationQueue : self.operationQueue addOperation:operation];
+    }
+}
+
+
+#pragma mark - Adding Tasks
 
 - (void)addTask:(TSKTask *)task prerequisiteTasks:(NSSet *)prerequisiteTasks
 {
@@ -212,60 +559,105 @@ NSString *const TSKWorkflowTaskKey = @"TSKWorkflowTaskKey";
 
 - (void)addTask:(TSKTask *)task prerequisiteTasks:(NSSet *)prerequisiteTasks keyedPrerequisiteTasks:(NSDictionary *)keyedPrerequisiteTasks
 {
-    NSParameterAssert(task);
-    NSAssert(!task.workflow, @"Task (%@) has been previously added to a workflow (%@)", task, task.workflow);
+    [self addTask:task prerequisiteTasks:prerequisiteTasks keyedPrerequisiteTasks:keyedPrerequisiteTasks prerequisiteConditions:nil];
+}
 
-    if (!prerequisiteTasks) {
-        prerequisiteTasks = [[NSSet alloc] init];
-    }
 
-    keyedPrerequisiteTasks = keyedPrerequisiteTasks ? [keyedPrerequisiteTasks copy] : [[NSDictionary alloc] init];
+-            (void)addTask:(TSKTask *)task
+         prerequisiteTasks:(NSSet *)prerequisiteTasks
+    keyedPrerequisiteTasks:(NSDictionary *)keyedPrerequisiteTasks
+    prerequisiteConditions:(NSMapTable *)prerequisiteConditions
+{
+    NSParameterAssert(task);
 
-    prerequisiteTasks = [prerequisiteTasks setByAddingObjectsFromArray:[keyedPrerequisiteTasks allValues]];
-    NSAssert([prerequisiteTasks isSubsetOfSet:self.tasks], @"Prerequisite tasks have not been added to workflow");
+    keyedPrerequisiteTasks = keyedPrerequisiteTasks.count != 0 ? [keyedPrerequisiteTasks copy] : nil;
+    if (keyedPrerequisiteTasks) {
+        prerequisiteTasks = prerequisiteTasks ? [prerequisiteTasks setByAddingObjectsFromArray:[keyedPrerequisiteTasks allValues]]
+                                              : [[NSSet alloc] initWithArray:[keyedPrerequisiteTasks allValues]];
+    } else {
+        prerequisiteTasks = [prerequisiteTasks copy];
+    }
 
     NSSet *requiredPrerequisiteKeys = task.requiredPrerequisiteKeys;
-    if (!requiredPrerequisiteKeys) {
-        requiredPrerequisiteKeys = [[NSSet alloc] init];
+    if (requiredPrerequisiteKeys.count != 0) {
+        NSAssert([requiredPrerequisiteKeys isSubsetOfSet:[NSSet setWithArray:[keyedPrerequisiteTasks allKeys]]],
+                 @"Task has required keyed prerequisites that are unfulfilled");
     }
 
-    NSAssert([requiredPrerequisiteKeys isSubsetOfSet:[NSSet setWithArray:[keyedPrerequisiteTasks allKeys]]],
-             @"Task has required keyed prerequisites that are unfulfilled");
+    // Tasks are never removed from a workflow, so whether the prerequisites have been added can be
+    // determined before taking the graph lock
+    BOOL prerequisitesInWorkflow = YES;
+    for (TSKTask *prerequisiteTask in prerequisiteTasks) {
+        if (prerequisiteTask.workflow != self) {
+            prerequisitesInWorkflow = NO;
+            break;
+        }
+    }
+
+    // If the task has prerequisites, it must be pending before other threads can see it. Otherwise, a
+    // prerequisite that finishes concurrently could try to start the task before we’ve determined
+    // whether it’s ready. The task isn’t visible to anyone else yet, so this is safe to do without
+    // holding the graph lock. It only happens once the task is known to be valid, so that a task that
+    // can’t be added isn’t left pending.
+    BOOL hasPrerequisites = prerequisiteTasks.count != 0;
+    if (hasPrerequisites && prerequisitesInWorkflow && !task.workflow) {
+        [task didAddPrerequisiteTask];
+    }
 
     NSSet *taskSet = [NSSet setWithObject:task];
     [self willChangeValueForKey:@"allTasks" withSetMutation:NSKeyValueUnionSetMutation usingObjects:taskSet];
 
-    task.workflow = self;
-    [self.tasks addObject:task];
-    [self.prerequisiteTasks setObject:prerequisiteTasks forKey:task];
-    [self.keyedPrerequisiteTasks setObject:keyedPrerequisiteTasks forKey:task];
+    pthread_rwlock_wrlock(&_graphLock);
 
-    [self.dependentTasks setObject:[[NSSet alloc] init] forKey:task];
+    // We check the task’s workflow again while holding the lock so that two threads can’t add the same
+    // task at once, but we can’t raise exceptions until after we’ve released it
+    TSKWorkflow *previousWorkflow = task.workflow;
+    BOOL isValid = !previousWorkflow && prerequisitesInWorkflow;
+    if (isValid) {
+        NSUInteger nodeIndex = [self.graph addNodeWithTask:task];
+        task.workflowNodeIndex = nodeIndex;
 
-    for (TSKTask *prerequisiteTask in prerequisiteTasks) {
-        NSSet *dependentTasks = [self dependentTasksForTask:prerequisiteTask];
+        if (keyedPrerequisiteTasks) {
+            [self.keyedPrerequisiteTasks setObject:keyedPrerequisiteTasks forKey:task];
+        }
 
-        // We create an immutable set here, because -[TSKTask dependentTasks] just invokes
-        // -[TSKWorkflow dependentTasksForTask:], which would need to return a copy of the set if
-        // we stored mutable sets. Since -[TSKTask dependentTasks] is likely to be invoked many more
-        // times than this method, and creating copies of mutable sets is not cheap, we’re better off
-        // using immutable sets.
-        [self.dependentTasks setObject:[dependentTasks setByAddingObject:task] forKey:prerequisiteTask];
-    }
+        if (prerequisiteConditions.count != 0) {
+            [self.prerequisiteConditions setObject:prerequisiteConditions forKey:task];
+        }
 
-    if (prerequisiteTasks.count != 0) {
-        [task didAddPrerequisiteTask];
-    }
+        for (TSKTask *prerequisiteTask in prerequisiteTasks) {
+            [self.graph addEdgeFromNode:prerequisiteTask.workflowNodeIndex toNode:nodeIndex];
+            [self.mutableTasksWithNoDependentTasks removeObject:prerequisiteTask];
+        }
 
-    self.tasksWithNoPrerequisiteTasks = [self.tasks objectsPassingTest:^BOOL(TSKTask *task, BOOL *stop) {
-        return task.prerequisiteTasks.count == 0;
-    }];
+        [self.mutableTasksWithNoDependentTasks addObject:task];
+        if (!hasPrerequisites) {
+            [self.mutableTasksWithNoPrerequisiteTasks addObject:task];
+        }
 
-    self.tasksWithNoDependentTasks = [self.tasks objectsPassingTest:^BOOL(TSKTask *task, BOOL *stop) {
-        return task.dependentTasks.count == 0;
-    }];
+        // Setting the workflow last publishes the task to other threads. See ‑containsTask:.
+        task.workflow = self;
+    }
+
+    pthread_rwlock_unlock(&_graphLock);
 
     [self didChangeValueForKey:@"allTasks" withSetMutation:NSKeyValueUnionSetMutation usingObjects:taskSet];
+
+    NSAssert(!previousWorkflow, @"Task (%@) has been previously added to a workflow (%@)", task, previousWorkflow);
+    NSAssert(prerequisitesInWorkflow, @"Prerequisite tasks have not been added to workflow");
+    if (!isValid) {
+        return;
+    }
+
+    // If the workflow is running, the new task is started as soon as its prerequisites have finished,
+    // which may be right now. Otherwise, it just becomes ready if its prerequisites have finished.
+    if (!self.isRunning || ![self needsTask:task]) {
+        [task transitionToReadyStateAndExecuteBlock:nil];
+    } else if (hasPrerequisites) {
+        [task startIfReady];
+    } else {
+        [task start];
+    }
 }
 
 
@@ -287,9 +679,148 @@ NSString *const TSKWorkflowTaskKey = @"TSKWorkflowTaskKey";
 }
 
 
+-           (void)addTask:(TSKTask *)task
+streamingPrerequisiteTask:(TSKTask *)streamingPrerequisiteTask
+                  channel:(TSKChannel *)channel
+        prerequisiteTasks:(NSSet *)prerequisiteTasks
+{
+    NSParameterAssert(task);
+    NSParameterAssert(streamingPrerequisiteTask);
+    NSParameterAssert(channel);
+    NSAssert(!task.workflow, @"Task (%@) has been previously added to a workflow (%@)", task, task.workflow);
+    NSAssert([self containsTask:streamingPrerequisiteTask], @"Streaming prerequisite task has not been added to workflow");
+    NSAssert(!streamingPrerequisiteTask.outputChannel, @"Streaming prerequisite task (%@) already has an output channel",
+             streamingPrerequisiteTask);
+
+    // The producer may already be executing, so it can send its first item before the consumer has
+    // been added. In that case, the handler does nothing, and the consumer is started when it is
+    // added below, since its readiness takes into account whether the channel has an item.
+    __weak TSKTask *weakTask = task;
+    channel.firstItemHandler = ^{
+        TSKTask *consumer = weakTask;
+        if (consumer.workflow) {
+            [consumer startIfReady];
+        }
+    };
+
+    task.inputChannel = channel;
+    streamingPrerequisiteTask.outputChannel = channel;
+
+    prerequisiteTasks = prerequisiteTasks ? [prerequisiteTasks setByAddingObject:streamingPrerequisiteTask]
+                                          : [NSSet setWithObject:streamingPrerequisiteTask];
+    [self addTask:task prerequisiteTasks:prerequisiteTasks keyedPrerequisiteTasks:nil];
+}
+
+
+- (void)adoptGraph:(TSKWorkflowGraph *)graph
+    keyedPrerequisiteTasks:(NSMapTable *)keyedPrerequisiteTasks
+    prerequisiteConditions:(NSMapTable *)prerequisiteConditions
+{
+    NSParameterAssert(graph);
+    NSAssert(!self.isRunning, @"Tasks cannot be adopted by a running workflow");
+
+    NSArray<TSKTask *> *tasks = graph.tasks;
+    NSUInteger nodeCount = tasks.count;
+
+    // As in ‑addTask:…, tasks with prerequisites must be pending before they’re visible to other threads.
+    // Every task is validated first, so that none are left pending if one can’t be adopted.
+    for (TSKTask *task in tasks) {
+        NSAssert(!task.workflow, @"Task (%@) has been previously added to a workflow (%@)", task, task.workflow);
+    }
+
+    for (NSUInteger index = 0; index < nodeCount; ++index) {
+        if ([graph prerequisiteCountOfNode:index] != 0) {
+            [tasks[index] didAddPrerequisiteTask];
+        }
+    }
+
+    NSSet *taskSet = [[NSSet alloc] initWithArray:tasks];
+    [self willChangeValueForKey:@"allTasks" withSetMutation:NSKeyValueUnionSetMutation usingObjects:taskSet];
+
+    pthread_rwlock_wrlock(&_graphLock);
+
+    BOOL isEmpty = self.graph.nodeCount == 0;
+    if (isEmpty) {
+        _graph = graph;
+
+        for (TSKTask *task in keyedPrerequisiteTasks) {
+            [self.keyedPrerequisiteTasks setObject:[keyedPrerequisiteTasks objectForKey:task] forKey:task];
+        }
+
+        for (TSKTask *task in prerequisiteConditions) {
+            [self.prerequisiteConditions setObject:[prerequisiteConditions objectForKey:task] forKey:task];
+        }
+
+        for (NSUInteger index = 0; index < nodeCount; ++index) {
+            TSKTask *task = tasks[index];
+            task.workflowNodeIndex = index;
+
+            if ([graph prerequisiteCountOfNode:index] == 0) {
+                [self.mutableTasksWithNoPrerequisiteTasks addObject:task];
+            }
+
+            if ([graph dependentCountOfNode:index] == 0) {
+                [self.mutableTasksWithNoDependentTasks addObject:task];
+            }
+
+            task.workflow = self;
+        }
+    }
+
+    pthread_rwlock_unlock(&_graphLock);
+
+    [self didChangeValueForKey:@"allTasks" withSetMutation:NSKeyValueUnionSetMutation usingObjects:taskSet];
+
+    NSAssert(isEmpty, @"Tasks can only be adopted by an empty workflow");
+}
+
+
+- (NSMapTable *)prerequisiteConditionsForTask:(TSKTask *)task
+{
+    NSParameterAssert(task);
+
+    pthread_rwlock_rdlock(&_graphLock);
+    NSMapTable *prerequisiteConditions = [self.prerequisiteConditions objectForKey:task];
+    pthread_rwlock_unlock(&_graphLock);
+    return prerequisiteConditions;
+}
+
+
+-             (void)addTask:(TSKTask *)task
+conditionalPrerequisiteTask:(TSKTask *)conditionalPrerequisiteTask
+                  condition:(BOOL (^)(id))condition
+          prerequisiteTasks:(NSSet *)prerequisiteTasks
+{
+    NSParameterAssert(conditionalPrerequisiteTask);
+    NSParameterAssert(condition);
+
+    NSMapTable *prerequisiteConditions = [NSMapTable strongToStrongObjectsMapTable];
+    [prerequisiteConditions setObject:[condition copy] forKey:conditionalPrerequisiteTask];
+
+    prerequisiteTasks = prerequisiteTasks ? [prerequisiteTasks setByAddingObject:conditionalPrerequisiteTask]
+                                          : [NSSet setWithObject:conditionalPrerequisiteTask];
+    [self addTask:task prerequisiteTasks:prerequisiteTasks keyedPrerequisiteTasks:nil prerequisiteConditions:prerequisiteConditions];
+}
+
+
+- (BOOL)containsTask:(TSKTask *)task
+{
+    // A task’s workflow is set only after it has been fully added to the graph, so if this is true,
+    // the task’s node is safe to read once the graph lock is acquired
+    return task.workflow == self;
+}
+
+
 - (NSSet *)prerequisiteTasksForTask:(TSKTask *)task
 {
-    return [self.prerequisiteTasks objectForKey:task];
+    if (![self containsTask:task]) {
+        return nil;
+    }
+
+    pthread_rwlock_rdlock(&_graphLock);
+    NSArray *prerequisiteTasks = [self.graph prerequisiteTasksOfNode:task.workflowNodeIndex];
+    pthread_rwlock_unlock(&_graphLock);
+    return [[NSSet alloc] initWithArray:prerequisiteTasks];
 }
 
 
@@ -303,13 +834,101 @@ NSString *const TSKWorkflowTaskKey = @"TSKWorkflowTaskKey";
 
 - (NSDictionary *)keyedPrerequisiteTasksForTask:(TSKTask *)task
 {
-    return [self.keyedPrerequisiteTasks objectForKey:task];
+    if (![self containsTask:task]) {
+        return nil;
+    }
+
+    pthread_rwlock_rdlock(&_graphLock);
+    NSDictionary *keyedPrerequisiteTasks = [self.keyedPrerequisiteTasks objectForKey:task];
+    pthread_rwlock_unlock(&_graphLock);
+    return keyedPrerequisiteTasks ? keyedPrerequisiteTasks : [NSDictionary dictionary];
 }
 
 
 - (NSSet *)dependentTasksForTask:(TSKTask *)task
 {
-    return [self.dependentTasks objectForKey:task];
+    if (![self containsTask:task]) {
+        return nil;
+    }
+
+    return [[NSSet alloc] initWithArray:[self dependentTaskArrayForTask:task]];
+}
+
+
+- (void)readGraphUsingBlock:(void (NS_NOESCAPE ^)(TSKWorkflowGraph *))block
+{
+    NSParameterAssert(block);
+
+    pthread_rwlock_rdlock(&_graphLock);
+    block(self.graph);
+    pthread_rwlock_unlock(&_graphLock);
+}
+
+
+- (BOOL)allPrerequisiteTasksOfTask:(TSKTask *)task passTest:(BOOL (NS_NOESCAPE ^)(TSKTask *prerequisiteTask))predicate
+{
+    if (![self containsTask:task]) {
+        return YES;
+    }
+
+    __block BOOL allPassed = YES;
+    TSKWorkflowGraph *graph = self.graph;
+
+    pthread_rwlock_rdlock(&_graphLock);
+    [graph enumeratePrerequisitesOfNode:task.workflowNodeIndex usingBlock:^(NSUInteger prerequisiteIndex, BOOL *stop) {
+        if (!predicate([graph taskAtNode:prerequisiteIndex])) {
+            allPassed = NO;
+            *stop = YES;
+        }
+    }];
+    pthread_rwlock_unlock(&_graphLock);
+
+    return allPassed;
+}
+
+
+- (void)enumeratePrerequisiteTasksOfTask:(TSKTask *)task
+                              usingBlock:(void (NS_NOESCAPE ^)(TSKTask *, BOOL (^)(id), BOOL *))block
+{
+    if (![self containsTask:task]) {
+        return;
+    }
+
+    TSKWorkflowGraph *graph = self.graph;
+
+    // Conditions are client code that may re-enter the workflow, so we copy the prerequisites and
+    // their conditions while holding the lock and only execute the block after unlocking it
+    NSMutableArray<TSKTask *> *prerequisiteTasks = [[NSMutableArray alloc] init];
+    NSMutableArray *prerequisiteConditions = [[NSMutableArray alloc] init];
+
+    pthread_rwlock_rdlock(&_graphLock);
+    NSMapTable *conditions = [self.prerequisiteConditions objectForKey:task];
+    [graph enumeratePrerequisitesOfNode:task.workflowNodeIndex usingBlock:^(NSUInteger prerequisiteIndex, BOOL *stop) {
+        TSKTask *prerequisiteTask = [graph taskAtNode:prerequisiteIndex];
+        id condition = conditions ? [conditions objectForKey:prerequisiteTask] : nil;
+        [prerequisiteTasks addObject:prerequisiteTask];
+        [prerequisiteConditions addObject:condition ?: [NSNull null]];
+    }];
+    pthread_rwlock_unlock(&_graphLock);
+
+    BOOL stop = NO;
+    for (NSUInteger i = 0; i < prerequisiteTasks.count && !stop; ++i) {
+        id condition = prerequisiteConditions[i];
+        block(prerequisiteTasks[i], condition != [NSNull null] ? condition : nil, &stop);
+    }
+}
+
+
+- (NSArray<TSKTask *> *)dependentTaskArrayForTask:(TSKTask *)task
+{
+    if (![self containsTask:task]) {
+        return @[];
+    }
+
+    pthread_rwlock_rdlock(&_graphLock);
+    NSArray *dependentTasks = [self.graph dependentTasksOfNode:task.workflowNodeIndex];
+    pthread_rwlock_unlock(&_graphLock);
+    return dependentTasks;
 }
 
 
@@ -317,7 +936,7 @@ NSString *const TSKWorkflowTaskKey = @"TSKWorkflowTaskKey";
 {
     __block BOOL hasUnfinishedTasks = NO;
     dispatch_sync(self.finishedTasksQueue, ^{
-        hasUnfinishedTasks = ![self.tasksWithNoDependentTasks isSubsetOfSet:self.finishedTasks];
+        hasUnfinishedTasks = ![self tasksWithNoDependentTasksAreSubsetOfSet:self.finishedTasks];
     });
 
     return hasUnfinishedTasks;
@@ -326,7 +945,7 @@ NSString *const TSKWorkflowTaskKey = @"TSKWorkflowTaskKey";
 
 - (BOOL)hasFailedTasks
 {
-    for (TSKTask *task in self.tasks) {
+    for (TSKTask *task in [self allTaskArray]) {
         if (task.isFailed) {
             return YES;
         }
@@ -341,59 +960,410 @@ NSString *const TSKWorkflowTaskKey = @"TSKWorkflowTaskKey";
 - (void)start
 {
     [self.notificationCenter postNotificationName:TSKWorkflowWillStartNotification object:self];
+    atomic_store(&_running, true);
+    [self beginRun];
+    [self armTimeoutTimer];
+
+    BOOL hadTargetTasks = self.neededNodeIndexes != nil;
+    self.neededNodeIndexes = nil;
+    self.targetTasks = nil;
+
+    NSArray<TSKTask *> *tasks = [self allTaskArray];
+    if (tasks.count == 0) {
+        [self didFinish];
+        return;
+    }
+
+    [self setActive:YES];
+
+    // Running for targets may have left tasks anywhere in the graph ready but unstarted
+    if (hadTargetTasks) {
+        [self startTasksIfReady:tasks];
+    } else {
+        [self.tasksWithNoPrerequisiteTasks makeObjectsPerformSelector:@selector(start)];
+    }
+}
+
+
+- (void)startForTargetTasks:(NSSet<TSKTask *> *)targetTasks
+{
+    NSParameterAssert(targetTasks.count != 0);
+    for (TSKTask *targetTask in targetTasks) {
+        NSAssert([self containsTask:targetTask], @"Target task (%@) is not in the workflow", targetTask);
+    }
+
+    targetTasks = [targetTasks copy];
+
+    // Walk backwards from the targets, visiting each needed node and prerequisite relationship once
+    NSMutableIndexSet *neededNodeIndexes = [[NSMutableIndexSet alloc] init];
+    NSMutableArray<TSKTask *> *neededTasks = [[NSMutableArray alloc] init];
+
+    pthread_rwlock_rdlock(&_graphLock);
+    TSKWorkflowGraph *graph = self.graph;
+    NSUInteger nodeCount = graph.nodeCount;
+    bool *visited = calloc(nodeCount, sizeof(bool));
+    NSUInteger *stack = malloc(nodeCount * sizeof(NSUInteger));
+    if (!visited || !stack) {
+        free(visited);
+        free(stack);
+        pthread_rwlock_unlock(&_graphLock);
+        [NSException raise:NSMallocException format:@"Could not allocate memory to find needed tasks"];
+    }
 
-    if (self.tasks.count == 0) {
-        if ([self.delegate respondsToSelector:@selector(workflowDidFinish:)]) {
-            [self.delegate workflowDidFinish:self];
+    __block NSUInteger stackCount = 0;
+    for (TSKTask *targetTask in targetTasks) {
+        NSUInteger index = targetTask.workflowNodeIndex;
+        if (!visited[index]) {
+            visited[index] = true;
+            stack[stackCount++] = index;
         }
+    }
+
+    while (stackCount != 0) {
+        [graph enumeratePrerequisitesOfNode:stack[--stackCount] usingBlock:^(NSUInteger prerequisiteIndex, BOOL *stop) {
+            if (!visited[prerequisiteIndex]) {
+                visited[prerequisiteIndex] = true;
+                stack[stackCount++] = prerequisiteIndex;
+            }
+        }];
+    }
+
+    // Visiting nodes in order keeps index set insertion cheap and starts tasks in topological order
+    for (NSUInteger index = 0; index < nodeCount; ++index) {
+        if (visited[index]) {
+            [neededNodeIndexes addIndex:index];
+            [neededTasks addObject:[graph taskAtNode:index]];
+        }
+    }
+
+    pthread_rwlock_unlock(&_graphLock);
+    free(visited);
+    free(stack);
+
+    [self.notificationCenter postNotificationName:TSKWorkflowWillStartNotification object:self];
+    self.neededNodeIndexes = neededNodeIndexes;
+    self.targetTasks = targetTasks;
+    atomic_store(&_running, true);
+    [self beginRun];
+    [self armTimeoutTimer];
 
-        [self.notificationCenter postNotificationName:TSKWorkflowDidFinishNotification object:self];
+    __block BOOL targetTasksFinished = NO;
+    dispatch_sync(self.finishedTasksQueue, ^{
+        targetTasksFinished = [targetTasks isSubsetOfSet:self.finishedTasks];
+    });
+
+    if (targetTasksFinished) {
+        [self didFinish];
         return;
     }
 
-    [self.tasksWithNoPrerequisiteTasks makeObjectsPerformSelector:@selector(start)];
+    [self setActive:YES];
+    [self startTasksIfReady:neededTasks];
+}
+
+
+- (void)startTasksIfReady:(NSArray<TSKTask *> *)tasks
+{
+    for (TSKTask *task in tasks) {
+        if (task.state == TSKTaskStatePending) {
+            [task startIfReady];
+        } else {
+            [task start];
+        }
+    }
+}
+
+
+- (BOOL)needsTask:(TSKTask *)task
+{
+    NSIndexSet *neededNodeIndexes = self.neededNodeIndexes;
+    return !neededNodeIndexes || [neededNodeIndexes containsIndex:task.workflowNodeIndex];
+}
+
+
+- (void)didFinish
+{
+    [self setActive:NO];
+    [self disarmTimeoutTimer];
+
+    if ([self.delegate respondsToSelector:@selector(workflowDidFinish:)]) {
+        [self.delegate workflowDidFinish:self];
+    }
+
+    [self.notificationCenter postNotificationName:TSKWorkflowDidFinishNotification object:self];
+    [self completeWithOutcome:TSKWorkflowOutcomeFinished error:nil];
 }
 
 
 - (void)cancel
 {
     [self.notificationCenter postNotificationName:TSKWorkflowWillCancelNotification object:self];
+    atomic_store(&_running, false);
+    [self setActive:NO];
+    [self disarmTimeoutTimer];
     [self.tasksWithNoPrerequisiteTasks makeObjectsPerformSelector:@selector(cancel)];
+    [self completeWithOutcome:TSKWorkflowOutcomeCancelled error:nil];
 }
 
 
 - (void)reset
 {
     [self.notificationCenter postNotificationName:TSKWorkflowWillResetNotification object:self];
+    atomic_store(&_running, false);
+    [self setActive:NO];
+    [self disarmTimeoutTimer];
+    self.timeoutError = nil;
     [self.tasksWithNoPrerequisiteTasks makeObjectsPerformSelector:@selector(reset)];
+    [self completeWithOutcome:TSKWorkflowOutcomeCancelled error:nil];
 }
 
 
 - (void)retry
 {
     [self.notificationCenter postNotificationName:TSKWorkflowWillRetryNotification object:self];
+    atomic_store(&_running, true);
+    [self setActive:YES];
+    [self beginRun];
+    [self armTimeoutTimer];
     [self.tasksWithNoPrerequisiteTasks makeObjectsPerformSelector:@selector(retry)];
 }
 
 
+#pragma mark - Completion Handlers
+
+- (void)startWithCompletionHandler:(TSKWorkflowCompletionHandler)completionHandler
+{
+    NSParameterAssert(completionHandler);
+
+    // If the workflow already has an outcome, starting it again won’t change it, so we report it now
+    NSArray<TSKTask *> *tasks = [self allTaskArray];
+    TSKTask *failedTask = nil;
+    BOOL hasCancelledTask = NO;
+    BOOL hasUnfinishedTask = NO;
+    for (TSKTask *task in tasks) {
+        TSKTaskState state = task.state;
+        if (state == TSKTaskStateFailed) {
+            failedTask = task;
+            break;
+        }
+
+        hasCancelledTask = hasCancelledTask || state == TSKTaskStateCancelled;
+        hasUnfinishedTask = hasUnfinishedTask || (state != TSKTaskStateFinished && state != TSKTaskStateSkipped);
+    }
+
+    if (failedTask) {
+        completionHandler(TSKWorkflowOutcomeFailed, failedTask.error);
+        return;
+    } else if (hasCancelledTask) {
+        completionHandler(TSKWorkflowOutcomeCancelled, nil);
+        return;
+    } else if (tasks.count > 0 && !hasUnfinishedTask) {
+        completionHandler(TSKWorkflowOutcomeFinished, nil);
+        return;
+    }
+
+    [self.outcomeCondition lock];
+    if (!self.completionHandlers) {
+        self.completionHandlers = [[NSMutableArray alloc] init];
+    }
+
+    [self.completionHandlers addObject:[completionHandler copy]];
+    [self.outcomeCondition unlock];
+
+    [self start];
+}
+
+
+- (void)beginRun
+{
+    [self.outcomeCondition lock];
+    _hasOutcome = NO;
+    self.outcomeError = nil;
+    [self.outcomeCondition unlock];
+}
+
+
+- (void)completeWithOutcome:(TSKWorkflowOutcome)outcome error:(NSError *)error
+{
+    NSCondition *outcomeCondition = self.outcomeCondition;
+    [outcomeCondition lock];
+    if (!_hasOutcome) {
+        _hasOutcome = YES;
+        _outcome = outcome;
+        self.outcomeError = error;
+        [outcomeCondition broadcast];
+    }
+
+    NSArray<TSKWorkflowCompletionHandler> *completionHandlers = self.completionHandlers;
+    self.completionHandlers = nil;
+    [outcomeCondition unlock];
+
+    for (TSKWorkflowCompletionHandler completionHandler in completionHandlers) {
+        completionHandler(outcome, error);
+    }
+}
+
+
+- (TSKWorkflowOutcome)waitUntilFinishedWithTimeout:(NSTimeInterval)timeout error:(NSError **)error
+{
+    NSDate *limitDate = [NSDate dateWithTimeIntervalSinceNow:MAX(timeout, 0)];
+
+    NSCondition *outcomeCondition = self.outcomeCondition;
+    [outcomeCondition lock];
+    while (!_hasOutcome) {
+        if (![outcomeCondition waitUntilDate:limitDate]) {
+            break;
+        }
+    }
+
+    TSKWorkflowOutcome outcome = _hasOutcome ? _outcome : TSKWorkflowOutcomeUnfinished;
+    NSError *outcomeError = self.outcomeError;
+    [outcomeCondition unlock];
+
+    if (error) {
+        *error = outcomeError;
+    }
+
+    return outcome;
+}
+
+
+#pragma mark - Timeouts
+
+- (void)armTimeoutTimer
+{
+    [self disarmTimeoutTimer];
+    self.timeoutError = nil;
+
+    NSTimeInterval timeout = self.timeout;
+    if (timeout <= 0) {
+        return;
+    }
+
+    // The lock is held while arming so that the timer is recorded before its handler can check it
+    __weak typeof(self) weakSelf = self;
+    os_unfair_lock_lock(&_timeoutLock);
+    uint64_t generation = ++_timeoutGeneration;
+    TSKTimerWheelTimer *previousTimer = self.timeoutTimer;
+    self.timeoutTimer = [[TSKTimerWheel sharedTimerWheel] armTimerWithInterval:timeout handler:^{
+        [weakSelf timeOutWithGeneration:generation];
+    }];
+    os_unfair_lock_unlock(&_timeoutLock);
+
+    // Another thread may have armed a timer since we disarmed ours
+    if (previousTimer) {
+        [[TSKTimerWheel sharedTimerWheel] disarmTimer:previousTimer];
+    }
+}
+
+
+- (void)disarmTimeoutTimer
+{
+    os_unfair_lock_lock(&_timeoutLock);
+    TSKTimerWheelTimer *timer = self.timeoutTimer;
+    self.timeoutTimer = nil;
+    os_unfair_lock_unlock(&_timeoutLock);
+
+    if (timer) {
+        [[TSKTimerWheel sharedTimerWheel] disarmTimer:timer];
+    }
+}
+
+
+- (void)timeOutWithGeneration:(uint64_t)generation
+{
+    os_unfair_lock_lock(&_timeoutLock);
+    BOOL isCurrentTimer = self.timeoutTimer && _timeoutGeneration == generation;
+    if (isCurrentTimer) {
+        self.timeoutTimer = nil;
+    }
+    os_unfair_lock_unlock(&_timeoutLock);
+
+    if (!isCurrentTimer) {
+        return;
+    }
+
+    NSError *error = [NSError errorWithDomain:TSKTaskErrorDomain
+                                         code:TSKErrorCodeTimedOut
+                                     userInfo:@{ NSLocalizedDescriptionKey : @"Workflow’s timeout elapsed before it finished" }];
+
+    // Tasks that are about to start check this, so it must be set before executing tasks are failed.
+    // Tasks that are not executing ignore ‑failWithError:.
+    self.timeoutError = error;
+    for (TSKTask *task in [self allTaskArray]) {
+        [task failWithError:error];
+    }
+}
+
+
+#pragma mark - State Observers
+
+- (void)addStateObserver:(TSKWorkflowStateObserver *)observer
+{
+    NSParameterAssert(observer);
+
+    os_unfair_lock_lock(&_stateObserverLock);
+    _stateObservers = _stateObservers ? [_stateObservers arrayByAddingObject:observer] : @[ observer ];
+    os_unfair_lock_unlock(&_stateObserverLock);
+}
+
+
+- (void)removeStateObserver:(TSKWorkflowStateObserver *)observer
+{
+    NSParameterAssert(observer);
+
+    os_unfair_lock_lock(&_stateObserverLock);
+    NSMutableArray<TSKWorkflowStateObserver *> *stateObservers = [_stateObservers mutableCopy];
+    [stateObservers removeObjectIdenticalTo:observer];
+    _stateObservers = stateObservers.count > 0 ? [stateObservers copy] : nil;
+    os_unfair_lock_unlock(&_stateObserverLock);
+}
+
+
 #pragma mark - Subtask State
 
+- (void)subtaskDidChangeState:(TSKTask *)task
+{
+    os_unfair_lock_lock(&_stateObserverLock);
+    NSArray<TSKWorkflowStateObserver *> *stateObservers = _stateObservers;
+    os_unfair_lock_unlock(&_stateObserverLock);
+
+    for (TSKWorkflowStateObserver *observer in stateObservers) {
+        [observer taskDidChangeState:task];
+    }
+}
+
+
 - (void)subtask:(TSKTask *)task didFinishWithResult:(id)result
 {
     NSParameterAssert(task);
 
+    [self subtaskIsDone:task];
+}
+
+
+- (void)subtaskDidSkip:(TSKTask *)task
+{
+    NSParameterAssert(task);
+
+    // Skipping is a normal outcome, so the workflow can finish with skipped tasks
+    [self subtaskIsDone:task];
+}
+
+
+- (void)subtaskIsDone:(TSKTask *)task
+{
+    // When running for targets, the workflow is finished once the targets are
+    NSSet<TSKTask *> *targetTasks = self.targetTasks;
     __block BOOL allTasksFinished = NO;
     dispatch_barrier_sync(self.finishedTasksQueue, ^{
         [self.finishedTasks addObject:task];
-        allTasksFinished = [self.tasksWithNoDependentTasks isSubsetOfSet:self.finishedTasks];
+        allTasksFinished = targetTasks ? [targetTasks isSubsetOfSet:self.finishedTasks]
+                                       : [self tasksWithNoDependentTasksAreSubsetOfSet:self.finishedTasks];
     });
 
     if (allTasksFinished) {
-        if ([self.delegate respondsToSelector:@selector(workflowDidFinish:)]) {
-            [self.delegate workflowDidFinish:self];
-        }
-
-        [self.notificationCenter postNotificationName:TSKWorkflowDidFinishNotification object:self];
+        [self didFinish];
     }
 }
 
@@ -402,11 +1372,15 @@ NSString *const TSKWorkflowTaskKey = @"TSKWorkflowTaskKey";
 {
     NSParameterAssert(task);
 
+    [self setActive:NO];
+    [self disarmTimeoutTimer];
+
     if ([self.delegate respondsToSelector:@selector(workflow:task:didFailWithError:)]) {
         [self.delegate workflow:self task:task didFailWithError:error];
     }
 
     [self.notificationCenter postNotificationName:TSKWorkflowTaskDidFailNotification object:self userInfo:@{ TSKWorkflowTaskKey : task }];
+    [self completeWithOutcome:TSKWorkflowOutcomeFailed error:error];
 }
 
 
@@ -414,11 +1388,14 @@ NSString *const TSKWorkflowTaskKey = @"TSKWorkflowTaskKey";
 {
     NSParameterAssert(task);
 
+    [self disarmTimeoutTimer];
+
     if ([self.delegate respondsToSelector:@selector(workflow:taskDidCancel:)]) {
         [self.delegate workflow:self taskDidCancel:task];
     }
 
     [self.notificationCenter postNotificationName:TSKWorkflowTaskDidCancelNotification object:self userInfo:@{ TSKWorkflowTaskKey : task }];
+    [self completeWithOutcome:TSKWorkflowOutcomeCancelled error:nil];
 }
 
 
@@ -431,4 +1408,18 @@ NSString *const TSKWorkflowTaskKey = @"TSKWorkflowTaskKey";
     });
 }
 
+
+- (void)subtaskDidInvalidate:(TSKTask *)task
+{
+    NSParameterAssert(task);
+
+    // Unlike when resetting, this must happen synchronously. The task may finish again right away, and
+    // an asynchronous removal could then remove it after it had been added back.
+    dispatch_barrier_sync(self.finishedTasksQueue, ^{
+        [self.finishedTasks removeObject:task];
+    });
+
+    [self setActive:YES];
+}
+
 @end
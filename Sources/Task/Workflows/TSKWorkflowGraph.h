@@ -0,0 +1,141 @@
+//
+//  TSKWorkflowGraph.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class TSKTask;
+
+/*!
+ TSKWorkflowGraph stores the prerequisite and dependent relationships between the tasks in a
+ workflow. Each task is identified by a node index that is assigned when the task is added to the
+ graph.
+
+ Edge lists and per-node bookkeeping are carved out of large memory chunks owned by the graph, so
+ building a graph performs a small number of allocations regardless of how many tasks and edges it
+ has, and destroying the graph frees all of them at once.
+
+ Graphs can share their nodes and edges with other graphs that have the same structure but different
+ tasks. Shared structure is copied the first time one of the graphs sharing it is modified.
+
+ Access to a graph is not thread-safe.
+ */
+@interface TSKWorkflowGraph : NSObject
+
+/*! The number of nodes in the graph. */
+@property (nonatomic, assign, readonly) NSUInteger nodeCount;
+
+/*! The tasks in the graph, ordered by their node index. */
+@property (nonatomic, copy, readonly) NSArray<TSKTask *> *tasks;
+
+/*! The number of memory chunks the graph has allocated to hold its bookkeeping. */
+@property (nonatomic, assign, readonly) NSUInteger chunkCount;
+
+/*! Whether the graph shares its nodes and edges with another graph. */
+@property (nonatomic, assign, readonly) BOOL sharesStorage;
+
+/*!
+ @abstract Initializes a newly created, empty graph.
+ @result A newly initialized graph.
+ */
+- (instancetype)init NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Initializes a newly created graph that shares the specified graph’s nodes and edges, but
+     has different tasks.
+ @discussion No memory is allocated for nodes or edges until either graph is modified.
+ @param graph The graph whose nodes and edges to share. May not be nil.
+ @param tasks The tasks for the new graph’s nodes, ordered by node index. Must contain one task per
+     node in graph.
+ @result A newly initialized graph.
+ */
+- (instancetype)initWithGraph:(TSKWorkflowGraph *)graph tasks:(NSArray<TSKTask *> *)tasks NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Adds a node for the specified task to the graph.
+ @param task The task. May not be nil.
+ @result The index of the newly added node.
+ */
+- (NSUInteger)addNodeWithTask:(TSKTask *)task;
+
+/*!
+ @abstract Adds an edge between the specified nodes.
+ @discussion Adding the same edge more than once results in duplicate edges.
+ @param prerequisiteIndex The index of the prerequisite node.
+ @param dependentIndex The index of the dependent node.
+ */
+- (void)addEdgeFromNode:(NSUInteger)prerequisiteIndex toNode:(NSUInteger)dependentIndex;
+
+/*!
+ @abstract Returns the task for the node with the specified index.
+ @param index The node index.
+ @result The task for the node.
+ */
+- (TSKTask *)taskAtNode:(NSUInteger)index;
+
+/*! Returns the number of prerequisites of the node with the specified index. */
+- (NSUInteger)prerequisiteCountOfNode:(NSUInteger)index;
+
+/*! Returns the number of dependents of the node with the specified index. */
+- (NSUInteger)dependentCountOfNode:(NSUInteger)index;
+
+/*!
+ @abstract Returns the prerequisite tasks of the node with the specified index.
+ @param index The node index.
+ @result An array of the node’s prerequisite tasks in the order their edges were added.
+ */
+- (NSArray<TSKTask *> *)prerequisiteTasksOfNode:(NSUInteger)index;
+
+/*!
+ @abstract Returns the dependent tasks of the node with the specified index.
+ @param index The node index.
+ @result An array of the node’s dependent tasks in the order their edges were added.
+ */
+- (NSArray<TSKTask *> *)dependentTasksOfNode:(NSUInteger)index;
+
+/*!
+ @abstract Enumerates the prerequisite nodes of the node with the specified index.
+ @discussion The block must not modify the graph.
+ @param index The node index.
+ @param block The block to execute for each prerequisite node index. Setting *stop to YES ends the
+     enumeration.
+ */
+- (void)enumeratePrerequisitesOfNode:(NSUInteger)index usingBlock:(void (NS_NOESCAPE ^)(NSUInteger prerequisiteIndex, BOOL *stop))block;
+
+/*!
+ @abstract Enumerates the dependent nodes of the node with the specified index.
+ @discussion The block must not modify the graph.
+ @param index The node index.
+ @param block The block to execute for each dependent node index. Setting *stop to YES ends the
+     enumeration.
+ */
+- (void)enumerateDependentsOfNode:(NSUInteger)index usingBlock:(void (NS_NOESCAPE ^)(NSUInteger dependentIndex, BOOL *stop))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,431 @@
+//
+//  TSKWorkflowGraph.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TSKWorkflowGraph.h"
+
+#import <Task/TSKTask.h>
+#import <stdatomic.h>
+
+
+#pragma mark Arena
+
+/*! The size of a regular arena chunk, including its header. */
+static const size_t kTSKArenaChunkSize = 16 * 1024;
+
+/*! The number of nodes stored in each node page. */
+static const NSUInteger kTSKNodesPerPage = 256;
+
+/*! The number of node indexes stored in each edge block. */
+#define TSK_EDGE_BLOCK_CAPACITY 6
+
+
+/*! A chunk of memory from which arena allocations are carved. */
+typedef struct TSKArenaChunk {
+    struct TSKArenaChunk *next;
+    size_t size;
+    size_t used;
+    max_align_t bytes[];
+} TSKArenaChunk;
+
+
+/*!
+ A simple bump allocator. Allocations cannot be freed individually; all the memory in an arena is
+ freed at once by TSKArenaDestroy.
+ */
+typedef struct {
+    TSKArenaChunk *chunks;
+    NSUInteger chunkCount;
+} TSKArena;
+
+
+static void *TSKArenaAllocate(TSKArena *arena, size_t size)
+{
+    size = (size + sizeof(max_align_t) - 1) & ~(sizeof(max_align_t) - 1);
+
+    TSKArenaChunk *chunk = arena->chunks;
+    if (!chunk || chunk->size - chunk->used < size) {
+        size_t capacity = MAX(kTSKArenaChunkSize - sizeof(TSKArenaChunk), size);
+        chunk = calloc(1, sizeof(TSKArenaChunk) + capacity);
+        if (!chunk) {
+            [NSException raise:NSMallocException format:@"Could not allocate %zu bytes for workflow graph", capacity];
+        }
+
+        chunk->size = capacity;
+
+        // Oversized allocations get a dedicated chunk that goes behind the current one so that the
+        // remainder of the current chunk can still be used
+        if (arena->chunks && capacity == size) {
+            chunk->next = arena->chunks->next;
+            arena->chunks->next = chunk;
+        } else {
+            chunk->next = arena->chunks;
+            arena->chunks = chunk;
+        }
+
+        ++arena->chunkCount;
+    }
+
+    void *allocation = (uint8_t *)chunk->bytes + chunk->used;
+    chunk->used += size;
+    return allocation;
+}
+
+
+static void TSKArenaDestroy(TSKArena *arena)
+{
+    TSKArenaChunk *chunk = arena->chunks;
+    while (chunk) {
+        TSKArenaChunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    arena->chunks = NULL;
+    arena->chunkCount = 0;
+}
+
+
+#pragma mark - Nodes and Edges
+
+/*! A fixed-size block of node indexes in an edge list. */
+typedef struct TSKEdgeBlock {
+    struct TSKEdgeBlock *next;
+    uint32_t count;
+    uint32_t indexes[TSK_EDGE_BLOCK_CAPACITY];
+} TSKEdgeBlock;
+
+
+/*! A singly linked list of edge blocks. Edges are appended to the tail block. */
+typedef struct {
+    TSKEdgeBlock *head;
+    TSKEdgeBlock *tail;
+    uint32_t count;
+} TSKEdgeList;
+
+
+typedef struct {
+    TSKEdgeList prerequisites;
+    TSKEdgeList dependents;
+} TSKGraphNode;
+
+
+static void TSKEdgeListAppend(TSKArena *arena, TSKEdgeList *list, uint32_t index)
+{
+    if (!list->tail || list->tail->count == TSK_EDGE_BLOCK_CAPACITY) {
+        TSKEdgeBlock *block = TSKArenaAllocate(arena, sizeof(TSKEdgeBlock));
+        if (list->tail) {
+            list->tail->next = block;
+        } else {
+            list->head = block;
+        }
+
+        list->tail = block;
+    }
+
+    list->tail->indexes[list->tail->count++] = index;
+    ++list->count;
+}
+
+
+static void TSKEdgeListEnumerate(const TSKEdgeList *list, void (NS_NOESCAPE ^block)(NSUInteger index, BOOL *stop))
+{
+    BOOL stop = NO;
+    for (TSKEdgeBlock *edgeBlock = list->head; edgeBlock; edgeBlock = edgeBlock->next) {
+        for (uint32_t i = 0; i < edgeBlock->count; ++i) {
+            block(edgeBlock->indexes[i], &stop);
+            if (stop) {
+                return;
+            }
+        }
+    }
+}
+
+
+#pragma mark - Storage
+
+/*!
+ The nodes and edges of a graph. Storage is reference counted so that graphs can share it. Shared
+ storage is never modified; a graph whose storage is shared copies it before modifying it.
+ */
+typedef struct {
+    _Atomic(NSUInteger) referenceCount;
+    TSKArena arena;
+
+    /*!
+     Nodes are stored in fixed-size pages allocated from the arena so that existing nodes never move
+     when the graph grows. Only the page table itself is reallocated.
+     */
+    TSKGraphNode **pages;
+    NSUInteger pageCapacity;
+    NSUInteger nodeCount;
+} TSKGraphStorage;
+
+
+static TSKGraphStorage *TSKGraphStorageCreate(void)
+{
+    TSKGraphStorage *storage = calloc(1, sizeof(TSKGraphStorage));
+    if (!storage) {
+        [NSException raise:NSMallocException format:@"Could not allocate workflow graph"];
+    }
+
+    atomic_init(&storage->referenceCount, 1);
+    return storage;
+}
+
+
+static void TSKGraphStorageRelease(TSKGraphStorage *storage)
+{
+    if (atomic_fetch_sub_explicit(&storage->referenceCount, 1, memory_order_acq_rel) != 1) {
+        return;
+    }
+
+    free(storage->pages);
+    TSKArenaDestroy(&storage->arena);
+    free(storage);
+}
+
+
+static TSKGraphNode *TSKGraphStorageNodeAtIndex(TSKGraphStorage *storage, NSUInteger index)
+{
+    NSCAssert(index < storage->nodeCount, @"Node index %lu is out of bounds", (unsigned long)index);
+    return &storage->pages[index / kTSKNodesPerPage][index % kTSKNodesPerPage];
+}
+
+
+static NSUInteger TSKGraphStorageAddNode(TSKGraphStorage *storage)
+{
+    NSCAssert(storage->nodeCount < UINT32_MAX, @"Workflow graphs may not have more than %u nodes", UINT32_MAX);
+
+    NSUInteger index = storage->nodeCount;
+    NSUInteger pageIndex = index / kTSKNodesPerPage;
+    if (index % kTSKNodesPerPage == 0) {
+        if (pageIndex == storage->pageCapacity) {
+            storage->pageCapacity = storage->pageCapacity ? storage->pageCapacity * 2 : 4;
+            TSKGraphNode **pages = realloc(storage->pages, storage->pageCapacity * sizeof(TSKGraphNode *));
+            if (!pages) {
+                [NSException raise:NSMallocException format:@"Could not allocate workflow graph page table"];
+            }
+
+            storage->pages = pages;
+        }
+
+        storage->pages[pageIndex] = TSKArenaAllocate(&storage->arena, kTSKNodesPerPage * sizeof(TSKGraphNode));
+    }
+
+    // Arena memory is zeroed, so the node’s edge lists are already empty
+    ++storage->nodeCount;
+    return index;
+}
+
+
+static void TSKGraphStorageAddEdge(TSKGraphStorage *storage, NSUInteger prerequisiteIndex, NSUInteger dependentIndex)
+{
+    TSKEdgeListAppend(&storage->arena, &TSKGraphStorageNodeAtIndex(storage, prerequisiteIndex)->dependents, (uint32_t)dependentIndex);
+    TSKEdgeListAppend(&storage->arena, &TSKGraphStorageNodeAtIndex(storage, dependentIndex)->prerequisites, (uint32_t)prerequisiteIndex);
+}
+
+
+/*! Returns an unshared copy of the specified storage with the same nodes and edges in the same order. */
+static TSKGraphStorage *TSKGraphStorageCopy(TSKGraphStorage *storage)
+{
+    TSKGraphStorage *copy = TSKGraphStorageCreate();
+    for (NSUInteger i = 0; i < storage->nodeCount; ++i) {
+        TSKGraphStorageAddNode(copy);
+
+        // Edges are only ever added to the node being added, so replaying each node’s prerequisites
+        // in order reproduces every edge list in its original order
+        const TSKEdgeList *prerequisites = &TSKGraphStorageNodeAtIndex(storage, i)->prerequisites;
+        TSKEdgeListEnumerate(prerequisites, ^(NSUInteger prerequisiteIndex, BOOL *stop) {
+            TSKGraphStorageAddEdge(copy, prerequisiteIndex, i);
+        });
+    }
+
+    return copy;
+}
+
+
+#pragma mark -
+
+@interface TSKWorkflowGraph () {
+    TSKGraphStorage *_storage;
+}
+
+@property (nonatomic, strong, readonly) NSMutableArray<TSKTask *> *mutableTasks;
+
+@end
+
+
+@implementation TSKWorkflowGraph
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _storage = TSKGraphStorageCreate();
+        _mutableTasks = [[NSMutableArray alloc] init];
+    }
+
+    return self;
+}
+
+
+- (instancetype)initWithGraph:(TSKWorkflowGraph *)graph tasks:(NSArray<TSKTask *> *)tasks
+{
+    NSParameterAssert(graph);
+    NSParameterAssert(tasks.count == graph.nodeCount);
+
+    self = [super init];
+    if (self) {
+        _storage = graph->_storage;
+        atomic_fetch_add_explicit(&_storage->referenceCount, 1, memory_order_relaxed);
+        _mutableTasks = [tasks mutableCopy];
+    }
+
+    return self;
+}
+
+
+- (void)dealloc
+{
+    TSKGraphStorageRelease(_storage);
+}
+
+
+- (NSUInteger)nodeCount
+{
+    return _storage->nodeCount;
+}
+
+
+- (NSArray<TSKTask *> *)tasks
+{
+    return [self.mutableTasks copy];
+}
+
+
+- (NSUInteger)chunkCount
+{
+    return _storage->arena.chunkCount;
+}
+
+
+- (BOOL)sharesStorage
+{
+    return atomic_load_explicit(&_storage->referenceCount, memory_order_acquire) > 1;
+}
+
+
+- (TSKGraphNode *)nodeAtIndex:(NSUInteger)index
+{
+    return TSKGraphStorageNodeAtIndex(_storage, index);
+}
+
+
+#pragma mark -
+
+/*! Ensures that the graph’s storage is not shared so that it can be modified. */
+- (void)prepareForMutation
+{
+    if (self.sharesStorage) {
+        TSKGraphStorage *storage = TSKGraphStorageCopy(_storage);
+        TSKGraphStorageRelease(_storage);
+        _storage = storage;
+    }
+}
+
+
+- (NSUInteger)addNodeWithTask:(TSKTask *)task
+{
+    NSParameterAssert(task);
+
+    [self prepareForMutation];
+    NSUInteger index = TSKGraphStorageAddNode(_storage);
+    [self.mutableTasks addObject:task];
+    return index;
+}
+
+
+- (void)addEdgeFromNode:(NSUInteger)prerequisiteIndex toNode:(NSUInteger)dependentIndex
+{
+    [self prepareForMutation];
+    TSKGraphStorageAddEdge(_storage, prerequisiteIndex, dependentIndex);
+}
+
+
+- (TSKTask *)taskAtNode:(NSUInteger)index
+{
+    return self.mutableTasks[index];
+}
+
+
+- (NSUInteger)prerequisiteCountOfNode:(NSUInteger)index
+{
+    return [self nodeAtIndex:index]->prerequisites.count;
+}
+
+
+- (NSUInteger)dependentCountOfNode:(NSUInteger)index
+{
+    return [self nodeAtIndex:index]->dependents.count;
+}
+
+
+- (NSArray<TSKTask *> *)tasksForEdgeList:(const TSKEdgeList *)list
+{
+    NSMutableArray *tasks = [[NSMutableArray alloc] initWithCapacity:list->count];
+    NSArray *allTasks = self.mutableTasks;
+    TSKEdgeListEnumerate(list, ^(NSUInteger index, BOOL *stop) {
+        [tasks addObject:allTasks[index]];
+    });
+
+    return tasks;
+}
+
+
+- (NSArray<TSKTask *> *)prerequisiteTasksOfNode:(NSUInteger)index
+{
+    return [self tasksForEdgeList:&[self nodeAtIndex:index]->prerequisites];
+}
+
+
+- (NSArray<TSKTask *> *)dependentTasksOfNode:(NSUInteger)index
+{
+    return [self tasksForEdgeList:&[self nodeAtIndex:index]->dependents];
+}
+
+
+- (void)enumeratePrerequisitesOfNode:(NSUInteger)index usingBlock:(void (NS_NOESCAPE ^)(NSUInteger, BOOL *))block
+{
+    TSKEdgeListEnumerate(&[self nodeAtIndex:index]->prerequisites, block);
+}
+
+
+- (void)enumerateDependentsOfNode:(NSUInteger)index usingBlock:(void (NS_NOESCAPE ^)(NSUInteger, BOOL *))block
+{
+    TSKEdgeListEnumerate(&[self nodeAtIndex:index]->dependents, block);
+}
+
+@end
@@ -0,0 +1,393 @@
+//
+//  TSKWorkflowSimulator.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Task/TSKWorkflowSimulator.h>
+
+#import <Task/TSKDurationHistogram.h>
+#import <Task/TSKDurationStatistics.h>
+#import <Task/TSKTask.h>
+
+#import "TSKTask+WorkflowInterface.h"
+#import "TSKWorkflow+TaskInterface.h"
+#import "TSKWorkflowGraph.h"
+
+
+#pragma mark Heap
+
+/*! An entry in a simulation heap. Entries with smaller keys are popped first; ties go to smaller indexes. */
+typedef struct {
+    double key;
+    uint32_t index;
+} TSKHeapEntry;
+
+
+/*! A binary min-heap of heap entries with a fixed capacity. */
+typedef struct {
+    TSKHeapEntry *entries;
+    size_t count;
+} TSKHeap;
+
+
+static inline bool TSKHeapEntryPrecedes(TSKHeapEntry a, TSKHeapEntry b)
+{
+    return a.key < b.key || (a.key == b.key && a.index < b.index);
+}
+
+
+static void TSKHeapPush(TSKHeap *heap, double key, uint32_t index)
+{
+    size_t i = heap->count++;
+    TSKHeapEntry entry = { key, index };
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (!TSKHeapEntryPrecedes(entry, heap->entries[parent])) {
+            break;
+        }
+
+        heap->entries[i] = heap->entries[parent];
+        i = parent;
+    }
+
+    heap->entries[i] = entry;
+}
+
+
+static TSKHeapEntry TSKHeapPop(TSKHeap *heap)
+{
+    TSKHeapEntry top = heap->entries[0];
+    TSKHeapEntry last = heap->entries[--heap->count];
+
+    size_t i = 0;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= heap->count) {
+            break;
+        }
+
+        if (child + 1 < heap->count && TSKHeapEntryPrecedes(heap->entries[child + 1], heap->entries[child])) {
+            ++child;
+        }
+
+        if (!TSKHeapEntryPrecedes(heap->entries[child], last)) {
+            break;
+        }
+
+        heap->entries[i] = heap->entries[child];
+        i = child;
+    }
+
+    if (heap->count > 0) {
+        heap->entries[i] = last;
+    }
+
+    return top;
+}
+
+
+static void *TSKSimulatorAllocate(size_t count, size_t size)
+{
+    void *allocation = calloc(MAX(count, 1), size);
+    if (!allocation) {
+        [NSException raise:NSMallocException format:@"Could not allocate workflow simulation state"];
+    }
+
+    return allocation;
+}
+
+
+#pragma mark - TSKWorkflowSimulationResult
+
+@interface TSKWorkflowSimulationResult ()
+
+- (instancetype)initWithWorkerCount:(NSUInteger)workerCount
+                             policy:(TSKSimulationPolicy)policy
+                           makespan:(NSTimeInterval)makespan
+                        utilization:(double)utilization
+               criticalPathDuration:(NSTimeInterval)criticalPathDuration
+                       criticalPath:(NSArray<TSKTask *> *)criticalPath NS_DESIGNATED_INITIALIZER;
+
+@end
+
+
+@implementation TSKWorkflowSimulationResult
+
+- (instancetype)initWithWorkerCount:(NSUInteger)workerCount
+                             policy:(TSKSimulationPolicy)policy
+                           makespan:(NSTimeInterval)makespan
+                        utilization:(double)utilization
+               criticalPathDuration:(NSTimeInterval)criticalPathDuration
+                       criticalPath:(NSArray<TSKTask *> *)criticalPath
+{
+    self = [super init];
+    if (self) {
+        _workerCount = workerCount;
+        _policy = policy;
+        _makespan = makespan;
+        _utilization = utilization;
+        _criticalPathDuration = criticalPathDuration;
+        _criticalPath = [criticalPath copy];
+    }
+
+    return self;
+}
+
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; workerCount = %lu; makespan = %g; utilization = %g; criticalPathDuration = %g>",
+            self.class, self, (unsigned long)self.workerCount, self.makespan, self.utilization, self.criticalPathDuration];
+}
+
+@end
+
+
+#pragma mark - TSKWorkflowSimulator
+
+@interface TSKWorkflowSimulator () {
+    /*!
+     The graph snapshot in compressed sparse row form: the dependents of node i are
+     _dependents[_dependentOffsets[i]] through _dependents[_dependentOffsets[i + 1] - 1].
+     */
+    uint32_t *_dependentOffsets;
+    uint32_t *_dependents;
+
+    /*! The number of prerequisites of each node. */
+    uint32_t *_prerequisiteCounts;
+
+    /*! The estimated duration of each node. */
+    double *_durations;
+
+    /*!
+     The bottom level of each node, i.e., the total estimated duration of the longest path from the
+     start of the node to the end of the workflow.
+     */
+    double *_bottomLevels;
+}
+
+/*! The tasks in the snapshot, ordered by node index. */
+@property (nonatomic, copy, readonly) NSArray<TSKTask *> *tasks;
+
+/*! The total estimated duration of all tasks in the snapshot. */
+@property (nonatomic, assign, readonly) double totalDuration;
+
+/*! The tasks on the critical path, which is the same for every simulation. */
+@property (nonatomic, copy, readonly) NSArray<TSKTask *> *criticalPath;
+
+/*! The total estimated duration of the tasks on the critical path. */
+@property (nonatomic, assign, readonly) double criticalPathDuration;
+
+@end
+
+
+@implementation TSKWorkflowSimulator
+
+- (instancetype)initWithWorkflow:(TSKWorkflow *)workflow
+              durationStatistics:(TSKDurationStatistics *)durationStatistics
+                 defaultDuration:(NSTimeInterval)defaultDuration
+{
+    NSParameterAssert(durationStatistics);
+
+    // Looking up histograms must not create them. Tasks with the default name are never recorded, so
+    // we don’t look them up at all.
+    return [self initWithWorkflow:workflow durationEstimator:^NSTimeInterval(TSKTask *task) {
+        if (task.hasDefaultName) {
+            return defaultDuration;
+        }
+
+        TSKDurationHistogram *histogram = [durationStatistics existingHistogramForTaskName:task.name];
+        return histogram.count > 0 ? [histogram durationAtPercentile:0.5] : defaultDuration;
+    }];
+}
+
+
+- (instancetype)initWithWorkflow:(TSKWorkflow *)workflow durationEstimator:(NSTimeInterval (NS_NOESCAPE ^)(TSKTask *))durationEstimator
+{
+    NSParameterAssert(workflow);
+    NSParameterAssert(durationEstimator);
+
+    self = [super init];
+    if (self) {
+        _workflow = workflow;
+        [self snapshotGraph];
+
+        NSUInteger taskCount = _taskCount;
+        _durations = TSKSimulatorAllocate(taskCount, sizeof(double));
+        for (NSUInteger i = 0; i < taskCount; ++i) {
+            _durations[i] = MAX(durationEstimator(_tasks[i]), 0);
+            _totalDuration += _durations[i];
+        }
+
+        [self computeCriticalPath];
+    }
+
+    return self;
+}
+
+
+- (void)dealloc
+{
+    free(_dependentOffsets);
+    free(_dependents);
+    free(_prerequisiteCounts);
+    free(_durations);
+    free(_bottomLevels);
+}
+
+
+- (void)snapshotGraph
+{
+    [self.workflow readGraphUsingBlock:^(TSKWorkflowGraph *graph) {
+        NSUInteger nodeCount = graph.nodeCount;
+        self->_taskCount = nodeCount;
+        self->_tasks = graph.tasks;
+
+        uint32_t *offsets = TSKSimulatorAllocate(nodeCount + 1, sizeof(uint32_t));
+        uint32_t *prerequisiteCounts = TSKSimulatorAllocate(nodeCount, sizeof(uint32_t));
+        for (NSUInteger i = 0; i < nodeCount; ++i) {
+            offsets[i + 1] = offsets[i] + (uint32_t)[graph dependentCountOfNode:i];
+            prerequisiteCounts[i] = (uint32_t)[graph prerequisiteCountOfNode:i];
+        }
+
+        uint32_t *dependents = TSKSimulatorAllocate(offsets[nodeCount], sizeof(uint32_t));
+        for (NSUInteger i = 0; i < nodeCount; ++i) {
+            __block uint32_t *cursor = &dependents[offsets[i]];
+            [graph enumerateDependentsOfNode:i usingBlock:^(NSUInteger dependentIndex, BOOL *stop) {
+                *cursor++ = (uint32_t)dependentIndex;
+            }];
+        }
+
+        self->_dependentOffsets = offsets;
+        self->_dependents = dependents;
+        self->_prerequisiteCounts = prerequisiteCounts;
+    }];
+}
+
+
+- (void)computeCriticalPath
+{
+    NSUInteger taskCount = self.taskCount;
+    _bottomLevels = TSKSimulatorAllocate(taskCount, sizeof(double));
+
+    // Prerequisites must be added to a workflow before their dependents, so node indexes are already
+    // in topological order. Visiting them in reverse guarantees that every dependent’s bottom level
+    // is known before its prerequisites’.
+    for (NSUInteger i = taskCount; i-- > 0; ) {
+        double longestDependentLevel = 0;
+        for (uint32_t edge = _dependentOffsets[i]; edge < _dependentOffsets[i + 1]; ++edge) {
+            longestDependentLevel = MAX(longestDependentLevel, _bottomLevels[_dependents[edge]]);
+        }
+
+        _bottomLevels[i] = _durations[i] + longestDependentLevel;
+    }
+
+    NSMutableArray<TSKTask *> *criticalPath = [[NSMutableArray alloc] init];
+    NSUInteger node = NSNotFound;
+    for (NSUInteger i = 0; i < taskCount; ++i) {
+        if (_prerequisiteCounts[i] == 0 && (node == NSNotFound || _bottomLevels[i] > _bottomLevels[node])) {
+            node = i;
+        }
+    }
+
+    _criticalPathDuration = node != NSNotFound ? _bottomLevels[node] : 0;
+    while (node != NSNotFound) {
+        [criticalPath addObject:self.tasks[node]];
+
+        NSUInteger next = NSNotFound;
+        for (uint32_t edge = _dependentOffsets[node]; edge < _dependentOffsets[node + 1]; ++edge) {
+            uint32_t dependent = _dependents[edge];
+            if (next == NSNotFound || _bottomLevels[dependent] > _bottomLevels[next]) {
+                next = dependent;
+            }
+        }
+
+        node = next;
+    }
+
+    _criticalPath = criticalPath;
+}
+
+
+- (TSKWorkflowSimulationResult *)simulateWithWorkerCount:(NSUInteger)workerCount policy:(TSKSimulationPolicy)policy
+{
+    NSParameterAssert(workerCount > 0);
+
+    NSUInteger taskCount = self.taskCount;
+    uint32_t *remainingPrerequisiteCounts = TSKSimulatorAllocate(taskCount, sizeof(uint32_t));
+    memcpy(remainingPrerequisiteCounts, _prerequisiteCounts, taskCount * sizeof(uint32_t));
+
+    TSKHeap readyHeap = { TSKSimulatorAllocate(taskCount, sizeof(TSKHeapEntry)), 0 };
+    TSKHeap finishHeap = { TSKSimulatorAllocate(taskCount, sizeof(TSKHeapEntry)), 0 };
+
+    // Under FIFO, ready tasks are keyed by the order in which they became ready; under longest path
+    // first, they are keyed by their negated bottom level so that the longest path is popped first
+    __block double readySequence = 0;
+    double *bottomLevels = _bottomLevels;
+    void (^pushReadyNode)(uint32_t) = ^(uint32_t node) {
+        double key = policy == TSKSimulationPolicyLongestPathFirst ? -bottomLevels[node] : readySequence++;
+        TSKHeapPush(&readyHeap, key, node);
+    };
+
+    for (uint32_t i = 0; i < taskCount; ++i) {
+        if (remainingPrerequisiteCounts[i] == 0) {
+            pushReadyNode(i);
+        }
+    }
+
+    NSUInteger idleWorkerCount = MIN(workerCount, MAX(taskCount, 1));
+    double now = 0;
+    while (readyHeap.count > 0 || finishHeap.count > 0) {
+        while (idleWorkerCount > 0 && readyHeap.count > 0) {
+            uint32_t node = TSKHeapPop(&readyHeap).index;
+            TSKHeapPush(&finishHeap, now + _durations[node], node);
+            --idleWorkerCount;
+        }
+
+        TSKHeapEntry finished = TSKHeapPop(&finishHeap);
+        now = finished.key;
+        ++idleWorkerCount;
+
+        for (uint32_t edge = _dependentOffsets[finished.index]; edge < _dependentOffsets[finished.index + 1]; ++edge) {
+            uint32_t dependent = _dependents[edge];
+            if (--remainingPrerequisiteCounts[dependent] == 0) {
+                pushReadyNode(dependent);
+            }
+        }
+    }
+
+    free(remainingPrerequisiteCounts);
+    free(readyHeap.entries);
+    free(finishHeap.entries);
+
+    double utilization = now > 0 ? self.totalDuration / (workerCount * now) : 0;
+    return [[TSKWorkflowSimulationResult alloc] initWithWorkerCount:workerCount
+                                                             policy:policy
+                                                           makespan:now
+                                                        utilization:utilization
+                                               criticalPathDuration:self.criticalPathDuration
+                                                       criticalPath:self.criticalPath];
+}
+
+@end
@@ -0,0 +1,47 @@
+//
+//  TSKWorkflowStateObserver+WorkflowInterface.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <Task/TSKWorkflowStateObserver.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ The WorkflowInterface category of TSKWorkflowStateObserver declares the message workflows use to
+ report state changes to their observers.
+ */
+@interface TSKWorkflowStateObserver (WorkflowInterface)
+
+/*!
+ @abstract Marks the specified task as changed, scheduling a delivery if one isn’t already scheduled.
+ @param task The task whose state changed. May not be nil.
+ */
+- (void)taskDidChangeState:(TSKTask *)task;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,244 @@
+//
+//  TSKWorkflowStateObserver.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import "TSKWorkflowStateObserver+WorkflowInterface.h"
+
+#import <Task/TSKWorkflow.h>
+#import <os/lock.h>
+#import <time.h>
+
+#import "TSKWorkflow+StateObserverInterface.h"
+
+
+#pragma mark - TSKWorkflowStateDelta
+
+@interface TSKWorkflowStateDelta ()
+
+/*! The states of the delta’s changed tasks, keyed by task. */
+@property (nonatomic, strong, readonly) NSMapTable<TSKTask *, NSNumber *> *statesByTask;
+
+/*!
+ @abstract Initializes a newly created delta with the current states of the specified tasks.
+ @param workflow The workflow whose tasks changed.
+ @param changedTasks The tasks whose states changed.
+ @result A newly initialized delta.
+ */
+- (instancetype)initWithWorkflow:(TSKWorkflow *)workflow changedTasks:(NSArray<TSKTask *> *)changedTasks NS_DESIGNATED_INITIALIZER;
+
+@end
+
+
+@implementation TSKWorkflowStateDelta
+
+- (instancetype)initWithWorkflow:(TSKWorkflow *)workflow changedTasks:(NSArray<TSKTask *> *)changedTasks
+{
+    self = [super init];
+    if (self) {
+        _workflow = workflow;
+        _changedTasks = [changedTasks copy];
+        _statesByTask = [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+                                                  valueOptions:NSPointerFunctionsStrongMemory
+                                                      capacity:changedTasks.count];
+        for (TSKTask *task in changedTasks) {
+            [_statesByTask setObject:@(task.state) forKey:task];
+        }
+    }
+
+    return self;
+}
+
+
+- (TSKTaskState)stateOfTask:(TSKTask *)task
+{
+    NSParameterAssert(task);
+
+    NSNumber *state = [self.statesByTask objectForKey:task];
+    return state ? state.integerValue : task.state;
+}
+
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p workflow = %@; changedTaskCount = %lu>",
+            self.class, self, self.workflow.name, (unsigned long)self.changedTasks.count];
+}
+
+@end
+
+
+#pragma mark - TSKWorkflowStateObserver
+
+@interface TSKWorkflowStateObserver () {
+    /*! A lock that synchronizes access to the observer’s pending changes and delivery state. */
+    os_unfair_lock _lock;
+
+    /*! The minimum time between deliveries, in nanoseconds. */
+    uint64_t _deliveryInterval;
+
+    /*! The uptime at which the last delta was delivered, in nanoseconds, or 0 if none has been. */
+    uint64_t _lastDeliveryTime;
+
+    /*! Whether a delivery is scheduled on the observer’s queue. */
+    BOOL _deliveryScheduled;
+}
+
+@property (nonatomic, copy, readonly) void (^handler)(TSKWorkflowStateDelta *);
+
+/*!
+ @abstract The tasks whose states changed since the last delivery.
+ @discussion Tasks are compared by identity. Access to this object must be synchronized using the
+     observer’s lock.
+ */
+@property (nonatomic, strong) NSHashTable<TSKTask *> *changedTasks;
+
+/*! Makes a delta from the changed tasks and invokes the handler with it. */
+- (void)deliverDelta;
+
+@end
+
+
+@implementation TSKWorkflowStateObserver
+
+@synthesize invalidated = _invalidated;
+
+- (instancetype)initWithWorkflow:(TSKWorkflow *)workflow
+             maximumDeliveryRate:(double)maximumDeliveryRate
+                           queue:(dispatch_queue_t)queue
+                         handler:(void (^)(TSKWorkflowStateDelta *))handler
+{
+    NSParameterAssert(workflow);
+    NSParameterAssert(maximumDeliveryRate > 0);
+    NSParameterAssert(queue);
+    NSParameterAssert(handler);
+
+    self = [super init];
+    if (self) {
+        _workflow = workflow;
+        _maximumDeliveryRate = maximumDeliveryRate;
+        _queue = queue;
+        _handler = [handler copy];
+        _lock = OS_UNFAIR_LOCK_INIT;
+        _deliveryInterval = (uint64_t)(NSEC_PER_SEC / maximumDeliveryRate);
+        _changedTasks = [NSHashTable hashTableWithOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality];
+
+        [workflow addStateObserver:self];
+    }
+
+    return self;
+}
+
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p workflow = %@; maximumDeliveryRate = %g>",
+            self.class, self, self.workflow.name, self.maximumDeliveryRate];
+}
+
+
+- (BOOL)isInvalidated
+{
+    os_unfair_lock_lock(&_lock);
+    BOOL invalidated = _invalidated;
+    os_unfair_lock_unlock(&_lock);
+    return invalidated;
+}
+
+
+- (void)invalidate
+{
+    os_unfair_lock_lock(&_lock);
+    _invalidated = YES;
+    [self.changedTasks removeAllObjects];
+    os_unfair_lock_unlock(&_lock);
+
+    [self.workflow removeStateObserver:self];
+}
+
+
+#pragma mark - Delivering Changes
+
+- (void)taskDidChangeState:(TSKTask *)task
+{
+    NSParameterAssert(task);
+
+    os_unfair_lock_lock(&_lock);
+    if (_invalidated) {
+        os_unfair_lock_unlock(&_lock);
+        return;
+    }
+
+    [self.changedTasks addObject:task];
+
+    // Only the first change after a delivery schedules the next one. Later changes are picked up by it.
+    BOOL shouldScheduleDelivery = !_deliveryScheduled;
+    uint64_t delay = 0;
+    if (shouldScheduleDelivery) {
+        _deliveryScheduled = YES;
+
+        uint64_t now = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+        uint64_t nextDeliveryTime = _lastDeliveryTime ? _lastDeliveryTime + _deliveryInterval : now;
+        delay = nextDeliveryTime > now ? nextDeliveryTime - now : 0;
+    }
+    os_unfair_lock_unlock(&_lock);
+
+    if (!shouldScheduleDelivery) {
+        return;
+    }
+
+    // The workflow retains the observer until it is invalidated, so this only guards against the
+    // workflow having been deallocated in the meantime
+    __weak typeof(self) weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)delay), self.queue, ^{
+        [weakSelf deliverDelta];
+    });
+}
+
+
+- (void)deliverDelta
+{
+    os_unfair_lock_lock(&_lock);
+    if (_invalidated) {
+        os_unfair_lock_unlock(&_lock);
+        return;
+    }
+
+    NSArray<TSKTask *> *changedTasks = self.changedTasks.allObjects;
+    [self.changedTasks removeAllObjects];
+    _deliveryScheduled = NO;
+    _lastDeliveryTime = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+    os_unfair_lock_unlock(&_lock);
+
+    TSKWorkflow *workflow = self.workflow;
+    if (!workflow || changedTasks.count == 0) {
+        return;
+    }
+
+    // States are read now rather than when they changed so that each task’s latest state is delivered
+    self.handler([[TSKWorkflowStateDelta alloc] initWithWorkflow:workflow changedTasks:changedTasks]);
+}
+
+@end
@@ -0,0 +1,206 @@
+//
+//  TSKWorkflowTemplate.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Task/TSKWorkflowTemplate.h>
+
+#import <Task/TSKTask.h>
+#import <Task/TSKWorkflow.h>
+
+#import "../Tasks/TSKTask+WorkflowInterface.h"
+#import "TSKWorkflow+TaskInterface.h"
+#import "TSKWorkflow+TemplateInterface.h"
+#import "TSKWorkflowGraph.h"
+
+
+@interface TSKWorkflowTemplate ()
+
+/*! The prototype workflow. */
+@property (nonatomic, strong, readonly) TSKWorkflow *prototypeWorkflow;
+
+/*!
+ @abstract The template’s snapshot of the prototype workflow’s graph.
+ @discussion The graph’s tasks are the prototype tasks. It is never modified, so it can be shared by
+     any number of instantiated workflows’ graphs without synchronization.
+ */
+@property (nonatomic, strong, readonly) TSKWorkflowGraph *graph;
+
+/*!
+ @abstract The keyed prerequisites of the prototype tasks, expressed as node indexes.
+ @discussion The keys of this dictionary are the node indexes of tasks that have keyed prerequisites.
+     Each value maps a prerequisite key to the node index of the corresponding prerequisite task.
+ */
+@property (nonatomic, copy, readonly) NSDictionary<NSNumber *, NSDictionary<id<NSCopying>, NSNumber *> *> *keyedPrerequisiteIndexes;
+
+/*!
+ @abstract The conditions on the prototype tasks’ conditional prerequisites, expressed by node index.
+ @discussion The keys of this dictionary are the node indexes of tasks that have conditional
+     prerequisites. Each value maps the node index of a conditional prerequisite task to its
+     condition.
+ */
+@property (nonatomic, copy, readonly) NSDictionary<NSNumber *, NSDictionary<NSNumber *, id> *> *prerequisiteConditionIndexes;
+
+@end
+
+
+#pragma mark -
+
+@implementation TSKWorkflowTemplate
+
+- (instancetype)initWithWorkflow:(TSKWorkflow *)workflow
+{
+    NSParameterAssert(workflow);
+
+    self = [super init];
+    if (self) {
+        _prototypeWorkflow = workflow;
+
+        __block TSKWorkflowGraph *graph = nil;
+        [workflow readGraphUsingBlock:^(TSKWorkflowGraph *workflowGraph) {
+            graph = [[TSKWorkflowGraph alloc] initWithGraph:workflowGraph tasks:workflowGraph.tasks];
+        }];
+
+        _graph = graph;
+        _taskCount = graph.nodeCount;
+
+        // Keyed and conditional prerequisites can’t change once a task is in a workflow, so we don’t
+        // need to read them while holding the graph lock
+        NSMutableDictionary *keyedPrerequisiteIndexes = [[NSMutableDictionary alloc] init];
+        NSMutableDictionary *prerequisiteConditionIndexes = [[NSMutableDictionary alloc] init];
+        [graph.tasks enumerateObjectsUsingBlock:^(TSKTask *task, NSUInteger index, BOOL *stop) {
+            NSAssert(!task.inputChannel && !task.outputChannel, @"Templates cannot be created from workflows with streaming prerequisites");
+
+            NSMapTable *prerequisiteConditions = [workflow prerequisiteConditionsForTask:task];
+            if (prerequisiteConditions.count != 0) {
+                NSMutableDictionary *conditionsByIndex = [[NSMutableDictionary alloc] initWithCapacity:prerequisiteConditions.count];
+                for (TSKTask *prerequisiteTask in prerequisiteConditions) {
+                    conditionsByIndex[@(prerequisiteTask.workflowNodeIndex)] = [prerequisiteConditions objectForKey:prerequisiteTask];
+                }
+
+                prerequisiteConditionIndexes[@(index)] = conditionsByIndex;
+            }
+
+            NSDictionary *keyedPrerequisiteTasks = [workflow keyedPrerequisiteTasksForTask:task];
+            if (keyedPrerequisiteTasks.count == 0) {
+                return;
+            }
+
+            NSMutableDictionary *indexesByKey = [[NSMutableDictionary alloc] initWithCapacity:keyedPrerequisiteTasks.count];
+            [keyedPrerequisiteTasks enumerateKeysAndObjectsUsingBlock:^(id<NSCopying> key, TSKTask *prerequisiteTask, BOOL *stop) {
+                indexesByKey[key] = @(prerequisiteTask.workflowNodeIndex);
+            }];
+
+            keyedPrerequisiteIndexes[@(index)] = indexesByKey;
+        }];
+
+        _keyedPrerequisiteIndexes = [keyedPrerequisiteIndexes copy];
+        _prerequisiteConditionIndexes = [prerequisiteConditionIndexes copy];
+    }
+
+    return self;
+}
+
+
+- (TSKWorkflow *)instantiateWorkflow
+{
+    return [self instantiateWorkflowWithName:nil operationQueue:nil];
+}
+
+
+- (TSKWorkflow *)instantiateWorkflowWithName:(NSString *)name operationQueue:(NSOperationQueue *)operationQueue
+{
+    TSKWorkflow *prototypeWorkflow = self.prototypeWorkflow;
+    TSKWorkflow *workflow = [[TSKWorkflow alloc] initWithName:name
+                                               operationQueue:operationQueue
+                                           notificationCenter:prototypeWorkflow.notificationCenter];
+    workflow.delegate = prototypeWorkflow.delegate;
+    workflow.executionClass = prototypeWorkflow.executionClass;
+    workflow.durationStatistics = prototypeWorkflow.durationStatistics;
+    workflow.resultStore = prototypeWorkflow.resultStore;
+    workflow.scheduler = prototypeWorkflow.scheduler;
+    workflow.timeout = prototypeWorkflow.timeout;
+    workflow.retryPolicy = prototypeWorkflow.retryPolicy;
+    workflow.batchSize = prototypeWorkflow.batchSize;
+    workflow.batchLingerInterval = prototypeWorkflow.batchLingerInterval;
+
+    NSArray<TSKTask *> *prototypeTasks = self.graph.tasks;
+    NSUInteger taskCount = prototypeTasks.count;
+    NSMutableArray<TSKTask *> *tasks = [[NSMutableArray alloc] initWithCapacity:taskCount];
+    for (TSKTask *prototypeTask in prototypeTasks) {
+        [tasks addObject:[prototypeTask copy]];
+    }
+
+    NSMapTable *keyedPrerequisiteTasks = nil;
+    if (self.keyedPrerequisiteIndexes.count != 0) {
+        keyedPrerequisiteTasks = [NSMapTable strongToStrongObjectsMapTable];
+        [self.keyedPrerequisiteIndexes enumerateKeysAndObjectsUsingBlock:^(NSNumber *index, NSDictionary *indexesByKey, BOOL *stop) {
+            NSMutableDictionary *prerequisiteTasksByKey = [[NSMutableDictionary alloc] initWithCapacity:indexesByKey.count];
+            [indexesByKey enumerateKeysAndObjectsUsingBlock:^(id<NSCopying> key, NSNumber *prerequisiteIndex, BOOL *stop) {
+                prerequisiteTasksByKey[key] = tasks[prerequisiteIndex.unsignedIntegerValue];
+            }];
+
+            [keyedPrerequisiteTasks setObject:[prerequisiteTasksByKey copy] forKey:tasks[index.unsignedIntegerValue]];
+        }];
+    }
+
+    NSMapTable *prerequisiteConditions = nil;
+    if (self.prerequisiteConditionIndexes.count != 0) {
+        prerequisiteConditions = [NSMapTable strongToStrongObjectsMapTable];
+        [self.prerequisiteConditionIndexes enumerateKeysAndObjectsUsingBlock:^(NSNumber *index, NSDictionary *conditionsByIndex, BOOL *stop) {
+            NSMapTable *conditions = [NSMapTable strongToStrongObjectsMapTable];
+            [conditionsByIndex enumerateKeysAndObjectsUsingBlock:^(NSNumber *prerequisiteIndex, id condition, BOOL *stop) {
+                [conditions setObject:condition forKey:tasks[prerequisiteIndex.unsignedIntegerValue]];
+            }];
+
+            [prerequisiteConditions setObject:conditions forKey:tasks[index.unsignedIntegerValue]];
+        }];
+    }
+
+    TSKWorkflowGraph *graph = [[TSKWorkflowGraph alloc] initWithGraph:self.graph tasks:tasks];
+    [workflow adoptGraph:graph keyedPrerequisiteTasks:keyedPrerequisiteTasks prerequisiteConditions:prerequisiteConditions];
+    return workflow;
+}
+
+
+- (TSKTask *)taskInWorkflow:(TSKWorkflow *)workflow correspondingToPrototypeTask:(TSKTask *)prototypeTask
+{
+    NSParameterAssert(workflow);
+    NSParameterAssert(prototypeTask);
+
+    // Node indexes never change, so the prototype’s index identifies its copy in every instance
+    NSUInteger index = prototypeTask.workflowNodeIndex;
+    if (index >= self.taskCount || [self.graph taskAtNode:index] != prototypeTask) {
+        return nil;
+    }
+
+    __block TSKTask *task = nil;
+    [workflow readGraphUsingBlock:^(TSKWorkflowGraph *graph) {
+        task = index < graph.nodeCount ? [graph taskAtNode:index] : nil;
+    }];
+
+    return task;
+}
+
+@end
@@ -0,0 +1,102 @@
+//
+//  TSKCancellationToken.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ TSKCancellationToken objects let long-running work find out cheaply that it should stop. Checking
+ whether a token is cancelled is a single atomic load, so it can be done on every iteration of a
+ tight loop.
+
+ Each time a task starts executing, it gets a new token, available via its cancellationToken
+ property. That token is cancelled when the task stops executing for any reason other than finishing
+ successfully, i.e., when it is cancelled, reset, skipped, or fails. It is also cancelled when a task
+ that started a speculative attempt finishes, so that the attempts that lost stop. Tasks whose work
+ consists of waiting on I/O or other asynchronous operations can register cancellation handlers that
+ abort the work. Handlers run synchronously on the thread that cancels the token, before the task’s
+ cancellation is reported to its delegate, workflow, or observers.
+
+ Tokens can have a parent token. A child token is cancelled as soon as its parent is. When a task
+ starts executing, its token’s parent is its workflow’s cancellationToken, if it has one.
+
+ TSKCancellationToken is thread-safe.
+ */
+@interface TSKCancellationToken : NSObject
+
+/*!
+ @abstract Whether the token has been cancelled.
+ @discussion Once a token is cancelled, it stays cancelled.
+ */
+@property (nonatomic, assign, readonly, getter=isCancelled) BOOL cancelled;
+
+/*! The token’s parent token. */
+@property (nonatomic, strong, readonly, nullable) TSKCancellationToken *parentToken;
+
+/*!
+ @abstract Initializes a newly created TSKCancellationToken instance with no parent.
+ @result A newly initialized TSKCancellationToken instance.
+ */
+- (instancetype)init;
+
+/*!
+ @abstract Initializes a newly created TSKCancellationToken instance with the specified parent.
+ @discussion This is the class’s designated initializer. If the parent token is already cancelled,
+     the new token is cancelled immediately.
+ @param parentToken The token’s parent token. May be nil.
+ @result A newly initialized TSKCancellationToken instance.
+ */
+- (instancetype)initWithParentToken:(nullable TSKCancellationToken *)parentToken NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Cancels the token and runs its cancellation handlers.
+ @discussion Handlers run synchronously on the current thread in the order they were added. Cancelling
+     a token that is already cancelled has no effect.
+ */
+- (void)cancel;
+
+/*!
+ @abstract Adds a block that runs when the token is cancelled.
+ @discussion If the token is already cancelled, the handler runs immediately on the current thread.
+     Each handler runs at most once. Handlers must not block for long, as they delay the code that
+     cancelled the token.
+ @param handler The block to run. May not be nil.
+ @result An opaque object that can be passed to ‑removeCancellationHandler: to remove the handler.
+ */
+- (id)addCancellationHandler:(void (^)(void))handler;
+
+/*!
+ @abstract Removes a cancellation handler from the token.
+ @discussion Handlers that have already run or been removed are ignored.
+ @param handler The object returned by ‑addCancellationHandler: when the handler was added.
+ */
+- (void)removeCancellationHandler:(id)handler;
+
+@end
+
+NS_ASSUME_NONNULL_END
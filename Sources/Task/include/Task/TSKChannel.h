@@ -0,0 +1,132 @@
+//
+//  TSKChannel.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ TSKChannel objects are bounded, first-in first-out queues that stream items from one task to
+ another while both are executing. A channel is typically created when a task is added to a workflow
+ with a streaming prerequisite, using ‑[TSKWorkflow addTask:streamingPrerequisiteTask:channel:
+ prerequisiteTasks:]. The prerequisite, or producer, sends items into its output channel, and the
+ dependent task, or consumer, receives them from its input channel.
+
+ Channels provide back-pressure. When a channel holds as many items as its capacity, ‑sendItem:
+ blocks until the consumer receives an item or the channel is closed. Producers that cannot block
+ may use ‑trySendItem: instead and retry later.
+
+ ‑sendItem: and ‑receiveItem block the calling thread, so a producer and consumer that use them must
+ be able to execute at the same time. If both run on an operation queue whose
+ maxConcurrentOperationCount is 1, the first of them to block waits forever, as the other can never
+ execute. Run them on queues that allow concurrent operations, for example by giving them execution
+ classes with separate queues.
+
+ A producer’s output channel is closed automatically when it finishes, fails, or is cancelled, and a
+ consumer’s input channel is closed automatically when it finishes, fails, or is cancelled. Closing
+ a channel wakes all blocked senders and receivers. Items that were sent before the channel was
+ closed can still be received. Once a channel is closed and empty, ‑receiveItem returns nil. At that
+ point, consumers should check the channel’s error and fail if it is non-nil, as the producer did
+ not finish successfully.
+
+ TSKChannel is thread-safe.
+ */
+@interface TSKChannel : NSObject
+
+/*! The maximum number of items the channel can hold. */
+@property (nonatomic, assign, readonly) NSUInteger capacity;
+
+/*! The number of items currently in the channel. */
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/*! Whether the channel is closed. */
+@property (nonatomic, assign, readonly, getter=isClosed) BOOL closed;
+
+/*!
+ @abstract The error the channel was closed with.
+ @discussion This is nil if the channel is open or was closed without an error. When a producer
+     fails, its output channel is closed with the producer’s error.
+ */
+@property (nonatomic, strong, readonly, nullable) NSError *error;
+
+/*!
+ @abstract -init is unavailable, as there is no reasonable default capacity.
+ @discussion Use -initWithCapacity: instead.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*!
+ @abstract Initializes a newly created TSKChannel instance with the specified capacity.
+ @discussion This is the class’s designated initializer.
+ @param capacity The maximum number of items the channel can hold. Must be positive.
+ @result A newly initialized TSKChannel instance.
+ */
+- (instancetype)initWithCapacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Adds the specified item to the channel, waiting for space to become available if the
+     channel is full.
+ @discussion This blocks the calling thread while the channel is full, so the consumer must be able
+     to execute on another thread.
+ @param item The item to add. May not be nil.
+ @result Whether the item was added. Returns NO if the channel is or becomes closed before the item
+     could be added.
+ */
+- (BOOL)sendItem:(id)item NS_SWIFT_NAME(send(_:));
+
+/*!
+ @abstract Adds the specified item to the channel if the channel is open and not full.
+ @param item The item to add. May not be nil.
+ @result Whether the item was added.
+ */
+- (BOOL)trySendItem:(id)item NS_SWIFT_NAME(trySend(_:));
+
+/*!
+ @abstract Removes and returns the oldest item in the channel, waiting for one to become available
+     if the channel is empty.
+ @discussion This blocks the calling thread while the channel is empty, so the producer must be able
+     to execute on another thread.
+ @result The oldest item in the channel, or nil if the channel is closed and empty.
+ */
+- (nullable id)receiveItem NS_SWIFT_NAME(receive());
+
+/*!
+ @abstract Closes the channel without an error.
+ @discussion Closing a channel that is already closed has no effect.
+ */
+- (void)close;
+
+/*!
+ @abstract Closes the channel with the specified error.
+ @discussion Closing a channel that is already closed has no effect.
+ @param error The error the channel is closed with. May be nil.
+ */
+- (void)closeWithError:(nullable NSError *)error NS_SWIFT_NAME(close(with:));
+
+@end
+
+NS_ASSUME_NONNULL_END
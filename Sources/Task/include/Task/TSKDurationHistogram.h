@@ -0,0 +1,92 @@
+//
+//  TSKDurationHistogram.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ TSKDurationHistogram objects summarize the durations recorded within a recent window of time.
+
+ Durations are counted in logarithmically sized buckets, four per power of two from one nanosecond
+ up, so percentiles are approximate: each is reported as the midpoint of its bucket, which is within
+ 12.5% of the true value. In exchange, recording a duration takes a few atomic additions and
+ never blocks or allocates memory, which makes histograms suitable for recording every task
+ execution. Tasks use histograms to decide whether they can meet their deadlines, speculation
+ policies use them to decide when to start speculative attempts, and TSKDurationStatistics keeps one
+ for each task name.
+
+ The window is divided into four epochs. Durations are recorded in the current epoch, and reads
+ merge the current epoch with the three before it, so the durations reflected in a histogram are
+ between three quarters of a window and a full window old. The first recording in a new epoch clears
+ the epoch’s old counts, and durations recorded concurrently wait for it to finish, so none are lost.
+
+ TSKDurationHistogram is thread-safe.
+ */
+@interface TSKDurationHistogram : NSObject
+
+/*! The length of time for which recorded durations are retained. */
+@property (nonatomic, assign, readonly) NSTimeInterval windowDuration;
+
+/*! The number of durations recorded during the window. */
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/*! The mean of the durations recorded during the window, or 0 if there are none. */
+@property (nonatomic, assign, readonly) NSTimeInterval meanDuration;
+
+/*!
+ @abstract Initializes a newly created TSKDurationHistogram instance with a window of five minutes.
+ @result A newly initialized TSKDurationHistogram instance.
+ */
+- (instancetype)init;
+
+/*!
+ @abstract Initializes a newly created TSKDurationHistogram instance with the specified window.
+ @discussion This is the class’s designated initializer.
+ @param windowDuration The length of time for which recorded durations are retained. Must be positive.
+ @result A newly initialized TSKDurationHistogram instance.
+ */
+- (instancetype)initWithWindowDuration:(NSTimeInterval)windowDuration NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Records the specified duration.
+ @param duration The duration to record. Negative durations are ignored.
+ */
+- (void)recordDuration:(NSTimeInterval)duration;
+
+/*!
+ @abstract Returns the approximate duration at the specified percentile of the durations recorded
+     during the window.
+ @param percentile The percentile, expressed as a value between 0 and 1, inclusive.
+ @result The approximate duration at the specified percentile, or a negative value if no durations
+     were recorded during the window.
+ */
+- (NSTimeInterval)durationAtPercentile:(double)percentile;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,101 @@
+//
+//  TSKDurationStatistics.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class TSKDurationHistogram;
+
+/*!
+ TSKDurationStatistics objects keep a duration histogram for each task name. Workflows whose
+ durationStatistics property is set record how long each of their tasks takes to finish successfully
+ in the histogram for the task’s name, so tasks that perform the same work should share a name.
+ Tasks that have the default name are not recorded, as their names are unique.
+
+ The recorded statistics can be used to estimate how long a workflow will take to run with
+ TSKWorkflowSimulator.
+
+ TSKDurationStatistics is thread-safe.
+ */
+@interface TSKDurationStatistics : NSObject
+
+/*! The window duration of the instance’s histograms. */
+@property (nonatomic, assign, readonly) NSTimeInterval windowDuration;
+
+/*! The names of the tasks for which durations have been recorded. */
+@property (nonatomic, copy, readonly) NSSet<NSString *> *taskNames;
+
+/*!
+ @abstract Returns the shared duration statistics instance.
+ @discussion The shared instance’s histograms have a window of five minutes.
+ @result The shared duration statistics instance.
+ */
++ (TSKDurationStatistics *)sharedStatistics;
+
+/*!
+ @abstract Initializes a newly created TSKDurationStatistics instance whose histograms have a window
+     of five minutes.
+ @result A newly initialized TSKDurationStatistics instance.
+ */
+- (instancetype)init;
+
+/*!
+ @abstract Initializes a newly created TSKDurationStatistics instance whose histograms have the
+     specified window.
+ @discussion This is the class’s designated initializer.
+ @param windowDuration The window duration of the instance’s histograms. Must be positive.
+ @result A newly initialized TSKDurationStatistics instance.
+ */
+- (instancetype)initWithWindowDuration:(NSTimeInterval)windowDuration NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Returns the histogram for the specified task name, creating it if necessary.
+ @param taskName The task name. May not be nil.
+ @result The histogram for the task name.
+ */
+- (TSKDurationHistogram *)histogramForTaskName:(NSString *)taskName NS_SWIFT_NAME(histogram(forTaskName:));
+
+/*!
+ @abstract Returns the histogram for the specified task name if one exists.
+ @discussion Unlike ‑histogramForTaskName:, this does not create a histogram, so it is appropriate
+     for looking up names that may never have been recorded.
+ @param taskName The task name. May not be nil.
+ @result The histogram for the task name, or nil if no durations have been recorded for it.
+ */
+- (nullable TSKDurationHistogram *)existingHistogramForTaskName:(NSString *)taskName NS_SWIFT_NAME(existingHistogram(forTaskName:));
+
+/*!
+ @abstract Records the specified duration in the histogram for the specified task name.
+ @param duration The duration to record.
+ @param taskName The task name. May not be nil.
+ */
+- (void)recordDuration:(NSTimeInterval)duration forTaskName:(NSString *)taskName NS_SWIFT_NAME(record(_:forTaskName:));
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,186 @@
+//
+//  TSKFairScheduler.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class TSKWorkflow;
+
+/*! TSKSchedulingPolicy enumerates the ways in which a TSKFairScheduler chooses the next task to run. */
+typedef NS_ENUM(NSInteger, TSKSchedulingPolicy) {
+    /*!
+     Workflows take turns running tasks in proportion to their weights using deficit round-robin.
+     Each workflow’s own tasks run in earliest-deadline-first order.
+     */
+    TSKSchedulingPolicyFairShare,
+
+    /*!
+     The task with the earliest deadline runs next, regardless of its workflow. Tasks without a
+     deadline run after all tasks with one, in the order they were scheduled. Workflow weights are
+     ignored.
+     */
+    TSKSchedulingPolicyEarliestDeadlineFirst,
+};
+
+
+/*!
+ TSKFairScheduler objects share one operation queue among many workflows without letting any one of
+ them starve the others. Workflows use a scheduler by setting their scheduler property.
+
+ Rather than adding every task to the operation queue as soon as it is ready, which would run tasks
+ in first-in first-out order across all workflows, the scheduler keeps a queue of ready tasks for
+ each workflow and only keeps maximumConcurrentTaskCount of them on the operation queue at once.
+ Whenever a slot opens up, it chooses the next task according to its policy. By default, it uses
+ deficit round-robin: workflows with queued tasks take turns, and on each turn a workflow may run as
+ many tasks as its weight. A workflow with a weight of 2 thus gets twice the share of the operation
+ queue as one with a weight of 1 when both have work queued, regardless of how many tasks each has.
+ Alternatively, the scheduler can run tasks in earliest-deadline-first order across all workflows.
+
+ A task occupies its slot until its ‑main method returns. Tasks that finish asynchronously therefore
+ only hold a slot while ‑main is executing.
+
+ TSKFairScheduler is thread-safe.
+ */
+@interface TSKFairScheduler : NSObject
+
+/*! The operation queue on which the scheduler runs tasks. */
+@property (nonatomic, strong, readonly) NSOperationQueue *operationQueue;
+
+/*! The maximum number of tasks the scheduler keeps on its operation queue at once. */
+@property (nonatomic, assign, readonly) NSUInteger maximumConcurrentTaskCount;
+
+/*!
+ @abstract How the scheduler chooses the next task to run.
+ @discussion Changing the policy affects the next choice the scheduler makes. The default value is
+     TSKSchedulingPolicyFairShare.
+ */
+@property (atomic, assign) TSKSchedulingPolicy policy;
+
+/*!
+ @abstract Initializes a newly created TSKFairScheduler with a new operation queue.
+ @discussion The maximum concurrent task count is the number of active processors.
+ @result A newly initialized TSKFairScheduler instance.
+ */
+- (instancetype)init;
+
+/*!
+ @abstract Initializes a newly created TSKFairScheduler with the specified operation queue.
+ @discussion The maximum concurrent task count is the queue’s maxConcurrentOperationCount if it is
+     set, and the number of active processors otherwise.
+ @param operationQueue The operation queue on which the scheduler runs tasks. May not be nil.
+ @result A newly initialized TSKFairScheduler instance.
+ */
+- (instancetype)initWithOperationQueue:(NSOperationQueue *)operationQueue;
+
+/*!
+ @abstract Initializes a newly created TSKFairScheduler with the specified operation queue and
+     maximum concurrent task count.
+ @discussion This is the class’s designated initializer.
+ @param operationQueue The operation queue on which the scheduler runs tasks. May not be nil.
+ @param maximumConcurrentTaskCount The maximum number of tasks the scheduler keeps on its operation
+     queue at once. Must be positive.
+ @result A newly initialized TSKFairScheduler instance.
+ */
+- (instancetype)initWithOperationQueue:(NSOperationQueue *)operationQueue
+            maximumConcurrentTaskCount:(NSUInteger)maximumConcurrentTaskCount NS_DESIGNATED_INITIALIZER;
+
+
+#pragma mark - Weights
+
+/*!
+ @abstract Sets the specified workflow’s weight.
+ @param weight The weight. Must be positive. Workflows have a weight of 1 by default.
+ @param workflow The workflow. May not be nil.
+ */
+- (void)setWeight:(NSUInteger)weight forWorkflow:(TSKWorkflow *)workflow NS_SWIFT_NAME(setWeight(_:for:));
+
+/*!
+ @abstract Returns the specified workflow’s weight.
+ @param workflow The workflow. May not be nil.
+ @result The workflow’s weight.
+ */
+- (NSUInteger)weightForWorkflow:(TSKWorkflow *)workflow NS_SWIFT_NAME(weight(for:));
+
+
+#pragma mark - Scheduling
+
+/*!
+ @abstract Schedules the specified block to run on the scheduler’s operation queue on behalf of the
+     specified workflow.
+ @discussion Workflows use this to run their tasks. It is exposed so that other work can be scheduled
+     fairly with workflows’ tasks.
+ @param block The block to run. May not be nil.
+ @param workflow The workflow on whose behalf the block is run. May not be nil.
+ */
+- (void)scheduleBlock:(void (^)(void))block forWorkflow:(TSKWorkflow *)workflow NS_SWIFT_NAME(schedule(_:for:));
+
+/*!
+ @abstract Schedules the specified block to run on the scheduler’s operation queue on behalf of the
+     specified workflow with the specified deadline.
+ @param block The block to run. May not be nil.
+ @param workflow The workflow on whose behalf the block is run. May not be nil.
+ @param deadline The block’s deadline. If nil, the block has no deadline.
+ */
+- (void)scheduleBlock:(void (^)(void))block forWorkflow:(TSKWorkflow *)workflow deadline:(nullable NSDate *)deadline NS_SWIFT_NAME(schedule(_:for:deadline:));
+
+
+#pragma mark - Statistics
+
+/*!
+ @abstract Returns the number of the specified workflow’s tasks that are waiting to be run.
+ @param workflow The workflow. May not be nil.
+ @result The number of the workflow’s tasks that are scheduled but not yet on the operation queue.
+ */
+- (NSUInteger)queueDepthForWorkflow:(TSKWorkflow *)workflow NS_SWIFT_NAME(queueDepth(for:));
+
+/*!
+ @abstract Returns the number of the specified workflow’s tasks that the scheduler has run.
+ @param workflow The workflow. May not be nil.
+ @result The number of the workflow’s tasks that have been added to the operation queue.
+ */
+- (NSUInteger)dispatchedTaskCountForWorkflow:(TSKWorkflow *)workflow NS_SWIFT_NAME(dispatchedTaskCount(for:));
+
+/*!
+ @abstract Returns the average time the specified workflow’s tasks waited to be run.
+ @discussion A task’s wait time is the time between when it was scheduled and when it was added to
+     the operation queue.
+ @param workflow The workflow. May not be nil.
+ @result The average wait time of the workflow’s tasks that have been run, or 0 if there are none.
+ */
+- (NSTimeInterval)averageWaitTimeForWorkflow:(TSKWorkflow *)workflow NS_SWIFT_NAME(averageWaitTime(for:));
+
+/*!
+ @abstract Returns the longest time any of the specified workflow’s tasks waited to be run.
+ @param workflow The workflow. May not be nil.
+ @result The maximum wait time of the workflow’s tasks that have been run, or 0 if there are none.
+ */
+- (NSTimeInterval)maximumWaitTimeForWorkflow:(TSKWorkflow *)workflow NS_SWIFT_NAME(maximumWaitTime(for:));
+
+@end
+
+NS_ASSUME_NONNULL_END
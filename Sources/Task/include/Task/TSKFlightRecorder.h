@@ -0,0 +1,97 @@
+//
+//  TSKFlightRecorder.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ TSKFlightRecorder records task lifecycle events so that a stalled or misbehaving workflow can be
+ diagnosed after the fact.
+
+ Every thread that performs task work has its own fixed-size ring of compact binary events. Each
+ event contains a monotonic timestamp, the ID of the thread that recorded it, the address of the
+ task it pertains to, and what happened: a state transition, the task’s work being enqueued on an
+ operation queue, or that work being dequeued and starting to run. Recording an event writes a few
+ words to the current thread’s ring and takes no locks, so the recorder is enabled by default. Once
+ a ring is full, each new event overwrites the thread’s oldest event.
+
+ The contents of all rings can be dumped on demand with +dump or, once a signal handler has been
+ installed with +installSignalHandlerForSignal:dumpPath:, by sending the process a signal. Dumps are
+ compact binary data that can be turned into readable text with +descriptionOfDump:. Because rings
+ are read while other threads may be writing to them, a dump is a best-effort snapshot.
+
+ TSKFlightRecorder is thread-safe.
+ */
+@interface TSKFlightRecorder : NSObject
+
+/*! Whether events are recorded. The default value is YES. */
+@property (class, atomic, assign, getter=isEnabled) BOOL enabled;
+
+/*! The number of events each thread’s ring can hold. */
+@property (class, nonatomic, assign, readonly) NSUInteger eventCapacityPerThread;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/*!
+ @abstract Returns a dump of the events recorded by all threads.
+ @result The dump, which can be decoded with +descriptionOfDump:.
+ */
++ (NSData *)dump;
+
+/*!
+ @abstract Returns a readable description of the events in the specified dump.
+ @discussion The description contains one line per event in the order in which the events were
+     recorded. Each line contains the time of the event relative to the first event in the dump, the
+     recording thread’s ID, the task’s address, and a description of the event.
+ @param dump The dump, which may have been returned by +dump or written by a signal handler. May not
+     be nil.
+ @result A description of the events in the dump, or nil if the data is not a valid dump.
+ */
++ (nullable NSString *)descriptionOfDump:(NSData *)dump;
+
+/*!
+ @abstract Discards all previously recorded events.
+ @discussion Events recorded concurrently with this method may or may not be discarded.
+ */
++ (void)removeAllEvents;
+
+/*!
+ @abstract Installs a handler that writes a dump to the specified path when the process receives
+     the specified signal.
+ @discussion The handler only uses async-signal-safe functions. Any previously installed handler for
+     the signal is replaced.
+ @param signal The signal, e.g., SIGUSR1.
+ @param path The path of the file to which dumps are written. The file is replaced each time the
+     signal is received. May not be nil.
+ @result Whether the handler was installed.
+ */
++ (BOOL)installSignalHandlerForSignal:(int)signal dumpPath:(NSString *)path;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,103 @@
+//
+//  TSKFunctionTask.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <Task/TSKTask.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ @abstract Type for functions that perform a TSKFunctionTask’s work.
+ @param task The task whose work is being performed.
+ @param context The task’s context pointer.
+ */
+typedef void (*TSKTaskFunction)(TSKTask *task, void *_Nullable context);
+
+
+/*!
+ TSKFunctionTasks perform a task’s work by calling a C function with a context pointer. They are
+ the cheapest tasks to create and run, and are intended for workflows with very large numbers of
+ tiny tasks, such as generated ones. Unlike TSKBlockTask, creating one does not copy a block, and
+ unlike TSKSelectorTask, running one does not send a message to a target. The function is called
+ directly from the task’s ‑main.
+
+ The context is not retained. It must remain valid for as long as the task or any of its copies may
+ execute.
+ */
+@interface TSKFunctionTask : TSKTask
+
+/*!
+ @abstract The function that performs the task’s work.
+ @discussion This function takes the place of a TSKTask’s ‑main method. As such, it must invoke
+     ‑finishWithResult: or ‑failWithError: on the supplied task parameter upon success and failure,
+     respectively. Failing to do so will prevent dependent tasks from executing.
+ */
+@property (nonatomic, assign, readonly) TSKTaskFunction function;
+
+/*! The pointer passed to the task’s function. */
+@property (nonatomic, assign, readonly, nullable) void *context;
+
+/*!
+ @abstract -init is unavailable, as there is no reasonable default value for the instance’s function.
+ @discussion Use -initWithFunction:context: instead.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*!
+ @abstract -initWithName: is unavailable, as there is no reasonable default value for the instance’s
+     function.
+ @discussion Use -initWithName:function:context: instead.
+ */
+- (instancetype)initWithName:(nullable NSString *)name NS_UNAVAILABLE;
+
+/*!
+ @abstract Initializes a newly created TSKFunctionTask instance with the specified function and
+     context.
+ @discussion A default name will be given to the task as specified by TSKTask’s ‑initWithName:.
+ @param function The function that performs the task’s work. May not be NULL.
+ @param context The pointer to pass to the function. May be NULL.
+ @result A newly initialized TSKFunctionTask instance with the specified function and context.
+ */
+- (instancetype)initWithFunction:(TSKTaskFunction)function context:(nullable void *)context;
+
+/*!
+ @abstract Initializes a newly created TSKFunctionTask instance with the specified name, function,
+     and context.
+ @discussion This is the class’s designated initializer.
+ @param name The name of the task. If nil, a default name will be given to the task as specified by
+     TSKTask’s ‑initWithName:.
+ @param function The function that performs the task’s work. May not be NULL.
+ @param context The pointer to pass to the function. May be NULL.
+ @result A newly initialized TSKFunctionTask instance with the specified name, function, and context.
+ */
+- (instancetype)initWithName:(nullable NSString *)name
+                    function:(TSKTaskFunction)function
+                     context:(nullable void *)context NS_DESIGNATED_INITIALIZER;
+
+@end
+
+NS_ASSUME_NONNULL_END
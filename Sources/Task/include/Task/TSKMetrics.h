@@ -0,0 +1,214 @@
+//
+//  TSKMetrics.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class TSKMetricsSnapshot;
+
+/*! TSKMetricsCounter enumerates the task lifecycle events that metrics count. */
+typedef NS_ENUM(NSInteger, TSKMetricsCounter) {
+    /*! Tasks that started executing. */
+    TSKMetricsCounterTasksStarted,
+
+    /*! Tasks that finished successfully. */
+    TSKMetricsCounterTasksFinished,
+
+    /*! Tasks that failed. */
+    TSKMetricsCounterTasksFailed,
+
+    /*! Tasks that were cancelled. */
+    TSKMetricsCounterTasksCancelled,
+
+    /*! Tasks that were retried. */
+    TSKMetricsCounterTasksRetried,
+
+    /*! Batches of batchable tasks’ work that were dispatched. */
+    TSKMetricsCounterBatchesDispatched,
+};
+
+
+/*!
+ TSKMetrics objects collect counters, gauges, and latency histograms about the tasks in one or more
+ workflows.
+
+ Each workflow has its own metrics, and everything recorded in a workflow’s metrics is also recorded
+ in the process-wide shared metrics. Metrics are updated by many threads at once, so updates go to
+ per-thread shards that are only merged when a snapshot is taken. Recording therefore never
+ contends on shared counters.
+
+ Latency histograms use logarithmic buckets with four buckets per power of two from about one
+ microsecond to about eighteen minutes, so percentiles are accurate to within 25%.
+
+ TSKMetrics is thread-safe.
+ */
+@interface TSKMetrics : NSObject
+
+/*!
+ @abstract The name of the metrics.
+ @discussion The name of a workflow’s metrics is the workflow’s name. The shared metrics have no
+     name. When present, the name is exported as the workflow label of each Prometheus metric.
+ */
+@property (nonatomic, copy, readonly, nullable) NSString *name;
+
+/*! Returns the process-wide shared metrics, which include the metrics of every workflow. */
++ (TSKMetrics *)sharedMetrics;
+
+/*!
+ @abstract Initializes a newly created TSKMetrics instance with no name.
+ @result A newly initialized TSKMetrics instance.
+ */
+- (instancetype)init;
+
+/*!
+ @abstract Initializes a newly created TSKMetrics instance with the specified name.
+ @discussion This is the class’s designated initializer.
+ @param name The name of the metrics. May be nil.
+ @result A newly initialized TSKMetrics instance.
+ */
+- (instancetype)initWithName:(nullable NSString *)name NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Returns a snapshot of the metrics’ current values.
+ @discussion Updates made concurrently with this method may or may not be reflected in the snapshot.
+ @result A snapshot of the metrics.
+ */
+- (TSKMetricsSnapshot *)snapshot;
+
+/*!
+ @abstract Periodically invokes the specified handler with a snapshot of the metrics.
+ @discussion The handler is invoked serially on a private queue. Any previous periodic export is
+     stopped. Use -[TSKMetricsSnapshot prometheusText] or -[TSKMetricsSnapshot
+     writePrometheusTextToURL:error:] in the handler to export the snapshot.
+ @param interval The time between invocations of the handler. Must be positive.
+ @param handler The handler to invoke. May not be nil.
+ */
+- (void)startExportingWithInterval:(NSTimeInterval)interval handler:(void (^)(TSKMetricsSnapshot *snapshot))handler;
+
+/*! Stops the periodic export started by ‑startExportingWithInterval:handler:, if any. */
+- (void)stopExporting;
+
+@end
+
+
+#pragma mark -
+
+/*! TSKLatencyHistogram objects are immutable snapshots of latency histograms. */
+@interface TSKLatencyHistogram : NSObject
+
+/*! The number of recorded latencies. */
+@property (nonatomic, assign, readonly) uint64_t count;
+
+/*! The sum of the recorded latencies. */
+@property (nonatomic, assign, readonly) NSTimeInterval totalDuration;
+
+/*! The mean of the recorded latencies, or 0 if there are none. */
+@property (nonatomic, assign, readonly) NSTimeInterval meanDuration;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/*!
+ @abstract Returns the approximate latency at the specified percentile.
+ @discussion The result is the upper bound of the bucket in which the percentile falls.
+ @param percentile The percentile, expressed as a value between 0 and 1, inclusive.
+ @result The approximate latency at the percentile, or a negative value if there are no latencies.
+ */
+- (NSTimeInterval)durationAtPercentile:(double)percentile;
+
+/*!
+ @abstract Enumerates the histogram’s buckets in increasing order.
+ @param block The block to invoke for each bucket. It is passed the bucket’s inclusive upper bound,
+     which is INFINITY for the last bucket, and the number of latencies less than or equal to that
+     bound.
+ */
+- (void)enumerateBucketsUsingBlock:(void (NS_NOESCAPE ^)(NSTimeInterval upperBound, uint64_t cumulativeCount))block;
+
+@end
+
+
+#pragma mark -
+
+/*! TSKMetricsSnapshot objects are immutable snapshots of metrics. */
+@interface TSKMetricsSnapshot : NSObject
+
+/*! The name of the metrics from which the snapshot was taken. */
+@property (nonatomic, copy, readonly, nullable) NSString *name;
+
+/*! The system uptime at which the snapshot was taken. */
+@property (nonatomic, assign, readonly) NSTimeInterval timestamp;
+
+/*! The number of task work blocks that have been enqueued but have not yet started running. */
+@property (nonatomic, assign, readonly) int64_t readyQueueDepth;
+
+/*!
+ @abstract The number of active workflows.
+ @discussion A workflow is active from when it is started or retried until all its tasks finish,
+     one of its tasks fails, or it is cancelled or reset. A workflow’s own metrics therefore have an
+     active workflow count of 0 or 1.
+ */
+@property (nonatomic, assign, readonly) int64_t activeWorkflowCount;
+
+/*! The time task work blocks spent enqueued before they started running. */
+@property (nonatomic, strong, readonly) TSKLatencyHistogram *queueWaitLatency;
+
+/*! The time tasks spent executing before they finished successfully. */
+@property (nonatomic, strong, readonly) TSKLatencyHistogram *executionLatency;
+
+/*! The snapshot in the Prometheus text exposition format. */
+@property (nonatomic, copy, readonly) NSString *prometheusText;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/*!
+ @abstract Returns the value of the specified counter.
+ @param counter The counter.
+ @result The number of times the counted event occurred before the snapshot was taken.
+ */
+- (uint64_t)valueForCounter:(TSKMetricsCounter)counter;
+
+/*!
+ @abstract Returns the rate at which the specified counter increased between the specified
+     snapshot and the receiver.
+ @param counter The counter.
+ @param snapshot An earlier snapshot of the same metrics. May not be nil.
+ @result The counter’s average increase per second, or 0 if the snapshots were taken at the same time.
+ */
+- (double)ratePerSecondForCounter:(TSKMetricsCounter)counter sinceSnapshot:(TSKMetricsSnapshot *)snapshot;
+
+/*!
+ @abstract Atomically writes the snapshot in the Prometheus text exposition format to the specified
+     file, e.g., for collection by the node exporter’s textfile collector.
+ @param fileURL The URL of the file. May not be nil.
+ @param error If an error occurs, upon return contains an NSError object that describes the problem.
+ @result Whether the file was written successfully.
+ */
+- (BOOL)writePrometheusTextToURL:(NSURL *)fileURL error:(NSError **)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
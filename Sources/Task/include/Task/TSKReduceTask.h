@@ -0,0 +1,96 @@
+//
+//  TSKReduceTask.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <Task/TSKTask.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ TSKReduceTasks combine the results of their prerequisite tasks into a single result using an
+ associative block.
+
+ Rather than waiting for every prerequisite to finish and then combining their results one after
+ another, a reduce task combines results pairwise in a balanced tree as its prerequisites finish.
+ Each combination runs on the thread of the prerequisite whose result completed the pair, so the
+ reduction proceeds in parallel with the prerequisites still executing. When the last prerequisite
+ finishes, at most log₂ n combinations remain, where n is the number of prerequisites. This makes
+ reduce tasks well suited to very large fan-ins.
+
+ Each operand of the block covers a contiguous range of the task’s prerequisites in the order the
+ workflow records them, and the left operand’s range always precedes the right operand’s. The block
+ therefore only needs to be associative, not commutative, for the shape of the reduction to be
+ independent of the order in which prerequisites finish.
+
+ Prerequisites that are skipped contribute nothing to the result. A reduce task with no
+ prerequisites, or none that finish, finishes with a nil result. A reduce task with exactly one
+ contributing prerequisite finishes with that prerequisite’s result without invoking its block.
+ */
+@interface TSKReduceTask : TSKTask
+
+/*!
+ @abstract The block that combines two results.
+ @discussion May not be nil. The block must be associative and must not block. It may be invoked
+     concurrently with itself on different threads for disjoint operands.
+ */
+@property (nonatomic, copy, readonly) id _Nullable (^block)(id _Nullable left, id _Nullable right);
+
+/*!
+ @abstract -init is unavailable, as there is no reasonable default value for the instance’s block.
+ @discussion Use -initWithBlock: instead.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*!
+ @abstract -initWithName: is unavailable, as there is no reasonable default value for the instance’s
+     block.
+ @discussion Use -initWithName:block: instead.
+ */
+- (instancetype)initWithName:(nullable NSString *)name NS_UNAVAILABLE;
+
+/*!
+ @abstract Initializes a newly created TSKReduceTask instance with the specified block.
+ @discussion A default name will be given to the task as specified by TSKTask’s ‑initWithName:.
+ @param block The block that combines two results. May not be nil.
+ @result A newly initialized TSKReduceTask instance with the specified block.
+ */
+- (instancetype)initWithBlock:(id _Nullable (^)(id _Nullable left, id _Nullable right))block;
+
+/*!
+ @abstract Initializes a newly created TSKReduceTask instance with the specified name and block.
+ @discussion This is the class’s designated initializer.
+ @param name The name of the task. If nil, a default name will be given to the task as specified by
+     TSKTask’s ‑initWithName:.
+ @param block The block that combines two results. May not be nil.
+ @result A newly initialized TSKReduceTask instance with the specified name and block.
+ */
+- (instancetype)initWithName:(nullable NSString *)name
+                       block:(id _Nullable (^)(id _Nullable left, id _Nullable right))block NS_DESIGNATED_INITIALIZER;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,116 @@
+//
+//  TSKResultStore.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ TSKResultStore objects keep large task results from exhausting memory. Workflows whose resultStore
+ property is set register each of their tasks’ results with it when the task finishes.
+
+ NSData results whose length is at least the store’s spill threshold are candidates for spilling.
+ When the process’s memory footprint exceeds the store’s memory budget, or the system reports memory
+ pressure, the store writes candidates to temporary files, oldest first, and replaces each task’s
+ result with an NSData that memory-maps its file. The mapped data is equal to the original, and
+ accessors like ‑[TSKTask result] and ‑[TSKTask prerequisiteResultForKey:] return it directly, so
+ reading a spilled result doesn’t copy it. Its pages are read back in from disk as they are accessed
+ and, because they are backed by a file, the system can evict them again instead of counting them
+ against the process.
+
+ Spilled files are unlinked as soon as they are mapped, so they use disk space only while their data
+ is referenced and never outlive the process. Spilling only reduces memory use once nothing else
+ references the original data, so tasks should not hold on to large results after finishing with them.
+ Results of other classes are never spilled.
+
+ TSKResultStore is thread-safe.
+ */
+@interface TSKResultStore : NSObject
+
+/*! The directory in which spilled results are written. */
+@property (nonatomic, copy, readonly) NSURL *directoryURL;
+
+/*!
+ @abstract The minimum length in bytes of results that the store spills.
+ @discussion Mapping a file costs at least a page of address space and a system call, so small
+     results are better left in memory. Changing this only affects results registered afterward.
+     Must be positive. The default value is 1 MiB.
+ */
+@property (atomic, assign) NSUInteger spillThreshold;
+
+/*!
+ @abstract The memory footprint in bytes above which the store spills results.
+ @discussion The store checks the process’s footprint each time a result that can be spilled is
+     registered and spills enough results to bring it back under the budget. Setting this to 0 spills
+     every candidate as soon as it is registered. The default value is half of the device’s physical
+     memory.
+ */
+@property (atomic, assign) uint64_t memoryBudget;
+
+/*! The number of results the store has spilled. */
+@property (nonatomic, assign, readonly) NSUInteger spilledResultCount;
+
+/*! The total length in bytes of the results the store has spilled. */
+@property (nonatomic, assign, readonly) uint64_t spilledByteCount;
+
+/*! The process’s current memory footprint in bytes, as the store measures it. */
+@property (class, nonatomic, assign, readonly) uint64_t currentMemoryFootprint;
+
+/*!
+ @abstract Initializes a newly created result store that spills results to the temporary directory.
+ @result A newly initialized result store.
+ */
+- (instancetype)init;
+
+/*!
+ @abstract Initializes a newly created result store that spills results to the specified directory.
+ @discussion This is the class’s designated initializer.
+ @param directoryURL The file URL of an existing directory in which to write spilled results. May not
+     be nil.
+ @result A newly initialized result store.
+ */
+- (instancetype)initWithDirectoryURL:(NSURL *)directoryURL NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Spills results until the process’s memory footprint is within the store’s memory budget
+     or no candidates remain.
+ @discussion The store does this automatically. This method is useful after lowering the budget.
+     Results are spilled synchronously.
+ */
+- (void)spillResultsIfNeeded;
+
+/*!
+ @abstract Spills every candidate result, regardless of the store’s memory budget.
+ @discussion The store does this automatically when the system reports memory pressure. Results are
+     spilled synchronously.
+ */
+- (void)spillAllResults;
+
+@end
+
+NS_ASSUME_NONNULL_END
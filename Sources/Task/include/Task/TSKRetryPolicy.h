@@ -0,0 +1,115 @@
+//
+//  TSKRetryPolicy.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ TSKRetryPolicy objects describe when and how soon a task that fails should automatically try again.
+
+ When a task with a retry policy fails and the policy allows another attempt, the task goes back
+ into the pending state instead of the failed state, and its failure is not reported to its
+ delegate or workflow. After the policy’s delay, the task starts again. Waiting tasks do not occupy
+ an operation queue thread; their retries are scheduled on +[TSKTimerWheel sharedTimerWheel]. Once
+ the policy allows no more attempts, the task fails as usual.
+
+ Delays grow exponentially with each attempt, up to a maximum, and are randomly shortened by the
+ policy’s jitter. Jitter keeps many tasks that fail at the same time, e.g., because a service they
+ depend on has a brief outage, from all retrying at the same time.
+
+ Policies may be shared among many tasks. Their properties should not be changed while tasks that
+ use them are executing.
+ */
+@interface TSKRetryPolicy : NSObject
+
+/*!
+ @abstract The maximum number of times a task may attempt its work, including the first attempt.
+ @discussion A value of 1 means the task is never retried. The default value is 3.
+ */
+@property (nonatomic, assign) NSUInteger maximumAttemptCount;
+
+/*!
+ @abstract The delay before the first retry.
+ @discussion The default value is 1 second.
+ */
+@property (nonatomic, assign) NSTimeInterval initialDelay;
+
+/*!
+ @abstract The factor by which the delay grows after each retry.
+ @discussion Must be at least 1. The default value is 2.
+ */
+@property (nonatomic, assign) double backoffMultiplier;
+
+/*!
+ @abstract The longest delay before a retry, before jitter is applied.
+ @discussion The default value is 60 seconds.
+ */
+@property (nonatomic, assign) NSTimeInterval maximumDelay;
+
+/*!
+ @abstract The fraction of each delay that is randomized.
+ @discussion Expressed as a value between 0 and 1, inclusive. Each delay is shortened by a random
+     amount up to this fraction of it. A value of 0 means delays are not randomized; a value of 1
+     means each delay is chosen uniformly between 0 and its full length. The default value is 1.
+ */
+@property (nonatomic, assign) double jitter;
+
+/*!
+ @abstract A block that returns whether a task that failed with the specified error may be retried.
+ @discussion If nil, every error is retryable. The default value is nil.
+ */
+@property (nonatomic, copy, nullable) BOOL (^retryableErrorPredicate)(NSError * _Nullable error);
+
+/*!
+ @abstract Initializes a newly created TSKRetryPolicy instance with the default values.
+ @discussion This is the class’s designated initializer.
+ @result A newly initialized TSKRetryPolicy instance.
+ */
+- (instancetype)init NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Returns whether a task that failed with the specified error on the specified attempt
+     should be retried.
+ @param attemptCount The number of attempts the task has made, including the one that failed.
+ @param error The error the task failed with.
+ @result Whether the task should be retried.
+ */
+- (BOOL)shouldRetryAfterAttemptCount:(NSUInteger)attemptCount error:(nullable NSError *)error NS_SWIFT_NAME(shouldRetry(afterAttemptCount:error:));
+
+/*!
+ @abstract Returns how long a task should wait before retrying after the specified attempt.
+ @discussion The result includes jitter, so it may differ each time this method is invoked.
+ @param attemptCount The number of attempts the task has made, including the one that failed.
+ @result The delay before the next attempt.
+ */
+- (NSTimeInterval)delayAfterAttemptCount:(NSUInteger)attemptCount NS_SWIFT_NAME(delay(afterAttemptCount:));
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,108 @@
+//
+//  TSKSpeculationPolicy.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class TSKDurationHistogram;
+
+/*!
+ TSKSpeculationPolicy objects describe when a task should hedge against running unusually long by
+ starting a duplicate, speculative attempt of its work.
+
+ A policy keeps a histogram of how long the tasks that use it take to finish successfully. Once the
+ histogram has at least minimumSampleCount durations, a task that has been executing longer than the
+ duration at the policy’s percentile starts a speculative attempt: its ‑main method is invoked
+ again on its operation queue while the original attempt is still running. Whichever attempt sends
+ the task ‑finishWithResult: or ‑failWithError: first determines the task’s outcome. The task then
+ leaves the executing state and cancels its cancellationToken, even if it finished successfully, so
+ losing attempts are cancelled. Any later ‑finishWithResult: or ‑failWithError: messages are ignored.
+
+ Speculation is only appropriate for tasks whose ‑main is idempotent and safe to run concurrently
+ with itself. Tasks that share a policy should perform similar work, since they share its histogram.
+ */
+@interface TSKSpeculationPolicy : NSObject
+
+/*!
+ @abstract The percentile of observed durations after which a speculative attempt starts.
+ @discussion This is expressed as a value between 0 and 1, inclusive.
+ */
+@property (nonatomic, assign, readonly) double percentile;
+
+/*!
+ @abstract The minimum number of observed durations required before speculation occurs.
+ @discussion The default value is 10.
+ */
+@property (nonatomic, assign) NSUInteger minimumSampleCount;
+
+/*!
+ @abstract The maximum number of speculative attempts a task may start each time it executes.
+ @discussion Each additional attempt starts after the task has been executing for another
+     speculation delay. The default value is 1.
+ */
+@property (nonatomic, assign) NSUInteger maximumSpeculativeAttemptCount;
+
+/*! The histogram of durations that tasks using the policy took to finish successfully. */
+@property (nonatomic, strong, readonly) TSKDurationHistogram *durationHistogram;
+
+/*!
+ @abstract How long a task should execute before starting a speculative attempt.
+ @discussion This is the approximate duration at the policy’s percentile of its duration histogram,
+     or a negative value if the histogram has fewer than minimumSampleCount durations.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval speculationDelay;
+
+/*!
+ @abstract -init is unavailable, as there is no reasonable default percentile.
+ @discussion Use -initWithPercentile: instead.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*!
+ @abstract Initializes a newly created TSKSpeculationPolicy instance with the specified percentile
+     and a new duration histogram with a window of five minutes.
+ @param percentile The percentile of observed durations after which a speculative attempt starts,
+     expressed as a value between 0 and 1, inclusive.
+ @result A newly initialized TSKSpeculationPolicy instance.
+ */
+- (instancetype)initWithPercentile:(double)percentile;
+
+/*!
+ @abstract Initializes a newly created TSKSpeculationPolicy instance with the specified percentile
+     and duration histogram.
+ @discussion This is the class’s designated initializer.
+ @param percentile The percentile of observed durations after which a speculative attempt starts,
+     expressed as a value between 0 and 1, inclusive.
+ @param durationHistogram The duration histogram to use. May not be nil.
+ @result A newly initialized TSKSpeculationPolicy instance.
+ */
+- (instancetype)initWithPercentile:(double)percentile durationHistogram:(TSKDurationHistogram *)durationHistogram NS_DESIGNATED_INITIALIZER;
+
+@end
+
+NS_ASSUME_NONNULL_END
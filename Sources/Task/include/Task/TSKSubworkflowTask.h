@@ -38,7 +38,9 @@ NS_ASSUME_NONNULL_BEGIN
  A subworkflow task’s state reflects that of the tasks in its subworkflow. When the entire
  subworkflow finishes, the subworkflow task finishes; when a single task in the subworkflow fails
  with an error, the subworkflow task fails with that error. Finally, when a task in the subworkflow
- is cancelled, the entire subworkflow task is cancelled.
+ is cancelled, the entire subworkflow task is cancelled. When the subworkflow task starts its
+ subworkflow, it sets the subworkflow’s cancellationToken to its own, so the work of the
+ subworkflow’s executing tasks is told to stop as soon as the subworkflow task stops executing.
 
  Generally speaking, avoid starting a subworkflow task’s subworkflow before starting the subworkflow
  task itself. If, when a subworkflow task starts, it finds that its subworkflow is already finished,
@@ -68,6 +70,9 @@ NS_ASSUME_NONNULL_BEGIN
  Using result-forwarding tasks as either the first tasks in a subworkflow or the first tasks after a
  subworkflow task can make it significantly easier to communicate results in and out of a
  subworkflow.
+
+ Copying a subworkflow task instantiates a new subworkflow from a TSKWorkflowTemplate of the
+ original’s subworkflow, so each copy runs its own subworkflow.
  */
 @interface TSKSubworkflowTask : TSKTask
 
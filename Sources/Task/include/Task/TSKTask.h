@@ -52,7 +52,13 @@ typedef NS_ENUM(NSUInteger, TSKTaskState) {
     TSKTaskStateFinished,
 
     /*! State indicating that the task failed. */
-    TSKTaskStateFailed
+    TSKTaskStateFailed,
+
+    /*!
+     State indicating that the task was skipped, either because it was sent ‑skip or because its
+     prerequisites did not call for it to run.
+     */
+    TSKTaskStateSkipped
 };
 
 /*!
@@ -63,6 +69,32 @@ typedef NS_ENUM(NSUInteger, TSKTaskState) {
 extern NSString *const _Nullable TSKTaskStateDescription(TSKTaskState state);
 
 
+/*!
+ @abstract Type for execution class names.
+ @discussion An execution class groups tasks that should run on the same pool of worker threads.
+     Workflows map execution classes to operation queues using ‑[TSKWorkflow
+     setOperationQueue:forExecutionClass:]. Each queue’s maximum concurrent operation count and
+     quality of service determine how many threads the class may use and how the system schedules
+     them.
+ */
+typedef NSString *TSKExecutionClass NS_TYPED_EXTENSIBLE_ENUM;
+
+/*!
+ @abstract Execution class for latency-critical work.
+ @discussion Operation queues used for this class should typically have a quality of service of
+     NSQualityOfServiceUserInitiated or NSQualityOfServiceUserInteractive.
+ */
+extern TSKExecutionClass const TSKExecutionClassLatencyCritical;
+
+/*!
+ @abstract Execution class for throughput-oriented batch work.
+ @discussion Operation queues used for this class should typically have a quality of service of
+     NSQualityOfServiceUtility or NSQualityOfServiceBackground, which the system schedules with
+     lower priority and, on Apple silicon, preferentially on efficiency cores.
+ */
+extern TSKExecutionClass const TSKExecutionClassBatch;
+
+
 /*!
  @abstract Notification posted when a task is cancelled.
  @discussion This notification is posted immediately after the task goes into the cancelled state.
@@ -86,6 +118,14 @@ extern NSString *const TSKTaskDidFailNotification;
  */
 extern NSString *const TSKTaskDidFinishNotification;
 
+/*!
+ @abstract Notification posted when a task is invalidated.
+ @discussion This notification is posted immediately after the task is put back into the pending
+     state by ‑invalidate, either because it was sent that message or because one of its
+     prerequisites was. The object of the notification is the task. It has no userInfo dictionary.
+ */
+extern NSString *const TSKTaskDidInvalidateNotification;
+
 /*!
  @abstract Notification posted when a task is reset.
  @discussion This notification is posted immediately after the task is reset but before it is
@@ -97,10 +137,26 @@ extern NSString *const TSKTaskDidResetNotification;
 /*!
  @abstract Notification posted when a task is retried.
  @discussion This notification is posted immediately after the task is put back into the pending
-     state. The object of the notification is the task. It has no userInfo dictionary.
+     state by ‑retry, or when a retry scheduled by the task’s retry policy is due, just before the
+     task is restarted. The object of the notification is the task. It has no userInfo dictionary.
  */
 extern NSString *const TSKTaskDidRetryNotification;
 
+/*!
+ @abstract Notification posted when a task that failed schedules a retry.
+ @discussion This notification is posted immediately after the task’s retry policy allows another
+     attempt and the task is put back into the pending state to wait for it. The task’s failure is
+     not reported. The object of the notification is the task. It has no userInfo dictionary.
+ */
+extern NSString *const TSKTaskDidScheduleRetryNotification;
+
+/*!
+ @abstract Notification posted when a task is skipped.
+ @discussion This notification is posted immediately after the task goes into the skipped state.
+     The object of the notification is the task. It has no userInfo dictionary.
+ */
+extern NSString *const TSKTaskDidSkipNotification;
+
 /*!
  @abstract Notification posted when a task starts.
  @discussion This notification is posted immediately after the task goes into the executing state,
@@ -113,6 +169,11 @@ extern NSString *const TSKTaskDidStartNotification;
 
 #pragma mark -
 
+@class TSKCancellationToken;
+@class TSKChannel;
+@class TSKDurationHistogram;
+@class TSKRetryPolicy;
+@class TSKSpeculationPolicy;
 @class TSKWorkflow;
 @protocol TSKTaskDelegate;
 
@@ -145,8 +206,12 @@ extern NSString *const TSKTaskDidStartNotification;
 
  Every TSKTask has an optional delegate that can be informed when a task succeeds or fails. See the
  documentation for TSKTaskDelegate for more information.
+
+ Copying a task creates a new task that is configured like the original but is not in a workflow and
+ has not been run. This is how TSKWorkflowTemplate instantiates its prototype tasks. Subclasses with
+ configuration of their own must override ‑copyWithZone:. See ‑copyConfigurationToTask: for details.
  */
-@interface TSKTask : NSObject
+@interface TSKTask : NSObject <NSCopying>
 
 /*! 
  @abstract The task’s name. 
@@ -160,10 +225,124 @@ extern NSString *const TSKTaskDidStartNotification;
 
 /*!
  @abstract The task’s operation queue.
- @discussion If not explicitly set, the task’s queue will be the same as its workflow’s.
+ @discussion If not explicitly set, the task’s queue is its workflow’s operation queue for the task’s
+     effective execution class. See ‑[TSKWorkflow operationQueueForExecutionClass:]. In that case, if
+     the execution class has no dedicated queue and the workflow has a scheduler, the task instead
+     runs on the scheduler’s operation queue.
  */
 @property (nonatomic, strong, nullable) NSOperationQueue *operationQueue;
 
+/*!
+ @abstract The task’s execution class.
+ @discussion The execution class determines which of its workflow’s operation queues the task runs
+     on when its operationQueue property has not been explicitly set. If nil, the workflow’s
+     execution class is used. The default value is nil.
+ */
+@property (nonatomic, copy, nullable) TSKExecutionClass executionClass;
+
+/*!
+ @abstract Whether the task’s work may be batched with other tasks’ work.
+ @discussion Batchable tasks whose operationQueue property has not been explicitly set don’t get an
+     operation of their own. Instead, their workflow collects the work of ready batchable tasks with
+     the same effective execution class and runs it one after another in a single operation, as
+     controlled by its batchSize and batchLingerInterval properties. Each task still changes state
+     and posts notifications individually. This amortizes scheduling overhead across tasks whose
+     work is so small that the overhead dominates, but can delay a task by up to the workflow’s
+     batch linger interval, and a batch’s tasks do not run concurrently with one another. The
+     default value is NO.
+ */
+@property (nonatomic, assign, getter=isBatchable) BOOL batchable;
+
+/*!
+ @abstract The time by which the task should finish.
+ @discussion If nil, the task uses its workflow’s deadline. When the workflow has a scheduler whose
+     policy is TSKSchedulingPolicyEarliestDeadlineFirst, ready tasks with earlier deadlines run first.
+     Without a scheduler, the task’s work is given a higher queue priority when its deadline is less
+     than ten seconds away, and a higher one still when it is less than a second away, so that tasks
+     with imminent deadlines run ahead of other waiting work.
+
+     When the task is about to execute, it checks whether its deadline can still be met. If the
+     deadline has passed, or if the median of the task’s duration histogram would take it past the
+     deadline, the task fails immediately with a TSKErrorCodeDeadlineCannotBeMet error
+     instead of invoking ‑main. This leaves capacity for tasks that can still meet their deadlines.
+     The default value is nil.
+ */
+@property (atomic, strong, nullable) NSDate *deadline;
+
+/*!
+ @abstract The maximum amount of time the task may execute each time it starts.
+ @discussion If the task is still executing when its timeout elapses, it fails with a
+     TSKErrorCodeTimedOut error and its cancellationToken is cancelled. Timeouts are tracked using
+     +[TSKTimerWheel sharedTimerWheel], so they are cheap to use on large numbers of tasks, and fire
+     within 10 milliseconds of elapsing. The timer is disarmed as soon as the task stops executing. A
+     value of 0 means the task has no timeout. The default value is 0.
+ */
+@property (atomic, assign) NSTimeInterval timeout;
+
+/*!
+ @abstract A histogram of how long the task takes to finish successfully.
+ @discussion If non-nil, the task records its duration each time it finishes successfully, and uses
+     the histogram’s median to decide whether it can meet its deadline. Tasks that perform similar
+     work may share a histogram. If this is nil, the task uses the histogram for its name in its
+     workflow’s durationStatistics, if there is one. The default value is nil.
+ */
+@property (nonatomic, strong, nullable) TSKDurationHistogram *durationHistogram;
+
+/*!
+ @abstract The task’s speculation policy.
+ @discussion If non-nil, the task starts speculative attempts of its work when it executes for
+     longer than the policy allows. Only set this for tasks whose ‑main method is idempotent and safe
+     to run concurrently with itself. See TSKSpeculationPolicy for more information. The default
+     value is nil.
+ */
+@property (nonatomic, strong, nullable) TSKSpeculationPolicy *speculationPolicy;
+
+/*!
+ @abstract The task’s retry policy.
+ @discussion If non-nil, the task automatically retries after failing, for as long as the policy
+     allows. If nil, the task uses its workflow’s retry policy. Tasks do not retry when their
+     workflow’s timeout elapses or when they fail with a TSKErrorCodeDeadlineCannotBeMet error. See
+     TSKRetryPolicy for more information. The default value is nil.
+ */
+@property (nonatomic, strong, nullable) TSKRetryPolicy *retryPolicy;
+
+/*!
+ @abstract The number of times the task has started executing since it was last reset, retried, or
+     invalidated.
+ @discussion Retries scheduled by the task’s retry policy do not reset the count. Speculative
+     attempts are not counted.
+ */
+@property (nonatomic, assign, readonly) NSUInteger attemptCount;
+
+/*!
+ @abstract A block that returns whether two results of the task are equivalent.
+ @discussion When a task that was invalidated finishes again, this block is invoked with its
+     previous and new results. If it returns YES, the task’s dependents do not need to rerun, and
+     those that were invalidated along with the task finish with their previous results without
+     executing. If nil, results are never considered equivalent. The default value is nil. See
+     ‑invalidate for more information.
+ */
+@property (nonatomic, copy, nullable) BOOL (^resultEqualityTest)(id _Nullable previousResult, id _Nullable result);
+
+/*!
+ @abstract The number of speculative attempts the task started during its current or most recent
+     execution.
+ @discussion This is reset to 0 each time the task starts executing.
+ */
+@property (nonatomic, assign, readonly) NSUInteger speculativeAttemptCount;
+
+/*!
+ @abstract The cancellation token for the task’s current or most recent execution.
+ @discussion A new token is created each time the task starts executing. It is cancelled when the
+     task stops executing for any reason other than finishing successfully, and when the task
+     finishes after starting a speculative attempt, so that losing attempts stop. Long-running
+     implementations of ‑main should get the token once and check whether it is cancelled in their
+     inner loops, as that is much cheaper than checking isExecuting. They may also register
+     cancellation handlers on it to abort blocking work. This is nil until the task first starts
+     executing. See TSKCancellationToken for more information.
+ */
+@property (nonatomic, strong, readonly, nullable) TSKCancellationToken *cancellationToken;
+
 /*! 
  @abstract The task’s workflow. 
  @discussion This property is set when the task is added to a workflow. Once a task has been added
@@ -171,6 +350,21 @@ extern NSString *const TSKTaskDidStartNotification;
  */
 @property (nonatomic, weak, readonly, nullable) TSKWorkflow *workflow;
 
+/*!
+ @abstract The channel from which the task receives items streamed by its streaming prerequisite.
+ @discussion This is nil unless the task was added to its workflow with a streaming prerequisite. See
+     ‑[TSKWorkflow addTask:streamingPrerequisiteTask:channel:prerequisiteTasks:].
+ */
+@property (atomic, strong, readonly, nullable) TSKChannel *inputChannel;
+
+/*!
+ @abstract The channel into which the task streams items to its streaming dependent.
+ @discussion This is nil unless the task was added to its workflow as another task’s streaming
+     prerequisite. Tasks with an output channel should send items to it from ‑main using ‑[TSKChannel
+     sendItem:] and stop executing early if sending fails.
+ */
+@property (atomic, strong, readonly, nullable) TSKChannel *outputChannel;
+
 /*!
  @abstract The task’s prerequisite tasks.
  @discussion This method returns a task’s keyed and unkeyed prerequisite tasks. A task’s prerequisite
@@ -219,6 +413,7 @@ extern NSString *const TSKTaskDidStartNotification;
 /*!
  @abstract Whether the task is ready to execute.
  @discussion A task is ready to execute if all of its prerequisite tasks have finished successfully.
+     See runsWhenPrerequisitesSkipped for how skipped prerequisites are treated.
  */
 @property (nonatomic, assign, readonly, getter=isReady) BOOL ready;
 
@@ -238,6 +433,18 @@ extern NSString *const TSKTaskDidStartNotification;
 /*! Whether the task failed. */
 @property (nonatomic, assign, readonly, getter=isFailed) BOOL failed;
 
+/*! Whether the task was skipped. */
+@property (nonatomic, assign, readonly, getter=isSkipped) BOOL skipped;
+
+/*!
+ @abstract Whether the task runs when some of its prerequisites are skipped.
+ @discussion If NO, the task is skipped as soon as any of its prerequisites is skipped or one of its
+     conditional prerequisites finishes with a result that doesn’t satisfy the condition. If YES,
+     those prerequisites count as finished when deciding whether the task is ready, which is useful
+     for tasks that join conditional branches. The default value is NO.
+ */
+@property (nonatomic, assign) BOOL runsWhenPrerequisitesSkipped;
+
 /*!
  @abstract The date at which the task either finished successfully or failed. 
  @discussion This is nil until the task receives either ‑finishWithResult: or ‑failWithError:.
@@ -247,7 +454,8 @@ extern NSString *const TSKTaskDidStartNotification;
 /*!
  @abstract The result of the task finishing successfully. 
  @discussion This is nil until the task receives ‑finishWithResult:, after which it is the value
-     of that message’s result parameter.
+     of that message’s result parameter. If the task’s workflow has a result store, a large NSData
+     result may later be replaced with an equal one that is mapped from disk. See TSKResultStore.
  */
 @property (nonatomic, strong, readonly, nullable) id result;
 
@@ -305,6 +513,9 @@ extern NSString *const TSKTaskDidStartNotification;
 
      Subclass implementations of this method should periodically check whether the task is in the
      executing state (-isExecuting) and, if not, stop executing at the earliest possible moment.
+
+     If the task has a speculation policy, this method may be invoked again while a previous
+     invocation is still running. See TSKSpeculationPolicy for more information.
  */
 - (void)main;
 
@@ -335,7 +546,8 @@ extern NSString *const TSKTaskDidStartNotification;
 /*!
  @abstract Sets the task’s state to pending if it is ready, executing, finished, failed, or cancelled.
  @discussion If, after being reset, the task’s prerequisite tasks have all finished successfully, the 
-     task is automatically put into the ready state. Regardless of the task’s state, sends the ‑reset 
+     task is automatically put into the ready state. If the task is waiting for a retry scheduled by
+     its retry policy, the retry is cancelled. Regardless of the task’s state, sends the ‑reset
      message to all of the task’s dependent tasks.
 
      Subclasses should invoke the superclass implementation of this method.
@@ -352,6 +564,55 @@ extern NSString *const TSKTaskDidStartNotification;
  */
 - (void)retry NS_REQUIRES_SUPER;
 
+/*!
+ @abstract Sets the task’s state to skipped if it is pending, ready, or executing.
+ @discussion Skipping is a normal outcome, not a failure or cancellation: no failure or
+     cancellation notifications are posted, and the task counts as done when deciding whether its
+     workflow has finished. Each of the task’s dependents is then either skipped too or, if its
+     runsWhenPrerequisitesSkipped property is YES, started once its other prerequisites have
+     finished. Skipping reaches all affected tasks in time proportional to the number of tasks and
+     prerequisite relationships involved.
+
+     Like cancellation, this only marks the task as skipped. A task that is executing should stop
+     doing its work.
+ */
+- (void)skip;
+
+/*!
+ @abstract Marks a finished task as out of date and reruns it, rerunning its dependents only if its
+     result changes.
+ @discussion This is intended for incremental re-execution: when an input that a finished task
+     depends on changes, invalidate the task instead of resetting it. The task is put into the
+     pending state and restarted once its prerequisites have all finished successfully. Its finished
+     dependents, and theirs, are put into the pending state too, but they only execute again if the
+     result of at least one of their prerequisites changed. Whether a result changed is decided by
+     the task’s resultEqualityTest. Dependents whose prerequisites’ results are all unchanged
+     finish with their previous results without executing, so invalidating a task whose result does
+     not change costs a single execution. Skipped dependents are put into the pending state as well,
+     so that whether they are skipped is decided again once their prerequisites finish. So are ready
+     and executing dependents, which would otherwise use an out-of-date result; an executing
+     dependent’s cancellation token is cancelled and the result of that execution is ignored.
+
+     If the task is not finished or skipped, this method does nothing.
+ */
+- (void)invalidate;
+
+/*!
+ @abstract Blocks the calling thread until the task finishes, fails, is cancelled, or is skipped, or
+     until the specified timeout elapses.
+ @discussion The waiting thread is woken directly when the task is done; it does not poll or observe
+     notifications. By the time this returns, the task’s result or error has been set and its
+     delegate and observers have been informed. If the task is already done, this returns
+     immediately. A task waiting for a retry scheduled by its retry policy is not done.
+
+     This must not be invoked on a thread that the task needs in order to finish, e.g., from another
+     task’s ‑main method running on a serial operation queue that the task also uses.
+ @param timeout The maximum amount of time to wait.
+ @result The task’s state when the wait ended. If it is not finished, failed, cancelled, or skipped,
+     the timeout elapsed first.
+ */
+- (TSKTaskState)waitUntilFinishedWithTimeout:(NSTimeInterval)timeout NS_SWIFT_NAME(waitUntilFinished(timeout:));
+
 /*!
  @abstract Sets the task’s state to finished and updates its result and finishDate properties.
  @discussion Subclasses should ensure that this message is sent to the task when the task’s work
@@ -461,9 +722,10 @@ extern NSString *const TSKTaskDidStartNotification;
 /*!
  @abstract Performs actions once the task has been retried.
  @discussion This method is invoked after the task has been put in the pending state but before
-     it has informed its delegate or posted any relevant notifications. The default implementation
-     does nothing. Subclasses can override this method to perform any special actions upon being
-     retried. This method should not be invoked directly.
+     it has informed its delegate or posted any relevant notifications. It is also invoked when a
+     retry scheduled by the task’s retry policy is due, just before the task is restarted. The
+     default implementation does nothing. Subclasses can override this method to perform any special
+     actions upon being retried. This method should not be invoked directly.
  */
 - (void)didRetry;
 
@@ -485,6 +747,20 @@ extern NSString *const TSKTaskDidStartNotification;
  */
 - (void)didFailWithError:(nullable NSError *)error NS_SWIFT_NAME(didFail(with:));
 
+/*!
+ @abstract Copies the receiver’s TSKTask configuration to the specified copy of the receiver.
+ @discussion The configuration consists of the task’s name, unless it is the default name, delegate,
+     operation queue, execution class, whether it is batchable, timeout, duration histogram, speculation policy, retry policy,
+     result equality test, and whether it runs when its prerequisites are skipped. The deadline is not copied, since
+     it is a point in time rather than a property of the task’s work. TSKTask’s implementation of
+     ‑copyWithZone: creates a copy using ‑initWithName: and invokes this method on it. Subclasses that
+     cannot be initialized with ‑initWithName: or that have configuration of their own should
+     override ‑copyWithZone: to create the copy using their designated initializer and then invoke
+     this method on the copy. This method should not be invoked directly.
+ @param task The newly created copy of the receiver.
+ */
+- (void)copyConfigurationToTask:(TSKTask *)task;
+
 @end
 
 
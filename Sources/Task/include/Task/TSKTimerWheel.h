@@ -0,0 +1,107 @@
+//
+//  TSKTimerWheel.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ TSKTimerWheelTimer objects represent timers armed on a TSKTimerWheel. They are created by
+ ‑[TSKTimerWheel armTimerWithInterval:handler:] and can be passed to ‑[TSKTimerWheel disarmTimer:].
+ */
+@interface TSKTimerWheelTimer : NSObject
+
+/*! Whether the timer is armed, i.e., has neither fired nor been disarmed. */
+@property (nonatomic, assign, readonly, getter=isArmed) BOOL armed;
+
+/*! -init is unavailable, as timers can only be created by timer wheels. */
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+
+/*!
+ TSKTimerWheel objects manage large numbers of timers cheaply. Rather than using a dispatch timer for
+ each timer, a timer wheel keeps its timers in a hierarchy of slot arrays, or wheels, and advances
+ through them with a single dispatch timer that fires once per tick. Arming and disarming a timer
+ take constant time regardless of how many timers are armed. Timers that expire further in the
+ future live in coarser wheels and are moved to finer ones as their expiration approaches.
+
+ Timers fire within one tick after they expire. The dispatch timer only runs while at least one
+ timer is armed, so an idle timer wheel does not wake the process.
+
+ Task timeouts use the shared timer wheel, which has a tick interval of 10 milliseconds.
+
+ TSKTimerWheel is thread-safe.
+ */
+@interface TSKTimerWheel : NSObject
+
+/*! The shared timer wheel. */
+@property (class, nonatomic, strong, readonly) TSKTimerWheel *sharedTimerWheel;
+
+/*! The timer wheel’s tick interval, which is the granularity with which timers fire. */
+@property (nonatomic, assign, readonly) NSTimeInterval tickInterval;
+
+/*! The number of timers that are currently armed. */
+@property (nonatomic, assign, readonly) NSUInteger armedTimerCount;
+
+/*!
+ @abstract Initializes a newly created TSKTimerWheel with a tick interval of 10 milliseconds.
+ @result A newly initialized TSKTimerWheel instance.
+ */
+- (instancetype)init;
+
+/*!
+ @abstract Initializes a newly created TSKTimerWheel with the specified tick interval.
+ @discussion This is the class’s designated initializer.
+ @param tickInterval The tick interval. Must be positive.
+ @result A newly initialized TSKTimerWheel instance.
+ */
+- (instancetype)initWithTickInterval:(NSTimeInterval)tickInterval NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Arms a timer that runs the specified handler once the specified interval has elapsed.
+ @discussion Handlers run serially on a private queue owned by the timer wheel, so they should
+     return quickly and dispatch long-running work elsewhere.
+ @param interval The interval after which the timer fires. Intervals less than one tick are rounded
+     up to one tick.
+ @param handler The block to run when the timer fires. May not be nil. It is released once the timer
+     fires or is disarmed.
+ @result The newly armed timer.
+ */
+- (TSKTimerWheelTimer *)armTimerWithInterval:(NSTimeInterval)interval handler:(void (^)(void))handler NS_SWIFT_NAME(armTimer(interval:handler:));
+
+/*!
+ @abstract Disarms the specified timer so that its handler does not run.
+ @discussion Disarming a timer that has already fired or been disarmed has no effect.
+ @param timer The timer to disarm. May not be nil. Must have been armed by the receiver.
+ */
+- (void)disarmTimer:(TSKTimerWheelTimer *)timer NS_SWIFT_NAME(disarm(_:));
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,119 @@
+//
+//  TSKWorker.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ The name of the environment variable through which a TSKWorkerPool tells the worker processes it
+ launches which file descriptor is connected to the pool.
+ */
+extern NSString *const TSKWorkerSocketDescriptorEnvironmentKey API_UNAVAILABLE(ios, tvos, watchos);
+
+/*!
+ @abstract The type of block that performs a request in a worker process.
+ @param request The decoded request.
+ @param error On failure, an error describing why the request failed. Only the error’s domain, code,
+     and localized description are sent back to the pool.
+ @result The request’s result, which must support secure coding and be of one of the pool’s allowed
+     result classes. Return nil and set error to fail the request.
+ */
+typedef id<NSSecureCoding> _Nullable (^TSKWorkerRequestHandler)(id request, NSError **error);
+
+
+/*!
+ TSKWorker objects serve requests from a TSKWorkerPool inside a worker process.
+
+ A worker process’s main function creates a worker and runs it. The worker receives one request at
+ a time over the Unix-domain socket its pool connected it to, performs it using its handler, and
+ sends back the result or error. Because each request runs in a separate process from the workflow
+ that requested it, a request that crashes only takes its own worker down.
+
+     int main(int argc, char *argv[])
+     {
+         @autoreleasepool {
+             NSSet *requestClasses = [NSSet setWithObjects:[MyRequest class], nil];
+             TSKWorker *worker = [[TSKWorker alloc] initWithAllowedRequestClasses:requestClasses
+                                                                          handler:^id(MyRequest *request, NSError **error) {
+                 return [request performWithError:error];
+             }];
+
+             [worker run];
+         }
+
+         return 0;
+     }
+ */
+API_UNAVAILABLE(ios, tvos, watchos)
+@interface TSKWorker : NSObject
+
+/*! The classes of objects that the worker decodes from requests. */
+@property (nonatomic, copy, readonly) NSSet<Class> *allowedRequestClasses;
+
+/*! The block that performs the worker’s requests. */
+@property (nonatomic, copy, readonly) TSKWorkerRequestHandler handler;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/*!
+ @abstract Initializes a newly created worker that serves requests over the socket its pool passed
+     to the current process.
+ @discussion The socket descriptor is read from the TSKWorkerSocketDescriptorEnvironmentKey
+     environment variable. If the variable is not set, ‑run returns immediately.
+ @param allowedRequestClasses The classes of objects that the worker decodes from requests. May not
+     be nil.
+ @param handler The block that performs the worker’s requests. May not be nil.
+ @result A newly initialized worker.
+ */
+- (instancetype)initWithAllowedRequestClasses:(NSSet<Class> *)allowedRequestClasses handler:(TSKWorkerRequestHandler)handler;
+
+/*!
+ @abstract Initializes a newly created worker that serves requests over the specified socket.
+ @discussion This is the class’s designated initializer.
+ @param socketDescriptor A connected Unix-domain stream socket. The worker closes it when it stops
+     running. If negative, ‑run returns immediately.
+ @param allowedRequestClasses The classes of objects that the worker decodes from requests. May not
+     be nil.
+ @param handler The block that performs the worker’s requests. May not be nil.
+ @result A newly initialized worker.
+ */
+- (instancetype)initWithSocketDescriptor:(int)socketDescriptor
+                   allowedRequestClasses:(NSSet<Class> *)allowedRequestClasses
+                                 handler:(TSKWorkerRequestHandler)handler NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Serves requests on the current thread until the pool closes the connection.
+ @discussion Requests that cannot be decoded and results that cannot be encoded are reported to the
+     pool as errors rather than stopping the worker.
+ */
+- (void)run;
+
+@end
+
+NS_ASSUME_NONNULL_END
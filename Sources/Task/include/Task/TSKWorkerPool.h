@@ -0,0 +1,131 @@
+//
+//  TSKWorkerPool.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class TSKCancellationToken;
+
+/*!
+ TSKWorkerPool objects perform requests in a pool of local worker processes.
+
+ Workers are launched from the pool’s executable as they are needed, up to the pool’s maximum worker
+ count, and are kept running to serve later requests. Each worker performs one request at a time
+ using a TSKWorker. Requests and results are sent over a Unix-domain socket between the pool and the
+ worker, encoded with NSKeyedArchiver using secure coding.
+
+ Running work in separate processes isolates it: a request that crashes only takes down its worker,
+ and memory that a request uses is returned to the system when its worker exits. If a worker exits
+ before returning a result, its request fails with a TSKErrorCodeWorkerCrashed error and a new
+ worker is launched for the next request. Use TSKWorkerTask to run requests as part of a workflow,
+ and give the tasks a retry policy to retry requests whose workers crashed.
+
+ TSKWorkerPool is thread-safe.
+ */
+API_UNAVAILABLE(ios, tvos, watchos)
+@interface TSKWorkerPool : NSObject
+
+/*! The URL of the executable that worker processes run. */
+@property (nonatomic, copy, readonly) NSURL *executableURL;
+
+/*! The arguments that worker processes are launched with. */
+@property (nonatomic, copy, readonly) NSArray<NSString *> *arguments;
+
+/*! The maximum number of worker processes that run at once. */
+@property (nonatomic, assign, readonly) NSUInteger maximumWorkerCount;
+
+/*! The classes of objects that the pool decodes from results. */
+@property (nonatomic, copy, readonly) NSSet<Class> *allowedResultClasses;
+
+/*! The number of worker processes currently running. */
+@property (nonatomic, assign, readonly) NSUInteger workerCount;
+
+/*! The number of worker processes that exited unexpectedly while performing a request. */
+@property (nonatomic, assign, readonly) NSUInteger crashedWorkerCount;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/*!
+ @abstract Initializes a newly created worker pool with the specified executable and allowed result
+     classes.
+ @discussion Workers are launched without arguments, and the pool runs up to one worker per active
+     processor.
+ @param executableURL The URL of the executable that worker processes run. May not be nil.
+ @param allowedResultClasses The classes of objects that the pool decodes from results. May not be
+     nil.
+ @result A newly initialized worker pool.
+ */
+- (instancetype)initWithExecutableURL:(NSURL *)executableURL allowedResultClasses:(NSSet<Class> *)allowedResultClasses;
+
+/*!
+ @abstract Initializes a newly created worker pool.
+ @discussion This is the class’s designated initializer. No workers are launched until the first
+     request is performed.
+ @param executableURL The URL of the executable that worker processes run. May not be nil.
+ @param arguments The arguments that worker processes are launched with. If nil, no arguments are
+     used.
+ @param maximumWorkerCount The maximum number of worker processes that run at once. Must be
+     positive.
+ @param allowedResultClasses The classes of objects that the pool decodes from results. May not be
+     nil.
+ @result A newly initialized worker pool.
+ */
+- (instancetype)initWithExecutableURL:(NSURL *)executableURL
+                            arguments:(nullable NSArray<NSString *> *)arguments
+                   maximumWorkerCount:(NSUInteger)maximumWorkerCount
+                 allowedResultClasses:(NSSet<Class> *)allowedResultClasses NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Performs the specified request in one of the pool’s workers.
+ @discussion Requests are performed in the order they are made as workers become available. If the
+     cancellation token is cancelled before the request finishes, the request is abandoned and its
+     completion handler is invoked with an NSUserCancelledError. A worker that is performing an
+     abandoned request is terminated, since there is no other way to stop it.
+ @param request The request. It and every object it encodes must support secure coding. May not be
+     nil.
+ @param cancellationToken A token whose cancellation abandons the request. May be nil.
+ @param completionHandler The block to invoke with the request’s result or error when it finishes.
+     It is invoked exactly once, on an arbitrary queue. May not be nil.
+ */
+- (void)performRequest:(id<NSSecureCoding>)request
+     cancellationToken:(nullable TSKCancellationToken *)cancellationToken
+     completionHandler:(void (^)(id _Nullable result, NSError *_Nullable error))completionHandler;
+
+/*!
+ @abstract Stops the pool’s workers and fails its pending requests.
+ @discussion Idle workers exit immediately. Workers that are performing a request exit once it
+     finishes. Requests that have not started are failed with an NSUserCancelledError, as are
+     requests made after this method is invoked. This is invoked automatically when the pool is
+     deallocated.
+ */
+- (void)invalidate;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,99 @@
+//
+//  TSKWorkerTask.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <Task/TSKTask.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class TSKWorkerPool;
+
+/*!
+ TSKWorkerTasks perform their work by sending a request to a worker process in a TSKWorkerPool.
+
+ The request describes the task’s work in a form that can be sent to another process. When the task
+ executes, it performs the request using its pool, and finishes with the result that the worker
+ returns or fails with the error it reports. If the worker crashes, the task fails with a
+ TSKErrorCodeWorkerCrashed error; give the task a retry policy to run the request again on a new
+ worker. If the task stops executing before the worker responds, e.g., because it times out or is
+ cancelled, the worker is terminated.
+
+ Subclasses that need their prerequisites’ results to build the request can override ‑request.
+ */
+API_UNAVAILABLE(ios, tvos, watchos)
+@interface TSKWorkerTask : TSKTask
+
+/*! The pool whose workers perform the task’s request. */
+@property (nonatomic, strong, readonly) TSKWorkerPool *workerPool;
+
+/*!
+ @abstract The request that describes the task’s work.
+ @discussion It and every object it encodes must support secure coding, and must be of one of the
+     classes that the pool’s workers allow.
+ */
+@property (nonatomic, strong, readonly) id<NSSecureCoding> request;
+
+/*!
+ @abstract -init is unavailable, as there is no reasonable default value for the instance’s pool or
+     request.
+ @discussion Use -initWithWorkerPool:request: instead.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*!
+ @abstract -initWithName: is unavailable, as there is no reasonable default value for the instance’s
+     pool or request.
+ @discussion Use -initWithName:workerPool:request: instead.
+ */
+- (instancetype)initWithName:(nullable NSString *)name NS_UNAVAILABLE;
+
+/*!
+ @abstract Initializes a newly created TSKWorkerTask instance with the specified pool and request.
+ @discussion A default name will be given to the task as specified by TSKTask’s ‑initWithName:.
+ @param workerPool The pool whose workers perform the task’s request. May not be nil.
+ @param request The request that describes the task’s work. May not be nil.
+ @result A newly initialized TSKWorkerTask instance with the specified pool and request.
+ */
+- (instancetype)initWithWorkerPool:(TSKWorkerPool *)workerPool request:(id<NSSecureCoding>)request;
+
+/*!
+ @abstract Initializes a newly created TSKWorkerTask instance with the specified name, pool, and
+     request.
+ @discussion This is the class’s designated initializer.
+ @param name The name of the task. If nil, a default name will be given to the task as specified by
+     TSKTask’s ‑initWithName:.
+ @param workerPool The pool whose workers perform the task’s request. May not be nil.
+ @param request The request that describes the task’s work. May not be nil.
+ @result A newly initialized TSKWorkerTask instance with the specified name, pool, and request.
+ */
+- (instancetype)initWithName:(nullable NSString *)name
+                  workerPool:(TSKWorkerPool *)workerPool
+                     request:(id<NSSecureCoding>)request NS_DESIGNATED_INITIALIZER;
+
+@end
+
+NS_ASSUME_NONNULL_END
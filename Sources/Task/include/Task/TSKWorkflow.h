@@ -26,6 +26,9 @@
 
 #import <Foundation/Foundation.h>
 
+#import <Task/TSKChannel.h>
+#import <Task/TSKTask.h>
+
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -94,9 +97,41 @@ extern NSNotificationName const TSKWorkflowWillStartNotification;
 extern NSString *const TSKWorkflowTaskKey;
 
 
+/*! TSKWorkflowOutcome enumerates the ways a run of a workflow can end. */
+typedef NS_ENUM(NSInteger, TSKWorkflowOutcome) {
+    /*! Outcome indicating that all the workflow’s tasks, or all its target tasks, finished. */
+    TSKWorkflowOutcomeFinished,
+
+    /*! Outcome indicating that one of the workflow’s tasks failed. */
+    TSKWorkflowOutcomeFailed,
+
+    /*! Outcome indicating that one of the workflow’s tasks was cancelled, or the workflow was reset. */
+    TSKWorkflowOutcomeCancelled,
+
+    /*!
+     Outcome indicating that the run had not ended when a wait for it timed out. This is only
+     returned by ‑[TSKWorkflow waitUntilFinishedWithTimeout:error:].
+     */
+    TSKWorkflowOutcomeUnfinished,
+};
+
+/*!
+ @abstract Type for blocks that are invoked when a workflow’s run ends.
+ @param outcome How the run ended.
+ @param error If outcome is TSKWorkflowOutcomeFailed, the error the failed task failed with.
+     Otherwise, nil.
+ */
+typedef void (^TSKWorkflowCompletionHandler)(TSKWorkflowOutcome outcome, NSError *_Nullable error);
+
+
 #pragma mark -
 
-@class TSKTask;
+@class TSKCancellationToken;
+@class TSKDurationStatistics;
+@class TSKFairScheduler;
+@class TSKMetrics;
+@class TSKResultStore;
+@class TSKRetryPolicy;
 @protocol TSKWorkflowDelegate;
 
 /*!
@@ -136,6 +171,95 @@ extern NSString *const TSKWorkflowTaskKey;
  */
 @property (nonatomic, strong, readonly) NSOperationQueue *operationQueue;
 
+/*!
+ @abstract The workflow’s default execution class.
+ @discussion Tasks in the workflow whose executionClass property is nil use this execution class to
+     determine their operation queue. If nil, those tasks use the workflow’s operationQueue. The
+     default value is nil.
+ */
+@property (nonatomic, copy, nullable) TSKExecutionClass executionClass;
+
+/*!
+ @abstract The time by which the workflow’s tasks should finish.
+ @discussion This is the deadline for tasks in the workflow that do not have their own. See
+     ‑[TSKTask deadline] for more information. The default value is nil.
+ */
+@property (atomic, strong, nullable) NSDate *deadline;
+
+/*!
+ @abstract The maximum amount of time the workflow may run each time it is started or retried.
+ @discussion If the workflow has not finished when its timeout elapses, each of its executing tasks
+     fails with a TSKErrorCodeTimedOut error, as does each of its tasks that is about to start. The
+     timer is disarmed when the workflow finishes, one of its tasks fails or is cancelled, or the
+     workflow is cancelled or reset. Timeouts are tracked using +[TSKTimerWheel sharedTimerWheel]. A
+     value of 0 means the workflow has no timeout. The default value is 0.
+ */
+@property (atomic, assign) NSTimeInterval timeout;
+
+/*!
+ @abstract The retry policy for tasks in the workflow that do not have their own.
+ @discussion See ‑[TSKTask retryPolicy] for more information. The default value is nil.
+ */
+@property (atomic, strong, nullable) TSKRetryPolicy *retryPolicy;
+
+/*!
+ @abstract The maximum number of batchable tasks whose work runs in a single operation.
+ @discussion See ‑[TSKTask batchable] for more information. A batch is dispatched as soon as it is
+     full. Values of 0 or 1 disable batching. The default value is 64.
+ */
+@property (atomic, assign) NSUInteger batchSize;
+
+/*!
+ @abstract The maximum amount of time a batch waits to fill before it is dispatched anyway.
+ @discussion Longer intervals produce fuller batches when tasks become ready gradually, at the cost
+     of delaying the tasks that become ready first. The default value is 0.001 (1 millisecond).
+ */
+@property (atomic, assign) NSTimeInterval batchLingerInterval;
+
+/*!
+ @abstract The statistics in which the workflow records its tasks’ durations.
+ @discussion When set, each task in the workflow that finishes successfully records how long it
+     executed in the statistics’ histogram for its name. Tasks with the default name are not recorded.
+     Use +[TSKDurationStatistics sharedStatistics] to aggregate durations across workflows. The
+     default value is nil.
+ */
+@property (atomic, strong, nullable) TSKDurationStatistics *durationStatistics;
+
+/*!
+ @abstract The store with which the workflow registers its tasks’ results.
+ @discussion When set, each task in the workflow that finishes successfully registers its result with
+     the store, which may spill it to disk if it is large and memory is scarce. See TSKResultStore for
+     more information. The default value is nil.
+ */
+@property (atomic, strong, nullable) TSKResultStore *resultStore;
+
+/*!
+ @abstract The metrics that describe the workflow’s tasks.
+ @discussion The metrics are named after the workflow’s name at the time the workflow was created.
+     Everything recorded in them is also recorded in +[TSKMetrics sharedMetrics].
+ */
+@property (nonatomic, strong, readonly) TSKMetrics *metrics;
+
+/*!
+ @abstract The scheduler that runs the workflow’s tasks.
+ @discussion When set, tasks that would otherwise run on the workflow’s operationQueue instead run on
+     the scheduler’s operation queue, sharing it fairly with the other workflows that use the
+     scheduler. Tasks with an explicitly set operation queue or whose execution class has a dedicated
+     operation queue are unaffected. See TSKFairScheduler for more information. The default value is
+     nil.
+ */
+@property (nonatomic, strong, nullable) TSKFairScheduler *scheduler;
+
+/*!
+ @abstract A token whose cancellation is forwarded to the cancellation tokens of the workflow’s
+     executing tasks.
+ @discussion Each task that starts executing while this is set gets a cancellation token that is a
+     child of this token. Cancelling this token does not change the state of the workflow or its
+     tasks; it only tells their work to stop. TSKSubworkflowTask sets this to its own cancellation
+     token when it starts its subworkflow. The default value is nil.
+ */
+@property (atomic, strong, nullable) TSKCancellationToken *cancellationToken;
+
 /*!
  @abstract The task workflow’s notification center.
  @discussion All notifications posted by the workflow and its tasks will be posted to this
@@ -152,6 +276,13 @@ extern NSString *const TSKWorkflowTaskKey;
 /*! The set of tasks currently in the workflow that have no dependent tasks. */
 @property (nonatomic, copy, readonly) NSSet<TSKTask *> *tasksWithNoDependentTasks;
 
+/*!
+ @abstract The tasks the workflow is currently running for.
+ @discussion This is set by ‑startForTargetTasks: and cleared by ‑start. If nil, the workflow runs
+     all of its tasks.
+ */
+@property (atomic, copy, readonly, nullable) NSSet<TSKTask *> *targetTasks;
+
 
 #pragma mark - Initializers
 
@@ -211,6 +342,33 @@ extern NSString *const TSKWorkflowTaskKey;
           notificationCenter:(nullable NSNotificationCenter *)notificationCenter NS_DESIGNATED_INITIALIZER;
 
 
+#pragma mark - Execution Classes
+
+/*!
+ @abstract Sets the operation queue that the workflow’s tasks with the specified execution class run on.
+ @discussion This allows latency-critical and batch work in the same workflow to run on separate
+     pools of threads. Configure each queue’s maxConcurrentOperationCount and qualityOfService to
+     control the pool’s width and scheduling priority. The same queue may be used by several
+     workflows so that their tasks share a pool.
+
+     Changing a class’s queue only affects tasks that start after the change. This method is
+     thread-safe.
+ @param operationQueue The operation queue for the execution class. If nil, tasks with the execution
+     class run on the workflow’s operationQueue.
+ @param executionClass The execution class. May not be nil.
+ */
+- (void)setOperationQueue:(nullable NSOperationQueue *)operationQueue forExecutionClass:(TSKExecutionClass)executionClass NS_SWIFT_NAME(setOperationQueue(_:for:));
+
+/*!
+ @abstract Returns the operation queue that the workflow’s tasks with the specified execution class
+     run on.
+ @param executionClass The execution class. May be nil.
+ @result The operation queue previously set for the execution class, or the workflow’s operationQueue
+     if there is none or executionClass is nil.
+ */
+- (NSOperationQueue *)operationQueueForExecutionClass:(nullable TSKExecutionClass)executionClass NS_SWIFT_NAME(operationQueue(for:));
+
+
 #pragma mark - Adding Tasks
 
 /*!
@@ -244,7 +402,13 @@ keyedPrerequisiteTasks:(nullable NSDictionary<id<NSCopying>, TSKTask *> *)keyedP
      keyed or otherwise — the task is added to the prerequisite’s set of dependent tasks. If the 
      task has any prerequisites, its state is set to pending.
 
-     This is not a thread-safe operation. This method should only execute on one thread at a time.
+     This method is thread-safe. Tasks may be added to a workflow from multiple threads at once, as
+     long as each task’s prerequisites have been added before it.
+
+     Tasks may also be added while the workflow is running, i.e., after it has received ‑start or
+     ‑retry and before it has received ‑cancel or ‑reset. In that case, the task is started as soon as
+     all its prerequisite tasks have finished successfully, which may be immediately. If the workflow
+     is not running, the task is simply left in the ready or pending state.
  @param task The task to add. May not be nil. May not be a member of any other task workflow.
  @param prerequisiteTasks The task’s prerequisite tasks. If nil, the task will have no unkeyed
      prerequisite tasks. Otherwise, each task in the set must have already been added to the workflow.
@@ -268,6 +432,67 @@ keyedPrerequisiteTasks:(nullable NSDictionary<id<NSCopying>, TSKTask *> *)keyedP
  */
 - (void)addTask:(TSKTask *)task prerequisites:(nullable TSKTask *)prerequisiteTask1, ... NS_REQUIRES_NIL_TERMINATION;
 
+/*!
+ @abstract Adds the specified task to the task workflow with a streaming prerequisite task and the
+     specified set of other prerequisite tasks.
+ @discussion A streaming prerequisite, or producer, sends items into the specified channel while it
+     executes, and the task, or consumer, receives them. Rather than waiting for the producer to
+     finish, the consumer is ready as soon as the producer sends its first item and the consumer’s
+     other prerequisites have finished. The channel becomes the producer’s outputChannel and the
+     consumer’s inputChannel.
+
+     The channel ties its producer and consumer together. When the producer finishes, the channel is
+     closed, and when it fails, the channel is closed with its error. When either task is cancelled or
+     the consumer finishes or fails, the channel is closed so that the other task stops waiting on it.
+     When the producer is reset or retried, the channel is emptied and reopened. Otherwise, the
+     producer and consumer finish, fail, and are cancelled, reset, and retried as they would with an
+     ordinary prerequisite relationship.
+
+     Because TSKChannel’s ‑sendItem: and ‑receiveItem block, the producer and consumer must be able to
+     execute at the same time. Do not run both on an operation queue whose maxConcurrentOperationCount
+     is 1.
+
+     This method is otherwise equivalent to ‑addTask:prerequisiteTasks:keyedPrerequisiteTasks: with
+     a nil keyedPrerequisiteTasks parameter.
+ @param task The task to add. May not be nil. May not be a member of any other task workflow.
+ @param streamingPrerequisiteTask The task’s streaming prerequisite. May not be nil. Must have already
+     been added to the workflow and may not already have an output channel.
+ @param channel The channel through which items are streamed. May not be nil. May not be used by any
+     other task.
+ @param prerequisiteTasks The task’s other prerequisite tasks. If nil, the task will have no other
+     prerequisite tasks. Otherwise, each task in the set must have already been added to the workflow.
+ */
+-           (void)addTask:(TSKTask *)task
+streamingPrerequisiteTask:(TSKTask *)streamingPrerequisiteTask
+                  channel:(TSKChannel *)channel
+        prerequisiteTasks:(nullable NSSet<TSKTask *> *)prerequisiteTasks NS_SWIFT_NAME(add(_:streamingPrerequisite:channel:prerequisites:));
+
+/*!
+ @abstract Adds the specified task to the workflow with a prerequisite whose result decides whether
+     the task runs.
+ @discussion When the conditional prerequisite finishes, the condition is evaluated with its result.
+     If the condition returns YES, the prerequisite counts as finished, as with an ordinary
+     prerequisite relationship. Otherwise, it counts as skipped, so the task is skipped unless its
+     runsWhenPrerequisitesSkipped property is YES. Adding several tasks with the same conditional
+     prerequisite and different conditions lets the prerequisite’s result choose which branch of the
+     workflow runs.
+
+     This method is otherwise equivalent to ‑addTask:prerequisiteTasks:keyedPrerequisiteTasks: with
+     a nil keyedPrerequisiteTasks parameter.
+ @param task The task to add. May not be nil. May not be a member of any other task workflow.
+ @param conditionalPrerequisiteTask The task’s conditional prerequisite. May not be nil. Must have
+     already been added to the workflow.
+ @param condition The condition that the prerequisite’s result must satisfy for the task to run. It
+     may be evaluated more than once and on any thread, and must not access the workflow. May not be
+     nil.
+ @param prerequisiteTasks The task’s other prerequisite tasks. If nil, the task will have no other
+     prerequisite tasks. Otherwise, each task in the set must have already been added to the workflow.
+ */
+-             (void)addTask:(TSKTask *)task
+conditionalPrerequisiteTask:(TSKTask *)conditionalPrerequisiteTask
+                  condition:(BOOL (^)(id _Nullable result))condition
+          prerequisiteTasks:(nullable NSSet<TSKTask *> *)prerequisiteTasks NS_SWIFT_NAME(add(_:conditionalPrerequisite:condition:prerequisites:));
+
 
 #pragma mark - Getting Related Tasks
 
@@ -313,9 +538,63 @@ keyedPrerequisiteTasks:(nullable NSDictionary<id<NSCopying>, TSKTask *> *)keyedP
      tasks finish successfully, they will automatically invoke ‑start on their dependent tasks and
      so on until all tasks have finished successfully. If no tasks have been added to the workflow, 
      this will immediately send ‑workflowDidFinish: to the delegate.
+
+     If the workflow was previously started with ‑startForTargetTasks:, this also starts the tasks
+     that were left unstarted because the targets did not need them.
  */
 - (void)start;
 
+/*!
+ @abstract Runs only the tasks needed to finish the specified tasks.
+ @discussion The workflow determines the specified tasks’ prerequisites, their prerequisites, and so
+     on, and starts those that are ready. As tasks finish, only their dependents that are needed by
+     the targets are started; other tasks are left unstarted. The workflow is considered finished
+     when all of the targets have finished successfully, at which point ‑workflowDidFinish: is sent
+     to the delegate and TSKWorkflowDidFinishNotification is posted.
+
+     Finding the needed tasks takes time proportional to the number of tasks in the workflow plus
+     the number of prerequisite relationships between the needed tasks. Tasks added to the workflow
+     while it is running for targets are not started. Use ‑start to run the whole workflow.
+ @param targetTasks The tasks whose results are needed. Must be non-empty and contain only tasks in
+     the workflow.
+ */
+- (void)startForTargetTasks:(NSSet<TSKTask *> *)targetTasks NS_SWIFT_NAME(start(targets:));
+
+/*!
+ @abstract Starts the workflow and invokes the specified block when the run ends.
+ @discussion The block is invoked exactly once: when the workflow finishes, when one of its tasks
+     fails or is cancelled, or when the workflow is cancelled or reset, whichever happens first. It
+     is invoked on the thread on which that happened, after the delegate and notification
+     observers have been informed, and must not block. Waiting for the block does not occupy a
+     thread.
+
+     If the workflow already has failed or cancelled tasks, or all its tasks have finished, starting
+     it would not lead to another outcome, so the block is invoked immediately with the one it
+     already has and the workflow is not started. Retry or reset the workflow before running it
+     again.
+ @param completionHandler The block to invoke when the run ends. May not be nil.
+ */
+- (void)startWithCompletionHandler:(TSKWorkflowCompletionHandler)completionHandler NS_SWIFT_NAME(start(completionHandler:)) NS_SWIFT_DISABLE_ASYNC;
+
+/*!
+ @abstract Blocks the calling thread until the workflow’s current run ends or the specified timeout
+     elapses.
+ @discussion A run begins when the workflow is started or retried, and ends at the same points that
+     completion handlers passed to ‑startWithCompletionHandler: are invoked. The waiting thread is
+     woken directly when the run ends; it does not poll or observe notifications. If the run has
+     already ended, this returns immediately. If the workflow has never been started, this waits
+     until the timeout elapses.
+
+     This must not be invoked on a thread that the workflow’s tasks need in order to finish, e.g.,
+     from a task’s ‑main method running on a serial operation queue that other tasks in the workflow
+     use.
+ @param timeout The maximum amount of time to wait.
+ @param error On return, if the run ended because a task failed, the error the first task to fail
+     failed with. Otherwise, nil. May be NULL.
+ @result How the run ended, or TSKWorkflowOutcomeUnfinished if the timeout elapsed first.
+ */
+- (TSKWorkflowOutcome)waitUntilFinishedWithTimeout:(NSTimeInterval)timeout error:(NSError *_Nullable *_Nullable)error NS_SWIFT_NAME(waitUntilFinished(timeout:error:));
+
 /*!
  @abstract Sends ‑cancel to every prerequisite-less task in the workflow.
  @discussion This serves to mark all the tasks in the workflow as cancelled. The initial set of
@@ -0,0 +1,144 @@
+//
+//  TSKWorkflowSimulator.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class TSKDurationStatistics;
+@class TSKTask;
+@class TSKWorkflow;
+
+/*! TSKSimulationPolicy enumerates the ways in which a simulated executor chooses the next ready task. */
+typedef NS_ENUM(NSInteger, TSKSimulationPolicy) {
+    /*! Ready tasks run in the order in which they became ready, like an operation queue. */
+    TSKSimulationPolicyFirstInFirstOut,
+
+    /*!
+     The ready task with the longest path of estimated durations to the end of the workflow runs
+     first. This is a good approximation of an optimal schedule.
+     */
+    TSKSimulationPolicyLongestPathFirst,
+};
+
+
+/*! TSKWorkflowSimulationResult objects describe the outcome of a simulated workflow run. */
+@interface TSKWorkflowSimulationResult : NSObject
+
+/*! The number of workers the workflow was simulated with. */
+@property (nonatomic, assign, readonly) NSUInteger workerCount;
+
+/*! The policy the simulated executor used to choose the next task. */
+@property (nonatomic, assign, readonly) TSKSimulationPolicy policy;
+
+/*! The predicted time from the start of the workflow until its last task finishes. */
+@property (nonatomic, assign, readonly) NSTimeInterval makespan;
+
+/*!
+ @abstract The predicted fraction of the workers’ time spent executing tasks.
+ @discussion This is the total estimated duration of all tasks divided by the product of the worker
+     count and the makespan. It is 0 if the makespan is 0.
+ */
+@property (nonatomic, assign, readonly) double utilization;
+
+/*!
+ @abstract The total estimated duration of the tasks on the workflow’s critical path.
+ @discussion This is the makespan the workflow would have with unlimited workers and is therefore a
+     lower bound on the makespan for any number of workers.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval criticalPathDuration;
+
+/*! The tasks on the workflow’s critical path, in execution order. */
+@property (nonatomic, copy, readonly) NSArray<TSKTask *> *criticalPath;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+
+/*!
+ TSKWorkflowSimulator objects predict how long a workflow will take to run with a given number of
+ workers without running it. This is useful for capacity planning, e.g., to find the smallest
+ operation queue width beyond which a workflow no longer speeds up.
+
+ A simulator takes a snapshot of its workflow’s graph and estimates each task’s duration when it is
+ created. Each simulation then schedules the tasks on a fixed number of workers in virtual time,
+ assuming that tasks run for exactly their estimated durations. Simulations take time proportional
+ to (tasks + prerequisite relationships) × log(tasks), so graphs with hundreds of thousands of tasks
+ can be simulated in well under a second.
+
+ Tasks added to the workflow after the simulator is created are not included in its simulations.
+ */
+@interface TSKWorkflowSimulator : NSObject
+
+/*! The workflow the simulator simulates. */
+@property (nonatomic, strong, readonly) TSKWorkflow *workflow;
+
+/*! The number of tasks in the simulator’s snapshot of the workflow. */
+@property (nonatomic, assign, readonly) NSUInteger taskCount;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/*!
+ @abstract Initializes a newly created TSKWorkflowSimulator that estimates task durations using the
+     specified duration statistics.
+ @discussion Each task’s duration is estimated to be the median of the histogram for its name. Tasks
+     whose names have no recorded durations are estimated to take the default duration.
+ @param workflow The workflow to simulate. May not be nil.
+ @param durationStatistics The statistics used to estimate task durations. May not be nil.
+ @param defaultDuration The estimated duration of tasks with no recorded durations.
+ @result A newly initialized TSKWorkflowSimulator instance.
+ */
+- (instancetype)initWithWorkflow:(TSKWorkflow *)workflow
+              durationStatistics:(TSKDurationStatistics *)durationStatistics
+                 defaultDuration:(NSTimeInterval)defaultDuration;
+
+/*!
+ @abstract Initializes a newly created TSKWorkflowSimulator that estimates task durations using the
+     specified block.
+ @discussion This is the class’s designated initializer.
+ @param workflow The workflow to simulate. May not be nil.
+ @param durationEstimator A block that returns the estimated duration of a task. It is invoked once
+     for each task in the workflow before this method returns. Negative durations are treated as 0.
+     May not be nil.
+ @result A newly initialized TSKWorkflowSimulator instance.
+ */
+- (instancetype)initWithWorkflow:(TSKWorkflow *)workflow
+               durationEstimator:(NSTimeInterval (NS_NOESCAPE ^)(TSKTask *task))durationEstimator NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Simulates running the workflow with the specified number of workers and policy.
+ @discussion This method is thread-safe.
+ @param workerCount The number of tasks that may execute at once. Must be positive.
+ @param policy The policy used to choose the next ready task.
+ @result The result of the simulation.
+ */
+- (TSKWorkflowSimulationResult *)simulateWithWorkerCount:(NSUInteger)workerCount policy:(TSKSimulationPolicy)policy;
+
+@end
+
+NS_ASSUME_NONNULL_END
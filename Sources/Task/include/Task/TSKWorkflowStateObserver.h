@@ -0,0 +1,117 @@
+//
+//  TSKWorkflowStateObserver.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <Task/TSKTask.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class TSKWorkflow;
+@class TSKWorkflowStateDelta;
+
+/*!
+ TSKWorkflowStateObservers report changes to the states of a workflow’s tasks in batches, at a
+ limited rate. They are intended for user interfaces and monitoring, which need to show the latest
+ state of each task but not every transition it made to get there.
+
+ Each state change marks its task as changed. Changed tasks are delivered in a TSKWorkflowStateDelta
+ on the observer’s queue at most maximumDeliveryRate times per second, along with the state each
+ task was in when the delta was made. A task that changes state several times between deliveries
+ appears in the next delta once, with its latest state, so intermediate transitions are dropped.
+ When the workflow is idle, no deltas are delivered; the first change after a quiet period is
+ delivered right away.
+
+ A workflow retains its state observers, so observers must be invalidated to stop them. Observing a
+ workflow adds a small cost to each state change of its tasks and none to workflows without
+ observers.
+
+ TSKWorkflowStateObserver is thread-safe.
+ */
+@interface TSKWorkflowStateObserver : NSObject
+
+/*! The workflow whose tasks the observer observes. */
+@property (nonatomic, weak, readonly, nullable) TSKWorkflow *workflow;
+
+/*! The maximum number of deltas the observer delivers per second. */
+@property (nonatomic, assign, readonly) double maximumDeliveryRate;
+
+/*! The queue on which the observer’s handler is invoked. */
+@property (nonatomic, strong, readonly) dispatch_queue_t queue;
+
+/*! Whether the observer has been invalidated. */
+@property (nonatomic, assign, readonly, getter=isInvalidated) BOOL invalidated;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/*!
+ @abstract Initializes a newly created state observer and starts observing the specified workflow.
+ @discussion This is the class’s designated initializer.
+ @param workflow The workflow whose tasks to observe. May not be nil.
+ @param maximumDeliveryRate The maximum number of deltas to deliver per second. Must be positive.
+ @param queue The queue on which to invoke the handler. May not be nil.
+ @param handler The block to invoke with each delta on queue. May not be nil.
+ @result A newly initialized state observer.
+ */
+- (instancetype)initWithWorkflow:(TSKWorkflow *)workflow
+             maximumDeliveryRate:(double)maximumDeliveryRate
+                           queue:(dispatch_queue_t)queue
+                         handler:(void (^)(TSKWorkflowStateDelta *delta))handler NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Stops observing the workflow.
+ @discussion Changes that have not been delivered are discarded, and the handler is not invoked
+     again once any invocation in progress returns. The workflow releases the observer.
+ */
+- (void)invalidate;
+
+@end
+
+
+#pragma mark -
+
+/*! TSKWorkflowStateDelta objects are immutable sets of task state changes. */
+@interface TSKWorkflowStateDelta : NSObject
+
+/*! The workflow whose tasks changed. */
+@property (nonatomic, strong, readonly) TSKWorkflow *workflow;
+
+/*! The tasks whose states changed since the previous delta, in no particular order. */
+@property (nonatomic, copy, readonly) NSArray<TSKTask *> *changedTasks;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/*!
+ @abstract Returns the state the specified task was in when the delta was made.
+ @param task One of the delta’s changed tasks. May not be nil.
+ @result The task’s state when the delta was made. If the task is not one of the delta’s changed
+     tasks, its current state.
+ */
+- (TSKTaskState)stateOfTask:(TSKTask *)task NS_SWIFT_NAME(state(of:));
+
+@end
+
+NS_ASSUME_NONNULL_END
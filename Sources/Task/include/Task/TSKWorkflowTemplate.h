@@ -0,0 +1,102 @@
+//
+//  TSKWorkflowTemplate.h
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class TSKTask;
+@class TSKWorkflow;
+
+/*!
+ TSKWorkflowTemplate objects create workflows that have the same shape as a prototype workflow. This
+ is useful when the same workflow needs to be run many times, e.g., once per incoming request.
+
+ A template takes a snapshot of its prototype workflow’s tasks and their prerequisite relationships
+ when it is created. Instantiating the template copies each prototype task using ‑copyWithZone: and
+ adds the copies to a new workflow all at once. The new workflow shares the template’s prerequisite
+ and dependent relationships until tasks are added to it, so instantiation does none of the
+ per-task bookkeeping that ‑[TSKWorkflow addTask:prerequisiteTasks:keyedPrerequisiteTasks:] does.
+
+ Tasks added to the prototype workflow after the template is created are not included in the
+ workflows it instantiates. Templates cannot be created from workflows with streaming prerequisites,
+ as their channels cannot be shared.
+
+ Templates are immutable and thread-safe.
+ */
+@interface TSKWorkflowTemplate : NSObject
+
+/*! The number of tasks in each workflow the template instantiates. */
+@property (nonatomic, assign, readonly) NSUInteger taskCount;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/*!
+ @abstract Initializes a newly created TSKWorkflowTemplate with the specified prototype workflow.
+ @discussion This is the class’s designated initializer. The prototype workflow may continue to be
+     used after the template is created, but its tasks should not be started while the template is
+     being created.
+ @param workflow The prototype workflow. May not be nil. May not contain tasks with streaming
+     prerequisites.
+ @result A newly initialized TSKWorkflowTemplate instance.
+ */
+- (instancetype)initWithWorkflow:(TSKWorkflow *)workflow NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Creates a new workflow with copies of the template’s prototype tasks.
+ @discussion The new workflow has a default name and its own operation queue. See
+     ‑instantiateWorkflowWithName:operationQueue: for details.
+ @result A new, unstarted workflow.
+ */
+- (TSKWorkflow *)instantiateWorkflow;
+
+/*!
+ @abstract Creates a new workflow with copies of the template’s prototype tasks and the specified
+     name and operation queue.
+ @discussion The new workflow uses the prototype workflow’s notification center, and its delegate,
+     execution class, duration statistics, result store, scheduler, timeout, retry policy, batch
+     size, and batch linger interval are initially the same as the prototype’s.
+ @param name The name of the new workflow. If nil, a default name is used.
+ @param operationQueue The operation queue for the new workflow. If nil, a new operation queue is
+     created for it.
+ @result A new, unstarted workflow.
+ */
+- (TSKWorkflow *)instantiateWorkflowWithName:(nullable NSString *)name
+                              operationQueue:(nullable NSOperationQueue *)operationQueue NS_SWIFT_NAME(instantiateWorkflow(name:operationQueue:));
+
+/*!
+ @abstract Returns the task in the specified workflow that was copied from the specified prototype task.
+ @param workflow A workflow that was instantiated by the receiver. May not be nil.
+ @param prototypeTask A task in the template’s prototype workflow. May not be nil.
+ @result The task in workflow that was copied from prototypeTask, or nil if prototypeTask is not one
+     of the template’s prototype tasks.
+ */
+- (nullable TSKTask *)taskInWorkflow:(TSKWorkflow *)workflow correspondingToPrototypeTask:(TSKTask *)prototypeTask NS_SWIFT_NAME(task(in:correspondingTo:));
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -31,10 +31,30 @@ FOUNDATION_EXPORT const unsigned char TSKTaskVersionString[];
 
 #import <Task/TaskErrors.h>
 
+#import <Task/TSKCancellationToken.h>
+#import <Task/TSKChannel.h>
+#import <Task/TSKDurationHistogram.h>
+#import <Task/TSKDurationStatistics.h>
+#import <Task/TSKFairScheduler.h>
+#import <Task/TSKFlightRecorder.h>
+#import <Task/TSKMetrics.h>
+#import <Task/TSKResultStore.h>
+#import <Task/TSKRetryPolicy.h>
+#import <Task/TSKSpeculationPolicy.h>
+#import <Task/TSKTimerWheel.h>
+#import <Task/TSKWorker.h>
+#import <Task/TSKWorkerPool.h>
+
 #import <Task/TSKTask.h>
 #import <Task/TSKBlockTask.h>
 #import <Task/TSKExternalConditionTask.h>
+#import <Task/TSKFunctionTask.h>
+#import <Task/TSKReduceTask.h>
 #import <Task/TSKSelectorTask.h>
 #import <Task/TSKSubworkflowTask.h>
+#import <Task/TSKWorkerTask.h>
 
 #import <Task/TSKWorkflow.h>
+#import <Task/TSKWorkflowSimulator.h>
+#import <Task/TSKWorkflowStateObserver.h>
+#import <Task/TSKWorkflowTemplate.h>
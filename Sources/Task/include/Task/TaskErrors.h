@@ -34,4 +34,22 @@ extern NSString *const TSKTaskErrorDomain;
 typedef NS_ENUM(NSInteger, TSKErrorCode) {
     /*! Error code indicating that a TSKExternalConditionTask is not fulfilled. */
     TSKErrorCodeExternalConditionNotFulfilled = 1,
+
+    /*!
+     Error code indicating that a task’s deadline passed before it could start, or that its duration
+     history showed it could not finish before its deadline.
+     */
+    TSKErrorCodeDeadlineCannotBeMet = 2,
+
+    /*!
+     Error code indicating that a task was still executing when its timeout elapsed, or that its
+     workflow’s timeout elapsed before the task finished.
+     */
+    TSKErrorCodeTimedOut = 3,
+
+    /*!
+     Error code indicating that the worker process performing a TSKWorkerPool request exited before
+     returning a result.
+     */
+    TSKErrorCodeWorkerCrashed = 4,
 };
@@ -0,0 +1,96 @@
+//
+//  AsyncTask.swift
+//  TaskAsync
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+import Foundation
+import Task
+
+
+/// `AsyncTask` is a `TSKTask` whose work is performed by an `async` closure.
+///
+/// When the task executes, its body runs on Swift’s cooperative thread pool, so the task does not occupy an
+/// operation queue thread while the body awaits other asynchronous work. The task finishes with the value
+/// the body returns and fails with the error it throws.
+///
+/// Cancellation propagates in both directions. If the task stops executing for any reason other than
+/// finishing, e.g., because it is cancelled, reset, or times out, the Swift task running the body is
+/// cancelled. So are the Swift tasks running losing speculative attempts once another attempt
+/// finishes. If the body throws `CancellationError` while the task is still executing, the task is
+/// cancelled instead of failing.
+public final class AsyncTask : TSKTask {
+    /// The closure that performs the task’s work. It is passed the task so that it can access its
+    /// prerequisites’ results.
+    public let body: @Sendable (AsyncTask) async throws -> Any?
+
+
+    /// Creates a new async task with the specified name and body.
+    ///
+    /// - Parameters:
+    ///   - name: The name of the task. If `nil`, a default name is used.
+    ///   - body: The closure that performs the task’s work.
+    public init(name: String? = nil, body: @escaping @Sendable (AsyncTask) async throws -> Any?) {
+        self.body = body
+        super.init(name: name)
+    }
+
+
+    public override func copy(with zone: NSZone? = nil) -> Any {
+        let copy = AsyncTask(name: nil, body: body)
+        copyConfiguration(to: copy)
+        return copy
+    }
+
+
+    public override func main() {
+        // Each execution has its own token, which is cancelled as soon as the execution ends without
+        // finishing or another speculative attempt wins. Results from a body whose token is cancelled
+        // are ignored.
+        guard let cancellationToken = cancellationToken else {
+            return
+        }
+
+        let swiftTask = _Concurrency.Task { [self] in
+            do {
+                let result = try await body(self)
+                if !cancellationToken.isCancelled {
+                    finish(with: result)
+                }
+            } catch is CancellationError {
+                if !cancellationToken.isCancelled {
+                    cancel()
+                }
+            } catch {
+                if !cancellationToken.isCancelled {
+                    fail(with: error)
+                }
+            }
+        }
+
+        _ = cancellationToken.addCancellationHandler {
+            swiftTask.cancel()
+        }
+    }
+}
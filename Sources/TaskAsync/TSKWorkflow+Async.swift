@@ -0,0 +1,74 @@
+//
+//  TSKWorkflow+Async.swift
+//  TaskAsync
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+import Foundation
+import Task
+
+
+/// The errors that `TSKWorkflow.run()` can throw, in addition to the errors its tasks fail with.
+public enum WorkflowRunError : Error {
+    /// Indicates that one of the workflow’s tasks failed without an error.
+    case taskFailedWithoutError
+}
+
+
+extension TSKWorkflow {
+    /// Starts the workflow and suspends until its run ends.
+    ///
+    /// No thread is blocked while the workflow runs. If the Swift task awaiting this method is cancelled,
+    /// even before calling it, the workflow is cancelled. See `start(completionHandler:)` for details
+    /// about when a run ends.
+    ///
+    /// - Throws: The error that one of the workflow’s tasks failed with, or `CancellationError` if one of
+    ///   its tasks was cancelled or the workflow was cancelled or reset.
+    public func run() async throws {
+        try await withTaskCancellationHandler {
+            try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
+                start { outcome, error in
+                    switch outcome {
+                    case .finished:
+                        continuation.resume()
+                    case .failed:
+                        continuation.resume(throwing: error ?? WorkflowRunError.taskFailedWithoutError)
+                    case .cancelled, .unfinished:
+                        continuation.resume(throwing: CancellationError())
+                    @unknown default:
+                        continuation.resume(throwing: CancellationError())
+                    }
+                }
+
+                // If the Swift task was already cancelled, the cancellation handler ran before the workflow
+                // started, so it must be cancelled again
+                if _Concurrency.Task.isCancelled {
+                    cancel()
+                }
+            }
+        } onCancel: {
+            cancel()
+        }
+    }
+}
@@ -0,0 +1,204 @@
+//
+//  AsyncTaskTests.swift
+//  TaskAsyncTests
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+import Task
+import TaskAsync
+import XCTest
+
+
+final class AsyncTaskTests : XCTestCase {
+    private struct TestError : Error, Equatable {
+        let value: Int
+    }
+
+
+    private final class AttemptCounter : @unchecked Sendable {
+        private let lock = NSLock()
+        private var count = 0
+
+        func increment() -> Int {
+            lock.lock()
+            defer { lock.unlock() }
+            count += 1
+            return count
+        }
+    }
+
+
+    func testFinish() async throws {
+        let workflow = TSKWorkflow()
+        let prerequisite = AsyncTask { _ in
+            try await _Concurrency.Task.sleep(nanoseconds: 10_000_000)
+            return 1
+        }
+
+        let dependent = AsyncTask { task in
+            let value = task.anyPrerequisiteResult as? Int ?? 0
+            return value + 1
+        }
+
+        workflow.add(prerequisite, prerequisites: nil)
+        workflow.add(dependent, prerequisites: [prerequisite])
+
+        try await workflow.run()
+        XCTAssertTrue(dependent.isFinished)
+        XCTAssertEqual(dependent.result as? Int, 2)
+    }
+
+
+    func testFail() async {
+        let workflow = TSKWorkflow()
+        let task = AsyncTask { _ in
+            throw TestError(value: 42)
+        }
+
+        workflow.add(task, prerequisites: nil)
+
+        do {
+            try await workflow.run()
+            XCTFail("run did not throw")
+        } catch {
+            XCTAssertTrue(task.isFailed)
+            XCTAssertEqual(error as? TestError, TestError(value: 42))
+        }
+    }
+
+
+    func testCancellingTaskCancelsBody() async {
+        let workflow = TSKWorkflow()
+        let bodyDidStart = expectation(description: "body did start")
+        let bodyWasCancelled = expectation(description: "body was cancelled")
+
+        let task = AsyncTask { _ in
+            bodyDidStart.fulfill()
+            do {
+                try await _Concurrency.Task.sleep(nanoseconds: 10_000_000_000)
+            } catch {
+                bodyWasCancelled.fulfill()
+                throw error
+            }
+
+            return nil
+        }
+
+        workflow.add(task, prerequisites: nil)
+        task.start()
+
+        await fulfillment(of: [bodyDidStart], timeout: 1)
+        task.cancel()
+        await fulfillment(of: [bodyWasCancelled], timeout: 1)
+        XCTAssertTrue(task.isCancelled)
+    }
+
+
+    func testLosingSpeculativeAttemptIsCancelled() async throws {
+        let policy = TSKSpeculationPolicy(percentile: 0.5)
+        policy.minimumSampleCount = 1
+        policy.durationHistogram.recordDuration(0.05)
+
+        // The first attempt sleeps until its Swift task is cancelled; the speculative attempt returns
+        // immediately
+        let attemptCounter = AttemptCounter()
+        let stragglerWasCancelled = expectation(description: "straggler was cancelled")
+
+        let task = AsyncTask { _ in
+            if attemptCounter.increment() > 1 {
+                return "speculative"
+            }
+
+            do {
+                try await _Concurrency.Task.sleep(nanoseconds: 10_000_000_000)
+            } catch {
+                stragglerWasCancelled.fulfill()
+                throw error
+            }
+
+            return "straggler"
+        }
+
+        task.speculationPolicy = policy
+
+        let workflow = TSKWorkflow()
+        workflow.add(task, prerequisites: nil)
+
+        try await workflow.run()
+        await fulfillment(of: [stragglerWasCancelled], timeout: 1)
+        XCTAssertTrue(task.isFinished)
+        XCTAssertEqual(task.result as? String, "speculative")
+    }
+
+
+    func testCancellingRunCancelsWorkflow() async {
+        let workflow = TSKWorkflow()
+        let bodyDidStart = expectation(description: "body did start")
+
+        let task = AsyncTask { _ in
+            bodyDidStart.fulfill()
+            try await _Concurrency.Task.sleep(nanoseconds: 10_000_000_000)
+            return nil
+        }
+
+        workflow.add(task, prerequisites: nil)
+
+        let run = _Concurrency.Task {
+            try await workflow.run()
+        }
+
+        await fulfillment(of: [bodyDidStart], timeout: 1)
+        run.cancel()
+
+        let result = await run.result
+        XCTAssertThrowsError(try result.get()) { error in
+            XCTAssertTrue(error is CancellationError)
+        }
+
+        XCTAssertTrue(task.isCancelled)
+    }
+
+
+    func testRunFromCancelledTaskCancelsWorkflow() async {
+        let workflow = TSKWorkflow()
+        let task = AsyncTask { _ in
+            try await _Concurrency.Task.sleep(nanoseconds: 10_000_000_000)
+            return nil
+        }
+
+        workflow.add(task, prerequisites: nil)
+
+        let run = _Concurrency.Task {
+            withUnsafeCurrentTask { $0?.cancel() }
+            try await workflow.run()
+        }
+
+        let result = await run.result
+        XCTAssertThrowsError(try result.get()) { error in
+            XCTAssertTrue(error is CancellationError)
+        }
+
+        XCTAssertTrue(task.isCancelled)
+    }
+}
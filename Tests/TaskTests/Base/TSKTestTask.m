@@ -62,6 +62,15 @@ NSString *const TSKTestTaskDidCancelNotification = @"Task did cancel";
 }
 
 
+- (id)copyWithZone:(NSZone *)zone
+{
+    TSKTestTask *copy = [[[self class] allocWithZone:zone] initWithName:nil block:self.block];
+    copy.requiredPrerequisiteKeys = self.requiredPrerequisiteKeys;
+    [self copyConfigurationToTask:copy];
+    return copy;
+}
+
+
 - (void)main
 {
     [[NSNotificationCenter defaultCenter] postNotificationName:TSKTestTaskDidStartNotification object:self];
@@ -0,0 +1,144 @@
+//
+//  TSKChannelTestCase.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TSKRandomizedTestCase.h"
+
+
+@interface TSKChannelTestCase : TSKRandomizedTestCase
+
+- (void)testInit;
+- (void)testSendAndReceive;
+- (void)testTrySend;
+- (void)testBackPressure;
+- (void)testClose;
+
+@end
+
+
+@implementation TSKChannelTestCase
+
+- (void)testInit
+{
+    NSUInteger capacity = random() % 10 + 1;
+    TSKChannel *channel = [[TSKChannel alloc] initWithCapacity:capacity];
+    XCTAssertNotNil(channel, @"returns nil");
+    XCTAssertEqual(channel.capacity, capacity, @"capacity is set incorrectly");
+    XCTAssertEqual(channel.count, 0, @"count is non-zero");
+    XCTAssertFalse(channel.isClosed, @"channel is closed");
+    XCTAssertNil(channel.error, @"error is non-nil");
+
+    XCTAssertThrows([[TSKChannel alloc] initWithCapacity:0], @"zero capacity does not throw exception");
+}
+
+
+- (void)testSendAndReceive
+{
+    NSUInteger count = random() % 10 + 5;
+    TSKChannel *channel = [[TSKChannel alloc] initWithCapacity:count];
+
+    NSMutableArray *items = [[NSMutableArray alloc] init];
+    for (NSUInteger i = 0; i < count; ++i) {
+        NSString *item = UMKRandomUnicodeString();
+        [items addObject:item];
+        XCTAssertTrue([channel sendItem:item], @"send fails");
+    }
+
+    XCTAssertEqual(channel.count, count, @"count is incorrect");
+
+    for (NSString *item in items) {
+        XCTAssertEqualObjects([channel receiveItem], item, @"items are not received in order");
+    }
+
+    XCTAssertEqual(channel.count, 0, @"count is non-zero");
+
+    id nilObject = nil;
+    XCTAssertThrows([channel sendItem:nilObject], @"nil item does not throw exception");
+}
+
+
+- (void)testTrySend
+{
+    TSKChannel *channel = [[TSKChannel alloc] initWithCapacity:1];
+    XCTAssertTrue([channel trySendItem:@1], @"send to empty channel fails");
+    XCTAssertFalse([channel trySendItem:@2], @"send to full channel succeeds");
+
+    XCTAssertEqualObjects([channel receiveItem], @1, @"received incorrect item");
+    XCTAssertTrue([channel trySendItem:@3], @"send after receive fails");
+
+    [channel close];
+    XCTAssertEqualObjects([channel receiveItem], @3, @"received incorrect item");
+    XCTAssertFalse([channel trySendItem:@4], @"send to closed channel succeeds");
+}
+
+
+- (void)testBackPressure
+{
+    TSKChannel *channel = [[TSKChannel alloc] initWithCapacity:1];
+    [channel sendItem:@1];
+
+    XCTestExpectation *didSendExpectation = [self expectationWithDescription:@"blocked send did complete"];
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+        XCTAssertTrue([channel sendItem:@2], @"blocked send fails");
+        [didSendExpectation fulfill];
+    });
+
+    // The sender should still be blocked, since nothing has been received
+    usleep(50000);
+    XCTAssertEqual(channel.count, 1, @"send did not block on full channel");
+
+    XCTAssertEqualObjects([channel receiveItem], @1, @"received incorrect item");
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+    XCTAssertEqualObjects([channel receiveItem], @2, @"received incorrect item");
+}
+
+
+- (void)testClose
+{
+    TSKChannel *channel = [[TSKChannel alloc] initWithCapacity:1];
+    [channel sendItem:@1];
+
+    XCTestExpectation *didStopExpectation = [self expectationWithDescription:@"blocked send did stop"];
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+        XCTAssertFalse([channel sendItem:@2], @"send to closed channel succeeds");
+        [didStopExpectation fulfill];
+    });
+
+    NSError *error = UMKRandomError();
+    usleep(10000);
+    [channel closeWithError:error];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertTrue(channel.isClosed, @"channel is not closed");
+    XCTAssertEqualObjects(channel.error, error, @"error is set incorrectly");
+
+    [channel closeWithError:nil];
+    XCTAssertEqualObjects(channel.error, error, @"closing twice changes error");
+
+    XCTAssertEqualObjects([channel receiveItem], @1, @"item sent before closing is not received");
+    XCTAssertNil([channel receiveItem], @"closed, empty channel returns item");
+}
+
+@end
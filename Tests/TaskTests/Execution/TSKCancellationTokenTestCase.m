@@ -0,0 +1,134 @@
+//
+//  TSKCancellationTokenTestCase.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TSKRandomizedTestCase.h"
+
+
+@interface TSKCancellationTokenTestCase : TSKRandomizedTestCase
+
+- (void)testInit;
+- (void)testCancel;
+- (void)testHandlers;
+- (void)testParentToken;
+
+@end
+
+
+@implementation TSKCancellationTokenTestCase
+
+- (void)testInit
+{
+    TSKCancellationToken *token = [[TSKCancellationToken alloc] init];
+    XCTAssertNotNil(token, @"returns nil");
+    XCTAssertFalse(token.isCancelled, @"new token is cancelled");
+    XCTAssertNil(token.parentToken, @"parentToken is non-nil");
+
+    TSKCancellationToken *childToken = [[TSKCancellationToken alloc] initWithParentToken:token];
+    XCTAssertEqual(childToken.parentToken, token, @"parentToken is set incorrectly");
+    XCTAssertFalse(childToken.isCancelled, @"new token is cancelled");
+}
+
+
+- (void)testCancel
+{
+    TSKCancellationToken *token = [[TSKCancellationToken alloc] init];
+    [token cancel];
+    XCTAssertTrue(token.isCancelled, @"token is not cancelled");
+
+    [token cancel];
+    XCTAssertTrue(token.isCancelled, @"token is not cancelled after second cancel");
+}
+
+
+- (void)testHandlers
+{
+    TSKCancellationToken *token = [[TSKCancellationToken alloc] init];
+
+    NSMutableArray *handlerOrder = [[NSMutableArray alloc] init];
+    NSUInteger handlerCount = random() % 5 + 2;
+    for (NSUInteger i = 0; i < handlerCount; ++i) {
+        [token addCancellationHandler:^{
+            [handlerOrder addObject:@(i)];
+        }];
+    }
+
+    __block BOOL removedHandlerRan = NO;
+    id removedHandler = [token addCancellationHandler:^{
+        removedHandlerRan = YES;
+    }];
+    [token removeCancellationHandler:removedHandler];
+
+    XCTAssertEqual(handlerOrder.count, 0, @"handlers ran before cancellation");
+
+    [token cancel];
+    [token cancel];
+
+    NSMutableArray *expectedOrder = [[NSMutableArray alloc] init];
+    for (NSUInteger i = 0; i < handlerCount; ++i) {
+        [expectedOrder addObject:@(i)];
+    }
+
+    XCTAssertEqualObjects(handlerOrder, expectedOrder, @"handlers did not run exactly once in order");
+    XCTAssertFalse(removedHandlerRan, @"removed handler ran");
+
+    // Handlers added after cancellation run immediately
+    __block BOOL lateHandlerRan = NO;
+    [token addCancellationHandler:^{
+        lateHandlerRan = YES;
+    }];
+    XCTAssertTrue(lateHandlerRan, @"handler added after cancellation did not run immediately");
+
+    XCTAssertThrows([token addCancellationHandler:nil], @"nil handler does not throw exception");
+}
+
+
+- (void)testParentToken
+{
+    TSKCancellationToken *parentToken = [[TSKCancellationToken alloc] init];
+    TSKCancellationToken *childToken = [[TSKCancellationToken alloc] initWithParentToken:parentToken];
+    TSKCancellationToken *grandchildToken = [[TSKCancellationToken alloc] initWithParentToken:childToken];
+
+    // Cancelling a child does not cancel its parent
+    TSKCancellationToken *siblingToken = [[TSKCancellationToken alloc] initWithParentToken:parentToken];
+    [siblingToken cancel];
+    XCTAssertFalse(parentToken.isCancelled, @"cancelling child cancelled parent");
+
+    __block BOOL handlerRan = NO;
+    [grandchildToken addCancellationHandler:^{
+        handlerRan = YES;
+    }];
+
+    [parentToken cancel];
+    XCTAssertTrue(childToken.isCancelled, @"child was not cancelled");
+    XCTAssertTrue(grandchildToken.isCancelled, @"grandchild was not cancelled");
+    XCTAssertTrue(handlerRan, @"grandchild’s handler did not run");
+
+    // Children of cancelled tokens are cancelled immediately
+    TSKCancellationToken *lateChildToken = [[TSKCancellationToken alloc] initWithParentToken:parentToken];
+    XCTAssertTrue(lateChildToken.isCancelled, @"child of cancelled token is not cancelled");
+}
+
+@end
@@ -0,0 +1,182 @@
+//
+//  TSKDurationHistogramTestCase.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TSKRandomizedTestCase.h"
+
+
+@interface TSKDurationHistogramTestCase : TSKRandomizedTestCase
+
+- (void)testInit;
+- (void)testDurationAtPercentile;
+- (void)testWindowExpiration;
+- (void)testConcurrentRecordingAcrossEpochs;
+- (void)testStatistics;
+- (void)testWorkflowRecordsDurations;
+
+@end
+
+
+@implementation TSKDurationHistogramTestCase
+
+- (void)testInit
+{
+    TSKDurationHistogram *histogram = [[TSKDurationHistogram alloc] init];
+    XCTAssertNotNil(histogram, @"returns nil");
+    XCTAssertEqual(histogram.windowDuration, 300, @"default window is incorrect");
+    XCTAssertEqual(histogram.count, 0, @"count is non-zero");
+    XCTAssertEqual(histogram.meanDuration, 0, @"meanDuration is non-zero");
+    XCTAssertLessThan([histogram durationAtPercentile:0.5], 0, @"empty histogram returns non-negative duration");
+
+    NSTimeInterval windowDuration = random() % 100 + 1;
+    histogram = [[TSKDurationHistogram alloc] initWithWindowDuration:windowDuration];
+    XCTAssertEqual(histogram.windowDuration, windowDuration, @"windowDuration is set incorrectly");
+
+    XCTAssertThrows([[TSKDurationHistogram alloc] initWithWindowDuration:0], @"zero window does not throw exception");
+}
+
+
+- (void)testDurationAtPercentile
+{
+    TSKDurationHistogram *histogram = [[TSKDurationHistogram alloc] init];
+
+    // Record 1 ms through 1000 ms
+    for (NSUInteger i = 1; i <= 1000; ++i) {
+        [histogram recordDuration:i / 1000.0];
+    }
+
+    [histogram recordDuration:-1];
+    XCTAssertEqual(histogram.count, 1000, @"count is incorrect");
+    XCTAssertEqualWithAccuracy(histogram.meanDuration, 0.5005, 1e-6, @"meanDuration is incorrect");
+
+    // Percentiles are accurate to within 12.5%
+    XCTAssertEqualWithAccuracy([histogram durationAtPercentile:0], 0.001, 0.001 * 0.125, @"0th percentile is incorrect");
+    XCTAssertEqualWithAccuracy([histogram durationAtPercentile:0.5], 0.5, 0.5 * 0.125, @"50th percentile is incorrect");
+    XCTAssertEqualWithAccuracy([histogram durationAtPercentile:0.99], 0.99, 0.99 * 0.125, @"99th percentile is incorrect");
+    XCTAssertEqualWithAccuracy([histogram durationAtPercentile:1], 1, 0.125, @"100th percentile is incorrect");
+
+    XCTAssertThrows([histogram durationAtPercentile:1.5], @"out-of-range percentile does not throw exception");
+}
+
+
+- (void)testWindowExpiration
+{
+    TSKDurationHistogram *histogram = [[TSKDurationHistogram alloc] initWithWindowDuration:0.2];
+    [histogram recordDuration:1];
+    XCTAssertEqual(histogram.count, 1, @"count is incorrect");
+
+    // After a full window, the duration has aged out
+    [NSThread sleepForTimeInterval:0.3];
+    XCTAssertEqual(histogram.count, 0, @"duration was not expired");
+    XCTAssertLessThan([histogram durationAtPercentile:0.5], 0, @"expired histogram returns non-negative duration");
+
+    [histogram recordDuration:2];
+    XCTAssertEqual(histogram.count, 1, @"count is incorrect after expiration");
+    XCTAssertEqualWithAccuracy([histogram durationAtPercentile:0.5], 2, 0.25, @"duration is incorrect after expiration");
+}
+
+
+- (void)testConcurrentRecordingAcrossEpochs
+{
+    // Epochs are 0.2 seconds long. Recording for 0.35 seconds crosses at least one epoch boundary but
+    // spans at most three epochs, so every recorded duration is still in the window afterward.
+    TSKDurationHistogram *histogram = [[TSKDurationHistogram alloc] initWithWindowDuration:0.8];
+    const NSTimeInterval duration = 0.001;
+    const NSUInteger threadCount = 8;
+    const NSTimeInterval recordingInterval = 0.35;
+
+    NSLock *recordedCountLock = [[NSLock alloc] init];
+    __block NSUInteger recordedCount = 0;
+    NSDate *endDate = [NSDate dateWithTimeIntervalSinceNow:recordingInterval];
+    dispatch_apply(threadCount, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+        NSUInteger threadRecordedCount = 0;
+        while (endDate.timeIntervalSinceNow > 0) {
+            [histogram recordDuration:duration];
+            ++threadRecordedCount;
+        }
+
+        [recordedCountLock lock];
+        recordedCount += threadRecordedCount;
+        [recordedCountLock unlock];
+    });
+
+    // Clearing a slot for a new epoch must not erase durations recorded in that epoch, and the
+    // count, total, and buckets must stay consistent with one another
+    XCTAssertEqual(histogram.count, recordedCount, @"durations recorded at an epoch boundary were lost");
+    XCTAssertEqualWithAccuracy(histogram.meanDuration, duration, 1e-12, @"count and total are inconsistent");
+    XCTAssertEqualWithAccuracy([histogram durationAtPercentile:1], duration, duration / 8, @"buckets are inconsistent");
+}
+
+
+- (void)testStatistics
+{
+    XCTAssertNotNil([TSKDurationStatistics sharedStatistics], @"shared statistics is nil");
+    XCTAssertEqual([TSKDurationStatistics sharedStatistics], [TSKDurationStatistics sharedStatistics], @"shared statistics is not shared");
+
+    TSKDurationStatistics *statistics = [[TSKDurationStatistics alloc] initWithWindowDuration:60];
+    XCTAssertEqualObjects(statistics.taskNames, [NSSet set], @"taskNames is not empty");
+
+    NSString *name = UMKRandomUnicodeString();
+    XCTAssertNil([statistics existingHistogramForTaskName:name], @"existing histogram for unrecorded name is non-nil");
+    XCTAssertEqualObjects(statistics.taskNames, [NSSet set], @"looking up a histogram created it");
+
+    [statistics recordDuration:1 forTaskName:name];
+    [statistics recordDuration:3 forTaskName:name];
+
+    XCTAssertEqualObjects(statistics.taskNames, [NSSet setWithObject:name], @"taskNames is incorrect");
+
+    TSKDurationHistogram *histogram = [statistics histogramForTaskName:name];
+    XCTAssertEqual(histogram, [statistics histogramForTaskName:name], @"histogram is not reused");
+    XCTAssertEqual(histogram, [statistics existingHistogramForTaskName:name], @"existing histogram is incorrect");
+    XCTAssertEqual(histogram.windowDuration, 60, @"histogram window is incorrect");
+    XCTAssertEqual(histogram.count, 2, @"count is incorrect");
+    XCTAssertEqualWithAccuracy(histogram.meanDuration, 2, 1e-6, @"meanDuration is incorrect");
+}
+
+
+- (void)testWorkflowRecordsDurations
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    workflow.durationStatistics = [[TSKDurationStatistics alloc] init];
+
+    NSString *name = UMKRandomUnicodeString();
+    TSKTestTask *namedTask = [[TSKTestTask alloc] initWithName:name block:^(TSKTask *task) {
+        [task finishWithResult:nil];
+    }];
+
+    TSKTestTask *unnamedTask = [self finishingTaskWithLock:nil];
+    [workflow addTask:namedTask prerequisites:nil];
+    [workflow addTask:unnamedTask prerequisites:nil];
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:namedTask];
+    [self expectationForNotification:TSKTaskDidFinishNotification task:unnamedTask];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertEqualObjects(workflow.durationStatistics.taskNames, [NSSet setWithObject:name], @"only named tasks are recorded");
+    XCTAssertEqual([workflow.durationStatistics histogramForTaskName:name].count, 1, @"duration was not recorded");
+}
+
+@end
@@ -0,0 +1,274 @@
+//
+//  TSKFairSchedulerTestCase.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TSKRandomizedTestCase.h"
+
+
+@interface TSKFairSchedulerTestCase : TSKRandomizedTestCase
+
+- (void)testInit;
+- (void)testWeights;
+- (void)testSmallWorkflowIsNotStarved;
+- (void)testWeightedShares;
+- (void)testEarliestDeadlineFirst;
+- (void)testStatistics;
+- (void)testWorkflowScheduler;
+
+/*!
+ @abstract Blocks the scheduler, schedules blocks for the specified workflows, then unblocks it.
+ @discussion The scheduler must have a maximum concurrent task count of 1.
+ @param scheduler The scheduler.
+ @param blockCounts The number of blocks to schedule for each workflow, in the same order as
+     workflows. Each workflow’s blocks are scheduled before the next workflow’s.
+ @param workflows The workflows.
+ @result The workflows for which the blocks ran, in the order they ran.
+ */
+- (NSArray<TSKWorkflow *> *)runOrderForScheduler:(TSKFairScheduler *)scheduler
+                                     blockCounts:(NSArray<NSNumber *> *)blockCounts
+                                       workflows:(NSArray<TSKWorkflow *> *)workflows;
+
+@end
+
+
+@implementation TSKFairSchedulerTestCase
+
+- (void)testInit
+{
+    TSKFairScheduler *scheduler = [[TSKFairScheduler alloc] init];
+    XCTAssertNotNil(scheduler, @"returns nil");
+    XCTAssertNotNil(scheduler.operationQueue, @"operation queue is nil");
+    XCTAssertEqual(scheduler.maximumConcurrentTaskCount, [NSProcessInfo processInfo].activeProcessorCount,
+                   @"maximumConcurrentTaskCount default is incorrect");
+
+    NSOperationQueue *operationQueue = [[NSOperationQueue alloc] init];
+    operationQueue.maxConcurrentOperationCount = random() % 8 + 1;
+    scheduler = [[TSKFairScheduler alloc] initWithOperationQueue:operationQueue];
+    XCTAssertEqual(scheduler.operationQueue, operationQueue, @"operation queue is set incorrectly");
+    XCTAssertEqual(scheduler.maximumConcurrentTaskCount, operationQueue.maxConcurrentOperationCount,
+                   @"maximumConcurrentTaskCount does not match queue");
+
+    NSUInteger maximumConcurrentTaskCount = random() % 8 + 1;
+    scheduler = [[TSKFairScheduler alloc] initWithOperationQueue:operationQueue maximumConcurrentTaskCount:maximumConcurrentTaskCount];
+    XCTAssertEqual(scheduler.maximumConcurrentTaskCount, maximumConcurrentTaskCount, @"maximumConcurrentTaskCount is set incorrectly");
+
+    id nilObject = nil;
+    XCTAssertThrows([[TSKFairScheduler alloc] initWithOperationQueue:nilObject], @"nil operation queue does not throw exception");
+    XCTAssertThrows([[TSKFairScheduler alloc] initWithOperationQueue:operationQueue maximumConcurrentTaskCount:0],
+                    @"zero maximumConcurrentTaskCount does not throw exception");
+}
+
+
+- (void)testWeights
+{
+    TSKFairScheduler *scheduler = [[TSKFairScheduler alloc] init];
+    TSKWorkflow *workflow = [[TSKWorkflow alloc] init];
+    XCTAssertEqual([scheduler weightForWorkflow:workflow], 1, @"default weight is incorrect");
+
+    NSUInteger weight = random() % 10 + 2;
+    [scheduler setWeight:weight forWorkflow:workflow];
+    XCTAssertEqual([scheduler weightForWorkflow:workflow], weight, @"weight is set incorrectly");
+
+    XCTAssertThrows([scheduler setWeight:0 forWorkflow:workflow], @"zero weight does not throw exception");
+}
+
+
+- (NSArray<TSKWorkflow *> *)runOrderForScheduler:(TSKFairScheduler *)scheduler
+                                     blockCounts:(NSArray<NSNumber *> *)blockCounts
+                                       workflows:(NSArray<TSKWorkflow *> *)workflows
+{
+    NSMutableArray *runOrder = [[NSMutableArray alloc] init];
+    NSUInteger totalBlockCount = [[blockCounts valueForKeyPath:@"@sum.unsignedIntegerValue"] unsignedIntegerValue];
+
+    // Occupy the scheduler’s only slot so that everything else is queued
+    NSLock *lock = [[NSLock alloc] init];
+    [lock lock];
+    [scheduler scheduleBlock:^{
+        [lock lock];
+        [lock unlock];
+    } forWorkflow:[[TSKWorkflow alloc] init]];
+
+    XCTestExpectation *didRunExpectation = [self expectationWithDescription:@"all blocks did run"];
+    didRunExpectation.expectedFulfillmentCount = totalBlockCount;
+
+    [workflows enumerateObjectsUsingBlock:^(TSKWorkflow *workflow, NSUInteger i, BOOL *stop) {
+        for (NSUInteger j = 0; j < blockCounts[i].unsignedIntegerValue; ++j) {
+            [scheduler scheduleBlock:^{
+                @synchronized (runOrder) {
+                    [runOrder addObject:workflow];
+                }
+
+                [didRunExpectation fulfill];
+            } forWorkflow:workflow];
+        }
+    }];
+
+    [lock unlock];
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+    return runOrder;
+}
+
+
+- (void)testSmallWorkflowIsNotStarved
+{
+    TSKFairScheduler *scheduler = [[TSKFairScheduler alloc] initWithOperationQueue:[[NSOperationQueue alloc] init] maximumConcurrentTaskCount:1];
+    TSKWorkflow *largeWorkflow = [[TSKWorkflow alloc] init];
+    TSKWorkflow *smallWorkflow = [[TSKWorkflow alloc] init];
+
+    // Even though all of the large workflow’s tasks were scheduled first, the small workflow’s tasks
+    // should be interleaved with them
+    NSArray *runOrder = [self runOrderForScheduler:scheduler blockCounts:@[ @200, @10 ] workflows:@[ largeWorkflow, smallWorkflow ]];
+    NSUInteger lastSmallIndex = [runOrder indexOfObjectWithOptions:NSEnumerationReverse passingTest:^BOOL(id workflow, NSUInteger idx, BOOL *stop) {
+        return workflow == smallWorkflow;
+    }];
+
+    XCTAssertLessThan(lastSmallIndex, 21, @"small workflow was starved");
+}
+
+
+- (void)testWeightedShares
+{
+    TSKFairScheduler *scheduler = [[TSKFairScheduler alloc] initWithOperationQueue:[[NSOperationQueue alloc] init] maximumConcurrentTaskCount:1];
+    TSKWorkflow *heavyWorkflow = [[TSKWorkflow alloc] init];
+    TSKWorkflow *lightWorkflow = [[TSKWorkflow alloc] init];
+    [scheduler setWeight:3 forWorkflow:heavyWorkflow];
+
+    NSArray *runOrder = [self runOrderForScheduler:scheduler blockCounts:@[ @60, @60 ] workflows:@[ heavyWorkflow, lightWorkflow ]];
+
+    // While both workflows have work queued, the heavy workflow should get three times the share
+    NSArray *firstRuns = [runOrder subarrayWithRange:NSMakeRange(0, 40)];
+    NSUInteger heavyCount = [firstRuns indexesOfObjectsPassingTest:^BOOL(id workflow, NSUInteger idx, BOOL *stop) {
+        return workflow == heavyWorkflow;
+    }].count;
+
+    XCTAssertEqualWithAccuracy(heavyCount, 30, 2, @"heavy workflow did not get its weighted share");
+}
+
+
+- (void)testEarliestDeadlineFirst
+{
+    TSKFairScheduler *scheduler = [[TSKFairScheduler alloc] initWithOperationQueue:[[NSOperationQueue alloc] init] maximumConcurrentTaskCount:1];
+    XCTAssertEqual(scheduler.policy, TSKSchedulingPolicyFairShare, @"default policy is incorrect");
+    scheduler.policy = TSKSchedulingPolicyEarliestDeadlineFirst;
+
+    NSArray *workflows = @[ [[TSKWorkflow alloc] init], [[TSKWorkflow alloc] init], [[TSKWorkflow alloc] init] ];
+    NSMutableArray<NSDate *> *runDeadlines = [[NSMutableArray alloc] init];
+
+    NSLock *lock = [[NSLock alloc] init];
+    [lock lock];
+    [scheduler scheduleBlock:^{
+        [lock lock];
+        [lock unlock];
+    } forWorkflow:workflows[0]];
+
+    NSUInteger blockCount = random() % 20 + 20;
+    XCTestExpectation *didRunExpectation = [self expectationWithDescription:@"all blocks did run"];
+    didRunExpectation.expectedFulfillmentCount = blockCount;
+
+    // Every fourth block has no deadline
+    NSDate *now = [NSDate date];
+    for (NSUInteger i = 0; i < blockCount; ++i) {
+        NSDate *deadline = i % 4 == 0 ? nil : [now dateByAddingTimeInterval:random() % 1000 + 1];
+        [scheduler scheduleBlock:^{
+            @synchronized (runDeadlines) {
+                [runDeadlines addObject:deadline ? deadline : [NSDate distantFuture]];
+            }
+
+            [didRunExpectation fulfill];
+        } forWorkflow:workflows[random() % workflows.count] deadline:deadline];
+    }
+
+    [lock unlock];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    NSArray *sortedDeadlines = [runDeadlines sortedArrayUsingSelector:@selector(compare:)];
+    XCTAssertEqualObjects(runDeadlines, sortedDeadlines, @"blocks did not run in deadline order");
+}
+
+
+- (void)testStatistics
+{
+    TSKFairScheduler *scheduler = [[TSKFairScheduler alloc] initWithOperationQueue:[[NSOperationQueue alloc] init] maximumConcurrentTaskCount:1];
+    TSKWorkflow *workflow = [[TSKWorkflow alloc] init];
+    XCTAssertEqual([scheduler queueDepthForWorkflow:workflow], 0, @"queue depth is non-zero");
+    XCTAssertEqual([scheduler averageWaitTimeForWorkflow:workflow], 0, @"average wait time is non-zero");
+
+    NSLock *lock = [[NSLock alloc] init];
+    [lock lock];
+
+    NSUInteger blockCount = random() % 10 + 5;
+    XCTestExpectation *didRunExpectation = [self expectationWithDescription:@"all blocks did run"];
+    didRunExpectation.expectedFulfillmentCount = blockCount;
+    for (NSUInteger i = 0; i < blockCount; ++i) {
+        [scheduler scheduleBlock:^{
+            [lock lock];
+            [lock unlock];
+            [didRunExpectation fulfill];
+        } forWorkflow:workflow];
+    }
+
+    // The first block is running; the rest are queued
+    XCTAssertEqual([scheduler queueDepthForWorkflow:workflow], blockCount - 1, @"queue depth is incorrect");
+    usleep(20000);
+    [lock unlock];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertEqual([scheduler queueDepthForWorkflow:workflow], 0, @"queue depth is non-zero");
+    XCTAssertEqual([scheduler dispatchedTaskCountForWorkflow:workflow], blockCount, @"dispatched task count is incorrect");
+    XCTAssertGreaterThan([scheduler averageWaitTimeForWorkflow:workflow], 0, @"average wait time is zero");
+    XCTAssertGreaterThanOrEqual([scheduler maximumWaitTimeForWorkflow:workflow], 0.02, @"maximum wait time is too short");
+}
+
+
+- (void)testWorkflowScheduler
+{
+    TSKFairScheduler *scheduler = [[TSKFairScheduler alloc] init];
+    NSMutableArray *workflows = [[NSMutableArray alloc] init];
+
+    for (NSUInteger i = 0; i < 5; ++i) {
+        TSKWorkflow *workflow = [self workflowForNotificationTesting];
+        workflow.scheduler = scheduler;
+
+        TSKBlockTask *task = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+            XCTAssertEqual([NSOperationQueue currentQueue], scheduler.operationQueue, @"task did not run on scheduler’s queue");
+            [task finishWithResult:nil];
+        }];
+
+        [workflow addTask:task prerequisites:nil];
+        [workflow addTask:[self finishingTaskWithLock:nil] prerequisites:task, nil];
+        [workflows addObject:workflow];
+
+        [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    }
+
+    [workflows makeObjectsPerformSelector:@selector(start)];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    for (TSKWorkflow *workflow in workflows) {
+        XCTAssertEqual([scheduler dispatchedTaskCountForWorkflow:workflow], 2, @"workflow’s tasks did not use scheduler");
+    }
+}
+
+@end
@@ -0,0 +1,161 @@
+//
+//  TSKFlightRecorderTestCase.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TSKRandomizedTestCase.h"
+
+#import <signal.h>
+
+
+@interface TSKFlightRecorderTestCase : TSKRandomizedTestCase
+
+- (void)testRecordsTaskLifecycle;
+- (void)testDisabled;
+- (void)testRemoveAllEvents;
+- (void)testInvalidDumps;
+- (void)testSignalHandler;
+
+@end
+
+
+@implementation TSKFlightRecorderTestCase
+
+- (void)setUp
+{
+    [super setUp];
+    TSKFlightRecorder.enabled = YES;
+    [TSKFlightRecorder removeAllEvents];
+}
+
+
+- (void)tearDown
+{
+    TSKFlightRecorder.enabled = YES;
+    [super tearDown];
+}
+
+
+/*! Runs a task that finishes immediately in a new workflow and returns it. */
+- (TSKTask *)runFinishingTask
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    TSKTestTask *task = [self finishingTaskWithLock:nil];
+    [workflow addTask:task prerequisites:nil];
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:task];
+    [task start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+    return task;
+}
+
+
+/*! Returns the lines in the specified dump description that pertain to the specified task. */
+- (NSArray<NSString *> *)linesForTask:(TSKTask *)task inDescription:(NSString *)description
+{
+    NSString *taskString = [NSString stringWithFormat:@"task %p ", task];
+    NSMutableArray<NSString *> *lines = [[NSMutableArray alloc] init];
+    [description enumerateLinesUsingBlock:^(NSString *line, BOOL *stop) {
+        if ([line containsString:taskString]) {
+            [lines addObject:line];
+        }
+    }];
+
+    return lines;
+}
+
+
+- (void)testRecordsTaskLifecycle
+{
+    XCTAssertTrue(TSKFlightRecorder.enabled, @"recorder is not enabled by default");
+    XCTAssertGreaterThan(TSKFlightRecorder.eventCapacityPerThread, 0, @"eventCapacityPerThread is 0");
+
+    TSKTask *task = [self runFinishingTask];
+    NSString *description = [TSKFlightRecorder descriptionOfDump:[TSKFlightRecorder dump]];
+    XCTAssertNotNil(description, @"dump could not be decoded");
+
+    // Events appear in the order in which they were recorded
+    NSArray<NSString *> *lines = [self linesForTask:task inDescription:description];
+    NSArray<NSString *> *expectedSuffixes = @[ @"Enqueued", @"Dequeued", @"Ready → Executing", @"Executing → Finished" ];
+    XCTAssertEqual(lines.count, expectedSuffixes.count, @"incorrect number of events recorded: %@", lines);
+    for (NSUInteger i = 0; i < MIN(lines.count, expectedSuffixes.count); ++i) {
+        XCTAssertTrue([lines[i] hasSuffix:expectedSuffixes[i]], @"event %lu is incorrect: %@", (unsigned long)i, lines[i]);
+    }
+}
+
+
+- (void)testDisabled
+{
+    TSKFlightRecorder.enabled = NO;
+    XCTAssertFalse(TSKFlightRecorder.enabled, @"enabled is not set");
+
+    TSKTask *task = [self runFinishingTask];
+    NSString *description = [TSKFlightRecorder descriptionOfDump:[TSKFlightRecorder dump]];
+    XCTAssertEqual([self linesForTask:task inDescription:description].count, 0, @"events recorded while disabled");
+}
+
+
+- (void)testRemoveAllEvents
+{
+    TSKTask *task = [self runFinishingTask];
+    [TSKFlightRecorder removeAllEvents];
+
+    NSString *description = [TSKFlightRecorder descriptionOfDump:[TSKFlightRecorder dump]];
+    XCTAssertEqual([self linesForTask:task inDescription:description].count, 0, @"events were not removed");
+}
+
+
+- (void)testInvalidDumps
+{
+    XCTAssertThrows([TSKFlightRecorder descriptionOfDump:nil], @"nil dump does not throw exception");
+    XCTAssertNil([TSKFlightRecorder descriptionOfDump:[NSData data]], @"empty data decoded");
+    XCTAssertNil([TSKFlightRecorder descriptionOfDump:[UMKRandomUnicodeString() dataUsingEncoding:NSUTF8StringEncoding]],
+                 @"random data decoded");
+
+    // A valid dump with a partial event is invalid
+    NSMutableData *truncatedDump = [[TSKFlightRecorder dump] mutableCopy];
+    [truncatedDump appendBytes:"x" length:1];
+    XCTAssertNil([TSKFlightRecorder descriptionOfDump:truncatedDump], @"truncated dump decoded");
+}
+
+
+- (void)testSignalHandler
+{
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    XCTAssertThrows([TSKFlightRecorder installSignalHandlerForSignal:SIGUSR2 dumpPath:nil], @"nil path does not throw exception");
+    XCTAssertTrue([TSKFlightRecorder installSignalHandlerForSignal:SIGUSR2 dumpPath:path], @"handler not installed");
+
+    TSKTask *task = [self runFinishingTask];
+    raise(SIGUSR2);
+    signal(SIGUSR2, SIG_DFL);
+
+    NSData *dump = [NSData dataWithContentsOfFile:path];
+    [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+    XCTAssertNotNil(dump, @"dump not written");
+
+    NSString *description = [TSKFlightRecorder descriptionOfDump:dump];
+    XCTAssertEqual([self linesForTask:task inDescription:description].count, 4, @"dump is missing events");
+}
+
+@end
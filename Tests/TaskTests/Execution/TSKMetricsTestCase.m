@@ -0,0 +1,241 @@
+//
+//  TSKMetricsTestCase.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TSKRandomizedTestCase.h"
+
+
+@interface TSKMetricsTestCase : TSKRandomizedTestCase
+
+- (void)testInit;
+- (void)testCountersAndLatencies;
+- (void)testActiveWorkflows;
+- (void)testRates;
+- (void)testPrometheusText;
+- (void)testExport;
+
+@end
+
+
+@implementation TSKMetricsTestCase
+
+- (TSKWorkflow *)workflowWithName:(NSString *)name
+{
+    return [[TSKWorkflow alloc] initWithName:name operationQueue:nil notificationCenter:self.notificationCenter];
+}
+
+
+- (void)testInit
+{
+    XCTAssertNotNil([TSKMetrics sharedMetrics], @"shared metrics is nil");
+    XCTAssertEqual([TSKMetrics sharedMetrics], [TSKMetrics sharedMetrics], @"shared metrics is not shared");
+    XCTAssertNil([TSKMetrics sharedMetrics].name, @"shared metrics has a name");
+
+    NSString *name = UMKRandomUnicodeString();
+    TSKMetrics *metrics = [[TSKMetrics alloc] initWithName:name];
+    XCTAssertEqualObjects(metrics.name, name, @"name is set incorrectly");
+
+    TSKMetricsSnapshot *snapshot = [metrics snapshot];
+    XCTAssertEqualObjects(snapshot.name, name, @"snapshot name is incorrect");
+    XCTAssertEqual([snapshot valueForCounter:TSKMetricsCounterTasksStarted], 0, @"counter is non-zero");
+    XCTAssertEqual(snapshot.readyQueueDepth, 0, @"readyQueueDepth is non-zero");
+    XCTAssertEqual(snapshot.activeWorkflowCount, 0, @"activeWorkflowCount is non-zero");
+    XCTAssertEqual(snapshot.queueWaitLatency.count, 0, @"queueWaitLatency is not empty");
+    XCTAssertLessThan([snapshot.executionLatency durationAtPercentile:0.5], 0, @"empty histogram returns non-negative duration");
+
+    TSKWorkflow *workflow = [self workflowWithName:name];
+    XCTAssertNotNil(workflow.metrics, @"workflow metrics is nil");
+    XCTAssertEqualObjects(workflow.metrics.name, name, @"workflow metrics name is incorrect");
+}
+
+
+- (void)testCountersAndLatencies
+{
+    TSKMetricsSnapshot *sharedSnapshot = [[TSKMetrics sharedMetrics] snapshot];
+
+    TSKWorkflow *workflow = [self workflowWithName:UMKRandomUnicodeString()];
+    TSKTask *finishingTask = [self finishingTaskWithLock:nil];
+    TSKTask *failingTask = [self failingTaskWithLock:nil];
+    TSKTask *cancelledTask = [[TSKTestTask alloc] init];
+    [workflow addTask:finishingTask prerequisites:nil];
+    [workflow addTask:failingTask prerequisites:nil];
+    [workflow addTask:cancelledTask prerequisites:failingTask, nil];
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:finishingTask];
+    [self expectationForNotification:TSKTaskDidFailNotification task:failingTask];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    [cancelledTask cancel];
+
+    [self expectationForNotification:TSKTaskDidFailNotification task:failingTask];
+    [failingTask retry];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    TSKMetricsSnapshot *snapshot = [workflow.metrics snapshot];
+    XCTAssertEqual([snapshot valueForCounter:TSKMetricsCounterTasksStarted], 3, @"started count is incorrect");
+    XCTAssertEqual([snapshot valueForCounter:TSKMetricsCounterTasksFinished], 1, @"finished count is incorrect");
+    XCTAssertEqual([snapshot valueForCounter:TSKMetricsCounterTasksFailed], 2, @"failed count is incorrect");
+    XCTAssertEqual([snapshot valueForCounter:TSKMetricsCounterTasksCancelled], 1, @"cancelled count is incorrect");
+
+    // Retrying the failed task also retries its cancelled dependent
+    XCTAssertEqual([snapshot valueForCounter:TSKMetricsCounterTasksRetried], 2, @"retried count is incorrect");
+    XCTAssertEqual(snapshot.readyQueueDepth, 0, @"readyQueueDepth is non-zero");
+
+    XCTAssertEqual(snapshot.queueWaitLatency.count, 3, @"queue wait latency count is incorrect");
+    XCTAssertEqual(snapshot.executionLatency.count, 1, @"execution latency count is incorrect");
+    XCTAssertGreaterThan([snapshot.executionLatency durationAtPercentile:1], 0, @"execution latency is not positive");
+    XCTAssertLessThan([snapshot.executionLatency durationAtPercentile:1], 1, @"execution latency is too large");
+
+    __block uint64_t previousCount = 0;
+    __block NSTimeInterval previousUpperBound = 0;
+    [snapshot.queueWaitLatency enumerateBucketsUsingBlock:^(NSTimeInterval upperBound, uint64_t cumulativeCount) {
+        XCTAssertGreaterThan(upperBound, previousUpperBound, @"bucket bounds are not increasing");
+        XCTAssertGreaterThanOrEqual(cumulativeCount, previousCount, @"bucket counts are not cumulative");
+        previousUpperBound = upperBound;
+        previousCount = cumulativeCount;
+    }];
+
+    XCTAssertTrue(isinf(previousUpperBound), @"last bucket is not unbounded");
+    XCTAssertEqual(previousCount, 3, @"last bucket does not include every latency");
+
+    // The workflow’s metrics are also recorded in the shared metrics
+    TSKMetricsSnapshot *newSharedSnapshot = [[TSKMetrics sharedMetrics] snapshot];
+    XCTAssertGreaterThanOrEqual([newSharedSnapshot valueForCounter:TSKMetricsCounterTasksStarted] -
+                                [sharedSnapshot valueForCounter:TSKMetricsCounterTasksStarted], 3,
+                                @"shared metrics were not updated");
+}
+
+
+- (void)testActiveWorkflows
+{
+    int64_t initialActiveWorkflowCount = [[TSKMetrics sharedMetrics] snapshot].activeWorkflowCount;
+
+    // A task with no block never finishes, so the workflow stays active until it is cancelled
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    TSKTestTask *task = [[TSKTestTask alloc] init];
+    [workflow addTask:task prerequisites:nil];
+
+    [self expectationForNotification:TSKTaskDidStartNotification task:task];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertEqual([workflow.metrics snapshot].activeWorkflowCount, 1, @"started workflow is not active");
+    XCTAssertEqual([[TSKMetrics sharedMetrics] snapshot].activeWorkflowCount, initialActiveWorkflowCount + 1, @"shared count is incorrect");
+
+    [workflow cancel];
+    XCTAssertEqual([workflow.metrics snapshot].activeWorkflowCount, 0, @"cancelled workflow is active");
+    XCTAssertEqual([[TSKMetrics sharedMetrics] snapshot].activeWorkflowCount, initialActiveWorkflowCount, @"shared count is incorrect");
+
+    // Finishing deactivates a workflow too
+    TSKWorkflow *finishingWorkflow = [self workflowForNotificationTesting];
+    [finishingWorkflow addTask:[self finishingTaskWithLock:nil] prerequisites:nil];
+
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:finishingWorkflow block:nil];
+    [finishingWorkflow start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+    XCTAssertEqual([finishingWorkflow.metrics snapshot].activeWorkflowCount, 0, @"finished workflow is active");
+}
+
+
+- (void)testRates
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    TSKMetricsSnapshot *initialSnapshot = [workflow.metrics snapshot];
+
+    NSUInteger taskCount = random() % 5 + 1;
+    for (NSUInteger i = 0; i < taskCount; ++i) {
+        [workflow addTask:[self finishingTaskWithLock:nil] prerequisites:nil];
+    }
+
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    TSKMetricsSnapshot *snapshot = [workflow.metrics snapshot];
+    NSTimeInterval elapsed = snapshot.timestamp - initialSnapshot.timestamp;
+    XCTAssertGreaterThan(elapsed, 0, @"snapshot timestamps are not increasing");
+    XCTAssertEqualWithAccuracy([snapshot ratePerSecondForCounter:TSKMetricsCounterTasksFinished sinceSnapshot:initialSnapshot],
+                               taskCount / elapsed, 1e-6, @"rate is incorrect");
+    XCTAssertEqual([snapshot ratePerSecondForCounter:TSKMetricsCounterTasksFinished sinceSnapshot:snapshot], 0,
+                   @"rate between identical snapshots is non-zero");
+}
+
+
+- (void)testPrometheusText
+{
+    TSKWorkflow *workflow = [self workflowWithName:@"a \"quoted\" name"];
+    TSKTask *task = [self finishingTaskWithLock:nil];
+    [workflow addTask:task prerequisites:nil];
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:task];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    NSString *text = [workflow.metrics snapshot].prometheusText;
+    NSString *labels = @"{workflow=\"a \\\"quoted\\\" name\"}";
+    XCTAssertTrue([text containsString:@"# TYPE tsk_tasks_started_total counter\n"], @"counter type is missing");
+    XCTAssertTrue([text containsString:[NSString stringWithFormat:@"tsk_tasks_started_total%@ 1\n", labels]], @"counter sample is incorrect");
+    XCTAssertTrue([text containsString:[NSString stringWithFormat:@"tsk_ready_queue_depth%@ 0\n", labels]], @"gauge sample is incorrect");
+    XCTAssertTrue([text containsString:@"# TYPE tsk_task_execution_seconds histogram\n"], @"histogram type is missing");
+    XCTAssertTrue([text containsString:@"tsk_task_execution_seconds_bucket{workflow=\"a \\\"quoted\\\" name\",le=\"+Inf\"} 1\n"],
+                  @"histogram bucket is incorrect");
+    XCTAssertTrue([text containsString:[NSString stringWithFormat:@"tsk_task_execution_seconds_count%@ 1\n", labels]],
+                  @"histogram count is incorrect");
+
+    // Unnamed metrics have no labels
+    XCTAssertTrue([[[TSKMetrics alloc] init].snapshot.prometheusText containsString:@"tsk_tasks_started_total 0\n"],
+                  @"unnamed sample is incorrect");
+}
+
+
+- (void)testExport
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    TSKMetricsSnapshot *snapshot = [workflow.metrics snapshot];
+
+    NSURL *fileURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString]];
+    NSError *error = nil;
+    XCTAssertTrue([snapshot writePrometheusTextToURL:fileURL error:&error], @"write failed: %@", error);
+    XCTAssertEqualObjects([NSString stringWithContentsOfURL:fileURL encoding:NSUTF8StringEncoding error:NULL], snapshot.prometheusText,
+                          @"written text is incorrect");
+    [[NSFileManager defaultManager] removeItemAtURL:fileURL error:NULL];
+
+    // The handler is invoked serially, so the flag needs no synchronization
+    XCTestExpectation *exportExpectation = [self expectationWithDescription:@"metrics exported"];
+    NSString *name = workflow.metrics.name;
+    __block BOOL exported = NO;
+    [workflow.metrics startExportingWithInterval:0.01 handler:^(TSKMetricsSnapshot *exportedSnapshot) {
+        if (!exported && [exportedSnapshot.name isEqualToString:name]) {
+            exported = YES;
+            [exportExpectation fulfill];
+        }
+    }];
+
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+    [workflow.metrics stopExporting];
+}
+
+@end
@@ -0,0 +1,259 @@
+//
+//  TSKResultStoreTestCase.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import "TSKRandomizedTestCase.h"
+
+
+@interface TSKResultStoreTestCase : TSKRandomizedTestCase
+
+- (void)testInit;
+- (void)testSpillAllResults;
+- (void)testSpillResultsOverBudget;
+- (void)testResetBeforeSpilling;
+- (void)testTaskThatFinishesRepeatedly;
+
+/*!
+ @abstract Returns data of the specified length containing random bytes.
+ @param length The length of the data.
+ @result The data.
+ */
+- (NSData *)randomDataWithLength:(NSUInteger)length;
+
+@end
+
+
+@implementation TSKResultStoreTestCase
+
+- (NSData *)randomDataWithLength:(NSUInteger)length
+{
+    NSMutableData *data = [[NSMutableData alloc] initWithLength:length];
+    arc4random_buf(data.mutableBytes, length);
+    return [data copy];
+}
+
+
+- (void)testInit
+{
+    TSKResultStore *store = [[TSKResultStore alloc] init];
+    XCTAssertNotNil(store, @"returns nil");
+    XCTAssertEqualObjects(store.directoryURL.path.stringByStandardizingPath, NSTemporaryDirectory().stringByStandardizingPath,
+                          @"default directory is incorrect");
+    XCTAssertEqual(store.spillThreshold, 1024 * 1024, @"spillThreshold default is incorrect");
+    XCTAssertEqual(store.memoryBudget, [NSProcessInfo processInfo].physicalMemory / 2, @"memoryBudget default is incorrect");
+    XCTAssertEqual(store.spilledResultCount, 0, @"spilledResultCount is non-zero");
+    XCTAssertEqual(store.spilledByteCount, 0, @"spilledByteCount is non-zero");
+    XCTAssertGreaterThan(TSKResultStore.currentMemoryFootprint, 0, @"currentMemoryFootprint is zero");
+
+    NSURL *directoryURL = [NSURL fileURLWithPath:NSHomeDirectory() isDirectory:YES];
+    store = [[TSKResultStore alloc] initWithDirectoryURL:directoryURL];
+    XCTAssertEqualObjects(store.directoryURL, directoryURL, @"directoryURL is set incorrectly");
+
+    id nilObject = nil;
+    XCTAssertThrows([[TSKResultStore alloc] initWithDirectoryURL:nilObject], @"nil directory URL does not throw exception");
+    XCTAssertThrows([[TSKResultStore alloc] initWithDirectoryURL:[NSURL URLWithString:@"https://example.com/"]],
+                    @"non-file directory URL does not throw exception");
+    XCTAssertThrows(store.spillThreshold = 0, @"zero spill threshold does not throw exception");
+}
+
+
+- (void)testSpillAllResults
+{
+    TSKResultStore *store = [[TSKResultStore alloc] init];
+    store.spillThreshold = 4096;
+    store.memoryBudget = UINT64_MAX;
+
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    workflow.resultStore = store;
+
+    NSData *largeData = [self randomDataWithLength:random() % 65536 + 4096];
+    NSData *smallData = [self randomDataWithLength:random() % 4096];
+    NSString *string = UMKRandomUnicodeString();
+
+    TSKTask *largeTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        [task finishWithResult:largeData];
+    }];
+
+    TSKTask *smallTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        [task finishWithResult:smallData];
+    }];
+
+    TSKTask *stringTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        [task finishWithResult:string];
+    }];
+
+    TSKTask *consumerTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        [task finishWithResult:nil];
+    }];
+
+    [workflow addTask:largeTask prerequisites:nil];
+    [workflow addTask:smallTask prerequisites:nil];
+    [workflow addTask:stringTask prerequisites:nil];
+    [workflow addTask:consumerTask keyedPrerequisiteTasks:@{ @"large" : largeTask, @"small" : smallTask, @"string" : stringTask }];
+
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertEqual(store.spilledResultCount, 0, @"results spilled while under budget");
+    XCTAssertEqual(largeTask.result, largeData, @"result changed while under budget");
+
+    [store spillAllResults];
+    XCTAssertEqual(store.spilledResultCount, 1, @"spilledResultCount is incorrect");
+    XCTAssertEqual(store.spilledByteCount, largeData.length, @"spilledByteCount is incorrect");
+
+    NSData *spilledData = [consumerTask prerequisiteResultForKey:@"large"];
+    XCTAssertEqual(spilledData, largeTask.result, @"prerequisite result is not the task’s result");
+    XCTAssertNotEqual(spilledData, largeData, @"result was not replaced");
+    XCTAssertEqualObjects(spilledData, largeData, @"spilled result is not equal to the original");
+    XCTAssertEqual(spilledData.bytes, [consumerTask prerequisiteResultForKey:@"large"].bytes, @"spilled result is copied on access");
+
+    XCTAssertEqual(smallTask.result, smallData, @"result below the threshold was spilled");
+    XCTAssertEqual(stringTask.result, string, @"non-data result was spilled");
+
+    // Spilled results aren’t spilled again
+    [store spillAllResults];
+    XCTAssertEqual(store.spilledResultCount, 1, @"spilled result was spilled again");
+    XCTAssertEqual(largeTask.result, spilledData, @"spilled result was replaced");
+}
+
+
+- (void)testSpillResultsOverBudget
+{
+    TSKResultStore *store = [[TSKResultStore alloc] init];
+    store.spillThreshold = 4096;
+    store.memoryBudget = 0;
+
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    workflow.resultStore = store;
+
+    NSUInteger taskCount = random() % 8 + 2;
+    NSMutableArray<NSData *> *results = [[NSMutableArray alloc] initWithCapacity:taskCount];
+    NSMutableArray<TSKTask *> *tasks = [[NSMutableArray alloc] initWithCapacity:taskCount];
+    for (NSUInteger i = 0; i < taskCount; ++i) {
+        NSData *result = [self randomDataWithLength:random() % 65536 + 4096];
+        TSKTask *task = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+            [task finishWithResult:result];
+        }];
+
+        [results addObject:result];
+        [tasks addObject:task];
+        [workflow addTask:task prerequisites:nil];
+    }
+
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    [self expectationForPredicate:[NSPredicate predicateWithFormat:@"spilledResultCount == %lu", (unsigned long)taskCount]
+              evaluatedWithObject:store
+                          handler:nil];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+
+    for (NSUInteger i = 0; i < taskCount; ++i) {
+        XCTAssertNotEqual(tasks[i].result, results[i], @"result was not replaced");
+        XCTAssertEqualObjects(tasks[i].result, results[i], @"spilled result is not equal to the original");
+    }
+}
+
+
+- (void)testResetBeforeSpilling
+{
+    TSKResultStore *store = [[TSKResultStore alloc] init];
+    store.spillThreshold = 4096;
+    store.memoryBudget = UINT64_MAX;
+
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    workflow.resultStore = store;
+
+    NSData *result = [self randomDataWithLength:8192];
+    TSKTask *task = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        [task finishWithResult:result];
+    }];
+
+    [workflow addTask:task prerequisites:nil];
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:task];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    // The reset task’s result is gone, so there is nothing to spill
+    [self expectationForNotification:TSKTaskDidResetNotification task:task];
+    [task reset];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    [store spillAllResults];
+    XCTAssertEqual(store.spilledResultCount, 0, @"reset task’s result was spilled");
+}
+
+
+- (void)testTaskThatFinishesRepeatedly
+{
+    TSKResultStore *store = [[TSKResultStore alloc] init];
+    store.spillThreshold = 4096;
+    store.memoryBudget = UINT64_MAX;
+
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    workflow.resultStore = store;
+
+    __block NSData *result = nil;
+    TSKTask *task = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        [task finishWithResult:result];
+    }];
+
+    [workflow addTask:task prerequisites:nil];
+
+    // Each time the task finishes, its new result is registered
+    NSUInteger finishCount = random() % 8 + 2;
+    for (NSUInteger i = 0; i < finishCount; ++i) {
+        result = [self randomDataWithLength:random() % 65536 + 4096];
+
+        [self expectationForNotification:TSKTaskDidFinishNotification task:task];
+        if (i == 0) {
+            [workflow start];
+        } else {
+            [task invalidate];
+        }
+
+        [self waitForExpectationsWithTimeout:1 handler:nil];
+    }
+
+    // Only the current result is spilled, and only once
+    [store spillAllResults];
+    XCTAssertEqual(store.spilledResultCount, 1, @"spilledResultCount is incorrect");
+    XCTAssertEqual(store.spilledByteCount, result.length, @"spilledByteCount is incorrect");
+    XCTAssertEqualObjects(task.result, result, @"spilled result is not equal to the original");
+
+    // Once spilled, the task can be registered again when it next finishes
+    result = [self randomDataWithLength:random() % 65536 + 4096];
+    [self expectationForNotification:TSKTaskDidFinishNotification task:task];
+    [task invalidate];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    [store spillAllResults];
+    XCTAssertEqual(store.spilledResultCount, 2, @"result registered after spilling was not spilled");
+    XCTAssertNotEqual(task.result, result, @"result was not replaced");
+}
+
+@end
@@ -0,0 +1,277 @@
+//
+//  TSKRetryPolicyTestCase.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import "TSKRandomizedTestCase.h"
+
+#import <stdatomic.h>
+
+
+@interface TSKRetryPolicyTestCase : TSKRandomizedTestCase
+
+- (void)testInit;
+- (void)testShouldRetry;
+- (void)testDelay;
+- (void)testTaskRetriesUntilFinished;
+- (void)testTaskFailsWhenAttemptsAreExhausted;
+- (void)testTaskDoesNotRetryWhenDeadlineCannotBeMet;
+- (void)testResetCancelsScheduledRetry;
+
+@end
+
+
+@implementation TSKRetryPolicyTestCase
+
+- (void)testInit
+{
+    TSKRetryPolicy *policy = [[TSKRetryPolicy alloc] init];
+    XCTAssertNotNil(policy, @"returns nil");
+    XCTAssertEqual(policy.maximumAttemptCount, 3, @"maximumAttemptCount default is incorrect");
+    XCTAssertEqual(policy.initialDelay, 1, @"initialDelay default is incorrect");
+    XCTAssertEqual(policy.backoffMultiplier, 2, @"backoffMultiplier default is incorrect");
+    XCTAssertEqual(policy.maximumDelay, 60, @"maximumDelay default is incorrect");
+    XCTAssertEqual(policy.jitter, 1, @"jitter default is incorrect");
+    XCTAssertNil(policy.retryableErrorPredicate, @"retryableErrorPredicate is non-nil");
+}
+
+
+- (void)testShouldRetry
+{
+    TSKRetryPolicy *policy = [[TSKRetryPolicy alloc] init];
+    policy.maximumAttemptCount = 3;
+
+    NSError *error = UMKRandomError();
+    XCTAssertTrue([policy shouldRetryAfterAttemptCount:1 error:error], @"does not retry after first attempt");
+    XCTAssertTrue([policy shouldRetryAfterAttemptCount:2 error:nil], @"does not retry nil error");
+    XCTAssertFalse([policy shouldRetryAfterAttemptCount:3 error:error], @"retries after maximum attempts");
+
+    NSError *retryableError = [NSError errorWithDomain:UMKRandomAlphanumericString() code:1 userInfo:nil];
+    policy.retryableErrorPredicate = ^BOOL(NSError *error) {
+        return [error isEqual:retryableError];
+    };
+
+    XCTAssertTrue([policy shouldRetryAfterAttemptCount:1 error:retryableError], @"does not retry retryable error");
+    XCTAssertFalse([policy shouldRetryAfterAttemptCount:1 error:error], @"retries non-retryable error");
+}
+
+
+- (void)testDelay
+{
+    TSKRetryPolicy *policy = [[TSKRetryPolicy alloc] init];
+    policy.initialDelay = 0.5;
+    policy.backoffMultiplier = 3;
+    policy.maximumDelay = 10;
+    policy.jitter = 0;
+
+    XCTAssertEqualWithAccuracy([policy delayAfterAttemptCount:1], 0.5, 1e-9, @"first delay is incorrect");
+    XCTAssertEqualWithAccuracy([policy delayAfterAttemptCount:2], 1.5, 1e-9, @"second delay is incorrect");
+    XCTAssertEqualWithAccuracy([policy delayAfterAttemptCount:3], 4.5, 1e-9, @"third delay is incorrect");
+    XCTAssertEqualWithAccuracy([policy delayAfterAttemptCount:4], 10, 1e-9, @"delay is not capped");
+
+    // With jitter, delays fall between the unjittered delay less the jittered fraction and the unjittered delay
+    policy.jitter = 0.5;
+    BOOL foundDifferentDelays = NO;
+    NSTimeInterval firstDelay = [policy delayAfterAttemptCount:3];
+    for (NSUInteger i = 0; i < 100; ++i) {
+        NSTimeInterval delay = [policy delayAfterAttemptCount:3];
+        XCTAssertGreaterThan(delay, 2.25, @"jittered delay is too short");
+        XCTAssertLessThanOrEqual(delay, 4.5, @"jittered delay is too long");
+        foundDifferentDelays = foundDifferentDelays || delay != firstDelay;
+    }
+
+    XCTAssertTrue(foundDifferentDelays, @"delays are not randomized");
+}
+
+
+- (void)testTaskRetriesUntilFinished
+{
+    TSKRetryPolicy *policy = [[TSKRetryPolicy alloc] init];
+    policy.initialDelay = 0.02;
+    policy.jitter = 0;
+
+    TSKBlockTask *task = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        if (task.attemptCount < 3) {
+            [task failWithError:UMKRandomError()];
+        } else {
+            [task finishWithResult:@(task.attemptCount)];
+        }
+    }];
+
+    // The task uses its workflow’s policy since it doesn’t have its own
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    workflow.retryPolicy = policy;
+    [workflow addTask:task prerequisites:nil];
+    XCTAssertEqual(task.attemptCount, 0, @"attemptCount is non-zero before execution");
+
+    __block atomic_uint scheduledRetryCount = 0;
+    id scheduleObserver = [workflow.notificationCenter addObserverForName:TSKTaskDidScheduleRetryNotification
+                                                                   object:task
+                                                                    queue:nil
+                                                               usingBlock:^(NSNotification *note) {
+        atomic_fetch_add(&scheduledRetryCount, 1);
+    }];
+
+    id failObserver = [workflow.notificationCenter addObserverForName:TSKTaskDidFailNotification
+                                                               object:task
+                                                                queue:nil
+                                                           usingBlock:^(NSNotification *note) {
+        XCTFail(@"failure was reported for retried attempt");
+    }];
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:task];
+    [task start];
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+
+    [workflow.notificationCenter removeObserver:scheduleObserver];
+    [workflow.notificationCenter removeObserver:failObserver];
+
+    XCTAssertEqualObjects(task.result, @3, @"result is incorrect");
+    XCTAssertEqual(task.attemptCount, 3, @"attemptCount is incorrect");
+    XCTAssertEqual(atomic_load(&scheduledRetryCount), 2, @"incorrect number of retries scheduled");
+}
+
+
+- (void)testTaskFailsWhenAttemptsAreExhausted
+{
+    TSKRetryPolicy *policy = [[TSKRetryPolicy alloc] init];
+    policy.maximumAttemptCount = 2;
+    policy.initialDelay = 0.02;
+
+    NSError *error = UMKRandomError();
+    TSKBlockTask *task = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        [task failWithError:error];
+    }];
+
+    task.retryPolicy = policy;
+
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    [workflow addTask:task prerequisites:nil];
+
+    [self expectationForNotification:TSKTaskDidFailNotification task:task];
+    [task start];
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+
+    XCTAssertTrue(task.isFailed, @"task is not failed");
+    XCTAssertEqualObjects(task.error, error, @"error is incorrect");
+    XCTAssertEqual(task.attemptCount, 2, @"attemptCount is incorrect");
+
+    // Errors the policy doesn’t consider retryable fail right away
+    policy.retryableErrorPredicate = ^BOOL(NSError *error) {
+        return NO;
+    };
+
+    [self expectationForNotification:TSKTaskDidFailNotification task:task];
+    [task retry];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+    XCTAssertEqual(task.attemptCount, 1, @"attemptCount was not reset by retry");
+}
+
+
+- (void)testTaskDoesNotRetryWhenDeadlineCannotBeMet
+{
+    TSKRetryPolicy *policy = [[TSKRetryPolicy alloc] init];
+    policy.maximumAttemptCount = 3;
+    policy.initialDelay = 0.02;
+
+    __block atomic_uint executionCount = 0;
+    TSKBlockTask *lateTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        atomic_fetch_add(&executionCount, 1);
+        [task finishWithResult:nil];
+    }];
+
+    lateTask.retryPolicy = policy;
+    lateTask.deadline = [NSDate dateWithTimeIntervalSinceNow:-1];
+
+    // Deadline errors are recognized by their domain and code, not by identity
+    TSKBlockTask *deadlineErrorTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        [task failWithError:[NSError errorWithDomain:TSKTaskErrorDomain code:TSKErrorCodeDeadlineCannotBeMet userInfo:nil]];
+    }];
+
+    deadlineErrorTask.retryPolicy = policy;
+
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    [workflow addTask:lateTask prerequisites:nil];
+    [workflow addTask:deadlineErrorTask prerequisites:nil];
+
+    __block atomic_uint scheduledRetryCount = 0;
+    id observer = [workflow.notificationCenter addObserverForName:TSKTaskDidScheduleRetryNotification object:nil queue:nil usingBlock:^(NSNotification *note) {
+        atomic_fetch_add(&scheduledRetryCount, 1);
+    }];
+
+    [self expectationForNotification:TSKTaskDidFailNotification task:lateTask];
+    [self expectationForNotification:TSKTaskDidFailNotification task:deadlineErrorTask];
+    [lateTask start];
+    [deadlineErrorTask start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+    [workflow.notificationCenter removeObserver:observer];
+
+    XCTAssertEqual(lateTask.error.code, TSKErrorCodeDeadlineCannotBeMet, @"error code is incorrect");
+    XCTAssertEqual(lateTask.attemptCount, 1, @"attemptCount is incorrect");
+    XCTAssertEqual(deadlineErrorTask.attemptCount, 1, @"attemptCount is incorrect");
+    XCTAssertEqual(atomic_load(&executionCount), 0, @"main invoked after deadline passed");
+    XCTAssertEqual(atomic_load(&scheduledRetryCount), 0, @"retry scheduled after deadline error");
+}
+
+
+- (void)testResetCancelsScheduledRetry
+{
+    TSKRetryPolicy *policy = [[TSKRetryPolicy alloc] init];
+    policy.initialDelay = 0.1;
+    policy.jitter = 0;
+
+    __block atomic_uint executionCount = 0;
+    TSKBlockTask *task = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        atomic_fetch_add(&executionCount, 1);
+        [task failWithError:UMKRandomError()];
+    }];
+
+    task.retryPolicy = policy;
+
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    [workflow addTask:task prerequisites:nil];
+
+    [self expectationForNotification:TSKTaskDidScheduleRetryNotification task:task];
+    [task start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertEqual(task.state, TSKTaskStatePending, @"task waiting to retry is not pending");
+    XCTAssertNil(task.error, @"task waiting to retry has an error");
+
+    [task reset];
+    XCTAssertEqual(task.state, TSKTaskStateReady, @"task is not ready after reset");
+    XCTAssertEqual(task.attemptCount, 0, @"attemptCount was not reset");
+
+    XCTestExpectation *retryDelayElapsedExpectation = [self expectationWithDescription:@"retry delay elapsed"];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.3 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [retryDelayElapsedExpectation fulfill];
+    });
+
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+    XCTAssertEqual(task.state, TSKTaskStateReady, @"cancelled retry restarted the task");
+    XCTAssertEqual(atomic_load(&executionCount), 1, @"cancelled retry executed the task");
+}
+
+@end
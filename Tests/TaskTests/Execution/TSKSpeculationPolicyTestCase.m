@@ -0,0 +1,183 @@
+//
+//  TSKSpeculationPolicyTestCase.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TSKRandomizedTestCase.h"
+
+#import <stdatomic.h>
+
+
+@interface TSKSpeculationPolicyTestCase : TSKRandomizedTestCase
+
+- (void)testInit;
+- (void)testSpeculationDelay;
+- (void)testSpeculativeAttemptWins;
+- (void)testLosingAttemptIsCancelled;
+- (void)testNoSpeculationWithoutDurations;
+
+@end
+
+
+@implementation TSKSpeculationPolicyTestCase
+
+- (void)testInit
+{
+    TSKSpeculationPolicy *policy = [[TSKSpeculationPolicy alloc] initWithPercentile:0.95];
+    XCTAssertNotNil(policy, @"returns nil");
+    XCTAssertEqual(policy.percentile, 0.95, @"percentile is set incorrectly");
+    XCTAssertEqual(policy.minimumSampleCount, 10, @"minimumSampleCount default is incorrect");
+    XCTAssertEqual(policy.maximumSpeculativeAttemptCount, 1, @"maximumSpeculativeAttemptCount default is incorrect");
+    XCTAssertNotNil(policy.durationHistogram, @"durationHistogram is nil");
+
+    TSKDurationHistogram *histogram = [[TSKDurationHistogram alloc] init];
+    policy = [[TSKSpeculationPolicy alloc] initWithPercentile:0.5 durationHistogram:histogram];
+    XCTAssertEqual(policy.durationHistogram, histogram, @"durationHistogram is set incorrectly");
+
+    XCTAssertThrows([[TSKSpeculationPolicy alloc] initWithPercentile:2], @"out-of-range percentile does not throw exception");
+}
+
+
+- (void)testSpeculationDelay
+{
+    TSKSpeculationPolicy *policy = [[TSKSpeculationPolicy alloc] initWithPercentile:0.9];
+    policy.minimumSampleCount = 10;
+
+    for (NSUInteger i = 1; i < 10; ++i) {
+        [policy.durationHistogram recordDuration:i];
+    }
+
+    XCTAssertLessThan(policy.speculationDelay, 0, @"speculation delay is non-negative without enough samples");
+
+    [policy.durationHistogram recordDuration:10];
+    XCTAssertEqualWithAccuracy(policy.speculationDelay, 9, 9 * 0.125, @"speculation delay is incorrect");
+}
+
+
+- (void)testSpeculativeAttemptWins
+{
+    TSKSpeculationPolicy *policy = [[TSKSpeculationPolicy alloc] initWithPercentile:0.5];
+    policy.minimumSampleCount = 1;
+    [policy.durationHistogram recordDuration:0.05];
+
+    // The first attempt straggles until it observes that the task is no longer executing; the
+    // speculative attempt finishes immediately
+    __block atomic_uint attemptCount = 0;
+    XCTestExpectation *stragglerDidStopExpectation = [self expectationWithDescription:@"straggler did stop"];
+    TSKBlockTask *task = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        if (atomic_fetch_add(&attemptCount, 1) == 0) {
+            while (task.isExecuting) {
+                usleep(1000);
+            }
+
+            [task finishWithResult:@"straggler"];
+            [stragglerDidStopExpectation fulfill];
+        } else {
+            [task finishWithResult:@"speculative"];
+        }
+    }];
+
+    task.speculationPolicy = policy;
+
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    [workflow addTask:task prerequisites:nil];
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:task];
+    [task start];
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+
+    XCTAssertTrue(task.isFinished, @"task did not finish");
+    XCTAssertEqualObjects(task.result, @"speculative", @"straggling attempt won");
+    XCTAssertEqual(task.speculativeAttemptCount, 1, @"speculativeAttemptCount is incorrect");
+    XCTAssertEqual(atomic_load(&attemptCount), 2, @"main invoked incorrect number of times");
+    XCTAssertEqual(policy.durationHistogram.count, 2, @"duration was not recorded");
+}
+
+
+- (void)testLosingAttemptIsCancelled
+{
+    TSKSpeculationPolicy *policy = [[TSKSpeculationPolicy alloc] initWithPercentile:0.5];
+    policy.minimumSampleCount = 1;
+    [policy.durationHistogram recordDuration:0.05];
+
+    // The first attempt only stops when its cancellation token is cancelled, which must happen even
+    // though the task finishes successfully
+    __block atomic_uint attemptCount = 0;
+    XCTestExpectation *stragglerWasCancelledExpectation = [self expectationWithDescription:@"straggler was cancelled"];
+    TSKBlockTask *task = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        if (atomic_fetch_add(&attemptCount, 1) == 0) {
+            dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+            [task.cancellationToken addCancellationHandler:^{
+                dispatch_semaphore_signal(semaphore);
+            }];
+
+            if (dispatch_semaphore_wait(semaphore, dispatch_time(DISPATCH_TIME_NOW, 2 * NSEC_PER_SEC)) == 0) {
+                [stragglerWasCancelledExpectation fulfill];
+            }
+        } else {
+            [task finishWithResult:@"speculative"];
+        }
+    }];
+
+    task.speculationPolicy = policy;
+
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    [workflow addTask:task prerequisites:nil];
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:task];
+    [task start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertTrue(task.isFinished, @"task did not finish");
+    XCTAssertEqualObjects(task.result, @"speculative", @"straggling attempt won");
+    XCTAssertTrue(task.cancellationToken.isCancelled, @"cancellation token is not cancelled");
+}
+
+
+- (void)testNoSpeculationWithoutDurations
+{
+    TSKSpeculationPolicy *policy = [[TSKSpeculationPolicy alloc] initWithPercentile:0.5];
+
+    __block atomic_uint attemptCount = 0;
+    TSKBlockTask *task = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        atomic_fetch_add(&attemptCount, 1);
+        usleep(10000);
+        [task finishWithResult:nil];
+    }];
+
+    task.speculationPolicy = policy;
+
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    [workflow addTask:task prerequisites:nil];
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:task];
+    [task start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertEqual(task.speculativeAttemptCount, 0, @"speculative attempt started without durations");
+    XCTAssertEqual(atomic_load(&attemptCount), 1, @"main invoked more than once");
+    XCTAssertEqual(policy.durationHistogram.count, 1, @"duration was not recorded");
+}
+
+@end
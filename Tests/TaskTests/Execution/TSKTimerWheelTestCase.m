@@ -0,0 +1,179 @@
+//
+//  TSKTimerWheelTestCase.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TSKRandomizedTestCase.h"
+
+
+@interface TSKTimerWheelTestCase : TSKRandomizedTestCase
+
+- (void)testInit;
+- (void)testFire;
+- (void)testDisarm;
+- (void)testManyTimers;
+
+@end
+
+
+@implementation TSKTimerWheelTestCase
+
+- (void)testInit
+{
+    TSKTimerWheel *timerWheel = [[TSKTimerWheel alloc] init];
+    XCTAssertNotNil(timerWheel, @"returns nil");
+    XCTAssertEqualWithAccuracy(timerWheel.tickInterval, 0.01, 1e-9, @"default tick interval is incorrect");
+    XCTAssertEqual(timerWheel.armedTimerCount, 0, @"armedTimerCount is non-zero");
+
+    NSTimeInterval tickInterval = (random() % 100 + 1) / 1000.0;
+    timerWheel = [[TSKTimerWheel alloc] initWithTickInterval:tickInterval];
+    XCTAssertEqualWithAccuracy(timerWheel.tickInterval, tickInterval, 1e-9, @"tick interval is set incorrectly");
+
+    XCTAssertNotNil([TSKTimerWheel sharedTimerWheel], @"shared timer wheel is nil");
+    XCTAssertEqual([TSKTimerWheel sharedTimerWheel], [TSKTimerWheel sharedTimerWheel], @"shared timer wheel is not shared");
+
+    XCTAssertThrows([[TSKTimerWheel alloc] initWithTickInterval:0], @"zero tick interval does not throw exception");
+}
+
+
+- (void)testFire
+{
+    TSKTimerWheel *timerWheel = [[TSKTimerWheel alloc] initWithTickInterval:0.001];
+
+    // Intervals longer than 64 ticks start out in a coarser wheel and must be moved to a finer one
+    NSTimeInterval intervals[] = { 0, 0.01, 0.05, 0.15, 0.3 };
+    NSUInteger intervalCount = sizeof(intervals) / sizeof(intervals[0]);
+
+    NSMutableArray *timers = [[NSMutableArray alloc] init];
+    for (NSUInteger i = 0; i < intervalCount; ++i) {
+        NSTimeInterval interval = intervals[i];
+        NSTimeInterval armTime = [NSProcessInfo processInfo].systemUptime;
+        XCTestExpectation *expectation = [self expectationWithDescription:[NSString stringWithFormat:@"timer %lu fired", (unsigned long)i]];
+        [timers addObject:[timerWheel armTimerWithInterval:interval handler:^{
+            NSTimeInterval elapsed = [NSProcessInfo processInfo].systemUptime - armTime;
+            XCTAssertGreaterThanOrEqual(elapsed + timerWheel.tickInterval, interval, @"timer fired early");
+            [expectation fulfill];
+        }]];
+    }
+
+    XCTAssertEqual(timerWheel.armedTimerCount, intervalCount, @"armedTimerCount is incorrect");
+    for (TSKTimerWheelTimer *timer in timers) {
+        XCTAssertTrue(timer.isArmed, @"timer is not armed");
+    }
+
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+
+    XCTAssertEqual(timerWheel.armedTimerCount, 0, @"armedTimerCount is non-zero");
+    for (TSKTimerWheelTimer *timer in timers) {
+        XCTAssertFalse(timer.isArmed, @"timer is armed after firing");
+    }
+
+    // The wheel keeps working after it goes idle
+    XCTestExpectation *idleExpectation = [self expectationWithDescription:@"timer fired after idle"];
+    [timerWheel armTimerWithInterval:0.02 handler:^{
+        [idleExpectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+}
+
+
+- (void)testDisarm
+{
+    TSKTimerWheel *timerWheel = [[TSKTimerWheel alloc] initWithTickInterval:0.001];
+
+    __block BOOL disarmedTimerFired = NO;
+    TSKTimerWheelTimer *disarmedTimer = [timerWheel armTimerWithInterval:0.05 handler:^{
+        disarmedTimerFired = YES;
+    }];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"timer fired"];
+    TSKTimerWheelTimer *timer = [timerWheel armTimerWithInterval:0.1 handler:^{
+        [expectation fulfill];
+    }];
+
+    [timerWheel disarmTimer:disarmedTimer];
+    XCTAssertFalse(disarmedTimer.isArmed, @"disarmed timer is armed");
+    XCTAssertEqual(timerWheel.armedTimerCount, 1, @"armedTimerCount is incorrect");
+
+    // Disarming twice has no effect
+    [timerWheel disarmTimer:disarmedTimer];
+    XCTAssertEqual(timerWheel.armedTimerCount, 1, @"armedTimerCount is incorrect");
+
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+    XCTAssertFalse(disarmedTimerFired, @"disarmed timer fired");
+
+    // Disarming a timer that fired has no effect
+    [timerWheel disarmTimer:timer];
+    XCTAssertEqual(timerWheel.armedTimerCount, 0, @"armedTimerCount is non-zero");
+
+    XCTAssertThrows([timerWheel disarmTimer:nil], @"nil timer does not throw exception");
+}
+
+
+- (void)testManyTimers
+{
+    TSKTimerWheel *timerWheel = [[TSKTimerWheel alloc] initWithTickInterval:0.001];
+
+    NSUInteger timerCount = random() % 5000 + 5000;
+    NSMutableArray *timers = [[NSMutableArray alloc] initWithCapacity:timerCount];
+    NSLock *lock = [[NSLock alloc] init];
+    NSMutableIndexSet *firedIndexes = [[NSMutableIndexSet alloc] init];
+
+    for (NSUInteger i = 0; i < timerCount; ++i) {
+        NSTimeInterval interval = (random() % 200) / 1000.0;
+        [timers addObject:[timerWheel armTimerWithInterval:interval handler:^{
+            [lock lock];
+            [firedIndexes addIndex:i];
+            [lock unlock];
+        }]];
+    }
+
+    // Disarm a random half of the timers
+    NSMutableIndexSet *disarmedIndexes = [[NSMutableIndexSet alloc] init];
+    for (NSUInteger i = 0; i < timerCount; ++i) {
+        if (random() % 2) {
+            [timerWheel disarmTimer:timers[i]];
+            [disarmedIndexes addIndex:i];
+        }
+    }
+
+    XCTAssertEqual(timerWheel.armedTimerCount, timerCount - disarmedIndexes.count, @"armedTimerCount is incorrect");
+
+    // Handlers run serially in expiration order, so this runs after all the others
+    XCTestExpectation *expectation = [self expectationWithDescription:@"last timer fired"];
+    [timerWheel armTimerWithInterval:0.3 handler:^{
+        [expectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+    XCTAssertEqual(timerWheel.armedTimerCount, 0, @"armedTimerCount is non-zero");
+
+    [lock lock];
+    XCTAssertEqual(firedIndexes.count, timerCount - disarmedIndexes.count, @"incorrect number of timers fired");
+    XCTAssertFalse([firedIndexes intersectsIndexSet:disarmedIndexes], @"disarmed timers fired");
+    [lock unlock];
+}
+
+@end
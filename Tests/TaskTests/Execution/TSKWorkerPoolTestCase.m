@@ -0,0 +1,332 @@
+//
+//  TSKWorkerPoolTestCase.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import "TSKRandomizedTestCase.h"
+
+
+#if TARGET_OS_OSX
+
+@interface TSKWorkerPoolTestCase : TSKRandomizedTestCase
+
+/*! The URL of the TaskWorkerFixture executable, or nil if it hasn’t been built. */
+@property (nonatomic, copy) NSURL *fixtureURL;
+
+- (void)testInit;
+- (void)testPerformRequest;
+- (void)testWorkerCrash;
+- (void)testWorkerTaskRetriesAfterCrash;
+- (void)testCancellation;
+- (void)testInvalidate;
+- (void)testScaling;
+
+/*!
+ @abstract Returns a pool of TaskWorkerFixture workers.
+ @param maximumWorkerCount The pool’s maximum worker count.
+ @result The pool.
+ */
+- (TSKWorkerPool *)fixturePoolWithMaximumWorkerCount:(NSUInteger)maximumWorkerCount;
+
+/*!
+ @abstract Performs the specified requests using the specified pool and waits for them to finish.
+ @param requests The requests.
+ @param pool The pool.
+ @result How long the requests took, in seconds.
+ */
+- (NSTimeInterval)durationOfPerformingRequests:(NSArray<NSDictionary *> *)requests withPool:(TSKWorkerPool *)pool;
+
+@end
+
+
+@implementation TSKWorkerPoolTestCase
+
+- (void)setUp
+{
+    [super setUp];
+
+    // SwiftPM and Xcode both put executables next to the test bundle
+    NSURL *productsURL = [[NSBundle bundleForClass:[self class]].bundleURL URLByDeletingLastPathComponent];
+    NSURL *fixtureURL = [productsURL URLByAppendingPathComponent:@"TaskWorkerFixture"];
+    self.fixtureURL = [[NSFileManager defaultManager] isExecutableFileAtPath:fixtureURL.path] ? fixtureURL : nil;
+}
+
+
+- (TSKWorkerPool *)fixturePoolWithMaximumWorkerCount:(NSUInteger)maximumWorkerCount
+{
+    NSSet *resultClasses = [NSSet setWithObjects:[NSString class], [NSNumber class], nil];
+    return [[TSKWorkerPool alloc] initWithExecutableURL:self.fixtureURL
+                                              arguments:nil
+                                     maximumWorkerCount:maximumWorkerCount
+                                   allowedResultClasses:resultClasses];
+}
+
+
+- (NSTimeInterval)durationOfPerformingRequests:(NSArray<NSDictionary *> *)requests withPool:(TSKWorkerPool *)pool
+{
+    dispatch_group_t group = dispatch_group_create();
+    NSDate *startDate = [NSDate date];
+    for (NSDictionary *request in requests) {
+        dispatch_group_enter(group);
+        [pool performRequest:request cancellationToken:nil completionHandler:^(id result, NSError *error) {
+            XCTAssertNotNil(result, @"request failed: %@", error);
+            dispatch_group_leave(group);
+        }];
+    }
+
+    XCTAssertEqual(dispatch_group_wait(group, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(60 * NSEC_PER_SEC))), 0, @"requests timed out");
+    return -startDate.timeIntervalSinceNow;
+}
+
+
+- (void)testInit
+{
+    NSURL *executableURL = [NSURL fileURLWithPath:@"/usr/bin/true"];
+    NSSet *resultClasses = [NSSet setWithObject:[NSString class]];
+
+    TSKWorkerPool *pool = [[TSKWorkerPool alloc] initWithExecutableURL:executableURL allowedResultClasses:resultClasses];
+    XCTAssertNotNil(pool, @"returns nil");
+    XCTAssertEqualObjects(pool.executableURL, executableURL, @"executableURL is set incorrectly");
+    XCTAssertEqualObjects(pool.arguments, @[ ], @"arguments is not empty");
+    XCTAssertEqual(pool.maximumWorkerCount, [NSProcessInfo processInfo].activeProcessorCount, @"maximumWorkerCount default is incorrect");
+    XCTAssertEqualObjects(pool.allowedResultClasses, resultClasses, @"allowedResultClasses is set incorrectly");
+    XCTAssertEqual(pool.workerCount, 0, @"workers launched before any requests");
+    XCTAssertEqual(pool.crashedWorkerCount, 0, @"crashedWorkerCount is non-zero");
+
+    NSArray *arguments = @[ UMKRandomAlphanumericString(), UMKRandomAlphanumericString() ];
+    NSUInteger maximumWorkerCount = random() % 8 + 1;
+    pool = [[TSKWorkerPool alloc] initWithExecutableURL:executableURL
+                                              arguments:arguments
+                                     maximumWorkerCount:maximumWorkerCount
+                                   allowedResultClasses:resultClasses];
+    XCTAssertEqualObjects(pool.arguments, arguments, @"arguments is set incorrectly");
+    XCTAssertEqual(pool.maximumWorkerCount, maximumWorkerCount, @"maximumWorkerCount is set incorrectly");
+
+    id nilObject = nil;
+    XCTAssertThrows([[TSKWorkerPool alloc] initWithExecutableURL:nilObject allowedResultClasses:resultClasses],
+                    @"nil executable URL does not throw exception");
+    XCTAssertThrows([[TSKWorkerPool alloc] initWithExecutableURL:executableURL allowedResultClasses:nilObject],
+                    @"nil allowed result classes does not throw exception");
+    XCTAssertThrows(([[TSKWorkerPool alloc] initWithExecutableURL:executableURL arguments:nil maximumWorkerCount:0 allowedResultClasses:resultClasses]),
+                    @"zero maximum worker count does not throw exception");
+}
+
+
+- (void)testPerformRequest
+{
+    XCTSkipUnless(self.fixtureURL, @"TaskWorkerFixture has not been built");
+    TSKWorkerPool *pool = [self fixturePoolWithMaximumWorkerCount:2];
+
+    NSString *value = UMKRandomUnicodeString();
+    XCTestExpectation *echoExpectation = [self expectationWithDescription:@"echo"];
+    [pool performRequest:@{ @"operation" : @"echo", @"value" : value } cancellationToken:nil completionHandler:^(id result, NSError *error) {
+        XCTAssertEqualObjects(result, value, @"result is incorrect");
+        XCTAssertNil(error, @"error is non-nil");
+        [echoExpectation fulfill];
+    }];
+
+    NSString *domain = UMKRandomAlphanumericString();
+    NSInteger code = random() % 1024;
+    XCTestExpectation *failExpectation = [self expectationWithDescription:@"fail"];
+    [pool performRequest:@{ @"operation" : @"fail", @"domain" : domain, @"code" : @(code) } cancellationToken:nil completionHandler:^(id result, NSError *error) {
+        XCTAssertNil(result, @"result is non-nil");
+        XCTAssertEqualObjects(error.domain, domain, @"error domain is incorrect");
+        XCTAssertEqual(error.code, code, @"error code is incorrect");
+        [failExpectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    XCTAssertEqual(pool.crashedWorkerCount, 0, @"worker crashed");
+    XCTAssertLessThanOrEqual(pool.workerCount, 2, @"too many workers launched");
+}
+
+
+- (void)testWorkerCrash
+{
+    XCTSkipUnless(self.fixtureURL, @"TaskWorkerFixture has not been built");
+    TSKWorkerPool *pool = [self fixturePoolWithMaximumWorkerCount:1];
+
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    TSKWorkerTask *task = [[TSKWorkerTask alloc] initWithWorkerPool:pool request:@{ @"operation" : @"crash" }];
+    [workflow addTask:task prerequisites:nil];
+
+    [self expectationForNotification:TSKTaskDidFailNotification task:task];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+
+    XCTAssertEqualObjects(task.error.domain, TSKTaskErrorDomain, @"error domain is incorrect");
+    XCTAssertEqual(task.error.code, TSKErrorCodeWorkerCrashed, @"error code is incorrect");
+    XCTAssertEqual(pool.crashedWorkerCount, 1, @"crash not counted");
+    XCTAssertEqual(pool.workerCount, 0, @"crashed worker still counted");
+
+    // The crash only took down its own worker, so the pool keeps working
+    XCTestExpectation *echoExpectation = [self expectationWithDescription:@"echo"];
+    [pool performRequest:@{ @"operation" : @"echo", @"value" : @"after crash" } cancellationToken:nil completionHandler:^(id result, NSError *error) {
+        XCTAssertEqualObjects(result, @"after crash", @"result is incorrect");
+        [echoExpectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+}
+
+
+- (void)testWorkerTaskRetriesAfterCrash
+{
+    XCTSkipUnless(self.fixtureURL, @"TaskWorkerFixture has not been built");
+    TSKWorkerPool *pool = [self fixturePoolWithMaximumWorkerCount:1];
+
+    NSString *markerPath = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    [self addTeardownBlock:^{
+        [[NSFileManager defaultManager] removeItemAtPath:markerPath error:NULL];
+    }];
+
+    TSKRetryPolicy *retryPolicy = [[TSKRetryPolicy alloc] init];
+    retryPolicy.initialDelay = 0.01;
+    retryPolicy.jitter = 0;
+
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    TSKWorkerTask *task = [[TSKWorkerTask alloc] initWithWorkerPool:pool request:@{ @"operation" : @"crashOnce", @"markerPath" : markerPath }];
+    task.retryPolicy = retryPolicy;
+    [workflow addTask:task prerequisites:nil];
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:task];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+
+    XCTAssertEqualObjects(task.result, @"recovered", @"result is incorrect");
+    XCTAssertEqual(task.attemptCount, 2, @"attempt count is incorrect");
+    XCTAssertEqual(pool.crashedWorkerCount, 1, @"crash not counted");
+}
+
+
+- (void)testCancellation
+{
+    XCTSkipUnless(self.fixtureURL, @"TaskWorkerFixture has not been built");
+    TSKWorkerPool *pool = [self fixturePoolWithMaximumWorkerCount:1];
+
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    TSKWorkerTask *task = [[TSKWorkerTask alloc] initWithWorkerPool:pool request:@{ @"operation" : @"hang" }];
+    task.timeout = 0.5;
+    [workflow addTask:task prerequisites:nil];
+
+    // A request waiting behind the hung one is abandoned without ever reaching a worker
+    TSKCancellationToken *pendingToken = [[TSKCancellationToken alloc] init];
+    XCTestExpectation *pendingExpectation = [self expectationWithDescription:@"pending request abandoned"];
+
+    [self expectationForPredicate:[NSPredicate predicateWithFormat:@"workerCount == 1"] evaluatedWithObject:pool handler:nil];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+
+    [self expectationForNotification:TSKTaskDidFailNotification task:task];
+    [pool performRequest:@{ @"operation" : @"echo", @"value" : @"pending" } cancellationToken:pendingToken completionHandler:^(id result, NSError *error) {
+        XCTAssertNil(result, @"result is non-nil");
+        XCTAssertEqualObjects(error.domain, NSCocoaErrorDomain, @"error domain is incorrect");
+        XCTAssertEqual(error.code, NSUserCancelledError, @"error code is incorrect");
+        [pendingExpectation fulfill];
+    }];
+
+    [pendingToken cancel];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+
+    // Timing out cancelled the task’s token, which killed the hung worker without counting a crash
+    XCTAssertEqual(task.error.code, TSKErrorCodeTimedOut, @"error code is incorrect");
+    XCTAssertEqual(pool.crashedWorkerCount, 0, @"killed worker counted as a crash");
+
+    XCTestExpectation *echoExpectation = [self expectationWithDescription:@"echo"];
+    [pool performRequest:@{ @"operation" : @"echo", @"value" : @"after cancel" } cancellationToken:nil completionHandler:^(id result, NSError *error) {
+        XCTAssertEqualObjects(result, @"after cancel", @"result is incorrect");
+        [echoExpectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+}
+
+
+- (void)testInvalidate
+{
+    XCTSkipUnless(self.fixtureURL, @"TaskWorkerFixture has not been built");
+    TSKWorkerPool *pool = [self fixturePoolWithMaximumWorkerCount:1];
+    [self durationOfPerformingRequests:@[ @{ @"operation" : @"echo", @"value" : @"" } ] withPool:pool];
+    XCTAssertEqual(pool.workerCount, 1, @"worker count is incorrect");
+
+    [pool invalidate];
+    XCTAssertEqual(pool.workerCount, 0, @"idle worker not stopped");
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"request after invalidation"];
+    [pool performRequest:@{ @"operation" : @"echo", @"value" : @"" } cancellationToken:nil completionHandler:^(id result, NSError *error) {
+        XCTAssertEqual(error.code, NSUserCancelledError, @"request after invalidation did not fail");
+        [expectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+}
+
+
+- (void)testScaling
+{
+    XCTSkipUnless(self.fixtureURL, @"TaskWorkerFixture has not been built");
+
+    NSUInteger workerCount = MIN([NSProcessInfo processInfo].activeProcessorCount, 4);
+    XCTSkipUnless(workerCount > 1, @"scaling requires more than one processor");
+
+    NSMutableArray<NSDictionary *> *requests = [[NSMutableArray alloc] init];
+    for (NSUInteger i = 0; i < workerCount * 4; ++i) {
+        [requests addObject:@{ @"operation" : @"spin", @"seed" : @(random()), @"iterations" : @(50000000) }];
+    }
+
+    // Each pool launches all of its workers before it is timed, so that launch time isn’t measured
+    NSDictionary *warmUpRequest = @{ @"operation" : @"spin", @"seed" : @1, @"iterations" : @1 };
+
+    TSKWorkerPool *serialPool = [self fixturePoolWithMaximumWorkerCount:1];
+    [self durationOfPerformingRequests:@[ warmUpRequest ] withPool:serialPool];
+    NSTimeInterval serialDuration = [self durationOfPerformingRequests:requests withPool:serialPool];
+
+    TSKWorkerPool *parallelPool = [self fixturePoolWithMaximumWorkerCount:workerCount];
+    NSMutableArray *warmUpRequests = [[NSMutableArray alloc] init];
+    for (NSUInteger i = 0; i < workerCount; ++i) {
+        [warmUpRequests addObject:@{ @"operation" : @"spin", @"seed" : @1, @"iterations" : @10000000 }];
+    }
+
+    [self durationOfPerformingRequests:warmUpRequests withPool:parallelPool];
+    NSTimeInterval parallelDuration = [self durationOfPerformingRequests:requests withPool:parallelPool];
+
+    // Perfect scaling would be a speedup of workerCount. Allow for a busy machine.
+    double speedup = serialDuration / parallelDuration;
+    NSString *summary = [[NSString alloc] initWithFormat:@"%lu workers: %.3fs serial, %.3fs parallel, %.2fx speedup",
+                         (unsigned long)workerCount, serialDuration, parallelDuration, speedup];
+
+    // The timings are kept with the test’s results so that scaling can be compared across runs
+    [XCTContext runActivityNamed:@"Record scaling" block:^(id<XCTActivity> activity) {
+        XCTAttachment *attachment = [XCTAttachment attachmentWithString:summary];
+        attachment.lifetime = XCTAttachmentLifetimeKeepAlways;
+        [activity addAttachment:attachment];
+    }];
+
+    XCTAssertGreaterThan(speedup, workerCount * 0.6, @"workers did not scale (%@)", summary);
+}
+
+@end
+
+#endif
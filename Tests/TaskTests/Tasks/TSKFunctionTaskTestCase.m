@@ -0,0 +1,150 @@
+//
+//  TSKFunctionTaskTestCase.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import "TSKRandomizedTestCase.h"
+
+
+/*! Records its task parameter in the NSMutableArray that context points to. */
+static void TSKRecordTask(TSKTask *task, void *context)
+{
+    [(__bridge NSMutableArray *)context addObject:task];
+}
+
+
+/*! Finishes its task with a nil result. */
+static void TSKFinishTask(TSKTask *task, void *context)
+{
+    [task finishWithResult:nil];
+}
+
+
+@interface TSKFunctionTaskTestCase : TSKRandomizedTestCase
+
+- (void)testInit;
+- (void)testCopy;
+- (void)testMain;
+- (void)testFunctionTaskThroughput;
+- (void)testBlockTaskThroughput;
+
+/*!
+ @abstract Measures how long it takes to create and run a workflow of independent tasks.
+ @param taskFactory A block that returns a new task that finishes with a nil result.
+ */
+- (void)measureThroughputOfTasksCreatedWithFactory:(TSKTask *(^)(void))taskFactory;
+
+@end
+
+
+@implementation TSKFunctionTaskTestCase
+
+- (void)testInit
+{
+    XCTAssertThrows(([[TSKFunctionTask alloc] initWithFunction:NULL context:NULL]), @"NULL function does not throw exception");
+
+    void *context = (__bridge void *)self;
+    TSKFunctionTask *task = [[TSKFunctionTask alloc] initWithFunction:TSKFinishTask context:context];
+    XCTAssertNotNil(task, @"returns nil");
+    XCTAssertEqual(task.function, TSKFinishTask, @"function is set incorrectly");
+    XCTAssertEqual(task.context, context, @"context is set incorrectly");
+    XCTAssertEqualObjects(task.name, [self defaultNameForTask:task], @"name not set to default");
+
+    NSString *name = UMKRandomUnicodeString();
+    task = [[TSKFunctionTask alloc] initWithName:name function:TSKFinishTask context:NULL];
+    XCTAssertNotNil(task, @"returns nil");
+    XCTAssertEqual(task.function, TSKFinishTask, @"function is set incorrectly");
+    XCTAssertEqual(task.context, NULL, @"context is set incorrectly");
+    XCTAssertEqualObjects(task.name, name, @"name is set incorrectly");
+
+    XCTAssertThrows(([[TSKFunctionTask alloc] initWithName:name function:NULL context:context]), @"NULL function does not throw exception");
+}
+
+
+- (void)testCopy
+{
+    NSString *name = UMKRandomUnicodeString();
+    void *context = (__bridge void *)self;
+    TSKFunctionTask *task = [[TSKFunctionTask alloc] initWithName:name function:TSKFinishTask context:context];
+    TSKFunctionTask *copy = [task copy];
+
+    XCTAssertNotEqual(copy, task, @"copy is the original task");
+    XCTAssertEqualObjects(copy.class, task.class, @"copy has a different class");
+    XCTAssertEqualObjects(copy.name, name, @"name is copied incorrectly");
+    XCTAssertEqual(copy.function, task.function, @"function is copied incorrectly");
+    XCTAssertEqual(copy.context, task.context, @"context is copied incorrectly");
+
+    task = [[TSKFunctionTask alloc] initWithFunction:TSKFinishTask context:NULL];
+    copy = [task copy];
+    XCTAssertEqualObjects(copy.name, [self defaultNameForTask:copy], @"default name is copied");
+}
+
+
+- (void)testMain
+{
+    NSMutableArray *invocations = [[NSMutableArray alloc] init];
+    TSKFunctionTask *task = [[TSKFunctionTask alloc] initWithFunction:TSKRecordTask context:(__bridge void *)invocations];
+
+    XCTAssertEqual(invocations.count, 0, @"function called early");
+    [task main];
+    XCTAssertEqualObjects(invocations, @[ task ], @"function not called with the task");
+}
+
+
+- (void)testFunctionTaskThroughput
+{
+    [self measureThroughputOfTasksCreatedWithFactory:^TSKTask *{
+        return [[TSKFunctionTask alloc] initWithFunction:TSKFinishTask context:NULL];
+    }];
+}
+
+
+- (void)testBlockTaskThroughput
+{
+    [self measureThroughputOfTasksCreatedWithFactory:^TSKTask *{
+        return [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+            [task finishWithResult:nil];
+        }];
+    }];
+}
+
+
+- (void)measureThroughputOfTasksCreatedWithFactory:(TSKTask *(^)(void))taskFactory
+{
+    const NSUInteger taskCount = 10000;
+    [self measureBlock:^{
+        TSKWorkflow *workflow = [[TSKWorkflow alloc] init];
+        for (NSUInteger i = 0; i < taskCount; ++i) {
+            TSKTask *task = taskFactory();
+            task.batchable = YES;
+            [workflow addTask:task prerequisites:nil];
+        }
+
+        [workflow start];
+        XCTAssertEqual([workflow waitUntilFinishedWithTimeout:30 error:NULL], TSKWorkflowOutcomeFinished, @"workflow did not finish");
+    }];
+}
+
+@end
@@ -0,0 +1,262 @@
+//
+//  TSKReduceTaskTestCase.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import "TSKRandomizedTestCase.h"
+
+
+@interface TSKReduceTaskTestCase : TSKRandomizedTestCase
+
+- (void)testInit;
+- (void)testCopy;
+- (void)testReduce;
+- (void)testReduceWithSkippedPrerequisites;
+- (void)testReduceWithSkippedUnconditionalPrerequisite;
+- (void)testReduceWithoutPrerequisites;
+- (void)testReset;
+
+/*!
+ @abstract Returns a sum task with the specified number of prerequisites in the specified workflow.
+ @discussion Each prerequisite finishes with its 1-based position, so the sum of n prerequisites’
+     results is n(n + 1)/2. The block of the returned task counts its invocations in invocationCount.
+ @param prerequisiteCount The number of prerequisites.
+ @param workflow The workflow.
+ @param invocationCount A pointer to the block’s invocation count, which must outlive the task.
+ @result The sum task.
+ */
+- (TSKReduceTask *)sumTaskWithPrerequisiteCount:(NSUInteger)prerequisiteCount
+                                       workflow:(TSKWorkflow *)workflow
+                                invocationCount:(NSUInteger *)invocationCount;
+
+@end
+
+
+@implementation TSKReduceTaskTestCase
+
+- (void)testInit
+{
+    id nilObject = nil;
+    XCTAssertThrows(([[TSKReduceTask alloc] initWithBlock:nilObject]), @"nil block does not throw exception");
+
+    id (^block)(id, id) = ^id(id left, id right) { return left; };
+
+    TSKReduceTask *task = [[TSKReduceTask alloc] initWithBlock:block];
+    XCTAssertNotNil(task, @"returns nil");
+    XCTAssertEqualObjects(task.block, block, @"block is set incorrectly");
+    XCTAssertEqualObjects(task.name, [self defaultNameForTask:task], @"name not set to default");
+
+    NSString *name = UMKRandomUnicodeString();
+    task = [[TSKReduceTask alloc] initWithName:name block:block];
+    XCTAssertNotNil(task, @"returns nil");
+    XCTAssertEqualObjects(task.block, block, @"block is set incorrectly");
+    XCTAssertEqualObjects(task.name, name, @"name is set incorrectly");
+
+    XCTAssertThrows(([[TSKReduceTask alloc] initWithName:name block:nilObject]), @"nil block does not throw exception");
+}
+
+
+- (void)testCopy
+{
+    NSString *name = UMKRandomUnicodeString();
+    TSKReduceTask *task = [[TSKReduceTask alloc] initWithName:name block:^id(id left, id right) { return left; }];
+    TSKReduceTask *copy = [task copy];
+
+    XCTAssertNotEqual(copy, task, @"copy is the original task");
+    XCTAssertEqualObjects(copy.class, task.class, @"copy has a different class");
+    XCTAssertEqualObjects(copy.name, name, @"name is copied incorrectly");
+    XCTAssertEqualObjects(copy.block, task.block, @"block is copied incorrectly");
+}
+
+
+- (TSKReduceTask *)sumTaskWithPrerequisiteCount:(NSUInteger)prerequisiteCount
+                                       workflow:(TSKWorkflow *)workflow
+                                invocationCount:(NSUInteger *)invocationCount
+{
+    NSMutableSet<TSKTask *> *prerequisiteTasks = [[NSMutableSet alloc] initWithCapacity:prerequisiteCount];
+    for (NSUInteger i = 1; i <= prerequisiteCount; ++i) {
+        TSKBlockTask *prerequisiteTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+            [task finishWithResult:@(i)];
+        }];
+
+        [workflow addTask:prerequisiteTask prerequisites:nil];
+        [prerequisiteTasks addObject:prerequisiteTask];
+    }
+
+    NSLock *invocationCountLock = [[NSLock alloc] init];
+    TSKReduceTask *sumTask = [[TSKReduceTask alloc] initWithBlock:^id(NSNumber *left, NSNumber *right) {
+        [invocationCountLock lock];
+        ++*invocationCount;
+        [invocationCountLock unlock];
+        return @(left.unsignedIntegerValue + right.unsignedIntegerValue);
+    }];
+
+    [workflow addTask:sumTask prerequisiteTasks:prerequisiteTasks];
+    return sumTask;
+}
+
+
+- (void)testReduce
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    NSUInteger prerequisiteCount = random() % 1000 + 1000;
+    NSUInteger invocationCount = 0;
+    TSKReduceTask *sumTask = [self sumTaskWithPrerequisiteCount:prerequisiteCount workflow:workflow invocationCount:&invocationCount];
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:sumTask];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+
+    XCTAssertEqualObjects(sumTask.result, @(prerequisiteCount * (prerequisiteCount + 1) / 2), @"result is incorrect");
+    XCTAssertEqual(invocationCount, prerequisiteCount - 1, @"block invoked incorrect number of times");
+
+    // Invalidating a prerequisite recomputes the reduction with its new result
+    invocationCount = 0;
+    TSKTask *prerequisiteTask = [sumTask.prerequisiteTasks anyObject];
+    [self expectationForNotification:TSKTaskDidFinishNotification task:sumTask];
+    [prerequisiteTask invalidate];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+
+    XCTAssertEqualObjects(sumTask.result, @(prerequisiteCount * (prerequisiteCount + 1) / 2), @"result is incorrect after invalidation");
+    XCTAssertEqual(invocationCount, prerequisiteCount - 1, @"block invoked incorrect number of times after invalidation");
+}
+
+
+- (void)testReduceWithSkippedPrerequisites
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+
+    TSKTask *includedTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        [task finishWithResult:@3];
+    }];
+
+    TSKTask *conditionalTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        [task finishWithResult:@5];
+    }];
+
+    TSKTask *skippedTask = [self finishingTaskWithLock:nil];
+    [workflow addTask:includedTask prerequisites:nil];
+    [workflow addTask:conditionalTask prerequisites:nil];
+    [workflow addTask:skippedTask prerequisites:nil];
+
+    __block NSUInteger invocationCount = 0;
+    TSKReduceTask *sumTask = [[TSKReduceTask alloc] initWithBlock:^id(NSNumber *left, NSNumber *right) {
+        ++invocationCount;
+        return @(left.integerValue + right.integerValue);
+    }];
+
+    sumTask.runsWhenPrerequisitesSkipped = YES;
+    [workflow addTask:sumTask
+        conditionalPrerequisiteTask:conditionalTask
+                          condition:^BOOL(id result) { return NO; }
+                  prerequisiteTasks:[NSSet setWithObjects:includedTask, skippedTask, nil]];
+
+    [skippedTask skip];
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:sumTask];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    // Only the included task contributed, so there was nothing to combine it with
+    XCTAssertEqualObjects(sumTask.result, @3, @"result is incorrect");
+    XCTAssertEqual(invocationCount, 0, @"block invoked for skipped prerequisites");
+}
+
+
+- (void)testReduceWithSkippedUnconditionalPrerequisite
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+
+    // Without a conditional prerequisite, nothing but the finishing prerequisite checks whether the
+    // sum task is ready, so the skipped one must not stop it from being checked
+    TSKTask *includedTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        [task finishWithResult:@3];
+    }];
+
+    TSKTask *skippedTask = [self finishingTaskWithLock:nil];
+    [workflow addTask:includedTask prerequisites:nil];
+    [workflow addTask:skippedTask prerequisites:nil];
+
+    TSKReduceTask *sumTask = [[TSKReduceTask alloc] initWithBlock:^id(NSNumber *left, NSNumber *right) {
+        return @(left.integerValue + right.integerValue);
+    }];
+
+    sumTask.runsWhenPrerequisitesSkipped = YES;
+    [workflow addTask:sumTask prerequisites:skippedTask, includedTask, nil];
+
+    [skippedTask skip];
+    XCTAssertEqual(sumTask.state, TSKTaskStatePending, @"sum task is not pending");
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:sumTask];
+    [includedTask start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertEqualObjects(sumTask.result, @3, @"result is incorrect");
+}
+
+
+- (void)testReduceWithoutPrerequisites
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    TSKReduceTask *task = [[TSKReduceTask alloc] initWithBlock:^id(id left, id right) {
+        XCTFail(@"block invoked without prerequisites");
+        return nil;
+    }];
+
+    [workflow addTask:task prerequisites:nil];
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:task];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+    XCTAssertNil(task.result, @"result is non-nil");
+}
+
+
+- (void)testReset
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    NSUInteger prerequisiteCount = random() % 100 + 100;
+    NSUInteger invocationCount = 0;
+    TSKReduceTask *sumTask = [self sumTaskWithPrerequisiteCount:prerequisiteCount workflow:workflow invocationCount:&invocationCount];
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:sumTask];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+
+    [self expectationForNotification:TSKTaskDidResetNotification task:sumTask];
+    [workflow reset];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+    XCTAssertNil(sumTask.result, @"result is non-nil after reset");
+
+    invocationCount = 0;
+    [self expectationForNotification:TSKTaskDidFinishNotification task:sumTask];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+
+    XCTAssertEqualObjects(sumTask.result, @(prerequisiteCount * (prerequisiteCount + 1) / 2), @"result is incorrect after reset");
+    XCTAssertEqual(invocationCount, prerequisiteCount - 1, @"block invoked incorrect number of times after reset");
+}
+
+@end
@@ -35,6 +35,7 @@
 - (void)testCancel;
 - (void)testReset;
 - (void)testRetry;
+- (void)testCancellationToken;
 
 - (void)testSubworkflowFinishesBefore;
 - (void)testSubworkflowFinishesAfter;
@@ -172,6 +173,35 @@
 }
 
 
+- (void)testCancellationToken
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    TSKWorkflow *subworkflow = [self workflowForNotificationTesting];
+
+    XCTestExpectation *subtaskTokenCancelledExpectation = [self expectationWithDescription:@"subtask token cancelled"];
+    TSKTestTask *subtask = [[TSKTestTask alloc] initWithBlock:^(TSKTask *task) {
+        [task.cancellationToken addCancellationHandler:^{
+            [subtaskTokenCancelledExpectation fulfill];
+        }];
+    }];
+    [subworkflow addTask:subtask prerequisites:nil];
+
+    TSKSubworkflowTask *task = [[TSKSubworkflowTask alloc] initWithSubworkflow:subworkflow];
+    [workflow addTask:task prerequisites:nil];
+
+    XCTestExpectation *subtaskDidStartExpectation = [self expectationForNotification:TSKTaskDidStartNotification task:subtask];
+    [task start];
+    [self waitForExpectations:@[ subtaskDidStartExpectation ] timeout:1];
+    XCTAssertEqual(subworkflow.cancellationToken, task.cancellationToken, @"token is not forwarded to subworkflow");
+    XCTAssertEqual(subtask.cancellationToken.parentToken, task.cancellationToken, @"subtask token’s parent is incorrect");
+
+    // Failing the subworkflow task from outside the subworkflow stops the subtask’s work
+    [task failWithError:UMKRandomError()];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+    XCTAssertTrue(subtask.cancellationToken.isCancelled, @"subtask token is not cancelled");
+}
+
+
 - (void)testSubworkflowFinishesBefore
 {
     // Run the empty subworkflow before starting the subworkflow task
@@ -72,13 +72,22 @@
 - (void)testWorkflow;
 - (void)testStart;
 - (void)testOperationQueue;
+- (void)testExecutionClass;
+- (void)testDeadline;
+- (void)testCopy;
 
 - (void)testFinish;
 - (void)testFail;
 - (void)testRetry;
 - (void)testCancelAndFinish;
 - (void)testCancelAndFail;
+- (void)testCancellationToken;
+- (void)testTimeout;
+- (void)testWaitUntilFinished;
 - (void)testReset;
+- (void)testInvalidate;
+- (void)testInvalidateWithUnfinishedDependents;
+- (void)testInvalidateLongChain;
 
 - (void)testTaskDelegateFinish;
 - (void)testTaskDelegateFail;
@@ -205,6 +214,198 @@
 }
 
 
+- (void)testExecutionClass
+{
+    NSOperationQueue *operationQueue = [[NSOperationQueue alloc] init];
+    TSKWorkflow *workflow = [[TSKWorkflow alloc] initWithOperationQueue:operationQueue];
+
+    NSOperationQueue *batchQueue = [[NSOperationQueue alloc] init];
+    batchQueue.maxConcurrentOperationCount = 1;
+    batchQueue.qualityOfService = NSQualityOfServiceUtility;
+    [workflow setOperationQueue:batchQueue forExecutionClass:TSKExecutionClassBatch];
+
+    XCTAssertEqualObjects([workflow operationQueueForExecutionClass:nil], operationQueue, @"nil execution class has incorrect queue");
+    XCTAssertEqualObjects([workflow operationQueueForExecutionClass:TSKExecutionClassBatch], batchQueue, @"execution class has incorrect queue");
+    XCTAssertEqualObjects([workflow operationQueueForExecutionClass:TSKExecutionClassLatencyCritical], operationQueue,
+                          @"unregistered execution class has incorrect queue");
+
+    XCTestExpectation *batchTaskDidRunExpectation = [self expectationWithDescription:@"batch task did run"];
+    TSKBlockTask *batchTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        XCTAssertEqualObjects(batchQueue, [NSOperationQueue currentQueue], @"task not executing on correct queue");
+        [batchTaskDidRunExpectation fulfill];
+        [task finishWithResult:nil];
+    }];
+
+    batchTask.executionClass = TSKExecutionClassBatch;
+
+    XCTestExpectation *defaultTaskDidRunExpectation = [self expectationWithDescription:@"default task did run"];
+    TSKBlockTask *defaultTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        XCTAssertEqualObjects(operationQueue, [NSOperationQueue currentQueue], @"task not executing on correct queue");
+        [defaultTaskDidRunExpectation fulfill];
+        [task finishWithResult:nil];
+    }];
+
+    [workflow addTask:batchTask prerequisites:nil];
+    [workflow addTask:defaultTask prerequisites:nil];
+    XCTAssertEqualObjects(batchTask.operationQueue, batchQueue, @"task has incorrect queue");
+    XCTAssertEqualObjects(defaultTask.operationQueue, operationQueue, @"task has incorrect queue");
+
+    [workflow start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    // The workflow’s execution class applies to tasks without one of their own
+    workflow.executionClass = TSKExecutionClassBatch;
+    XCTAssertEqualObjects(defaultTask.operationQueue, batchQueue, @"task does not use workflow’s execution class");
+
+    // An explicitly set queue always wins
+    NSOperationQueue *explicitQueue = [[NSOperationQueue alloc] init];
+    batchTask.operationQueue = explicitQueue;
+    XCTAssertEqualObjects(batchTask.operationQueue, explicitQueue, @"explicit queue not used");
+
+    [workflow setOperationQueue:nil forExecutionClass:TSKExecutionClassBatch];
+    XCTAssertEqualObjects(defaultTask.operationQueue, operationQueue, @"removed execution class queue still used");
+}
+
+
+- (void)testDeadline
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+
+    // A task whose deadline has passed fails without executing
+    __block BOOL mainInvoked = NO;
+    TSKBlockTask *lateTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        mainInvoked = YES;
+        [task finishWithResult:nil];
+    }];
+
+    lateTask.deadline = [NSDate dateWithTimeIntervalSinceNow:-1];
+    [workflow addTask:lateTask prerequisites:nil];
+
+    [self expectationForNotification:TSKTaskDidFailNotification task:lateTask];
+    [lateTask start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertFalse(mainInvoked, @"main invoked after deadline passed");
+    XCTAssertEqualObjects(lateTask.error.domain, TSKTaskErrorDomain, @"error domain is incorrect");
+    XCTAssertEqual(lateTask.error.code, TSKErrorCodeDeadlineCannotBeMet, @"error code is incorrect");
+
+    // A task whose histogram says it can’t finish in time fails too, as does one that inherits its
+    // workflow’s deadline
+    TSKDurationHistogram *slowHistogram = [[TSKDurationHistogram alloc] init];
+    [slowHistogram recordDuration:60];
+
+    TSKTestTask *slowTask = [[TSKTestTask alloc] init];
+    slowTask.durationHistogram = slowHistogram;
+    slowTask.deadline = [NSDate dateWithTimeIntervalSinceNow:30];
+    [workflow addTask:slowTask prerequisites:nil];
+
+    workflow.deadline = [NSDate dateWithTimeIntervalSinceNow:-1];
+    TSKTestTask *workflowDeadlineTask = [[TSKTestTask alloc] init];
+    [workflow addTask:workflowDeadlineTask prerequisites:nil];
+
+    [self expectationForNotification:TSKTaskDidFailNotification task:slowTask];
+    [self expectationForNotification:TSKTaskDidFailNotification task:workflowDeadlineTask];
+    [slowTask start];
+    [workflowDeadlineTask start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+    XCTAssertEqual(slowTask.error.code, TSKErrorCodeDeadlineCannotBeMet, @"error code is incorrect");
+    XCTAssertEqual(workflowDeadlineTask.error.code, TSKErrorCodeDeadlineCannotBeMet, @"workflow deadline not inherited");
+
+    workflow.deadline = nil;
+
+    // Without a histogram of its own, a task uses the durations its workflow recorded for its name
+    NSString *slowName = UMKRandomAlphanumericString();
+    workflow.durationStatistics = [[TSKDurationStatistics alloc] init];
+    [workflow.durationStatistics recordDuration:60 forTaskName:slowName];
+
+    TSKTask *namedSlowTask = [[TSKTask alloc] initWithName:slowName];
+    namedSlowTask.deadline = [NSDate dateWithTimeIntervalSinceNow:30];
+    [workflow addTask:namedSlowTask prerequisites:nil];
+
+    [self expectationForNotification:TSKTaskDidFailNotification task:namedSlowTask];
+    [namedSlowTask start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+    XCTAssertEqual(namedSlowTask.error.code, TSKErrorCodeDeadlineCannotBeMet, @"workflow’s duration statistics not used");
+
+    workflow.durationStatistics = nil;
+
+    // A task that can meet its deadline runs and records its duration
+    TSKDurationHistogram *fastHistogram = [[TSKDurationHistogram alloc] init];
+    [fastHistogram recordDuration:0.001];
+
+    TSKTestTask *fastTask = [self finishingTaskWithLock:nil];
+    fastTask.durationHistogram = fastHistogram;
+    fastTask.deadline = [NSDate dateWithTimeIntervalSinceNow:30];
+    [workflow addTask:fastTask prerequisites:nil];
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:fastTask];
+    [fastTask start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+    XCTAssertEqual(fastHistogram.count, 2, @"duration not recorded");
+}
+
+
+- (void)testCopy
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    TSKTestTaskDelegate *delegate = [[TSKTestTaskDelegate alloc] init];
+    NSOperationQueue *operationQueue = [[NSOperationQueue alloc] init];
+    TSKExecutionClass executionClass = UMKRandomUnicodeString();
+    TSKDurationHistogram *durationHistogram = [[TSKDurationHistogram alloc] init];
+    TSKRetryPolicy *retryPolicy = [[TSKRetryPolicy alloc] init];
+
+    TSKTask *task = [[TSKTask alloc] initWithName:UMKRandomUnicodeString()];
+    task.delegate = delegate;
+    task.operationQueue = operationQueue;
+    task.executionClass = executionClass;
+    task.batchable = YES;
+    task.durationHistogram = durationHistogram;
+    task.retryPolicy = retryPolicy;
+    task.resultEqualityTest = ^BOOL(id previousResult, id result) { return YES; };
+    task.runsWhenPrerequisitesSkipped = YES;
+    task.timeout = 30;
+    task.deadline = [NSDate dateWithTimeIntervalSinceNow:60];
+    [workflow addTask:task prerequisites:nil];
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:task];
+    [task start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    TSKTask *copy = [task copy];
+    XCTAssertNotEqual(copy, task, @"copy is the original task");
+    XCTAssertEqualObjects(copy.class, task.class, @"copy has a different class");
+    XCTAssertEqualObjects(copy.name, task.name, @"name is copied incorrectly");
+    XCTAssertEqual(copy.delegate, delegate, @"delegate is copied incorrectly");
+    XCTAssertEqual(copy.operationQueue, operationQueue, @"operationQueue is copied incorrectly");
+    XCTAssertEqualObjects(copy.executionClass, executionClass, @"executionClass is copied incorrectly");
+    XCTAssertTrue(copy.isBatchable, @"batchable is copied incorrectly");
+    XCTAssertEqual(copy.durationHistogram, durationHistogram, @"durationHistogram is copied incorrectly");
+    XCTAssertEqual(copy.retryPolicy, retryPolicy, @"retryPolicy is copied incorrectly");
+    XCTAssertEqualObjects(copy.resultEqualityTest, task.resultEqualityTest, @"resultEqualityTest is copied incorrectly");
+    XCTAssertTrue(copy.runsWhenPrerequisitesSkipped, @"runsWhenPrerequisitesSkipped is copied incorrectly");
+    XCTAssertEqual(copy.timeout, task.timeout, @"timeout is copied incorrectly");
+    XCTAssertNil(copy.deadline, @"deadline is copied");
+    XCTAssertNil(copy.workflow, @"copy is in a workflow");
+    XCTAssertEqual(copy.state, TSKTaskStateReady, @"copy is not ready");
+    XCTAssertNil(copy.result, @"copy has a result");
+
+    // Default names are not copied, since they include the task’s address
+    TSKTask *unnamedTask = [[TSKTask alloc] init];
+    TSKTask *unnamedCopy = [unnamedTask copy];
+    XCTAssertEqualObjects(unnamedCopy.name, [self defaultNameForTask:unnamedCopy], @"name not set to default");
+
+    // Subclasses copy their own configuration
+    NSSet *requiredPrerequisiteKeys = [NSSet setWithObject:UMKRandomUnicodeString()];
+    void (^block)(TSKTask *) = ^void(TSKTask *task) { };
+    TSKBlockTask *blockTask = [[TSKBlockTask alloc] initWithName:UMKRandomUnicodeString() requiredPrerequisiteKeys:requiredPrerequisiteKeys block:block];
+    TSKBlockTask *blockTaskCopy = [blockTask copy];
+    XCTAssertEqualObjects(blockTaskCopy.class, [TSKBlockTask class], @"copy has a different class");
+    XCTAssertEqualObjects(blockTaskCopy.block, block, @"block is copied incorrectly");
+    XCTAssertEqualObjects(blockTaskCopy.requiredPrerequisiteKeys, requiredPrerequisiteKeys, @"requiredPrerequisiteKeys is copied incorrectly");
+    XCTAssertEqualObjects(blockTaskCopy.name, blockTask.name, @"name is copied incorrectly");
+}
+
+
 - (void)testName
 {
     TSKTask *task = [[TSKTask alloc] init];
@@ -373,6 +574,163 @@
 }
 
 
+- (void)testCancellationToken
+{
+    __block BOOL handlerRan = NO;
+    XCTestExpectation *handlerAddedExpectation = [self expectationWithDescription:@"handler added"];
+    XCTestExpectation *loopExitedExpectation = [self expectationWithDescription:@"loop exited"];
+    TSKTestTask *task = [[TSKTestTask alloc] initWithBlock:^(TSKTask *task) {
+        TSKCancellationToken *token = task.cancellationToken;
+        [token addCancellationHandler:^{
+            handlerRan = YES;
+        }];
+        [handlerAddedExpectation fulfill];
+
+        while (!token.isCancelled) {
+            usleep(1000);
+        }
+
+        [loopExitedExpectation fulfill];
+    }];
+
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    [workflow addTask:task prerequisites:nil];
+    XCTAssertNil(task.cancellationToken, @"cancellationToken is non-nil before execution");
+
+    [task start];
+    [self waitForExpectations:@[ handlerAddedExpectation ] timeout:1];
+
+    TSKCancellationToken *token = task.cancellationToken;
+    XCTAssertNotNil(token, @"cancellationToken is nil during execution");
+    XCTAssertFalse(token.isCancelled, @"token is cancelled during execution");
+
+    // Handlers run before the cancellation is reported
+    [self expectationForNotification:TSKTaskDidCancelNotification object:task handler:^BOOL(NSNotification *notification) {
+        XCTAssertTrue(handlerRan, @"handler did not run before cancellation was reported");
+        return YES;
+    }];
+
+    [task cancel];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+    XCTAssertTrue(token.isCancelled, @"token is not cancelled");
+
+    // Finishing does not cancel the token, and each execution gets a new one
+    TSKTestTask *finishingTask = [self finishingTaskWithLock:nil];
+    [workflow addTask:finishingTask prerequisites:nil];
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:finishingTask];
+    [finishingTask start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    TSKCancellationToken *firstToken = finishingTask.cancellationToken;
+    XCTAssertNotNil(firstToken, @"cancellationToken is nil after execution");
+    XCTAssertFalse(firstToken.isCancelled, @"finishing cancelled the token");
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:finishingTask];
+    [finishingTask reset];
+    [finishingTask start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+    XCTAssertNotEqual(finishingTask.cancellationToken, firstToken, @"token was not replaced for new execution");
+
+    // Workflow tokens are the parents of their tasks’ tokens
+    workflow.cancellationToken = [[TSKCancellationToken alloc] init];
+    [self expectationForNotification:TSKTaskDidFinishNotification task:finishingTask];
+    [finishingTask reset];
+    [finishingTask start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+    XCTAssertEqual(finishingTask.cancellationToken.parentToken, workflow.cancellationToken, @"token’s parent is incorrect");
+}
+
+
+- (void)testTimeout
+{
+    TSKTestTask *task = [[TSKTestTask alloc] initWithBlock:^(TSKTask *task) {
+        while (!task.cancellationToken.isCancelled) {
+            usleep(1000);
+        }
+    }];
+
+    XCTAssertEqual(task.timeout, 0, @"timeout is non-zero by default");
+    task.timeout = 0.05;
+
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    [workflow addTask:task prerequisites:nil];
+
+    [self expectationForNotification:TSKTaskDidFailNotification task:task];
+    [task start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertEqualObjects(task.error.domain, TSKTaskErrorDomain, @"error domain is incorrect");
+    XCTAssertEqual(task.error.code, TSKErrorCodeTimedOut, @"error code is incorrect");
+    XCTAssertTrue(task.cancellationToken.isCancelled, @"token is not cancelled after timing out");
+
+    // Tasks that finish before their timeout are unaffected by it
+    TSKTestTask *finishingTask = [self finishingTaskWithLock:nil];
+    finishingTask.timeout = 0.05;
+    [workflow addTask:finishingTask prerequisites:nil];
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:finishingTask];
+    [finishingTask start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTestExpectation *timeoutElapsedExpectation = [self expectationWithDescription:@"timeout elapsed"];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.15 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [timeoutElapsedExpectation fulfill];
+    });
+
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+    XCTAssertTrue(finishingTask.isFinished, @"task is not finished after its timeout elapsed");
+}
+
+
+- (void)testWaitUntilFinished
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    NSLock *lock = [[NSLock alloc] init];
+    TSKTestTask *task = [self finishingTaskWithLock:lock];
+    [workflow addTask:task prerequisites:nil];
+
+    // Timing out
+    XCTAssertEqual([task waitUntilFinishedWithTimeout:0.01], TSKTaskStateReady, @"wait did not time out");
+
+    // Finishing; the result is set by the time the wait returns
+    id result = UMKRandomUnicodeString();
+    TSKTestTask *resultTask = [[TSKTestTask alloc] initWithBlock:^(TSKTask *task) {
+        usleep(10000);
+        [task finishWithResult:result];
+    }];
+
+    [workflow addTask:resultTask prerequisites:nil];
+    [resultTask start];
+    XCTAssertEqual([resultTask waitUntilFinishedWithTimeout:1], TSKTaskStateFinished, @"state is incorrect");
+    XCTAssertEqualObjects(resultTask.result, result, @"result is not set");
+
+    // Tasks that are already done return immediately
+    XCTAssertEqual([resultTask waitUntilFinishedWithTimeout:0], TSKTaskStateFinished, @"state is incorrect");
+
+    // Failing
+    NSError *error = UMKRandomError();
+    TSKTestTask *failingTask = [[TSKTestTask alloc] initWithBlock:^(TSKTask *task) {
+        [task failWithError:error];
+    }];
+
+    [workflow addTask:failingTask prerequisites:nil];
+    [failingTask start];
+    XCTAssertEqual([failingTask waitUntilFinishedWithTimeout:1], TSKTaskStateFailed, @"state is incorrect");
+    XCTAssertEqualObjects(failingTask.error, error, @"error is not set");
+
+    // Cancelling from another thread while waiting
+    [lock lock];
+    [task start];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.05 * NSEC_PER_SEC)), dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+        [task cancel];
+    });
+
+    XCTAssertEqual([task waitUntilFinishedWithTimeout:1], TSKTaskStateCancelled, @"state is incorrect");
+    [lock unlock];
+}
+
+
 - (void)testCancelAndFail
 {
     NSLock *didCancelLock = [[NSLock alloc] init];
@@ -498,6 +856,222 @@
 }
 
 
+- (void)testInvalidate
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    BOOL (^isEqualTest)(id, id) = ^BOOL(id previousResult, id result) {
+        return [previousResult isEqual:result];
+    };
+
+    // input -> doubled -> described, plus an independent task that depends on input
+    __block NSInteger inputValue = 1;
+    __block NSUInteger inputCount = 0, doubledCount = 0, describedCount = 0, independentCount = 0;
+    TSKBlockTask *inputTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        ++inputCount;
+        [task finishWithResult:@(inputValue)];
+    }];
+
+    TSKBlockTask *doubledTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        ++doubledCount;
+        [task finishWithResult:@([[task anyPrerequisiteResult] integerValue] * 2)];
+    }];
+
+    TSKBlockTask *describedTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        ++describedCount;
+        [task finishWithResult:[[task anyPrerequisiteResult] description]];
+    }];
+
+    TSKBlockTask *independentTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        ++independentCount;
+        [task finishWithResult:nil];
+    }];
+
+    inputTask.resultEqualityTest = isEqualTest;
+    doubledTask.resultEqualityTest = isEqualTest;
+    [workflow addTask:inputTask prerequisites:nil];
+    [workflow addTask:doubledTask prerequisites:inputTask, nil];
+    [workflow addTask:describedTask prerequisites:doubledTask, nil];
+    [workflow addTask:independentTask prerequisites:nil];
+
+    // Invalidating a task that isn’t finished does nothing
+    [inputTask invalidate];
+    XCTAssertEqual(inputTask.state, TSKTaskStateReady, @"unfinished task was invalidated");
+
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+    XCTAssertEqualObjects(describedTask.result, @"2", @"result is incorrect");
+
+    // If the input’s result doesn’t change, only the input executes again
+    [self expectationForNotification:TSKTaskDidInvalidateNotification task:describedTask];
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    [inputTask invalidate];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertEqual(inputCount, 2, @"invalidated task did not execute again");
+    XCTAssertEqual(doubledCount, 1, @"dependent executed although its prerequisite’s result did not change");
+    XCTAssertEqual(describedCount, 1, @"dependent executed although its prerequisite’s result did not change");
+    XCTAssertEqual(independentCount, 1, @"unrelated task executed again");
+    XCTAssertTrue(doubledTask.isFinished, @"dependent is not finished");
+    XCTAssertEqualObjects(doubledTask.result, @2, @"dependent’s previous result was not kept");
+    XCTAssertEqualObjects(describedTask.result, @"2", @"dependent’s previous result was not kept");
+
+    // If the input’s result changes, its dependents execute again
+    inputValue = 5;
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    [inputTask invalidate];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertEqual(inputCount, 3, @"invalidated task did not execute again");
+    XCTAssertEqual(doubledCount, 2, @"dependent did not execute again");
+    XCTAssertEqual(describedCount, 2, @"dependent did not execute again");
+    XCTAssertEqual(independentCount, 1, @"unrelated task executed again");
+    XCTAssertEqualObjects(describedTask.result, @"10", @"result is incorrect");
+
+    // Without an equality test, results are always considered changed
+    inputTask.resultEqualityTest = nil;
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    [inputTask invalidate];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertEqual(doubledCount, 3, @"dependent did not execute again");
+    XCTAssertEqual(describedCount, 2, @"dependent executed although its prerequisite’s result did not change");
+}
+
+
+- (void)testInvalidateWithUnfinishedDependents
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+
+    // The input only executes again once the test allows it, so that the dependents’ states can be
+    // checked while it is pending
+    __block NSInteger inputValue = 1;
+    __block NSUInteger inputCount = 0;
+    dispatch_semaphore_t inputSemaphore = dispatch_semaphore_create(0);
+    TSKBlockTask *inputTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        if (++inputCount > 1) {
+            dispatch_semaphore_wait(inputSemaphore, DISPATCH_TIME_FOREVER);
+        }
+
+        [task finishWithResult:@(inputValue)];
+    }];
+
+    // The ready dependent’s operation queue is suspended, so it stays ready until the test resumes it
+    NSOperationQueue *suspendedQueue = [[NSOperationQueue alloc] init];
+    suspendedQueue.suspended = YES;
+    __block NSUInteger readyCount = 0;
+    TSKBlockTask *readyDependent = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        ++readyCount;
+        [task finishWithResult:[task anyPrerequisiteResult]];
+    }];
+
+    readyDependent.operationQueue = suspendedQueue;
+
+    // The executing dependent’s first execution runs until it is cancelled and then reports a stale result
+    __block NSUInteger executingCount = 0;
+    XCTestExpectation *staleExecutionDidEndExpectation = [self expectationWithDescription:@"stale execution did end"];
+    TSKBlockTask *executingDependent = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        if (++executingCount == 1) {
+            dispatch_semaphore_t cancellationSemaphore = dispatch_semaphore_create(0);
+            [task.cancellationToken addCancellationHandler:^{
+                dispatch_semaphore_signal(cancellationSemaphore);
+            }];
+
+            dispatch_semaphore_wait(cancellationSemaphore, DISPATCH_TIME_FOREVER);
+            [task finishWithResult:@"stale"];
+            [staleExecutionDidEndExpectation fulfill];
+            return;
+        }
+
+        [task finishWithResult:[task anyPrerequisiteResult]];
+    }];
+
+    [workflow addTask:inputTask prerequisites:nil];
+    [workflow addTask:readyDependent prerequisites:inputTask, nil];
+    [workflow addTask:executingDependent prerequisites:inputTask, nil];
+
+    [self expectationForPredicate:[NSPredicate predicateWithFormat:@"state == %ld", (long)TSKTaskStateReady]
+              evaluatedWithObject:readyDependent
+                          handler:nil];
+    [self expectationForPredicate:[NSPredicate predicateWithFormat:@"state == %ld", (long)TSKTaskStateExecuting]
+              evaluatedWithObject:executingDependent
+                          handler:nil];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    // Both dependents would otherwise use the invalidated result, so they go back to pending
+    TSKCancellationToken *executionToken = executingDependent.cancellationToken;
+    inputValue = 2;
+    [inputTask invalidate];
+
+    XCTAssertEqual(readyDependent.state, TSKTaskStatePending, @"ready dependent was not invalidated");
+    XCTAssertEqual(executingDependent.state, TSKTaskStatePending, @"executing dependent was not invalidated");
+    XCTAssertTrue(executionToken.isCancelled, @"executing dependent’s cancellation token was not cancelled");
+
+    [self waitForExpectations:@[ staleExecutionDidEndExpectation ] timeout:1];
+    XCTAssertEqual(executingDependent.state, TSKTaskStatePending, @"stale result was accepted");
+
+    // Once the input finishes again, each dependent executes with its new result
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    suspendedQueue.suspended = NO;
+    dispatch_semaphore_signal(inputSemaphore);
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertEqual(readyCount, 1, @"ready dependent executed incorrect number of times");
+    XCTAssertEqual(executingCount, 2, @"executing dependent executed incorrect number of times");
+    XCTAssertEqualObjects(readyDependent.result, @2, @"ready dependent used invalidated result");
+    XCTAssertEqualObjects(executingDependent.result, @2, @"executing dependent used invalidated result");
+}
+
+
+- (void)testInvalidateLongChain
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    BOOL (^isEqualTest)(id, id) = ^BOOL(id previousResult, id result) {
+        return [previousResult isEqual:result];
+    };
+
+    // A chain long enough that invalidating or finishing it one stack frame per task would overflow
+    // the stack. Each task executes after its prerequisite finishes, so the counts need no lock.
+    const NSUInteger chainLength = 10000;
+    __block NSUInteger headCount = 0, dependentCount = 0;
+    TSKBlockTask *headTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        ++headCount;
+        [task finishWithResult:@1];
+    }];
+
+    headTask.resultEqualityTest = isEqualTest;
+    [workflow addTask:headTask prerequisites:nil];
+
+    TSKTask *tailTask = headTask;
+    for (NSUInteger i = 1; i < chainLength; ++i) {
+        TSKBlockTask *dependentTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+            ++dependentCount;
+            [task finishWithResult:[task anyPrerequisiteResult]];
+        }];
+
+        dependentTask.resultEqualityTest = isEqualTest;
+        [workflow addTask:dependentTask prerequisites:tailTask, nil];
+        tailTask = dependentTask;
+    }
+
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+    XCTAssertEqual(dependentCount, chainLength - 1, @"dependents executed incorrect number of times");
+
+    // The head’s result doesn’t change, so every dependent finishes with its previous result
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    [headTask invalidate];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+
+    XCTAssertEqual(headCount, 2, @"invalidated task did not execute again");
+    XCTAssertEqual(dependentCount, chainLength - 1, @"dependent executed although its prerequisite’s result did not change");
+    XCTAssertTrue(tailTask.isFinished, @"last task in chain is not finished");
+    XCTAssertEqualObjects(tailTask.result, @1, @"last task’s previous result was not kept");
+}
+
+
 - (void)testTaskDelegateFinish
 {
     NSString *result = UMKRandomUnicodeString();
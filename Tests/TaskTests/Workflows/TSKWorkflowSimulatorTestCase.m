@@ -0,0 +1,201 @@
+//
+//  TSKWorkflowSimulatorTestCase.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TSKRandomizedTestCase.h"
+
+
+@interface TSKWorkflowSimulatorTestCase : TSKRandomizedTestCase
+
+- (void)testInit;
+- (void)testMakespan;
+- (void)testPolicies;
+- (void)testDurationStatistics;
+- (void)testLargeWorkflow;
+
+@end
+
+
+@implementation TSKWorkflowSimulatorTestCase
+
+/*! Returns a simulator whose duration estimates are the task names parsed as numbers. */
+- (TSKWorkflowSimulator *)simulatorForWorkflow:(TSKWorkflow *)workflow
+{
+    return [[TSKWorkflowSimulator alloc] initWithWorkflow:workflow durationEstimator:^NSTimeInterval(TSKTask *task) {
+        return task.name.doubleValue;
+    }];
+}
+
+
+- (void)testInit
+{
+    XCTAssertThrows(([[TSKWorkflowSimulator alloc] initWithWorkflow:nil durationEstimator:^NSTimeInterval(TSKTask *task) { return 0; }]),
+                    @"nil workflow does not throw exception");
+
+    TSKWorkflow *workflow = [[TSKWorkflow alloc] init];
+    TSKWorkflowSimulator *simulator = [self simulatorForWorkflow:workflow];
+    XCTAssertNotNil(simulator, @"returns nil");
+    XCTAssertEqual(simulator.workflow, workflow, @"workflow is set incorrectly");
+    XCTAssertEqual(simulator.taskCount, 0, @"taskCount is non-zero");
+
+    TSKWorkflowSimulationResult *result = [simulator simulateWithWorkerCount:1 policy:TSKSimulationPolicyFirstInFirstOut];
+    XCTAssertEqual(result.makespan, 0, @"empty workflow has non-zero makespan");
+    XCTAssertEqual(result.utilization, 0, @"empty workflow has non-zero utilization");
+    XCTAssertEqualObjects(result.criticalPath, @[], @"empty workflow has a critical path");
+
+    XCTAssertThrows([simulator simulateWithWorkerCount:0 policy:TSKSimulationPolicyFirstInFirstOut], @"zero workers does not throw exception");
+}
+
+
+- (void)testMakespan
+{
+    // A diamond with durations 1, 5, 2, and 1 plus an independent task with duration 3
+    TSKWorkflow *workflow = [[TSKWorkflow alloc] init];
+    TSKTask *top = [[TSKTask alloc] initWithName:@"1"];
+    TSKTask *left = [[TSKTask alloc] initWithName:@"5"];
+    TSKTask *right = [[TSKTask alloc] initWithName:@"2"];
+    TSKTask *bottom = [[TSKTask alloc] initWithName:@"1"];
+    TSKTask *independent = [[TSKTask alloc] initWithName:@"3"];
+    [workflow addTask:top prerequisites:nil];
+    [workflow addTask:left prerequisites:top, nil];
+    [workflow addTask:right prerequisites:top, nil];
+    [workflow addTask:bottom prerequisites:left, right, nil];
+    [workflow addTask:independent prerequisites:nil];
+
+    TSKWorkflowSimulator *simulator = [self simulatorForWorkflow:workflow];
+    XCTAssertEqual(simulator.taskCount, 5, @"taskCount is incorrect");
+
+    // Tasks added after the simulator is created are not simulated
+    [workflow addTask:[[TSKTask alloc] initWithName:@"100"] prerequisites:nil];
+
+    TSKWorkflowSimulationResult *result = [simulator simulateWithWorkerCount:1 policy:TSKSimulationPolicyFirstInFirstOut];
+    XCTAssertEqual(result.workerCount, 1, @"workerCount is incorrect");
+    XCTAssertEqual(result.policy, TSKSimulationPolicyFirstInFirstOut, @"policy is incorrect");
+    XCTAssertEqualWithAccuracy(result.makespan, 12, 1e-9, @"single worker makespan is incorrect");
+    XCTAssertEqualWithAccuracy(result.utilization, 1, 1e-9, @"single worker utilization is incorrect");
+
+    NSArray *criticalPath = @[ top, left, bottom ];
+    XCTAssertEqualWithAccuracy(result.criticalPathDuration, 7, 1e-9, @"criticalPathDuration is incorrect");
+    XCTAssertEqualObjects(result.criticalPath, criticalPath, @"criticalPath is incorrect");
+
+    // With enough workers, the makespan is the critical path duration
+    for (NSUInteger workerCount = 2; workerCount <= 10; ++workerCount) {
+        result = [simulator simulateWithWorkerCount:workerCount policy:TSKSimulationPolicyLongestPathFirst];
+        XCTAssertEqualWithAccuracy(result.makespan, 7, 1e-9, @"makespan with %lu workers is incorrect", (unsigned long)workerCount);
+        XCTAssertEqualWithAccuracy(result.utilization, 12.0 / (7 * workerCount), 1e-9, @"utilization is incorrect");
+    }
+}
+
+
+- (void)testPolicies
+{
+    // Three short tasks, the last of which gates a long one. FIFO runs the first two short tasks
+    // first and delays the long task; longest path first starts the gating task immediately.
+    TSKWorkflow *workflow = [[TSKWorkflow alloc] init];
+    TSKTask *first = [[TSKTask alloc] initWithName:@"1"];
+    TSKTask *second = [[TSKTask alloc] initWithName:@"1"];
+    TSKTask *gate = [[TSKTask alloc] initWithName:@"1"];
+    TSKTask *longTask = [[TSKTask alloc] initWithName:@"10"];
+    [workflow addTask:first prerequisites:nil];
+    [workflow addTask:second prerequisites:nil];
+    [workflow addTask:gate prerequisites:nil];
+    [workflow addTask:longTask prerequisites:gate, nil];
+
+    TSKWorkflowSimulator *simulator = [self simulatorForWorkflow:workflow];
+    TSKWorkflowSimulationResult *fifoResult = [simulator simulateWithWorkerCount:2 policy:TSKSimulationPolicyFirstInFirstOut];
+    TSKWorkflowSimulationResult *longestPathResult = [simulator simulateWithWorkerCount:2 policy:TSKSimulationPolicyLongestPathFirst];
+
+    XCTAssertEqualWithAccuracy(fifoResult.makespan, 12, 1e-9, @"FIFO makespan is incorrect");
+    XCTAssertEqualWithAccuracy(longestPathResult.makespan, 11, 1e-9, @"longest path first makespan is incorrect");
+    XCTAssertEqualObjects(longestPathResult.criticalPath, (@[ gate, longTask ]), @"criticalPath is incorrect");
+}
+
+
+- (void)testDurationStatistics
+{
+    TSKDurationStatistics *statistics = [[TSKDurationStatistics alloc] init];
+    NSString *name = UMKRandomUnicodeString();
+    for (NSUInteger i = 0; i < 10; ++i) {
+        [statistics recordDuration:4 forTaskName:name];
+    }
+
+    TSKWorkflow *workflow = [[TSKWorkflow alloc] init];
+    TSKTask *knownTask = [[TSKTask alloc] initWithName:name];
+    TSKTask *unknownTask = [[TSKTask alloc] init];
+    TSKTask *unrecordedTask = [[TSKTask alloc] initWithName:UMKRandomAlphanumericString()];
+    [workflow addTask:knownTask prerequisites:nil];
+    [workflow addTask:unknownTask prerequisites:knownTask, nil];
+    [workflow addTask:unrecordedTask prerequisites:unknownTask, nil];
+
+    TSKWorkflowSimulator *simulator = [[TSKWorkflowSimulator alloc] initWithWorkflow:workflow durationStatistics:statistics defaultDuration:1];
+    TSKWorkflowSimulationResult *result = [simulator simulateWithWorkerCount:1 policy:TSKSimulationPolicyFirstInFirstOut];
+
+    // Histogram percentiles are accurate to within 12.5%
+    XCTAssertEqualWithAccuracy(result.makespan, 6, 0.5, @"makespan is incorrect");
+
+    // Estimating durations does not create histograms for tasks that were never recorded
+    XCTAssertEqualObjects(statistics.taskNames, [NSSet setWithObject:name], @"simulation created histograms");
+}
+
+
+- (void)testLargeWorkflow
+{
+    // A layered workflow of 100,000 tasks in which each task depends on up to three tasks in the
+    // previous layer
+    const NSUInteger layerWidth = 100;
+    const NSUInteger layerCount = 1000;
+
+    TSKWorkflow *workflow = [[TSKWorkflow alloc] init];
+    NSMutableArray<TSKTask *> *previousLayer = nil;
+    for (NSUInteger layer = 0; layer < layerCount; ++layer) {
+        NSMutableArray<TSKTask *> *currentLayer = [[NSMutableArray alloc] initWithCapacity:layerWidth];
+        for (NSUInteger i = 0; i < layerWidth; ++i) {
+            TSKTask *task = [[TSKTask alloc] initWithName:@"1"];
+            NSMutableSet<TSKTask *> *prerequisites = [[NSMutableSet alloc] init];
+            for (NSUInteger j = 0; previousLayer && j < 3; ++j) {
+                [prerequisites addObject:previousLayer[random() % layerWidth]];
+            }
+
+            [workflow addTask:task prerequisiteTasks:prerequisites];
+            [currentLayer addObject:task];
+        }
+
+        previousLayer = currentLayer;
+    }
+
+    TSKWorkflowSimulator *simulator = [self simulatorForWorkflow:workflow];
+    XCTAssertEqual(simulator.taskCount, layerWidth * layerCount, @"taskCount is incorrect");
+
+    NSDate *startDate = [NSDate date];
+    TSKWorkflowSimulationResult *result = [simulator simulateWithWorkerCount:layerWidth policy:TSKSimulationPolicyLongestPathFirst];
+    NSTimeInterval elapsed = -startDate.timeIntervalSinceNow;
+
+    XCTAssertEqualWithAccuracy(result.criticalPathDuration, layerCount, 1e-9, @"criticalPathDuration is incorrect");
+    XCTAssertEqualWithAccuracy(result.makespan, layerCount, 1e-9, @"makespan with one worker per task in a layer is incorrect");
+    XCTAssertEqual(result.criticalPath.count, layerCount, @"criticalPath length is incorrect");
+    XCTAssertLessThan(elapsed, 1, @"simulation took too long");
+}
+
+@end
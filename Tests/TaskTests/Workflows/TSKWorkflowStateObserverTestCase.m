@@ -0,0 +1,171 @@
+//
+//  TSKWorkflowStateObserverTestCase.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import "TSKRandomizedTestCase.h"
+
+
+@interface TSKWorkflowStateObserverTestCase : TSKRandomizedTestCase
+
+- (void)testInit;
+- (void)testCoalescedDelivery;
+- (void)testInvalidate;
+
+@end
+
+
+@implementation TSKWorkflowStateObserverTestCase
+
+- (void)testInit
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    dispatch_queue_t queue = dispatch_queue_create("com.ticketmaster.TSKWorkflowStateObserverTestCase", DISPATCH_QUEUE_SERIAL);
+    double maximumDeliveryRate = random() % 60 + 1;
+    void (^handler)(TSKWorkflowStateDelta *) = ^(TSKWorkflowStateDelta *delta) { };
+
+    TSKWorkflowStateObserver *observer = [[TSKWorkflowStateObserver alloc] initWithWorkflow:workflow
+                                                                        maximumDeliveryRate:maximumDeliveryRate
+                                                                                      queue:queue
+                                                                                    handler:handler];
+    XCTAssertNotNil(observer, @"returns nil");
+    XCTAssertEqual(observer.workflow, workflow, @"workflow is set incorrectly");
+    XCTAssertEqual(observer.maximumDeliveryRate, maximumDeliveryRate, @"maximumDeliveryRate is set incorrectly");
+    XCTAssertEqual(observer.queue, queue, @"queue is set incorrectly");
+    XCTAssertFalse(observer.isInvalidated, @"observer is initially invalidated");
+
+    [observer invalidate];
+    XCTAssertTrue(observer.isInvalidated, @"observer is not invalidated");
+
+    id nilObject = nil;
+    XCTAssertThrows(([[TSKWorkflowStateObserver alloc] initWithWorkflow:nilObject maximumDeliveryRate:1 queue:queue handler:handler]),
+                    @"nil workflow does not throw exception");
+    XCTAssertThrows(([[TSKWorkflowStateObserver alloc] initWithWorkflow:workflow maximumDeliveryRate:0 queue:queue handler:handler]),
+                    @"zero delivery rate does not throw exception");
+    XCTAssertThrows(([[TSKWorkflowStateObserver alloc] initWithWorkflow:workflow maximumDeliveryRate:1 queue:nilObject handler:handler]),
+                    @"nil queue does not throw exception");
+    XCTAssertThrows(([[TSKWorkflowStateObserver alloc] initWithWorkflow:workflow maximumDeliveryRate:1 queue:queue handler:nilObject]),
+                    @"nil handler does not throw exception");
+}
+
+
+- (void)testCoalescedDelivery
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    NSUInteger taskCount = random() % 500 + 500;
+    for (NSUInteger i = 0; i < taskCount; ++i) {
+        TSKBlockTask *task = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+            [task finishWithResult:nil];
+        }];
+
+        [workflow addTask:task prerequisites:nil];
+    }
+
+    // The latest delivered state of each task, and when each delta was delivered
+    NSLock *lock = [[NSLock alloc] init];
+    NSMapTable<TSKTask *, NSNumber *> *deliveredStates = [NSMapTable strongToStrongObjectsMapTable];
+    NSMutableArray<NSNumber *> *deliveryTimes = [[NSMutableArray alloc] init];
+    __block NSUInteger changedTaskCount = 0;
+
+    const double maximumDeliveryRate = 2;
+    dispatch_queue_t queue = dispatch_queue_create("com.ticketmaster.TSKWorkflowStateObserverTestCase", DISPATCH_QUEUE_SERIAL);
+    TSKWorkflowStateObserver *observer = [[TSKWorkflowStateObserver alloc] initWithWorkflow:workflow
+                                                                        maximumDeliveryRate:maximumDeliveryRate
+                                                                                      queue:queue
+                                                                                    handler:^(TSKWorkflowStateDelta *delta) {
+        XCTAssertEqual(delta.workflow, workflow, @"delta workflow is incorrect");
+        XCTAssertEqual([NSSet setWithArray:delta.changedTasks].count, delta.changedTasks.count, @"delta contains a task more than once");
+
+        [lock lock];
+        [deliveryTimes addObject:@([NSProcessInfo processInfo].systemUptime)];
+        changedTaskCount += delta.changedTasks.count;
+        for (TSKTask *task in delta.changedTasks) {
+            [deliveredStates setObject:@([delta stateOfTask:task]) forKey:task];
+        }
+        [lock unlock];
+    }];
+
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+
+    // Wait for the changes made before the workflow finished to be delivered
+    NSPredicate *allTasksDeliveredFinished = [NSPredicate predicateWithBlock:^BOOL(id object, NSDictionary *bindings) {
+        [lock lock];
+        NSUInteger finishedCount = 0;
+        for (NSNumber *state in deliveredStates.objectEnumerator) {
+            finishedCount += state.integerValue == TSKTaskStateFinished;
+        }
+        [lock unlock];
+        return finishedCount == taskCount;
+    }];
+
+    [self expectationForPredicate:allTasksDeliveredFinished evaluatedWithObject:observer handler:nil];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    [observer invalidate];
+
+    [lock lock];
+    XCTAssertEqual(deliveredStates.count, taskCount, @"not every task was delivered");
+
+    // Each task made at least two transitions, to executing and to finished. The workflow takes far
+    // less than a delivery interval to run, so most tasks’ transitions are delivered together.
+    XCTAssertLessThan(changedTaskCount, taskCount * 2, @"intermediate transitions were not coalesced");
+
+    // Deliveries are spaced by the interval, allowing for timer slop
+    const NSTimeInterval deliveryInterval = 1 / maximumDeliveryRate;
+    for (NSUInteger i = 1; i < deliveryTimes.count; ++i) {
+        NSTimeInterval gap = deliveryTimes[i].doubleValue - deliveryTimes[i - 1].doubleValue;
+        XCTAssertGreaterThan(gap, deliveryInterval * 0.9, @"deliveries exceeded maximum delivery rate");
+    }
+    [lock unlock];
+}
+
+
+- (void)testInvalidate
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    TSKBlockTask *task = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        [task finishWithResult:nil];
+    }];
+
+    [workflow addTask:task prerequisites:nil];
+
+    XCTestExpectation *deliveryExpectation = [self expectationWithDescription:@"delivery after invalidation"];
+    deliveryExpectation.inverted = YES;
+    TSKWorkflowStateObserver *observer = [[TSKWorkflowStateObserver alloc] initWithWorkflow:workflow
+                                                                        maximumDeliveryRate:100
+                                                                                      queue:dispatch_get_main_queue()
+                                                                                    handler:^(TSKWorkflowStateDelta *delta) {
+        [deliveryExpectation fulfill];
+    }];
+
+    [observer invalidate];
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:task];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:0.25 handler:nil];
+}
+
+@end
@@ -0,0 +1,198 @@
+//
+//  TSKWorkflowTemplateTestCase.m
+//  Task
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TSKRandomizedTestCase.h"
+
+
+@interface TSKWorkflowTemplateTestCase : TSKRandomizedTestCase
+
+- (void)testInit;
+- (void)testInstantiation;
+- (void)testRun;
+- (void)testInstanceIndependence;
+
+@end
+
+
+@implementation TSKWorkflowTemplateTestCase
+
+- (void)testInit
+{
+    XCTAssertThrows([[TSKWorkflowTemplate alloc] initWithWorkflow:nil], @"nil workflow does not throw exception");
+
+    TSKWorkflowTemplate *template = [[TSKWorkflowTemplate alloc] initWithWorkflow:[self workflowForNotificationTesting]];
+    XCTAssertNotNil(template, @"returns nil");
+    XCTAssertEqual(template.taskCount, 0, @"taskCount is non-zero");
+
+    TSKWorkflow *workflow = [template instantiateWorkflow];
+    XCTAssertNotNil(workflow, @"returns nil");
+    XCTAssertEqualObjects(workflow.allTasks, [NSSet set], @"empty template instantiates tasks");
+
+    // Streaming prerequisites are not supported
+    TSKWorkflow *streamingWorkflow = [self workflowForNotificationTesting];
+    TSKTask *producer = [[TSKTask alloc] init];
+    [streamingWorkflow addTask:producer prerequisites:nil];
+    [streamingWorkflow addTask:[[TSKTask alloc] init] streamingPrerequisiteTask:producer channel:[[TSKChannel alloc] initWithCapacity:1] prerequisiteTasks:nil];
+    XCTAssertThrows([[TSKWorkflowTemplate alloc] initWithWorkflow:streamingWorkflow], @"streaming prerequisites do not throw exception");
+}
+
+
+- (void)testInstantiation
+{
+    TSKWorkflow *prototypeWorkflow = [self workflowForNotificationTesting];
+    prototypeWorkflow.executionClass = UMKRandomUnicodeString();
+    prototypeWorkflow.resultStore = [[TSKResultStore alloc] init];
+
+    // A diamond whose bottom task has keyed prerequisites, plus an independent task
+    TSKTask *top = [[TSKTask alloc] initWithName:UMKRandomUnicodeString()];
+    TSKTask *left = [[TSKTask alloc] initWithName:UMKRandomUnicodeString()];
+    TSKTask *right = [[TSKTask alloc] initWithName:UMKRandomUnicodeString()];
+    TSKTask *bottom = [[TSKTask alloc] initWithName:UMKRandomUnicodeString()];
+    TSKTask *independent = [[TSKTask alloc] init];
+    [prototypeWorkflow addTask:top prerequisites:nil];
+    [prototypeWorkflow addTask:left prerequisites:top, nil];
+    [prototypeWorkflow addTask:right prerequisites:top, nil];
+    [prototypeWorkflow addTask:bottom keyedPrerequisiteTasks:@{ @"left" : left, @"right" : right }];
+    [prototypeWorkflow addTask:independent prerequisites:nil];
+
+    TSKWorkflowTemplate *template = [[TSKWorkflowTemplate alloc] initWithWorkflow:prototypeWorkflow];
+    XCTAssertEqual(template.taskCount, 5, @"taskCount is incorrect");
+
+    NSString *name = UMKRandomUnicodeString();
+    NSOperationQueue *operationQueue = [[NSOperationQueue alloc] init];
+    TSKWorkflow *workflow = [template instantiateWorkflowWithName:name operationQueue:operationQueue];
+    XCTAssertEqualObjects(workflow.name, name, @"name is set incorrectly");
+    XCTAssertEqual(workflow.operationQueue, operationQueue, @"operationQueue is set incorrectly");
+    XCTAssertEqual(workflow.notificationCenter, prototypeWorkflow.notificationCenter, @"notificationCenter is set incorrectly");
+    XCTAssertEqualObjects(workflow.executionClass, prototypeWorkflow.executionClass, @"executionClass is set incorrectly");
+    XCTAssertEqual(workflow.resultStore, prototypeWorkflow.resultStore, @"resultStore is set incorrectly");
+    XCTAssertEqual(workflow.allTasks.count, 5, @"task count is incorrect");
+
+    TSKTask *(^instanceTask)(TSKTask *) = ^TSKTask *(TSKTask *prototypeTask) {
+        return [template taskInWorkflow:workflow correspondingToPrototypeTask:prototypeTask];
+    };
+
+    for (TSKTask *prototypeTask in prototypeWorkflow.allTasks) {
+        TSKTask *task = instanceTask(prototypeTask);
+        XCTAssertNotNil(task, @"no corresponding task");
+        XCTAssertNotEqual(task, prototypeTask, @"prototype task is reused");
+        XCTAssertEqual(task.workflow, workflow, @"task is not in the workflow");
+        XCTAssertEqual(prototypeTask.workflow, prototypeWorkflow, @"prototype task changed workflows");
+        XCTAssertEqual(task.state, prototypeTask.state, @"task state is incorrect");
+    }
+
+    XCTAssertEqualObjects(instanceTask(top).name, top.name, @"name is copied incorrectly");
+    XCTAssertEqualObjects(instanceTask(independent).name, [self defaultNameForTask:instanceTask(independent)], @"default name is copied");
+    XCTAssertNil([template taskInWorkflow:workflow correspondingToPrototypeTask:[[TSKTask alloc] init]], @"returns task for non-prototype");
+
+    XCTAssertEqualObjects(workflow.tasksWithNoPrerequisiteTasks, ([NSSet setWithObjects:instanceTask(top), instanceTask(independent), nil]),
+                          @"tasksWithNoPrerequisiteTasks is incorrect");
+    XCTAssertEqualObjects(workflow.tasksWithNoDependentTasks, ([NSSet setWithObjects:instanceTask(bottom), instanceTask(independent), nil]),
+                          @"tasksWithNoDependentTasks is incorrect");
+    XCTAssertEqualObjects([workflow dependentTasksForTask:instanceTask(top)], ([NSSet setWithObjects:instanceTask(left), instanceTask(right), nil]),
+                          @"dependent tasks are incorrect");
+    XCTAssertEqualObjects([workflow prerequisiteTasksForTask:instanceTask(left)], [NSSet setWithObject:instanceTask(top)],
+                          @"prerequisite tasks are incorrect");
+    XCTAssertEqualObjects([workflow keyedPrerequisiteTasksForTask:instanceTask(bottom)], (@{ @"left" : instanceTask(left), @"right" : instanceTask(right) }),
+                          @"keyed prerequisite tasks are incorrect");
+    XCTAssertNil([workflow keyedPrerequisiteTasksForTask:instanceTask(left)], @"keyed prerequisite tasks are incorrect");
+}
+
+
+- (void)testRun
+{
+    TSKWorkflow *prototypeWorkflow = [self workflowForNotificationTesting];
+
+    TSKBlockTask *leftTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        [task finishWithResult:@1];
+    }];
+
+    TSKBlockTask *rightTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        [task finishWithResult:@2];
+    }];
+
+    TSKBlockTask *sumTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        NSNumber *left = [task prerequisiteResultForKey:@"left"];
+        NSNumber *right = [task prerequisiteResultForKey:@"right"];
+        [task finishWithResult:@(left.integerValue + right.integerValue)];
+    }];
+
+    [prototypeWorkflow addTask:leftTask prerequisites:nil];
+    [prototypeWorkflow addTask:rightTask prerequisites:nil];
+    [prototypeWorkflow addTask:sumTask keyedPrerequisiteTasks:@{ @"left" : leftTask, @"right" : rightTask }];
+
+    TSKWorkflowTemplate *template = [[TSKWorkflowTemplate alloc] initWithWorkflow:prototypeWorkflow];
+
+    NSMutableArray<TSKWorkflow *> *workflows = [[NSMutableArray alloc] init];
+    for (NSUInteger i = 0; i < 10; ++i) {
+        TSKWorkflow *workflow = [template instantiateWorkflow];
+        [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+        [workflows addObject:workflow];
+    }
+
+    for (TSKWorkflow *workflow in workflows) {
+        [workflow start];
+    }
+
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    for (TSKWorkflow *workflow in workflows) {
+        XCTAssertEqualObjects([template taskInWorkflow:workflow correspondingToPrototypeTask:sumTask].result, @3, @"result is incorrect");
+    }
+
+    XCTAssertEqual(sumTask.state, TSKTaskStatePending, @"prototype task was run");
+}
+
+
+- (void)testInstanceIndependence
+{
+    TSKWorkflow *prototypeWorkflow = [self workflowForNotificationTesting];
+    TSKTask *prototypeTask = [[TSKTask alloc] init];
+    [prototypeWorkflow addTask:prototypeTask prerequisites:nil];
+
+    TSKWorkflowTemplate *template = [[TSKWorkflowTemplate alloc] initWithWorkflow:prototypeWorkflow];
+
+    // Adding tasks to an instance doesn’t affect the template, the prototype, or other instances
+    TSKWorkflow *workflow = [template instantiateWorkflow];
+    TSKTask *task = [template taskInWorkflow:workflow correspondingToPrototypeTask:prototypeTask];
+    TSKTask *dependentTask = [[TSKTask alloc] init];
+    [workflow addTask:dependentTask prerequisites:task, nil];
+
+    XCTAssertEqualObjects([workflow dependentTasksForTask:task], [NSSet setWithObject:dependentTask], @"dependent tasks are incorrect");
+    XCTAssertEqualObjects([prototypeWorkflow dependentTasksForTask:prototypeTask], [NSSet set], @"prototype was modified");
+
+    TSKWorkflow *otherWorkflow = [template instantiateWorkflow];
+    TSKTask *otherTask = [template taskInWorkflow:otherWorkflow correspondingToPrototypeTask:prototypeTask];
+    XCTAssertEqual(otherWorkflow.allTasks.count, 1, @"instance was modified");
+    XCTAssertEqualObjects([otherWorkflow dependentTasksForTask:otherTask], [NSSet set], @"instance was modified");
+
+    // Adding tasks to the prototype doesn’t affect the template
+    [prototypeWorkflow addTask:[[TSKTask alloc] init] prerequisites:prototypeTask, nil];
+    XCTAssertEqual(template.taskCount, 1, @"template was modified");
+    XCTAssertEqual([template instantiateWorkflow].allTasks.count, 1, @"template was modified");
+}
+
+@end
@@ -27,6 +27,16 @@
 #import "TSKRandomizedTestCase.h"
 
 #import <URLMock/UMKMessageCountingProxy.h>
+#import <malloc/malloc.h>
+
+
+/*! Returns the number of heap blocks currently allocated in all malloc zones. */
+static long TSKMallocBlocksInUse(void)
+{
+    malloc_statistics_t statistics;
+    malloc_zone_statistics(NULL, &statistics);
+    return (long)statistics.blocks_in_use;
+}
 
 
 #pragma mark Test Delegate 
@@ -72,15 +82,39 @@
 - (void)testInit;
 - (void)testAddTasks;
 - (void)testAddTaskErrorCases;
+- (void)testAddManyTasks;
+- (void)testShortLivedWorkflowMemory;
+- (void)testAddTasksConcurrently;
+- (void)testAddTasksConcurrentlyScaling;
+- (void)testAddTaskWhileRunning;
+- (void)testStreamingPrerequisite;
+- (void)testStreamingPrerequisiteFailure;
 - (void)testHasUnfinishedTasks;
 - (void)testHasFailedTasks;
 - (void)testStartNoPrerequisites;
 - (void)testStartOnePrerequisite;
 - (void)testStartMultiplePrerequisites;
 - (void)testStartMultipleDependents;
+- (void)testStartForTargetTasks;
+- (void)testConditionalPrerequisites;
+- (void)testConditionThatModifiesWorkflow;
 - (void)testReset;
 - (void)testRetry;
 - (void)testCancel;
+- (void)testTimeout;
+- (void)testStartWithCompletionHandler;
+- (void)testWaitUntilFinished;
+- (void)testBatching;
+- (void)testBatchDeadline;
+- (void)testDeadlineWithoutScheduler;
+- (void)testBatchedThroughput;
+- (void)testUnbatchedThroughput;
+
+/*!
+ @abstract Measures how long a workflow takes to run many tasks that do almost no work.
+ @param batchable Whether the workflow’s tasks are batchable.
+ */
+- (void)measureThroughputOfTasksThatAreBatchable:(BOOL)batchable;
 
 - (void)testWorkflowDelegateFinish;
 - (void)testWorkflowDelegateFail;
@@ -181,6 +215,8 @@
 
     XCTAssertThrows(([workflow addTask:dependentTask prerequisites:prerequisiteTask, nil]),
                     @"workflow allows a task to be added before its prerequisite is added");
+    XCTAssertEqual(dependentTask.state, TSKTaskStateReady, @"task that could not be added was made pending");
+    XCTAssertNil(dependentTask.workflow, @"task that could not be added has a workflow");
 
     TSKTestTask *requiredKeysTask = [self finishingTaskWithLock:nil];
     requiredKeysTask.requiredPrerequisiteKeys = UMKGeneratedSetWithElementCount(random() % 5 + 2, ^id{
@@ -192,6 +228,412 @@
 }
 
 
+- (void)testAddManyTasks
+{
+    // Use enough tasks and edges that the workflow’s graph needs several node pages and edge blocks
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    NSUInteger taskCount = 1000 + random() % 1000;
+
+    NSMutableArray *tasks = [[NSMutableArray alloc] initWithCapacity:taskCount];
+    NSMutableArray *expectedPrerequisites = [[NSMutableArray alloc] initWithCapacity:taskCount];
+    NSMutableArray *expectedDependents = [[NSMutableArray alloc] initWithCapacity:taskCount];
+
+    for (NSUInteger i = 0; i < taskCount; ++i) {
+        TSKTask *task = [[TSKTask alloc] init];
+        NSSet *prerequisites = i == 0 ? [NSSet set] : [NSSet setWithObjects:tasks[i - 1], tasks[i / 2], tasks[0], nil];
+        [workflow addTask:task prerequisiteTasks:prerequisites];
+
+        [tasks addObject:task];
+        [expectedPrerequisites addObject:prerequisites];
+        [expectedDependents addObject:[NSMutableSet set]];
+        for (TSKTask *prerequisite in prerequisites) {
+            [expectedDependents[[tasks indexOfObject:prerequisite]] addObject:task];
+        }
+    }
+
+    for (NSUInteger i = 0; i < taskCount; ++i) {
+        TSKTask *task = tasks[i];
+        XCTAssertEqualObjects(task.prerequisiteTasks, expectedPrerequisites[i], @"prerequisites not set correctly");
+        XCTAssertEqualObjects(task.dependentTasks, expectedDependents[i], @"dependents not set correctly");
+        XCTAssertEqual(task.state, i == 0 ? TSKTaskStateReady : TSKTaskStatePending, @"state is not set correctly");
+    }
+
+    XCTAssertEqualObjects(workflow.allTasks, [NSSet setWithArray:tasks], @"all tasks not set correctly");
+    XCTAssertEqualObjects(workflow.tasksWithNoPrerequisiteTasks, [NSSet setWithObject:tasks[0]], @"tasksWithNoPrerequisiteTasks not set correctly");
+    XCTAssertEqualObjects(workflow.tasksWithNoDependentTasks, [NSSet setWithObject:tasks.lastObject], @"tasksWithNoDependentTasks not set correctly");
+
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    for (TSKTask *task in tasks) {
+        XCTAssertEqual(task.state, TSKTaskStateFinished, @"state is not finished");
+    }
+}
+
+
+- (void)testShortLivedWorkflowMemory
+{
+    // Workflows own their graph bookkeeping, so building a small one should allocate few heap blocks,
+    // and discarding it should free all of them. Each task depends on the two before it to exercise
+    // the edge lists. Blocks are counted once each workflow is built, before its autorelease pool is
+    // drained, so temporary objects are counted too.
+    const NSUInteger workflowCount = 1000;
+    const NSUInteger taskCount = 64;
+
+    long arenaBlocks = 0;
+    long arenaStartBlocks = TSKMallocBlocksInUse();
+    for (NSUInteger i = 0; i < workflowCount; ++i) {
+        @autoreleasepool {
+            long startBlocks = TSKMallocBlocksInUse();
+            TSKWorkflow *workflow = [[TSKWorkflow alloc] init];
+            TSKTask *previousTask = nil;
+            TSKTask *task = nil;
+            for (NSUInteger j = 0; j < taskCount; ++j) {
+                TSKTask *nextTask = [[TSKTask alloc] init];
+                [workflow addTask:nextTask prerequisites:task, previousTask, nil];
+                previousTask = task;
+                task = nextTask;
+            }
+
+            arenaBlocks += TSKMallocBlocksInUse() - startBlocks;
+            XCTAssertEqual(workflow.allTasks.count, taskCount, @"tasks were not added");
+        }
+    }
+
+    long arenaResidualBlocks = TSKMallocBlocksInUse() - arenaStartBlocks;
+
+    // For comparison, the same graphs are recorded the way workflows recorded them before they had
+    // arenas: map tables from each task to an immutable set of its prerequisites, an empty keyed
+    // prerequisite dictionary, and an immutable set of its dependents that is replaced on every add,
+    // with the sets of tasks without prerequisites or dependents rebuilt on every add. Tasks then also
+    // had a serial dispatch queue each, which this doesn’t count, so the baseline is an underestimate.
+    long mapTableBlocks = 0;
+    for (NSUInteger i = 0; i < workflowCount; ++i) {
+        @autoreleasepool {
+            long startBlocks = TSKMallocBlocksInUse();
+            NSMutableSet<TSKTask *> *tasks = [[NSMutableSet alloc] init];
+            NSMapTable<TSKTask *, NSSet<TSKTask *> *> *prerequisiteTasks = [NSMapTable strongToStrongObjectsMapTable];
+            NSMapTable<TSKTask *, NSDictionary *> *keyedPrerequisiteTasks = [NSMapTable strongToStrongObjectsMapTable];
+            NSMapTable<TSKTask *, NSSet<TSKTask *> *> *dependentTasks = [NSMapTable strongToStrongObjectsMapTable];
+            NSSet<TSKTask *> *tasksWithNoPrerequisiteTasks = nil;
+            NSSet<TSKTask *> *tasksWithNoDependentTasks = nil;
+
+            TSKTask *previousTask = nil;
+            TSKTask *task = nil;
+            for (NSUInteger j = 0; j < taskCount; ++j) {
+                TSKTask *nextTask = [[TSKTask alloc] init];
+                NSSet<TSKTask *> *prerequisites = [NSSet setWithObjects:task, previousTask, nil];
+                [tasks addObject:nextTask];
+                [prerequisiteTasks setObject:prerequisites forKey:nextTask];
+                [keyedPrerequisiteTasks setObject:[[NSDictionary alloc] init] forKey:nextTask];
+                [dependentTasks setObject:[[NSSet alloc] init] forKey:nextTask];
+                for (TSKTask *prerequisite in prerequisites) {
+                    [dependentTasks setObject:[[dependentTasks objectForKey:prerequisite] setByAddingObject:nextTask] forKey:prerequisite];
+                }
+
+                tasksWithNoPrerequisiteTasks = [tasks objectsPassingTest:^BOOL(TSKTask *candidate, BOOL *stop) {
+                    return [prerequisiteTasks objectForKey:candidate].count == 0;
+                }];
+
+                tasksWithNoDependentTasks = [tasks objectsPassingTest:^BOOL(TSKTask *candidate, BOOL *stop) {
+                    return [dependentTasks objectForKey:candidate].count == 0;
+                }];
+
+                previousTask = task;
+                task = nextTask;
+            }
+
+            mapTableBlocks += TSKMallocBlocksInUse() - startBlocks;
+            XCTAssertEqual(tasksWithNoPrerequisiteTasks.count, 1, @"map tables were not built correctly");
+            XCTAssertEqual(tasksWithNoDependentTasks.count, 1, @"map tables were not built correctly");
+        }
+    }
+
+    NSString *summary = [[NSString alloc] initWithFormat:@"%lu workflows of %lu tasks: arena %.1f blocks per workflow, "
+                         @"%ld blocks left after teardown; map tables %.1f blocks per workflow",
+                         (unsigned long)workflowCount, (unsigned long)taskCount, (double)arenaBlocks / workflowCount,
+                         arenaResidualBlocks, (double)mapTableBlocks / workflowCount];
+
+    // The counts are kept with the test’s results so that allocation can be compared across runs
+    [XCTContext runActivityNamed:@"Record allocations" block:^(id<XCTActivity> activity) {
+        XCTAttachment *attachment = [XCTAttachment attachmentWithString:summary];
+        attachment.lifetime = XCTAttachmentLifetimeKeepAlways;
+        [activity addAttachment:attachment];
+    }];
+
+    XCTAssertLessThan(arenaBlocks, mapTableBlocks, @"arena allocated more blocks than map tables (%@)", summary);
+
+    // Caches elsewhere in the process may keep a few blocks, but discarded workflows must not
+    XCTAssertLessThan(arenaResidualBlocks, (long)workflowCount, @"discarded workflows left blocks behind (%@)", summary);
+}
+
+
+- (void)testAddTasksConcurrently
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    TSKTask *rootTask = [[TSKTask alloc] init];
+    [workflow addTask:rootTask prerequisites:nil];
+
+    // Each chain is built on its own thread, and every chain’s first task depends on the shared root
+    NSUInteger chainCount = 16 + random() % 16;
+    NSUInteger chainLength = 100 + random() % 100;
+    NSMutableArray *chains = [[NSMutableArray alloc] initWithCapacity:chainCount];
+    for (NSUInteger i = 0; i < chainCount; ++i) {
+        NSMutableArray *chain = [[NSMutableArray alloc] initWithCapacity:chainLength];
+        for (NSUInteger j = 0; j < chainLength; ++j) {
+            [chain addObject:[[TSKTask alloc] init]];
+        }
+
+        [chains addObject:chain];
+    }
+
+    dispatch_apply(chainCount, dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^(size_t i) {
+        TSKTask *previousTask = rootTask;
+        for (TSKTask *task in chains[i]) {
+            [workflow addTask:task prerequisites:previousTask, nil];
+            previousTask = task;
+        }
+    });
+
+    NSMutableSet *lastTasks = [[NSMutableSet alloc] init];
+    NSMutableSet *firstTasks = [[NSMutableSet alloc] init];
+    for (NSArray *chain in chains) {
+        [firstTasks addObject:chain.firstObject];
+        [lastTasks addObject:chain.lastObject];
+
+        TSKTask *previousTask = rootTask;
+        for (TSKTask *task in chain) {
+            XCTAssertEqual(task.workflow, workflow, @"workflow not set correctly");
+            XCTAssertEqualObjects(task.prerequisiteTasks, [NSSet setWithObject:previousTask], @"prerequisites not set correctly");
+            XCTAssertEqual(task.state, TSKTaskStatePending, @"state is not pending");
+            previousTask = task;
+        }
+    }
+
+    XCTAssertEqual(workflow.allTasks.count, chainCount * chainLength + 1, @"all tasks not set correctly");
+    XCTAssertEqualObjects(rootTask.dependentTasks, firstTasks, @"dependents not set correctly");
+    XCTAssertEqualObjects(workflow.tasksWithNoPrerequisiteTasks, [NSSet setWithObject:rootTask], @"tasksWithNoPrerequisiteTasks not set correctly");
+    XCTAssertEqualObjects(workflow.tasksWithNoDependentTasks, lastTasks, @"tasksWithNoDependentTasks not set correctly");
+
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+}
+
+
+- (void)testAddTasksConcurrentlyScaling
+{
+    NSUInteger threadCount = MIN([NSProcessInfo processInfo].activeProcessorCount, 8);
+    XCTSkipUnless(threadCount > 1, @"scaling requires more than one processor");
+
+    // Every thread adds its own chain of tasks to one workflow, so all adds contend for the graph lock.
+    // The same chains are added from a single thread for comparison.
+    const NSUInteger chainLength = 2000;
+    NSArray<NSArray<TSKTask *> *> *(^makeChains)(void) = ^{
+        NSMutableArray *chains = [[NSMutableArray alloc] initWithCapacity:threadCount];
+        for (NSUInteger i = 0; i < threadCount; ++i) {
+            NSMutableArray *chain = [[NSMutableArray alloc] initWithCapacity:chainLength];
+            for (NSUInteger j = 0; j < chainLength; ++j) {
+                [chain addObject:[[TSKTask alloc] init]];
+            }
+
+            [chains addObject:chain];
+        }
+
+        return chains;
+    };
+
+    void (^addChain)(TSKWorkflow *, NSArray<TSKTask *> *) = ^(TSKWorkflow *workflow, NSArray<TSKTask *> *chain) {
+        TSKTask *previousTask = nil;
+        for (TSKTask *task in chain) {
+            [workflow addTask:task prerequisites:previousTask, nil];
+            previousTask = task;
+        }
+    };
+
+    NSArray<NSArray<TSKTask *> *> *serialChains = makeChains();
+    TSKWorkflow *serialWorkflow = [[TSKWorkflow alloc] init];
+    NSDate *startDate = [NSDate date];
+    for (NSArray<TSKTask *> *chain in serialChains) {
+        addChain(serialWorkflow, chain);
+    }
+
+    NSTimeInterval serialDuration = -[startDate timeIntervalSinceNow];
+
+    NSArray<NSArray<TSKTask *> *> *concurrentChains = makeChains();
+    TSKWorkflow *concurrentWorkflow = [[TSKWorkflow alloc] init];
+    startDate = [NSDate date];
+    dispatch_apply(threadCount, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+        addChain(concurrentWorkflow, concurrentChains[i]);
+    });
+
+    NSTimeInterval concurrentDuration = -[startDate timeIntervalSinceNow];
+
+    XCTAssertEqual(serialWorkflow.allTasks.count, threadCount * chainLength, @"tasks were not added");
+    XCTAssertEqual(concurrentWorkflow.allTasks.count, threadCount * chainLength, @"tasks were not added");
+
+    NSString *summary = [[NSString alloc] initWithFormat:@"%lu threads adding %lu tasks: %.3fs serial, %.3fs concurrent, %.2fx",
+                         (unsigned long)threadCount, (unsigned long)(threadCount * chainLength),
+                         serialDuration, concurrentDuration, concurrentDuration / serialDuration];
+
+    // The timings are kept with the test’s results so that contention can be compared across runs
+    [XCTContext runActivityNamed:@"Record scaling" block:^(id<XCTActivity> activity) {
+        XCTAttachment *attachment = [XCTAttachment attachmentWithString:summary];
+        attachment.lifetime = XCTAttachmentLifetimeKeepAlways;
+        [activity addAttachment:attachment];
+    }];
+
+    // Graph changes are serialized by the graph lock, so adds aren’t expected to scale with the number
+    // of threads, but contention shouldn’t make them much slower either. Allow for a busy machine.
+    XCTAssertLessThan(concurrentDuration, serialDuration * 3, @"concurrent adds collapsed under contention (%@)", summary);
+}
+
+
+- (void)testAddTaskWhileRunning
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    TSKTestTask *task = [self finishingTaskWithLock:nil];
+    [workflow addTask:task prerequisites:nil];
+
+    // A task whose prerequisites are finished is left ready if the workflow isn’t running
+    [self expectationForNotification:TSKTestTaskDidFinishNotification object:task handler:nil];
+    [task start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    TSKTestTask *idleDependentTask = [self finishingTaskWithLock:nil];
+    [workflow addTask:idleDependentTask prerequisites:task, nil];
+    XCTAssertEqual(idleDependentTask.state, TSKTaskStateReady, @"state is not ready");
+
+    // Once the workflow is running, new tasks start as soon as their prerequisites are finished
+    NSLock *willFinishLock = [[NSLock alloc] init];
+    workflow = [self workflowForNotificationTesting];
+    task = [self finishingTaskWithLock:willFinishLock];
+    [workflow addTask:task prerequisites:nil];
+
+    [willFinishLock lock];
+    [self expectationForNotification:TSKTestTaskDidStartNotification object:task handler:nil];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    TSKTestTask *independentTask = [self finishingTaskWithLock:nil];
+    TSKTestTask *dependentTask = [self finishingTaskWithLock:nil];
+
+    [self expectationForNotification:TSKTestTaskDidFinishNotification object:independentTask handler:nil];
+    [workflow addTask:independentTask prerequisites:nil];
+    [workflow addTask:dependentTask prerequisites:task, nil];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+    XCTAssertEqual(dependentTask.state, TSKTaskStatePending, @"dependent state is not pending");
+
+    [self expectationForNotification:TSKTestTaskDidFinishNotification object:dependentTask handler:nil];
+    [willFinishLock unlock];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    TSKTestTask *lateDependentTask = [self finishingTaskWithLock:nil];
+    [self expectationForNotification:TSKTestTaskDidFinishNotification object:lateDependentTask handler:nil];
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    [workflow addTask:lateDependentTask prerequisites:dependentTask, nil];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    // Cancelled workflows are no longer running
+    [workflow cancel];
+    TSKTestTask *cancelledWorkflowTask = [self finishingTaskWithLock:nil];
+    [workflow addTask:cancelledWorkflowTask prerequisites:nil];
+    XCTAssertEqual(cancelledWorkflowTask.state, TSKTaskStateReady, @"state is not ready");
+}
+
+
+- (void)testStreamingPrerequisite
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    NSUInteger itemCount = random() % 50 + 50;
+
+    // With a channel this small, the producer can’t finish unless the consumer runs concurrently
+    TSKBlockTask *producer = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        for (NSUInteger i = 1; i <= itemCount; ++i) {
+            if (![task.outputChannel sendItem:@(i)]) {
+                return;
+            }
+        }
+
+        [task finishWithResult:nil];
+    }];
+
+    __block BOOL producerFinishedBeforeConsumerStarted = NO;
+    TSKBlockTask *consumer = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        producerFinishedBeforeConsumerStarted = producer.isFinished;
+
+        NSUInteger sum = 0;
+        NSNumber *item = nil;
+        while ((item = [task.inputChannel receiveItem])) {
+            sum += item.unsignedIntegerValue;
+        }
+
+        [task finishWithResult:@(sum)];
+    }];
+
+    TSKChannel *channel = [[TSKChannel alloc] initWithCapacity:2];
+    [workflow addTask:producer prerequisites:nil];
+    [workflow addTask:consumer streamingPrerequisiteTask:producer channel:channel prerequisiteTasks:nil];
+
+    XCTAssertEqual(producer.outputChannel, channel, @"producer output channel is set incorrectly");
+    XCTAssertEqual(consumer.inputChannel, channel, @"consumer input channel is set incorrectly");
+    XCTAssertEqualObjects(consumer.prerequisiteTasks, [NSSet setWithObject:producer], @"prerequisites are set incorrectly");
+    XCTAssertEqual(consumer.state, TSKTaskStatePending, @"consumer state is not pending");
+
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+
+    XCTAssertFalse(producerFinishedBeforeConsumerStarted, @"consumer did not start until producer finished");
+    XCTAssertEqualObjects(consumer.result, @(itemCount * (itemCount + 1) / 2), @"consumer did not receive all items");
+    XCTAssertTrue(channel.isClosed, @"channel is not closed");
+
+    // Resetting the producer empties and reopens the channel
+    [workflow reset];
+    XCTAssertFalse(channel.isClosed, @"channel is closed after reset");
+    XCTAssertEqual(consumer.state, TSKTaskStatePending, @"consumer state is not pending");
+
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+    XCTAssertEqualObjects(consumer.result, @(itemCount * (itemCount + 1) / 2), @"consumer did not receive all items after reset");
+}
+
+
+- (void)testStreamingPrerequisiteFailure
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    NSError *error = UMKRandomError();
+
+    TSKBlockTask *producer = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        [task.outputChannel sendItem:@1];
+        [task failWithError:error];
+    }];
+
+    TSKBlockTask *consumer = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        while ([task.inputChannel receiveItem]) {
+        }
+
+        if (task.inputChannel.error) {
+            [task failWithError:task.inputChannel.error];
+        } else {
+            [task finishWithResult:nil];
+        }
+    }];
+
+    [workflow addTask:producer prerequisites:nil];
+    [workflow addTask:consumer streamingPrerequisiteTask:producer channel:[[TSKChannel alloc] initWithCapacity:1] prerequisiteTasks:nil];
+
+    [self expectationForNotification:TSKTaskDidFailNotification task:consumer];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertTrue(producer.isFailed, @"producer did not fail");
+    XCTAssertEqualObjects(consumer.error, error, @"consumer error is set incorrectly");
+}
+
+
 - (void)testHasUnfinishedTasks
 {
     // NOTE This property is also tested in other methods to test in other scenarios (e.g., retry, cancel)
@@ -444,6 +886,163 @@
 }
 
 
+- (void)testStartForTargetTasks
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    XCTAssertNil(workflow.targetTasks, @"targetTasks is non-nil");
+    XCTAssertThrows([workflow startForTargetTasks:[NSSet set]], @"empty targets do not throw exception");
+    XCTAssertThrows([workflow startForTargetTasks:[NSSet setWithObject:[[TSKTask alloc] init]]],
+                    @"target not in workflow does not throw exception");
+
+    // source -> middle -> target, source -> sibling, and an unrelated task
+    TSKTask *source = [self finishingTaskWithLock:nil];
+    TSKTask *middle = [self finishingTaskWithLock:nil];
+    TSKTask *target = [self finishingTaskWithLock:nil];
+    TSKTask *sibling = [self finishingTaskWithLock:nil];
+    TSKTask *unrelated = [self finishingTaskWithLock:nil];
+    [workflow addTask:source prerequisites:nil];
+    [workflow addTask:middle prerequisites:source, nil];
+    [workflow addTask:target prerequisites:middle, nil];
+    [workflow addTask:sibling prerequisites:source, nil];
+    [workflow addTask:unrelated prerequisites:nil];
+
+    NSSet *targetTasks = [NSSet setWithObject:target];
+    [self expectationForNotification:TSKWorkflowWillStartNotification workflow:workflow block:nil];
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    [workflow startForTargetTasks:targetTasks];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertEqualObjects(workflow.targetTasks, targetTasks, @"targetTasks is set incorrectly");
+    XCTAssertEqual(source.state, TSKTaskStateFinished, @"needed task did not finish");
+    XCTAssertEqual(middle.state, TSKTaskStateFinished, @"needed task did not finish");
+    XCTAssertEqual(target.state, TSKTaskStateFinished, @"target did not finish");
+    XCTAssertEqual(sibling.state, TSKTaskStateReady, @"unneeded dependent was started");
+    XCTAssertEqual(unrelated.state, TSKTaskStateReady, @"unneeded task was started");
+    XCTAssertTrue(workflow.hasUnfinishedTasks, @"workflow.hasUnfinishedTasks is not true");
+
+    // Tasks added while running for targets are not started
+    TSKTask *addedTask = [self finishingTaskWithLock:nil];
+    [workflow addTask:addedTask prerequisites:target, nil];
+    XCTAssertEqual(addedTask.state, TSKTaskStateReady, @"task added while running for targets was started");
+
+    // Targets that are already finished finish the workflow immediately
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    [workflow startForTargetTasks:[NSSet setWithObject:middle]];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    // Starting the whole workflow runs the tasks that were left unstarted
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertNil(workflow.targetTasks, @"targetTasks is non-nil");
+    XCTAssertEqual(sibling.state, TSKTaskStateFinished, @"state is not finished");
+    XCTAssertEqual(unrelated.state, TSKTaskStateFinished, @"state is not finished");
+    XCTAssertEqual(addedTask.state, TSKTaskStateFinished, @"state is not finished");
+    XCTAssertFalse(workflow.hasUnfinishedTasks, @"workflow.hasUnfinishedTasks is true");
+}
+
+
+- (void)testConditionalPrerequisites
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+
+    // branch -> left -> join, branch -> right -> rightChild -> join
+    __block NSString *direction = @"left";
+    TSKBlockTask *branch = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        [task finishWithResult:direction];
+    }];
+
+    TSKTask *left = [self finishingTaskWithLock:nil];
+    TSKTask *right = [self finishingTaskWithLock:nil];
+    TSKTask *rightChild = [self finishingTaskWithLock:nil];
+    TSKTask *join = [self finishingTaskWithLock:nil];
+    join.runsWhenPrerequisitesSkipped = YES;
+
+    [workflow addTask:branch prerequisites:nil];
+    [workflow addTask:left conditionalPrerequisiteTask:branch condition:^BOOL(id result) {
+        return [result isEqual:@"left"];
+    } prerequisiteTasks:nil];
+    [workflow addTask:right conditionalPrerequisiteTask:branch condition:^BOOL(id result) {
+        return [result isEqual:@"right"];
+    } prerequisiteTasks:nil];
+    [workflow addTask:rightChild prerequisites:right, nil];
+    [workflow addTask:join prerequisites:left, rightChild, nil];
+
+    XCTAssertEqualObjects([workflow prerequisiteTasksForTask:left], [NSSet setWithObject:branch], @"conditional prerequisite not added");
+
+    // Skipping is not a failure or cancellation
+    __block NSUInteger failureAndCancellationCount = 0;
+    id observer = [workflow.notificationCenter addObserverForName:nil object:workflow queue:nil usingBlock:^(NSNotification *note) {
+        if ([note.name isEqualToString:TSKWorkflowTaskDidFailNotification] || [note.name isEqualToString:TSKWorkflowTaskDidCancelNotification]) {
+            ++failureAndCancellationCount;
+        }
+    }];
+
+    [self expectationForNotification:TSKTaskDidSkipNotification object:right handler:nil];
+    [self expectationForNotification:TSKTaskDidSkipNotification object:rightChild handler:nil];
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertEqual(left.state, TSKTaskStateFinished, @"taken branch did not finish");
+    XCTAssertTrue(right.isSkipped, @"branch not taken was not skipped");
+    XCTAssertTrue(rightChild.isSkipped, @"dependent of skipped task was not skipped");
+    XCTAssertEqual(join.state, TSKTaskStateFinished, @"join task did not run");
+    XCTAssertFalse(workflow.hasUnfinishedTasks, @"workflow.hasUnfinishedTasks is true");
+
+    // Invalidating the branch decides again which side runs
+    direction = @"right";
+    [self expectationForNotification:TSKTaskDidSkipNotification object:left handler:nil];
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    [branch invalidate];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertTrue(left.isSkipped, @"branch not taken was not skipped");
+    XCTAssertEqual(right.state, TSKTaskStateFinished, @"taken branch did not finish");
+    XCTAssertEqual(rightChild.state, TSKTaskStateFinished, @"taken branch did not finish");
+    XCTAssertEqual(join.state, TSKTaskStateFinished, @"join task did not run");
+
+    // Skipping a task directly skips its dependents that don’t run when prerequisites are skipped
+    [workflow reset];
+    XCTAssertFalse(right.isSkipped, @"reset task is still skipped");
+    [right skip];
+    XCTAssertTrue(right.isSkipped, @"skipped task is not skipped");
+    XCTAssertTrue(rightChild.isSkipped, @"dependent of skipped task was not skipped");
+    XCTAssertFalse(join.isSkipped, @"task that runs when prerequisites are skipped was skipped");
+
+    [workflow.notificationCenter removeObserver:observer];
+    XCTAssertEqual(failureAndCancellationCount, 0, @"failure or cancellation notifications were posted");
+}
+
+
+- (void)testConditionThatModifiesWorkflow
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+
+    // Conditions are evaluated without holding the workflow’s graph lock, so they can add tasks
+    TSKTask *prerequisite = [self finishingTaskWithLock:nil];
+    TSKTask *dependent = [self finishingTaskWithLock:nil];
+    TSKTask *addedTask = [self finishingTaskWithLock:nil];
+
+    [workflow addTask:prerequisite prerequisites:nil];
+    [workflow addTask:dependent conditionalPrerequisiteTask:prerequisite condition:^BOOL(id result) {
+        if (!addedTask.workflow) {
+            [workflow addTask:addedTask prerequisites:nil];
+        }
+
+        return YES;
+    } prerequisiteTasks:nil];
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:dependent];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertTrue([workflow.allTasks containsObject:addedTask], @"task added by condition is not in workflow");
+    XCTAssertEqual(dependent.state, TSKTaskStateFinished, @"dependent did not finish");
+}
+
+
 - (void)testReset
 {
     NSLock *willFinishLock = [[NSLock alloc] init];
@@ -630,6 +1229,355 @@
 }
 
 
+- (void)testTimeout
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    XCTAssertEqual(workflow.timeout, 0, @"timeout is non-zero by default");
+    workflow.timeout = 0.05;
+
+    TSKTestTask *task = [[TSKTestTask alloc] initWithBlock:^(TSKTask *task) {
+        while (!task.cancellationToken.isCancelled) {
+            usleep(1000);
+        }
+    }];
+
+    TSKTestTask *dependentTask = [self finishingTaskWithLock:nil];
+    [workflow addTask:task prerequisites:nil];
+    [workflow addTask:dependentTask prerequisites:task, nil];
+
+    [self expectationForNotification:TSKWorkflowTaskDidFailNotification workflow:workflow block:^(NSNotification *note) {
+        XCTAssertEqual(note.userInfo[TSKWorkflowTaskKey], task, @"notification has incorrect task");
+    }];
+
+    [workflow start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertEqualObjects(task.error.domain, TSKTaskErrorDomain, @"error domain is incorrect");
+    XCTAssertEqual(task.error.code, TSKErrorCodeTimedOut, @"error code is incorrect");
+    XCTAssertEqual(dependentTask.state, TSKTaskStatePending, @"dependent task is not pending");
+
+    // Workflows that finish before their timeout are unaffected by it
+    TSKWorkflow *finishingWorkflow = [self workflowForNotificationTesting];
+    finishingWorkflow.timeout = 0.05;
+    TSKTestTask *finishingTask = [self finishingTaskWithLock:nil];
+    [finishingWorkflow addTask:finishingTask prerequisites:nil];
+
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:finishingWorkflow block:nil];
+    [finishingWorkflow start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTestExpectation *timeoutElapsedExpectation = [self expectationWithDescription:@"timeout elapsed"];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.15 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [timeoutElapsedExpectation fulfill];
+    });
+
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+    XCTAssertTrue(finishingTask.isFinished, @"task is not finished after its workflow’s timeout elapsed");
+}
+
+
+- (void)testStartWithCompletionHandler
+{
+    // Empty workflows finish immediately
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    __block TSKWorkflowOutcome outcome = TSKWorkflowOutcomeCancelled;
+    [workflow startWithCompletionHandler:^(TSKWorkflowOutcome completedOutcome, NSError *error) {
+        outcome = completedOutcome;
+        XCTAssertNil(error, @"error is non-nil");
+    }];
+
+    XCTAssertEqual(outcome, TSKWorkflowOutcomeFinished, @"outcome is incorrect");
+
+    // Finishing
+    TSKTestTask *task = [self finishingTaskWithLock:nil];
+    [workflow addTask:task prerequisites:nil];
+
+    XCTestExpectation *finishExpectation = [self expectationWithDescription:@"completion handler invoked"];
+    [workflow startWithCompletionHandler:^(TSKWorkflowOutcome outcome, NSError *error) {
+        XCTAssertEqual(outcome, TSKWorkflowOutcomeFinished, @"outcome is incorrect");
+        XCTAssertTrue(task.isFinished, @"task is not finished");
+        [finishExpectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    // Failing
+    NSError *error = UMKRandomError();
+    TSKWorkflow *failingWorkflow = [self workflowForNotificationTesting];
+    TSKBlockTask *failingTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        [task failWithError:error];
+    }];
+
+    [failingWorkflow addTask:failingTask prerequisites:nil];
+
+    XCTestExpectation *failExpectation = [self expectationWithDescription:@"completion handler invoked"];
+    [failingWorkflow startWithCompletionHandler:^(TSKWorkflowOutcome outcome, NSError *completionError) {
+        XCTAssertEqual(outcome, TSKWorkflowOutcomeFailed, @"outcome is incorrect");
+        XCTAssertEqualObjects(completionError, error, @"error is incorrect");
+        [failExpectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    // Workflows that already have an outcome report it without starting
+    outcome = TSKWorkflowOutcomeFinished;
+    [failingWorkflow startWithCompletionHandler:^(TSKWorkflowOutcome completedOutcome, NSError *completionError) {
+        outcome = completedOutcome;
+        XCTAssertEqualObjects(completionError, error, @"error is incorrect");
+    }];
+
+    XCTAssertEqual(outcome, TSKWorkflowOutcomeFailed, @"outcome is incorrect");
+
+    // Cancelling
+    TSKWorkflow *cancelledWorkflow = [self workflowForNotificationTesting];
+    TSKTestTask *executingTask = [[TSKTestTask alloc] initWithBlock:^(TSKTask *task) {
+        while (!task.cancellationToken.isCancelled) {
+            usleep(1000);
+        }
+    }];
+
+    [cancelledWorkflow addTask:executingTask prerequisites:nil];
+
+    XCTestExpectation *startExpectation = [self expectationForNotification:TSKTestTaskDidStartNotification object:executingTask handler:nil];
+    XCTestExpectation *cancelExpectation = [self expectationWithDescription:@"completion handler invoked"];
+    [cancelledWorkflow startWithCompletionHandler:^(TSKWorkflowOutcome outcome, NSError *error) {
+        XCTAssertEqual(outcome, TSKWorkflowOutcomeCancelled, @"outcome is incorrect");
+        [cancelExpectation fulfill];
+    }];
+
+    [self waitForExpectations:@[ startExpectation ] timeout:1];
+    [cancelledWorkflow cancel];
+    [self waitForExpectations:@[ cancelExpectation ] timeout:1];
+}
+
+
+- (void)testWaitUntilFinished
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    TSKTestTask *task = [self finishingTaskWithLock:nil];
+    TSKTestTask *dependentTask = [self finishingTaskWithLock:nil];
+    [workflow addTask:task prerequisites:nil];
+    [workflow addTask:dependentTask prerequisites:task, nil];
+
+    // Workflows that have never been started wait until the timeout elapses
+    NSError *error = UMKRandomError();
+    XCTAssertEqual([workflow waitUntilFinishedWithTimeout:0.01 error:&error], TSKWorkflowOutcomeUnfinished, @"wait did not time out");
+    XCTAssertNil(error, @"error is non-nil");
+
+    [workflow start];
+    XCTAssertEqual([workflow waitUntilFinishedWithTimeout:1 error:&error], TSKWorkflowOutcomeFinished, @"outcome is incorrect");
+    XCTAssertNil(error, @"error is non-nil");
+    XCTAssertTrue(dependentTask.isFinished, @"dependent task is not finished");
+
+    // Failing reports the first error
+    NSError *taskError = UMKRandomError();
+    TSKWorkflow *failingWorkflow = [self workflowForNotificationTesting];
+    TSKBlockTask *failingTask = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+        [task failWithError:taskError];
+    }];
+
+    [failingWorkflow addTask:failingTask prerequisites:nil];
+    [failingWorkflow start];
+    XCTAssertEqual([failingWorkflow waitUntilFinishedWithTimeout:1 error:&error], TSKWorkflowOutcomeFailed, @"outcome is incorrect");
+    XCTAssertEqualObjects(error, taskError, @"error is incorrect");
+
+    // Cancelling from another thread while waiting
+    TSKWorkflow *cancelledWorkflow = [self workflowForNotificationTesting];
+    NSLock *lock = [[NSLock alloc] init];
+    [lock lock];
+    [cancelledWorkflow addTask:[self finishingTaskWithLock:lock] prerequisites:nil];
+    [cancelledWorkflow start];
+
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.05 * NSEC_PER_SEC)), dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+        [cancelledWorkflow cancel];
+    });
+
+    XCTAssertEqual([cancelledWorkflow waitUntilFinishedWithTimeout:1 error:NULL], TSKWorkflowOutcomeCancelled, @"outcome is incorrect");
+    [lock unlock];
+}
+
+
+- (void)testBatching
+{
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    XCTAssertEqual(workflow.batchSize, 64, @"batchSize default is incorrect");
+    XCTAssertEqual(workflow.batchLingerInterval, 0.001, @"batchLingerInterval default is incorrect");
+
+    workflow.batchSize = random() % 16 + 2;
+    workflow.batchLingerInterval = 0.05;
+
+    NSUInteger taskCount = random() % 100 + 100;
+    NSLock *executedCountLock = [[NSLock alloc] init];
+    __block NSUInteger executedCount = 0;
+    for (NSUInteger i = 0; i < taskCount; ++i) {
+        TSKBlockTask *task = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+            [executedCountLock lock];
+            ++executedCount;
+            [executedCountLock unlock];
+            [task finishWithResult:nil];
+        }];
+
+        task.batchable = YES;
+        [workflow addTask:task prerequisites:nil];
+    }
+
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:workflow block:nil];
+    [workflow start];
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+
+    // Every task runs, but in far fewer operations than there are tasks
+    XCTAssertEqual(executedCount, taskCount, @"not every task executed");
+    uint64_t batchCount = [workflow.metrics.snapshot valueForCounter:TSKMetricsCounterBatchesDispatched];
+    XCTAssertGreaterThanOrEqual(batchCount, (taskCount + workflow.batchSize - 1) / workflow.batchSize, @"batches are too large");
+    XCTAssertLessThan(batchCount, taskCount, @"tasks were not batched");
+
+    // A batch size of 1 disables batching
+    TSKWorkflow *unbatchedWorkflow = [self workflowForNotificationTesting];
+    unbatchedWorkflow.batchSize = 1;
+    TSKTestTask *task = [self finishingTaskWithLock:nil];
+    task.batchable = YES;
+    [unbatchedWorkflow addTask:task prerequisites:nil];
+
+    [self expectationForNotification:TSKWorkflowDidFinishNotification workflow:unbatchedWorkflow block:nil];
+    [unbatchedWorkflow start];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+    XCTAssertEqual([unbatchedWorkflow.metrics.snapshot valueForCounter:TSKMetricsCounterBatchesDispatched], 0,
+                   @"task was batched with batching disabled");
+}
+
+
+- (void)testBatchDeadline
+{
+    // The scheduler runs one block at a time in earliest-deadline-first order
+    TSKFairScheduler *scheduler = [[TSKFairScheduler alloc] initWithOperationQueue:[[NSOperationQueue alloc] init] maximumConcurrentTaskCount:1];
+    scheduler.policy = TSKSchedulingPolicyEarliestDeadlineFirst;
+
+    TSKWorkflow *workflow = [self workflowForNotificationTesting];
+    workflow.scheduler = scheduler;
+    workflow.batchSize = 2;
+    workflow.batchLingerInterval = 10;
+
+    NSMutableArray<TSKTask *> *runOrder = [[NSMutableArray alloc] init];
+    TSKTask *(^recordingTask)(void) = ^TSKTask *{
+        return [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+            @synchronized (runOrder) {
+                [runOrder addObject:task];
+            }
+
+            [task finishWithResult:nil];
+        }];
+    };
+
+    // The batch is dispatched on behalf of its undated first task, but it must be ordered by its
+    // urgent task’s deadline, which is earlier than the unbatched task’s
+    TSKTask *unbatchedTask = recordingTask();
+    unbatchedTask.deadline = [NSDate dateWithTimeIntervalSinceNow:60];
+
+    TSKTask *undatedTask = recordingTask();
+    undatedTask.batchable = YES;
+
+    TSKTask *urgentTask = recordingTask();
+    urgentTask.batchable = YES;
+    urgentTask.deadline = [NSDate dateWithTimeIntervalSinceNow:30];
+
+    [workflow addTask:unbatchedTask prerequisites:nil];
+    [workflow addTask:undatedTask prerequisites:nil];
+    [workflow addTask:urgentTask prerequisites:nil];
+
+    // Occupy the scheduler’s only slot so that everything else is queued
+    NSLock *lock = [[NSLock alloc] init];
+    [lock lock];
+    [scheduler scheduleBlock:^{
+        [lock lock];
+        [lock unlock];
+    } forWorkflow:[[TSKWorkflow alloc] init]];
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:unbatchedTask];
+    [self expectationForNotification:TSKTaskDidFinishNotification task:undatedTask];
+    [self expectationForNotification:TSKTaskDidFinishNotification task:urgentTask];
+    [unbatchedTask start];
+    [undatedTask start];
+    [urgentTask start];
+    [lock unlock];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    NSArray *expectedRunOrder = @[ undatedTask, urgentTask, unbatchedTask ];
+    XCTAssertEqualObjects(runOrder, expectedRunOrder, @"batch was not ordered by its earliest deadline");
+}
+
+
+- (void)testDeadlineWithoutScheduler
+{
+    // The workflow has no scheduler, and its queue runs one operation at a time and starts suspended
+    // so that everything is queued before anything runs
+    NSOperationQueue *operationQueue = [[NSOperationQueue alloc] init];
+    operationQueue.maxConcurrentOperationCount = 1;
+    operationQueue.suspended = YES;
+    TSKWorkflow *workflow = [[TSKWorkflow alloc] initWithName:nil operationQueue:operationQueue notificationCenter:self.notificationCenter];
+
+    NSMutableArray<TSKTask *> *runOrder = [[NSMutableArray alloc] init];
+    TSKTask *(^recordingTask)(void) = ^TSKTask *{
+        return [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+            @synchronized (runOrder) {
+                [runOrder addObject:task];
+            }
+
+            [task finishWithResult:nil];
+        }];
+    };
+
+    // The task with an imminent deadline is started last, but must run first
+    TSKTask *undatedTask = recordingTask();
+    TSKTask *urgentTask = recordingTask();
+    urgentTask.deadline = [NSDate dateWithTimeIntervalSinceNow:5];
+
+    [workflow addTask:undatedTask prerequisites:nil];
+    [workflow addTask:urgentTask prerequisites:nil];
+
+    [self expectationForNotification:TSKTaskDidFinishNotification task:undatedTask];
+    [self expectationForNotification:TSKTaskDidFinishNotification task:urgentTask];
+    [undatedTask start];
+    [urgentTask start];
+    operationQueue.suspended = NO;
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    NSArray *expectedRunOrder = @[ urgentTask, undatedTask ];
+    XCTAssertEqualObjects(runOrder, expectedRunOrder, @"tasks were not ordered by deadline without a scheduler");
+}
+
+
+- (void)testBatchedThroughput
+{
+    [self measureThroughputOfTasksThatAreBatchable:YES];
+}
+
+
+- (void)testUnbatchedThroughput
+{
+    [self measureThroughputOfTasksThatAreBatchable:NO];
+}
+
+
+- (void)measureThroughputOfTasksThatAreBatchable:(BOOL)batchable
+{
+    const NSUInteger taskCount = 10000;
+    [self measureBlock:^{
+        TSKWorkflow *workflow = [[TSKWorkflow alloc] init];
+        for (NSUInteger i = 0; i < taskCount; ++i) {
+            TSKBlockTask *task = [[TSKBlockTask alloc] initWithBlock:^(TSKTask *task) {
+                [task finishWithResult:nil];
+            }];
+
+            task.batchable = batchable;
+            [workflow addTask:task prerequisites:nil];
+        }
+
+        [workflow start];
+        XCTAssertEqual([workflow waitUntilFinishedWithTimeout:30 error:NULL], TSKWorkflowOutcomeFinished, @"workflow did not finish");
+    }];
+}
+
+
 - (void)testWorkflowDelegateFinish
 {
     // Message-counting delegate
@@ -0,0 +1,111 @@
+//
+//  main.m
+//  TaskWorkerFixture
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <Task/Task.h>
+
+
+#if TARGET_OS_OSX
+
+/*!
+ @abstract Performs a request sent by TSKWorkerPoolTestCase.
+ @discussion Requests are dictionaries whose "operation" entry selects what to do:
+
+     - "spin" performs "iterations" rounds of a xorshift generator and returns its final state.
+     - "echo" returns the request’s "value".
+     - "fail" fails with an error whose domain and code are the request’s "domain" and "code".
+     - "crash" aborts the worker.
+     - "crashOnce" aborts the worker unless the file at "markerPath" exists, creating it first, and
+       returns "recovered" otherwise.
+     - "hang" never returns.
+ */
+static id TSKWorkerFixturePerformRequest(NSDictionary *request, NSError **error)
+{
+    NSString *operation = request[@"operation"];
+    if ([operation isEqualToString:@"spin"]) {
+        uint64_t state = [request[@"seed"] unsignedLongLongValue] | 1;
+        uint64_t iterations = [request[@"iterations"] unsignedLongLongValue];
+        for (uint64_t i = 0; i < iterations; ++i) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+        }
+
+        return @(state);
+    } else if ([operation isEqualToString:@"echo"]) {
+        return request[@"value"];
+    } else if ([operation isEqualToString:@"fail"]) {
+        if (error) {
+            *error = [NSError errorWithDomain:request[@"domain"] code:[request[@"code"] integerValue] userInfo:nil];
+        }
+
+        return nil;
+    } else if ([operation isEqualToString:@"crash"]) {
+        abort();
+    } else if ([operation isEqualToString:@"crashOnce"]) {
+        NSString *markerPath = request[@"markerPath"];
+        if (![[NSFileManager defaultManager] fileExistsAtPath:markerPath]) {
+            [[NSFileManager defaultManager] createFileAtPath:markerPath contents:nil attributes:nil];
+            abort();
+        }
+
+        return @"recovered";
+    } else if ([operation isEqualToString:@"hang"]) {
+        while (YES) {
+            pause();
+        }
+    }
+
+    if (error) {
+        *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSFeatureUnsupportedError userInfo:nil];
+    }
+
+    return nil;
+}
+
+
+int main(int argc, const char *argv[])
+{
+    @autoreleasepool {
+        NSSet *requestClasses = [NSSet setWithObjects:[NSDictionary class], [NSString class], [NSNumber class], nil];
+        TSKWorker *worker = [[TSKWorker alloc] initWithAllowedRequestClasses:requestClasses handler:^id(NSDictionary *request, NSError **error) {
+            return TSKWorkerFixturePerformRequest(request, error);
+        }];
+
+        [worker run];
+    }
+
+    return 0;
+}
+
+#else
+
+int main(int argc, const char *argv[])
+{
+    return 1;
+}
+
+#endif